@@ -29,7 +29,8 @@ let package = Package(
             linkerSettings: [
                 .linkedFramework("Foundation"),
                 .linkedFramework("SafariServices"),
-                .linkedFramework("CoreData")
+                .linkedFramework("CoreData"),
+                .linkedLibrary("z")
             ]
         ),
         // CloudXMetaAdapter - Binary framework target
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+@interface CLXAuctionDeadlineMockTask : NSObject
+- (void)resume;
+@end
+
+@implementation CLXAuctionDeadlineMockTask
+- (void)resume {
+}
+@end
+
+// Answers every request with 503 and counts the attempts
+@interface CLXAuctionDeadlineMockSession : NSURLSession
+@property (atomic, assign) NSInteger requestCount;
+@property (atomic, strong) NSURLRequest *lastRequest;
+@end
+
+@implementation CLXAuctionDeadlineMockSession
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                            completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
+    self.requestCount += 1;
+    self.lastRequest = request;
+    NSHTTPURLResponse *httpResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:503 HTTPVersion:@"HTTP/1.1" headerFields:@{}];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        completionHandler(nil, httpResponse, nil);
+    });
+    return (NSURLSessionDataTask *)[[CLXAuctionDeadlineMockTask alloc] init];
+}
+
+@end
+
+// Cacheable ad that records the timeout it was loaded with
+@interface CLXAuctionDeadlineMockAd : NSObject <CLXCacheableAd>
+@property (nonatomic, copy) NSString *impressionID;
+@property (nonatomic, strong, nullable) CLXBidResponse *bidResponse;
+@property (nonatomic, assign) NSTimeInterval loadTimeout;
+@property (nonatomic, assign) BOOL loadCalled;
+@end
+
+@implementation CLXAuctionDeadlineMockAd
+
+- (NSString *)network {
+    return @"test";
+}
+
+- (void)loadWithTimeout:(NSTimeInterval)timeout completion:(void (^)(NSError * _Nullable error))completion {
+    self.loadCalled = YES;
+    self.loadTimeout = timeout;
+    completion(nil);
+}
+
+- (void)showFromViewController:(UIViewController *)viewController {
+}
+
+- (void)destroy {
+}
+
+@end
+
+@interface CLXAuctionDeadlineTests : XCTestCase
+@property (atomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXAuctionDeadlineTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 100;
+    [[CLXRetryBudget shared] reset];
+}
+
+- (CLXAuctionDeadline *)_deadlineWithBudget:(NSTimeInterval)budget {
+    __weak typeof(self) weakSelf = self;
+    return [[CLXAuctionDeadline alloc] initWithBudget:budget clock:^NSTimeInterval{
+        return weakSelf.now;
+    }];
+}
+
+- (CLXCacheAdQueue *)_queue {
+    id<AdEventReporting> reportingService = nil;
+    return [[CLXCacheAdQueue alloc] initWithMaxCapacity:3 reportingService:reportingService placementID:@"placement"];
+}
+
+#pragma mark - Budget
+
+- (void)testRemainingBudgetShrinksWithTime {
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:2.0];
+    XCTAssertEqualWithAccuracy(deadline.remaining, 2.0, 0.001);
+
+    self.now += 1.5;
+    XCTAssertEqualWithAccuracy(deadline.elapsed, 1.5, 0.001);
+    XCTAssertEqualWithAccuracy(deadline.remaining, 0.5, 0.001);
+    XCTAssertTrue([deadline canFinishWithin:0.4]);
+    XCTAssertFalse([deadline canFinishWithin:0.6]);
+    XCTAssertFalse(deadline.isExpired);
+
+    self.now += 1.0;
+    XCTAssertEqual(deadline.remaining, 0);
+    XCTAssertTrue(deadline.isExpired);
+}
+
+- (void)testStageTimeoutIsCappedByRemainingBudget {
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:1.0];
+    XCTAssertEqualWithAccuracy([deadline timeoutBoundedBy:0.3], 0.3, 0.001);
+    XCTAssertEqualWithAccuracy([deadline timeoutBoundedBy:10.0], 1.0, 0.001);
+    XCTAssertEqualWithAccuracy([deadline timeoutBoundedBy:0], 1.0, 0.001);
+}
+
+- (void)testStageDurationsAreRecorded {
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:5.0];
+
+    [deadline beginStage:CLXMetricsTypeAuctionStageBidTokens];
+    self.now += 0.25;
+    NSTimeInterval duration = [deadline endStage:CLXMetricsTypeAuctionStageBidTokens];
+
+    XCTAssertEqualWithAccuracy(duration, 0.25, 0.001);
+    XCTAssertEqualObjects(deadline.stageDurations[CLXMetricsTypeAuctionStageBidTokens], @250);
+    XCTAssertEqual([deadline endStage:CLXMetricsTypeAuctionStageBidRequest], 0, @"A stage that never began has no duration");
+}
+
+#pragma mark - Network Retries
+
+- (void)testRetryIsSkippedWhenItCannotFinishInTime {
+    CLXAuctionDeadlineMockSession *session = [[CLXAuctionDeadlineMockSession alloc] init];
+    CLXBaseNetworkService *service = [[CLXBaseNetworkService alloc] initWithBaseURL:@"https://test.cloudx.io/auction" urlSession:session];
+    CLXAuctionDeadline *deadline = [[CLXAuctionDeadline alloc] initWithBudget:0.5];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    __block NSError *resultError = nil;
+    NSDate *start = [NSDate date];
+    [service executeRequestWithEndpoint:@""
+                          urlParameters:nil
+                            requestBody:[@"{}" dataUsingEncoding:NSUTF8StringEncoding]
+                                headers:nil
+                             maxRetries:1
+                                  delay:1.0
+                               deadline:deadline
+                             completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
+        resultError = error;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqual(session.requestCount, 1, @"The 1s retry delay does not fit in a 0.5s budget");
+    XCTAssertNotNil(resultError);
+    XCTAssertLessThan([[NSDate date] timeIntervalSinceDate:start], 0.9);
+    XCTAssertLessThanOrEqual(session.lastRequest.timeoutInterval, 0.5);
+}
+
+- (void)testExpiredDeadlineSendsNothing {
+    CLXAuctionDeadlineMockSession *session = [[CLXAuctionDeadlineMockSession alloc] init];
+    CLXBaseNetworkService *service = [[CLXBaseNetworkService alloc] initWithBaseURL:@"https://test.cloudx.io/auction" urlSession:session];
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:1.0];
+    self.now += 2.0;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    __block NSError *resultError = nil;
+    [service executeRequestWithEndpoint:@""
+                          urlParameters:nil
+                            requestBody:nil
+                                headers:nil
+                             maxRetries:1
+                                  delay:1.0
+                               deadline:deadline
+                             completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
+        resultError = error;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+
+    XCTAssertEqual(session.requestCount, 0);
+    XCTAssertEqual(resultError.code, CLXErrorCodeNetworkTimeout);
+}
+
+#pragma mark - Adapter Load
+
+- (void)testQueueCapsLoadTimeoutAndTimesTheLoad {
+    CLXCacheAdQueue *queue = [self _queue];
+    CLXAuctionDeadlineMockAd *ad = [[CLXAuctionDeadlineMockAd alloc] init];
+    ad.impressionID = @"imp";
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:2.0];
+    self.now += 0.5;
+
+    __block NSError *resultError = nil;
+    XCTestExpectation *loaded = [self expectationWithDescription:@"load"];
+    [queue enqueueAdWithPrice:1.0 loadTimeout:10.0 bidID:@"bid" ad:ad deadline:deadline completion:^(NSError * _Nullable error) {
+        resultError = error;
+        [loaded fulfill];
+    }];
+    [self waitForExpectations:@[loaded] timeout:2.0];
+
+    XCTAssertNil(resultError);
+    XCTAssertEqualWithAccuracy(ad.loadTimeout, 1.5, 0.001);
+    XCTAssertNotNil(deadline.stageDurations[CLXMetricsTypeAuctionStageAdapterLoad]);
+    XCTAssertTrue(queue.hasItems);
+}
+
+- (void)testQueueRefusesToLoadAfterDeadline {
+    CLXCacheAdQueue *queue = [self _queue];
+    CLXAuctionDeadlineMockAd *ad = [[CLXAuctionDeadlineMockAd alloc] init];
+    ad.impressionID = @"imp";
+    CLXAuctionDeadline *deadline = [self _deadlineWithBudget:1.0];
+    self.now += 1.0;
+
+    __block NSError *resultError = nil;
+    [queue enqueueAdWithPrice:1.0 loadTimeout:10.0 bidID:@"bid" ad:ad deadline:deadline completion:^(NSError * _Nullable error) {
+        resultError = error;
+    }];
+
+    XCTAssertFalse(ad.loadCalled);
+    XCTAssertEqual(resultError.code, CacheAdQueueErrorTimeout);
+    XCTAssertTrue(queue.isEmpty);
+}
+
+@end
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+static const NSInteger kCLXRequestBuildIterations = 200;
+
+@interface CLXBidRequestTemplateTests : XCTestCase
+@property (nonatomic, copy) NSDictionary *adapterInfo;
+@end
+
+@implementation CLXBidRequestTemplateTests
+
+- (void)setUp {
+    [super setUp];
+    self.adapterInfo = @{
+        @"meta": @{@"bid_token": @"meta-token-abcdef0123456789"},
+        @"vungle": @{@"bid_token": @"vungle-token-0123456789abcdef"}
+    };
+}
+
+- (NSDictionary *)_fullBidRequestJSON {
+    CLXBiddingConfigRequest *request = [[CLXBiddingConfigRequest alloc] initWithAdType:CLXAdTypeBanner
+                                                                             adUnitID:@"banner-unit"
+                                                                   storedImpressionId:@"placement-1"
+                                                                               dealID:nil
+                                                                             bidFloor:@0.01
+                                                                       displayManager:@"CLOUDX"
+                                                                    displayManagerVer:@"1.0.0"
+                                                                          publisherID:@"publisher-1"
+                                                                             location:nil
+                                                                            userAgent:nil
+                                                                          adapterInfo:self.adapterInfo
+                                                                 nativeAdRequirements:nil
+                                                                skadRequestParameters:nil
+                                                                                 tmax:@3000
+                                                                             impModel:nil
+                                                                             settings:[CLXSettings sharedInstance]
+                                                                       privacyService:[CLXPrivacyService sharedInstance]];
+    return [request json];
+}
+
+- (NSArray<id<XCTMetric>> *)_requestBuildMetrics {
+    return @[[[XCTClockMetric alloc] init], [[XCTCPUMetric alloc] init], [[XCTMemoryMetric alloc] init]];
+}
+
+#pragma mark - Tests
+
+- (void)testTemplateRequestMatchesFullBuild {
+    NSDictionary *full = [self _fullBidRequestJSON];
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:full nativeAdRequirements:nil];
+    XCTAssertNotNil(requestTemplate);
+
+    NSString *impressionID = full[@"imp"][0][@"id"];
+    NSData *body = nil;
+    NSDictionary *patched = [requestTemplate bidRequestWithRequestID:full[@"id"]
+                                                        impressionID:impressionID
+                                                         adapterInfo:self.adapterInfo
+                                                                tmax:@3000
+                                                         encodedBody:&body];
+    XCTAssertEqualObjects(patched, full);
+
+    // The spliced body decodes to the same request
+    XCTAssertNotNil(body);
+    NSDictionary *decoded = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+    XCTAssertEqualObjects(decoded, [NSJSONSerialization JSONObjectWithData:[NSJSONSerialization dataWithJSONObject:full options:0 error:nil] options:0 error:nil]);
+}
+
+- (void)testPerAuctionFieldsAreSpliced {
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:[self _fullBidRequestJSON] nativeAdRequirements:nil];
+
+    NSData *body = nil;
+    NSDictionary *request = [requestTemplate bidRequestWithRequestID:@"auction-2"
+                                                        impressionID:@"imp-2"
+                                                         adapterInfo:@{@"meta": @{@"bid_token": @"new-token"}}
+                                                                tmax:nil
+                                                         encodedBody:&body];
+    NSDictionary *decoded = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+
+    for (NSDictionary *json in @[request, decoded]) {
+        XCTAssertEqualObjects(json[@"id"], @"auction-2");
+        XCTAssertEqualObjects(json[@"imp"][0][@"id"], @"imp-2");
+        XCTAssertEqualObjects(json[@"imp"][0][@"tagid"], @"placement-1");
+        XCTAssertEqualObjects(json[@"ext"][@"cloudx"][@"adapter_extras"][@"meta"][@"bid_token"], @"new-token");
+        XCTAssertNil(json[@"tmax"]);
+        XCTAssertNotNil(json[@"device"]);
+        XCTAssertNotNil(json[@"regs"]);
+    }
+}
+
+- (void)testCacheInvalidatesOnInputChangeNotification {
+    CLXBidRequestTemplateCache *cache = [[CLXBidRequestTemplateCache alloc] init];
+    cache.fingerprintProviderForTesting = ^id{ return @"stable"; };
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:[self _fullBidRequestJSON] nativeAdRequirements:nil];
+
+    [cache setTemplate:requestTemplate forKey:@"banner"];
+    XCTAssertEqual([cache templateForKey:@"banner"], requestTemplate);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:nil];
+    XCTAssertNil([cache templateForKey:@"banner"]);
+    XCTAssertEqual(cache.invalidationCount, 1);
+}
+
+- (void)testCacheInvalidatesWhenFingerprintChanges {
+    CLXBidRequestTemplateCache *cache = [[CLXBidRequestTemplateCache alloc] init];
+    __block NSString *gpp = @"DBABMA~1YNN";
+    cache.fingerprintProviderForTesting = ^id{ return gpp; };
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:[self _fullBidRequestJSON] nativeAdRequirements:nil];
+
+    XCTAssertNil([cache templateForKey:@"banner"]);
+    [cache setTemplate:requestTemplate forKey:@"banner"];
+    XCTAssertNotNil([cache templateForKey:@"banner"]);
+
+    // A CMP rewrote the consent string directly in NSUserDefaults
+    gpp = @"DBABMA~1NNN";
+    XCTAssertNil([cache templateForKey:@"banner"]);
+}
+
+- (void)testCacheInvalidatesWhenUTCOffsetChanges {
+    NSTimeZone *originalTimeZone = [NSTimeZone defaultTimeZone];
+    NSTimeZone *otherTimeZone = [NSTimeZone timeZoneForSecondsFromGMT:originalTimeZone.secondsFromGMT == 14 * 3600 ? 0 : 14 * 3600];
+    CLXBidRequestTemplateCache *cache = [[CLXBidRequestTemplateCache alloc] init];
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:[self _fullBidRequestJSON] nativeAdRequirements:nil];
+
+    XCTAssertNil([cache templateForKey:@"interstitial"]);
+    [cache setTemplate:requestTemplate forKey:@"interstitial"];
+    XCTAssertEqual([cache templateForKey:@"interstitial"], requestTemplate, @"The live fingerprint is stable between lookups");
+
+    // geo.utcoffset is baked into the template
+    [NSTimeZone setDefaultTimeZone:otherTimeZone];
+    @try {
+        XCTAssertNil([cache templateForKey:@"interstitial"]);
+    } @finally {
+        [NSTimeZone setDefaultTimeZone:originalTimeZone];
+    }
+}
+
+- (void)testEncodedBodyIsBoundToDictionaryInstance {
+    CLXBidRequestTemplateCache *cache = [[CLXBidRequestTemplateCache alloc] init];
+    NSData *body = [@"{}" dataUsingEncoding:NSUTF8StringEncoding];
+    NSDictionary *request = @{@"id": @"auction-1"};
+    NSDictionary *equalCopy = [NSDictionary dictionaryWithDictionary:request];
+
+    [cache setEncodedBody:body forBidRequest:request];
+    XCTAssertNil([cache takeEncodedBodyForBidRequest:equalCopy]);
+    XCTAssertEqualObjects([cache takeEncodedBodyForBidRequest:request], body);
+    XCTAssertNil([cache takeEncodedBodyForBidRequest:request], @"Bodies are handed out once");
+}
+
+// Clock, CPU and peak memory of building the request body from scratch; compare with the templated build below
+- (void)testPerformanceFullRequestBuild {
+    [self measureWithMetrics:[self _requestBuildMetrics] block:^{
+        for (NSInteger i = 0; i < kCLXRequestBuildIterations; i++) {
+            @autoreleasepool {
+                [NSJSONSerialization dataWithJSONObject:[self _fullBidRequestJSON] options:0 error:nil];
+            }
+        }
+    }];
+}
+
+- (void)testPerformanceTemplatedRequestBuild {
+    CLXBidRequestTemplate *requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:[self _fullBidRequestJSON] nativeAdRequirements:nil];
+    [self measureWithMetrics:[self _requestBuildMetrics] block:^{
+        for (NSInteger i = 0; i < kCLXRequestBuildIterations; i++) {
+            @autoreleasepool {
+                NSData *body = nil;
+                [requestTemplate bidRequestWithRequestID:[[NSUUID UUID] UUIDString]
+                                            impressionID:[[NSUUID UUID] UUIDString]
+                                             adapterInfo:self.adapterInfo
+                                                    tmax:@3000
+                                             encodedBody:&body];
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+static const NSInteger kCLXIndexSeatCount = 50;
+static const NSInteger kCLXIndexBidsPerSeat = 4;
+static const NSInteger kCLXIndexLookupIterations = 100;
+
+@interface CLXBidResponseIndexTests : XCTestCase
+@property (nonatomic, strong) NSDictionary *responseJSON;
+@end
+
+@implementation CLXBidResponseIndexTests
+
+- (void)setUp {
+    [super setUp];
+
+    // 50 seats x 4 bids; ranks are spread across seats so the waterfall order differs from response order
+    NSMutableArray *seatbids = [NSMutableArray array];
+    for (NSInteger seat = 0; seat < kCLXIndexSeatCount; seat++) {
+        NSMutableArray *bids = [NSMutableArray array];
+        for (NSInteger i = 0; i < kCLXIndexBidsPerSeat; i++) {
+            NSInteger rank = i * kCLXIndexSeatCount + (kCLXIndexSeatCount - seat);
+            [bids addObject:@{
+                @"id": [NSString stringWithFormat:@"bid-%ld-%ld", (long)seat, (long)i],
+                @"impid": [NSString stringWithFormat:@"imp-%ld", (long)i],
+                @"price": @(1000.0 / rank),
+                @"adm": @"<div>ad</div>",
+                @"ext": @{@"prebid": @{@"meta": @{@"adaptercode": [NSString stringWithFormat:@"bidder-%ld", (long)seat]}},
+                          @"cloudx": @{@"rank": @(rank)}}
+            }];
+        }
+        [seatbids addObject:@{@"seat": [NSString stringWithFormat:@"seat-%ld", (long)seat], @"bid": bids}];
+    }
+    self.responseJSON = @{@"id": @"index-auction", @"cur": @"USD", @"seatbid": seatbids};
+}
+
+- (CLXBidResponse *)_parsedResponse {
+    return [CLXBidResponse parseBidResponseFromDictionary:self.responseJSON];
+}
+
+#pragma mark - Lookups
+
+- (void)testAllBidsKeepsResponseOrder {
+    NSArray<CLXBidResponseBid *> *bids = [[self _parsedResponse] allBids];
+    XCTAssertEqual(bids.count, kCLXIndexSeatCount * kCLXIndexBidsPerSeat);
+    XCTAssertEqualObjects(bids.firstObject.id, @"bid-0-0");
+    XCTAssertEqualObjects(bids.lastObject.id, @"bid-49-3");
+}
+
+- (void)testWaterfallIsSortedByRank {
+    NSArray<CLXBidResponseBid *> *bids = [[self _parsedResponse] getAllBidsForWaterfall];
+    XCTAssertEqual(bids.count, kCLXIndexSeatCount * kCLXIndexBidsPerSeat);
+    XCTAssertEqualObjects(bids.firstObject.id, @"bid-49-0");
+    for (NSUInteger i = 1; i < bids.count; i++) {
+        XCTAssertLessThanOrEqual(bids[i - 1].ext.cloudx.rank, bids[i].ext.cloudx.rank);
+    }
+}
+
+- (void)testFindBidWithID {
+    CLXBidResponse *response = [self _parsedResponse];
+    XCTAssertEqualObjects([response findBidWithID:@"bid-17-2"].impid, @"imp-2");
+    XCTAssertNil([response findBidWithID:@"missing"]);
+}
+
+- (void)testBidsForImpID {
+    CLXBidResponse *response = [self _parsedResponse];
+    NSArray<CLXBidResponseBid *> *bids = [response bidsForImpID:@"imp-1"];
+    XCTAssertEqual(bids.count, kCLXIndexSeatCount);
+    XCTAssertEqualObjects(bids.firstObject.id, @"bid-0-1");
+    XCTAssertEqualObjects([response bidsForImpID:@"missing"], @[]);
+}
+
+- (void)testAssigningSeatbidRebuildsTheIndex {
+    CLXBidResponse *response = [self _parsedResponse];
+    XCTAssertNotNil([response findBidWithID:@"bid-0-0"]);
+
+    CLXBidResponseBid *bid = [[CLXBidResponseBid alloc] init];
+    bid.id = @"replacement";
+    CLXBidResponseSeatBid *seatBid = [[CLXBidResponseSeatBid alloc] init];
+    seatBid.bid = @[bid];
+    response.seatbid = @[seatBid];
+
+    XCTAssertNil([response findBidWithID:@"bid-0-0"]);
+    XCTAssertEqual([response findBidWithID:@"replacement"], bid);
+    XCTAssertEqual([response getAllBidsForWaterfall].count, 1);
+}
+
+- (void)testDuplicateIDResolvesToFirstBid {
+    CLXBidResponseBid *first = [[CLXBidResponseBid alloc] init];
+    first.id = @"dup";
+    CLXBidResponseBid *second = [[CLXBidResponseBid alloc] init];
+    second.id = @"dup";
+    CLXBidResponseSeatBid *seatBid = [[CLXBidResponseSeatBid alloc] init];
+    seatBid.bid = @[first, second];
+    CLXBidResponse *response = [[CLXBidResponse alloc] init];
+    response.seatbid = @[seatBid];
+
+    XCTAssertEqual([response findBidWithID:@"dup"], first);
+}
+
+#pragma mark - Performance
+
+- (void)testPerformanceParse {
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < 10; i++) {
+            @autoreleasepool {
+                [self _parsedResponse];
+            }
+        }
+    }];
+}
+
+// Waterfall, LURL and win/loss paths: one waterfall read plus a lookup per bid
+- (void)testPerformanceLookups {
+    CLXBidResponse *response = [self _parsedResponse];
+    NSArray<CLXBidResponseBid *> *bids = [response allBids];
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < kCLXIndexLookupIterations; i++) {
+            @autoreleasepool {
+                [response getAllBidsForWaterfall];
+                for (CLXBidResponseBid *bid in bids) {
+                    [response findBidWithID:bid.id];
+                }
+            }
+        }
+    }];
+}
+
+@end
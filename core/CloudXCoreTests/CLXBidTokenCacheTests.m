@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+// Token source with a configurable delay and lifetime that counts its fetches; a stalled one never answers
+@interface CLXTestBidTokenSource : NSObject <CLXBidTokenSource>
+@property (nonatomic, assign) NSTimeInterval delay;
+@property (atomic, assign) BOOL stalled;
+@property (nonatomic, assign) NSTimeInterval lifetime;
+@property (atomic, assign) NSInteger fetchCount;
+@end
+
+@implementation CLXTestBidTokenSource
+
+- (void)getTokenWithCompletion:(void (^)(NSDictionary<NSString *, NSString *> * _Nullable token, NSError * _Nullable error))completion {
+    self.fetchCount += 1;
+    if (self.stalled) {
+        return;
+    }
+    NSDictionary *token = @{@"bid_token": [NSString stringWithFormat:@"token-%ld", (long)self.fetchCount]};
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        completion(token, nil);
+    });
+}
+
+- (NSTimeInterval)tokenExpirationTime {
+    return self.lifetime;
+}
+
+@end
+
+@interface CLXBidTokenCacheTests : XCTestCase
+@property (nonatomic, strong) CLXBidTokenCache *cache;
+@property (atomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXBidTokenCacheTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 1000;
+    self.cache = [[CLXBidTokenCache alloc] init];
+    __weak typeof(self) weakSelf = self;
+    self.cache.clockForTesting = ^NSTimeInterval{
+        return weakSelf.now;
+    };
+}
+
+- (CLXTestBidTokenSource *)_sourceWithDelay:(NSTimeInterval)delay lifetime:(NSTimeInterval)lifetime {
+    CLXTestBidTokenSource *source = [[CLXTestBidTokenSource alloc] init];
+    source.delay = delay;
+    source.lifetime = lifetime;
+    return source;
+}
+
+- (NSDictionary *)_tokensForSources:(NSDictionary<NSString *, id<CLXBidTokenSource>> *)sources {
+    __block NSDictionary *result = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"tokens"];
+    [self.cache tokensForSources:sources completion:^(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens) {
+        result = tokens;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    return result;
+}
+
+#pragma mark - Tests
+
+- (void)testPrefetchedTokenServesAuctionsFromCache {
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0 lifetime:1800];
+    [self.cache prefetchTokenForAdapter:@"vungle" source:source];
+
+    NSDictionary *first = [self _tokensForSources:@{@"vungle": source}];
+    NSDictionary *second = [self _tokensForSources:@{@"vungle": source}];
+
+    XCTAssertEqualObjects(first[@"vungle"][@"bid_token"], @"token-1");
+    XCTAssertEqualObjects(second[@"vungle"][@"bid_token"], @"token-1");
+    XCTAssertEqual(source.fetchCount, 1);
+    XCTAssertGreaterThanOrEqual(self.cache.hitCount, (NSUInteger)1);
+}
+
+- (void)testTokenIsRefreshedInBackgroundBeforeExpiry {
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0 lifetime:100];
+    [self _tokensForSources:@{@"vungle": source}];
+
+    // Past the refresh point but not expired: the cached token is served and a refresh starts
+    self.now += 85;
+    NSDictionary *tokens = [self _tokensForSources:@{@"vungle": source}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-1");
+
+    NSPredicate *refreshed = [NSPredicate predicateWithBlock:^BOOL(CLXTestBidTokenSource *evaluated, NSDictionary *bindings) {
+        return evaluated.fetchCount == 2;
+    }];
+    [self waitForExpectations:@[[self expectationForPredicate:refreshed evaluatedWithObject:source handler:nil]] timeout:5.0];
+
+    // Let the refreshed token land on the cache queue, then read it back
+    [NSThread sleepForTimeInterval:0.2];
+    tokens = [self _tokensForSources:@{@"vungle": source}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-2");
+}
+
+- (void)testExpiredTokenIsNotServed {
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0 lifetime:100];
+    [self _tokensForSources:@{@"vungle": source}];
+
+    self.now += 101;
+    NSDictionary *tokens = [self _tokensForSources:@{@"vungle": source}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-2");
+    XCTAssertEqual(self.cache.missCount, (NSUInteger)2);
+}
+
+- (void)testSlowSourceIsDroppedAtDeadline {
+    self.cache.fetchDeadline = 0.1;
+    CLXTestBidTokenSource *fast = [self _sourceWithDelay:0 lifetime:1800];
+    CLXTestBidTokenSource *slow = [self _sourceWithDelay:1.0 lifetime:1800];
+
+    NSDate *start = [NSDate date];
+    NSDictionary *tokens = [self _tokensForSources:@{@"meta": fast, @"vungle": slow}];
+    NSTimeInterval elapsed = [[NSDate date] timeIntervalSinceDate:start];
+
+    XCTAssertNotNil(tokens[@"meta"]);
+    XCTAssertNil(tokens[@"vungle"]);
+    XCTAssertLessThan(elapsed, 0.8, @"The auction must not wait for the slow adapter");
+    XCTAssertEqual(self.cache.deadlineMissCount, (NSUInteger)1);
+
+    // The late token still lands in the cache for the next auction
+    [NSThread sleepForTimeInterval:1.2];
+    tokens = [self _tokensForSources:@{@"vungle": slow}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-1");
+    XCTAssertEqual(slow.fetchCount, 1);
+}
+
+- (void)testInputChangeDropsCachedTokens {
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0 lifetime:1800];
+    [self _tokensForSources:@{@"vungle": source}];
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:nil];
+    NSDictionary *tokens = [self _tokensForSources:@{@"vungle": source}];
+
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-2");
+}
+
+- (void)testInputChangeDuringFetchRefetches {
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0.3 lifetime:1800];
+    [self.cache prefetchTokenForAdapter:@"vungle" source:source];
+    NSPredicate *started = [NSPredicate predicateWithBlock:^BOOL(CLXTestBidTokenSource *evaluated, NSDictionary *bindings) {
+        return evaluated.fetchCount == 1;
+    }];
+    [self waitForExpectations:@[[self expectationForPredicate:started evaluatedWithObject:source handler:nil]] timeout:5.0];
+
+    // The prefetch was asked with the old inputs; its answer is discarded and the token fetched again
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:nil];
+    [NSThread sleepForTimeInterval:0.8];
+
+    NSDictionary *tokens = [self _tokensForSources:@{@"vungle": source}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-2");
+    XCTAssertEqual(source.fetchCount, 2);
+}
+
+- (void)testStalledFetchIsAbandonedAfterFetchTimeout {
+    self.cache.fetchTimeout = 0.2;
+    self.cache.fetchDeadline = 3.0;
+    CLXTestBidTokenSource *source = [self _sourceWithDelay:0 lifetime:1800];
+    source.stalled = YES;
+
+    NSDate *start = [NSDate date];
+    NSDictionary *tokens = [self _tokensForSources:@{@"vungle": source}];
+
+    XCTAssertNil(tokens[@"vungle"]);
+    XCTAssertLessThan([[NSDate date] timeIntervalSinceDate:start], 2.0, @"Waiters are released by the fetch timeout, not the deadline");
+    XCTAssertEqual(self.cache.deadlineMissCount, (NSUInteger)0);
+
+    // The entry is no longer stuck fetching, so the next auction asks the adapter again
+    source.stalled = NO;
+    tokens = [self _tokensForSources:@{@"vungle": source}];
+    XCTAssertEqualObjects(tokens[@"vungle"][@"bid_token"], @"token-2");
+}
+
+@end
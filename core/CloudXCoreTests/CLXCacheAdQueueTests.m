@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCacheAdQueueTests.m
+ * @brief Tests for price ordering and expiry of cached ads
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+// Cacheable ad with a configurable network lifetime. Loads finish at once unless holdLoad is set,
+// in which case the completion waits in pendingLoad.
+@interface CLXCacheAdQueueMockAd : NSObject <CLXCacheableAd>
+@property (nonatomic, copy) NSString *impressionID;
+@property (nonatomic, strong, nullable) CLXBidResponse *bidResponse;
+@property (nonatomic, assign) NSTimeInterval expirationInterval;
+@property (nonatomic, assign, getter=isExpired) BOOL expired;
+@property (atomic, assign) BOOL destroyed;
+@property (nonatomic, assign) BOOL holdLoad;
+@property (atomic, copy, nullable) void (^pendingLoad)(NSError * _Nullable error);
+@end
+
+@implementation CLXCacheAdQueueMockAd
+
+- (NSString *)network {
+    return @"test";
+}
+
+- (void)loadWithTimeout:(NSTimeInterval)timeout completion:(void (^)(NSError * _Nullable error))completion {
+    if (self.holdLoad) {
+        self.pendingLoad = completion;
+        return;
+    }
+    completion(nil);
+}
+
+- (void)showFromViewController:(UIViewController *)viewController {
+}
+
+- (void)destroy {
+    self.destroyed = YES;
+}
+
+@end
+
+// Records loss reports instead of sending them
+@interface CLXCacheAdQueueMockTracker : CLXWinLossTracker
+@property (nonatomic, strong) NSMutableArray<NSString *> *lostBidIds;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *lossReasons;
+@end
+
+@implementation CLXCacheAdQueueMockTracker
+
+- (void)setBidLoadResult:(NSString *)auctionId bidId:(NSString *)bidId success:(BOOL)success lossReason:(NSNumber *)lossReason {
+    if (!self.lossReasons) {
+        self.lossReasons = [NSMutableArray array];
+    }
+    [self.lossReasons addObject:lossReason];
+}
+
+- (void)sendLoss:(NSString *)auctionId bidId:(NSString *)bidId {
+    if (!self.lostBidIds) {
+        self.lostBidIds = [NSMutableArray array];
+    }
+    [self.lostBidIds addObject:bidId];
+}
+
+@end
+
+@interface CLXCacheAdQueue (Testing)
+@property (nonatomic, strong) CLXWinLossTracker *winLossTracker;
+@property (nonatomic, strong) CLXTrackingFieldResolver *trackingFieldResolver;
+@end
+
+@interface CLXCacheAdQueueTests : XCTestCase
+@property (nonatomic, strong) CLXCacheAdQueue *queue;
+@property (nonatomic, strong) CLXCacheAdQueueMockTracker *tracker;
+@property (nonatomic, strong) CLXTrackingFieldResolver *resolver;
+@property (atomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXCacheAdQueueTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 1000;
+    id<AdEventReporting> reportingService = nil;
+    self.queue = [[CLXCacheAdQueue alloc] initWithMaxCapacity:10 reportingService:reportingService placementID:@"placement"];
+    self.tracker = [[CLXCacheAdQueueMockTracker alloc] init];
+    self.queue.winLossTracker = self.tracker;
+    self.resolver = [[CLXTrackingFieldResolver alloc] init];
+    self.queue.trackingFieldResolver = self.resolver;
+    __weak typeof(self) weakSelf = self;
+    self.queue.clockForTesting = ^NSTimeInterval{
+        return weakSelf.now;
+    };
+}
+
+- (void)tearDown {
+    [self.queue destroy];
+    self.queue = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (CLXCacheAdQueueMockAd *)_adWithBidID:(NSString *)bidID price:(double)price exp:(NSInteger)exp {
+    CLXCacheAdQueueMockAd *ad = [[CLXCacheAdQueueMockAd alloc] init];
+    ad.impressionID = bidID;
+    ad.bidResponse = [CLXBidResponse parseBidResponseFromDictionary:@{
+        @"id": @"auction-1",
+        @"seatbid": @[@{@"bid": @[@{@"id": bidID, @"price": @(price), @"exp": @(exp)}]}]
+    }];
+    return ad;
+}
+
+// Enqueues an ad and waits until it is in the queue
+- (void)_enqueueAd:(CLXCacheAdQueueMockAd *)ad price:(double)price {
+    XCTestExpectation *loaded = [self expectationWithDescription:ad.impressionID];
+    [self.queue enqueueAdWithPrice:price loadTimeout:1.0 bidID:ad.impressionID ad:ad completion:^(NSError * _Nullable error) {
+        XCTAssertNil(error);
+        [loaded fulfill];
+    }];
+    [self waitForExpectations:@[loaded] timeout:2.0];
+}
+
+- (CLXCacheAdQueueMockAd *)_enqueuePrice:(double)price bidID:(NSString *)bidID exp:(NSInteger)exp {
+    CLXCacheAdQueueMockAd *ad = [self _adWithBidID:bidID price:price exp:exp];
+    [self _enqueueAd:ad price:price];
+    return ad;
+}
+
+- (void)_runMainLoopUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition() && [deadline timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.02]];
+    }
+}
+
+#pragma mark - Ordering
+
+- (void)testPopsInPriceOrderWithLoadOrderForTies {
+    [self _enqueuePrice:1.0 bidID:@"low" exp:0];
+    [self _enqueuePrice:3.0 bidID:@"high" exp:0];
+    [self _enqueuePrice:2.0 bidID:@"mid-1" exp:0];
+    [self _enqueuePrice:2.0 bidID:@"mid-2" exp:0];
+    [self _enqueuePrice:0.5 bidID:@"lowest" exp:0];
+
+    NSMutableArray<NSString *> *order = [NSMutableArray array];
+    id<CLXCacheableAd> ad;
+    while ((ad = [self.queue popAd])) {
+        [order addObject:ad.impressionID];
+    }
+    XCTAssertEqualObjects(order, (@[@"high", @"mid-1", @"mid-2", @"low", @"lowest"]));
+    XCTAssertTrue(self.queue.isEmpty);
+}
+
+- (void)testRemoveKeepsHeapOrdered {
+    [self _enqueuePrice:5.0 bidID:@"a" exp:0];
+    CLXCacheAdQueueMockAd *removed = [self _enqueuePrice:4.0 bidID:@"b" exp:0];
+    [self _enqueuePrice:3.0 bidID:@"c" exp:0];
+    [self _enqueuePrice:2.0 bidID:@"d" exp:0];
+
+    [self.queue removeAd:removed];
+
+    XCTAssertTrue(removed.destroyed);
+    XCTAssertEqualObjects([self.queue popAd].impressionID, @"a");
+    XCTAssertEqualObjects([self.queue popAd].impressionID, @"c");
+    XCTAssertEqualObjects([self.queue popAd].impressionID, @"d");
+    XCTAssertNil([self.queue popAd]);
+}
+
+#pragma mark - Auction Tracking Data
+
+- (void)testQueuedAdsHoldTheirAuctionUntilTheyLeave {
+    CLXTrackingAuctionStore *store = self.resolver.auctionStore;
+    CLXCacheAdQueueMockAd *shown = [self _enqueuePrice:3.0 bidID:@"shown" exp:0];
+    CLXCacheAdQueueMockAd *removed = [self _enqueuePrice:2.0 bidID:@"removed" exp:0];
+    [self _enqueuePrice:1.0 bidID:@"stale" exp:30];
+    XCTAssertTrue([store isAuctionPinned:@"auction-1"]);
+
+    XCTAssertEqual([self.queue popAd], shown);
+    [self.queue removeAd:removed];
+    XCTAssertTrue([store isAuctionPinned:@"auction-1"]);
+
+    self.now += 31;
+    [self.queue sweepExpiredAds];
+    XCTAssertFalse([store isAuctionPinned:@"auction-1"]);
+}
+
+- (void)testDestroyReleasesQueuedAuctions {
+    [self _enqueuePrice:1.0 bidID:@"a" exp:0];
+    [self _enqueuePrice:2.0 bidID:@"b" exp:0];
+
+    [self.queue destroy];
+
+    XCTAssertFalse([self.resolver.auctionStore isAuctionPinned:@"auction-1"]);
+}
+
+#pragma mark - Expiry
+
+- (void)testExpiredAdIsSkippedAndReported {
+    CLXCacheAdQueueMockAd *stale = [self _enqueuePrice:5.0 bidID:@"stale" exp:30];
+    [self _enqueuePrice:1.0 bidID:@"fresh" exp:0];
+
+    self.now += 31;
+
+    XCTAssertEqualObjects(self.queue.first.impressionID, @"fresh");
+    XCTAssertEqualObjects([self.queue popAd].impressionID, @"fresh");
+    XCTAssertTrue(stale.destroyed);
+    XCTAssertEqualObjects(self.tracker.lostBidIds, @[@"stale"]);
+    XCTAssertEqualObjects(self.tracker.lossReasons, @[@(CLXLossReasonExpired)]);
+}
+
+- (void)testShortestLifetimeWins {
+    self.queue.defaultTimeToLive = 600;
+    CLXCacheAdQueueMockAd *networkLimited = [[CLXCacheAdQueueMockAd alloc] init];
+    networkLimited.impressionID = @"network";
+    networkLimited.expirationInterval = 20;
+    [self _enqueueAd:networkLimited price:2.0];
+    CLXCacheAdQueueMockAd *defaultLimited = [self _enqueuePrice:1.0 bidID:@"default" exp:0];
+
+    self.now += 21;
+    [self.queue sweepExpiredAds];
+    XCTAssertTrue(networkLimited.destroyed);
+    XCTAssertFalse(defaultLimited.destroyed);
+    XCTAssertTrue(self.queue.hasItems);
+
+    self.now += 600;
+    XCTAssertFalse(self.queue.hasItems, @"Default lifetime applies when bid and network give none");
+    XCTAssertTrue(defaultLimited.destroyed);
+}
+
+- (void)testNetworkReportedExpiryIsHonoured {
+    CLXCacheAdQueueMockAd *ad = [self _enqueuePrice:2.0 bidID:@"expired" exp:0];
+    ad.expired = YES;
+
+    XCTAssertNil([self.queue popAd]);
+    XCTAssertTrue(ad.destroyed);
+    XCTAssertEqualObjects(self.tracker.lostBidIds, @[@"expired"]);
+}
+
+- (void)testSweeperRunsOnItsOwn {
+    self.queue.clockForTesting = nil;
+    CLXCacheAdQueueMockAd *ad = [self _adWithBidID:@"short" price:1.0 exp:0];
+    ad.expirationInterval = 0.2;
+    [self _enqueueAd:ad price:1.0];
+
+    [self _runMainLoopUntil:^BOOL{
+        return ad.destroyed;
+    } timeout:3.0];
+    XCTAssertTrue(ad.destroyed);
+    XCTAssertEqualObjects(self.tracker.lostBidIds, @[@"short"]);
+}
+
+#pragma mark - Concurrency
+
+- (void)testAtMostTwoAdsLoadAtOnce {
+    self.queue.maxCapacity = 5;
+    NSMutableArray<CLXCacheAdQueueMockAd *> *ads = [NSMutableArray array];
+    __block NSInteger completed = 0;
+    for (NSInteger i = 0; i < 5; i++) {
+        CLXCacheAdQueueMockAd *ad = [self _adWithBidID:[NSString stringWithFormat:@"bid-%ld", (long)i] price:i exp:0];
+        ad.holdLoad = YES;
+        [ads addObject:ad];
+        [self.queue enqueueAdWithPrice:i loadTimeout:1.0 bidID:ad.impressionID ad:ad completion:^(NSError * _Nullable error) {
+            completed += 1;
+        }];
+    }
+    NSInteger (^loading)(void) = ^NSInteger{
+        NSInteger count = 0;
+        for (CLXCacheAdQueueMockAd *ad in ads) {
+            count += ad.pendingLoad ? 1 : 0;
+        }
+        return count;
+    };
+
+    [self _runMainLoopUntil:^BOOL{ return loading() == 2; } timeout:2.0];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    XCTAssertEqual(loading(), 2);
+    XCTAssertFalse(self.queue.isEnoughSpace, @"Loads in progress take up capacity");
+    XCTAssertFalse(self.queue.hasItems, @"but are not items yet");
+
+    // Finishing a load frees its slot for the next ad
+    for (CLXCacheAdQueueMockAd *ad in ads) {
+        if (ad.pendingLoad) {
+            void (^finish)(NSError * _Nullable) = ad.pendingLoad;
+            ad.pendingLoad = nil;
+            ad.holdLoad = NO;
+            finish(nil);
+            break;
+        }
+    }
+    [self _runMainLoopUntil:^BOOL{ return loading() == 2 && completed == 1; } timeout:2.0];
+    XCTAssertEqual(completed, 1);
+    XCTAssertEqual(loading(), 2);
+    XCTAssertTrue(self.queue.hasItems);
+}
+
+- (void)testDestroyAbandonsLoadsWaitingForASlot {
+    NSMutableArray<CLXCacheAdQueueMockAd *> *ads = [NSMutableArray array];
+    NSMutableArray<NSError *> *errors = [NSMutableArray array];
+    __block NSInteger completed = 0;
+    for (NSInteger i = 0; i < 4; i++) {
+        CLXCacheAdQueueMockAd *ad = [self _adWithBidID:[NSString stringWithFormat:@"bid-%ld", (long)i] price:i exp:0];
+        ad.holdLoad = YES;
+        [ads addObject:ad];
+        [self.queue enqueueAdWithPrice:i loadTimeout:1.0 bidID:ad.impressionID ad:ad completion:^(NSError * _Nullable error) {
+            completed += 1;
+            if (error) {
+                [errors addObject:error];
+            }
+        }];
+    }
+    NSPredicate *isLoading = [NSPredicate predicateWithBlock:^BOOL(CLXCacheAdQueueMockAd *ad, NSDictionary *bindings) {
+        return ad.pendingLoad != nil;
+    }];
+    [self _runMainLoopUntil:^BOOL{ return [ads filteredArrayUsingPredicate:isLoading].count == 2; } timeout:2.0];
+    NSArray<CLXCacheAdQueueMockAd *> *running = [ads filteredArrayUsingPredicate:isLoading];
+    NSMutableArray<CLXCacheAdQueueMockAd *> *waiting = [ads mutableCopy];
+    [waiting removeObjectsInArray:running];
+    XCTAssertEqual(running.count, 2);
+    XCTAssertEqual(self.queue.loadingCount, 4);
+
+    [self.queue destroy];
+    [self _runMainLoopUntil:^BOOL{ return completed == 2; } timeout:2.0];
+
+    // The two loads behind the held ones never start
+    XCTAssertEqual(completed, 2);
+    XCTAssertEqual(errors.count, 2);
+    XCTAssertEqual(errors.firstObject.code, CacheAdQueueErrorFailToLoad);
+    for (CLXCacheAdQueueMockAd *ad in waiting) {
+        XCTAssertNil(ad.pendingLoad);
+        XCTAssertTrue(ad.destroyed);
+    }
+    XCTAssertEqual(self.queue.loadingCount, 2);
+
+    // Loads already running destroy their ad when they finish
+    for (CLXCacheAdQueueMockAd *ad in running) {
+        XCTAssertFalse(ad.destroyed);
+        void (^finish)(NSError * _Nullable) = ad.pendingLoad;
+        ad.pendingLoad = nil;
+        finish(nil);
+        XCTAssertTrue(ad.destroyed);
+    }
+    XCTAssertEqual(completed, 4);
+    XCTAssertEqual(self.queue.loadingCount, 0);
+}
+
+// Enqueue, pop and remove from many threads at once, while the main queue finishes loads into
+// the heap. Every ad must end up either popped or destroyed, never both, and the queue must still
+// hand out ads in price order afterwards.
+- (void)testInterleavedEnqueuePopAndRemoveFromManyThreads {
+    static const NSInteger kOperations = 600;
+    NSMutableArray<CLXCacheAdQueueMockAd *> *ads = [NSMutableArray arrayWithCapacity:kOperations];
+    for (NSInteger i = 0; i < kOperations; i++) {
+        [ads addObject:[self _adWithBidID:[NSString stringWithFormat:@"bid-%ld", (long)i] price:(i * 7919) % 97 exp:0]];
+    }
+    self.queue.maxCapacity = kOperations;
+
+    NSMutableSet<NSString *> *popped = [NSMutableSet set];
+    __block NSInteger duplicatePops = 0;
+    dispatch_group_t loads = dispatch_group_create();
+    dispatch_group_t workers = dispatch_group_create();
+
+    // Off the main thread, so loads land in the heap while the workers run
+    dispatch_group_async(workers, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        dispatch_apply(kOperations, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+            CLXCacheAdQueueMockAd *ad = ads[i];
+            dispatch_group_enter(loads);
+            [self.queue enqueueAdWithPrice:(i * 7919) % 97 loadTimeout:1.0 bidID:ad.impressionID ad:ad completion:^(NSError * _Nullable error) {
+                dispatch_group_leave(loads);
+            }];
+            // Give the main queue time to finish loads between operations
+            usleep(200);
+            if (i % 3 == 1) {
+                id<CLXCacheableAd> out = [self.queue popAd];
+                if (out) {
+                    @synchronized (popped) {
+                        if ([popped containsObject:out.impressionID]) {
+                            duplicatePops += 1;
+                        }
+                        [popped addObject:out.impressionID];
+                    }
+                }
+            } else if (i % 3 == 2) {
+                [self.queue removeAd:ads[i / 2]];
+            }
+            (void)self.queue.hasItems;
+            (void)self.queue.isEnoughSpace;
+        });
+    });
+
+    [self _runMainLoopUntil:^BOOL{
+        return dispatch_group_wait(workers, DISPATCH_TIME_NOW) == 0 && dispatch_group_wait(loads, DISPATCH_TIME_NOW) == 0;
+    } timeout:20.0];
+    XCTAssertEqual(dispatch_group_wait(workers, DISPATCH_TIME_NOW), 0, @"Every worker finishes");
+    XCTAssertEqual(dispatch_group_wait(loads, DISPATCH_TIME_NOW), 0, @"Every load completes");
+    // Let destroys handed to the main queue by background removes run
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    // Pops and removes ran against a populated heap
+    XCTAssertGreaterThan(popped.count, 0);
+    NSUInteger removed = [ads indexesOfObjectsPassingTest:^BOOL(CLXCacheAdQueueMockAd *ad, NSUInteger idx, BOOL *stop) {
+        return ad.destroyed;
+    }].count;
+    XCTAssertGreaterThan(removed, 0);
+
+    double lastPrice = DBL_MAX;
+    id<CLXCacheableAd> out;
+    while ((out = [self.queue popAd])) {
+        double price = [out.bidResponse findBidWithID:out.impressionID].price;
+        XCTAssertLessThanOrEqual(price, lastPrice);
+        lastPrice = price;
+        XCTAssertFalse([popped containsObject:out.impressionID]);
+        [popped addObject:out.impressionID];
+    }
+
+    XCTAssertEqual(duplicatePops, 0);
+    for (CLXCacheAdQueueMockAd *ad in ads) {
+        BOOL wasPopped = [popped containsObject:ad.impressionID];
+        XCTAssertTrue(wasPopped != ad.destroyed, @"%@ popped: %d destroyed: %d", ad.impressionID, wasPopped, ad.destroyed);
+    }
+}
+
+@end
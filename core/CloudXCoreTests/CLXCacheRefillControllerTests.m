@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCacheRefillControllerTests.m
+ * @brief Tests for sizing and timing fullscreen cache refills
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import <CloudXCore/CLXMetricsType.h>
+
+// Records the performance metrics it is given
+@interface CLXCacheRefillMockTracker : NSObject <CLXMetricsTrackerProtocol>
+@property (nonatomic, strong) NSMutableArray<NSString *> *performanceMetrics;
+@end
+
+@implementation CLXCacheRefillMockTracker
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _performanceMetrics = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)startWithConfig:(CLXSDKConfig *)config {}
+- (void)setBasicDataWithSessionId:(NSString *)sessionId accountId:(NSString *)accountId basePayload:(NSString *)basePayload {}
+- (void)trackMethodCall:(NSString *)methodType {}
+- (void)trySendingPendingMetrics {}
+- (void)stop {}
+- (void)debugPrintStatus {}
+- (NSArray<NSString *> *)validateSystem { return @[]; }
+- (void)flushPendingOperations {}
+
+- (void)trackNetworkCall:(NSString *)networkType latency:(NSInteger)latencyMs {}
+
+- (void)trackPerformanceMetric:(NSString *)metricType value:(NSInteger)valueMs {
+    [self.performanceMetrics addObject:metricType];
+}
+
+- (NSInteger)countOf:(NSString *)networkType {
+    return [self.performanceMetrics indexesOfObjectsPassingTest:^BOOL(NSString *call, NSUInteger idx, BOOL *stop) {
+        return [call isEqualToString:networkType];
+    }].count;
+}
+
+@end
+
+@interface CLXCacheRefillControllerTests : XCTestCase
+@property (nonatomic, strong) CLXCacheRefillController *controller;
+@property (nonatomic, strong) CLXCacheRefillMockTracker *tracker;
+@property (nonatomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXCacheRefillControllerTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 1000;
+    self.tracker = [[CLXCacheRefillMockTracker alloc] init];
+    self.controller = [[CLXCacheRefillController alloc] initWithPlacementID:@"placement-1" readinessTarget:0.9 maxDepth:3];
+    self.controller.metricsTracker = self.tracker;
+    __weak typeof(self) weakSelf = self;
+    self.controller.clockForTesting = ^NSTimeInterval{
+        return weakSelf.now;
+    };
+}
+
+- (void)tearDown {
+    self.controller = nil;
+    self.tracker = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// A show every interval seconds, each followed by a refill that fills after refillDuration
+- (void)_showEvery:(NSTimeInterval)interval refillDuration:(NSTimeInterval)refillDuration count:(NSInteger)count {
+    for (NSInteger i = 0; i < count; i++) {
+        self.now += interval;
+        [self.controller noteShowWithAdReady:YES];
+        [self.controller noteRefillFinishedAfter:refillDuration filled:YES];
+    }
+}
+
+#pragma mark - Depth
+
+- (void)testRareShowsKeepOneAd {
+    CLXCacheRefillDecision *empty = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(empty.targetDepth, 1);
+    XCTAssertEqual(empty.auctionsToStart, 1);
+    XCTAssertEqual(empty.deferral, 0);
+    XCTAssertEqual(empty.readiness, 0);
+
+    CLXCacheRefillDecision *full = [self.controller decisionWithCachedCount:1 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(full.auctionsToStart, 0);
+    XCTAssertGreaterThan(full.readiness, 0.9);
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheRefillStart], 1);
+}
+
+- (void)testFrequentShowsDeepenCacheAndRunTwoAuctions {
+    // Shows every 2s against 4s refills: about two shows land within one refill
+    [self _showEvery:2.0 refillDuration:4.0 count:20];
+
+    CLXCacheRefillDecision *decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqualWithAccuracy(decision.showRate, 0.5, 0.05);
+    XCTAssertEqual(decision.targetDepth, 3, @"Capped at the cache capacity");
+    XCTAssertEqual(decision.auctionsToStart, 2);
+
+    decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:2];
+    XCTAssertEqual(decision.auctionsToStart, 0, @"No more than two auctions at once");
+
+    decision = [self.controller decisionWithCachedCount:1 loadingCount:1 auctionsInFlight:0];
+    XCTAssertEqual(decision.auctionsToStart, 1);
+}
+
+- (void)testShortLivedAdsCapDepth {
+    [self _showEvery:2.0 refillDuration:4.0 count:20];
+    [self.controller noteAdCachedFromNetwork:@"network-a" lifetime:3.0];
+
+    CLXCacheRefillDecision *decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(decision.targetDepth, 1, @"A second ad would expire before a show reaches it");
+}
+
+- (void)testIdleSessionDecaysShowRate {
+    [self _showEvery:2.0 refillDuration:4.0 count:20];
+    self.now += 600;
+
+    XCTAssertEqualWithAccuracy([self.controller showRate], 1.0 / 600, 1e-9);
+    CLXCacheRefillDecision *decision = [self.controller decisionWithCachedCount:1 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(decision.targetDepth, 1);
+    XCTAssertEqual(decision.auctionsToStart, 0);
+}
+
+#pragma mark - Timing
+
+- (void)testExpiredAdReplacementIsDeferred {
+    [self.controller noteShowWithAdReady:YES];
+    [self.controller noteAdCachedFromNetwork:@"network-a" lifetime:1800];
+    self.now += 1800;
+    [self.controller noteAdExpiredFromNetwork:@"network-a" cachedFor:1800];
+
+    // One show per 1800s: starting d late keeps readiness exp(-(d + 3.75) / 1800) at 0.9
+    NSTimeInterval expected = -log(0.9) * 1800 - 3.0 / 0.8;
+    CLXCacheRefillDecision *decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(decision.auctionsToStart, 0);
+    XCTAssertEqualWithAccuracy(decision.deferral, expected, 0.5);
+
+    self.now += 100;
+    decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqualWithAccuracy(decision.deferral, expected - 100, 0.5, @"The deferral is not restarted");
+
+    self.now += expected;
+    decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(decision.deferral, 0);
+    XCTAssertEqual(decision.auctionsToStart, 1);
+
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheAdExpired], 1);
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheRefillDefer], 1, @"One deferral, however often it is asked about");
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheRefillStart], 1);
+}
+
+- (void)testShowEndsDeferral {
+    [self.controller noteShowWithAdReady:YES];
+    self.now += 1800;
+    [self.controller noteAdExpiredFromNetwork:@"network-a" cachedFor:1800];
+    XCTAssertGreaterThan([self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0].deferral, 0);
+
+    self.now += 10;
+    [self.controller noteShowWithAdReady:NO];
+    CLXCacheRefillDecision *decision = [self.controller decisionWithCachedCount:0 loadingCount:0 auctionsInFlight:0];
+    XCTAssertEqual(decision.deferral, 0);
+    XCTAssertEqual(decision.auctionsToStart, 1);
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheShowReady], 1);
+    XCTAssertEqual([self.tracker countOf:CLXMetricsTypeCacheShowMiss], 1);
+}
+
+#pragma mark - Lifetime
+
+- (void)testNetworkLifetimeFollowsObservedExpiries {
+    XCTAssertEqual([self.controller expectedLifetimeForNetwork:@"network-a"], CLXCacheAdQueueDefaultTimeToLive);
+
+    [self.controller noteAdCachedFromNetwork:@"network-a" lifetime:3600];
+    XCTAssertEqualWithAccuracy([self.controller expectedLifetimeForNetwork:@"network-a"], 3600, 1e-6);
+
+    [self.controller noteAdExpiredFromNetwork:@"network-a" cachedFor:600];
+    XCTAssertEqualWithAccuracy([self.controller expectedLifetimeForNetwork:@"network-a"], 2700, 1e-6);
+
+    [self.controller noteAdExpiredFromNetwork:@"network-a" cachedFor:5000];
+    XCTAssertEqualWithAccuracy([self.controller expectedLifetimeForNetwork:@"network-a"], 2700, 1e-6,
+                               @"An ad outliving the estimate does not raise it");
+    XCTAssertEqual([self.controller expectedLifetimeForNetwork:@"network-b"], CLXCacheAdQueueDefaultTimeToLive);
+}
+
+@end
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCounterRegistryTests.m
+ * @brief Tests for the in-memory counter registry and its lazy NSUserDefaults persistence
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import <CloudXCore/CLXCounterRegistry.h>
+
+static NSString *const kCLXCounterRegistryTestsSuite = @"com.cloudx.tests.counterregistry";
+static NSString *const kCLXCounterRegistryTestsKey = @"CLXTests_metricsDict";
+
+@interface CLXCounterRegistryTests : XCTestCase
+@property (nonatomic, strong) NSUserDefaults *defaults;
+@end
+
+@implementation CLXCounterRegistryTests
+
+- (void)setUp {
+    [super setUp];
+    [[NSUserDefaults standardUserDefaults] removePersistentDomainForName:kCLXCounterRegistryTestsSuite];
+    self.defaults = [[NSUserDefaults alloc] initWithSuiteName:kCLXCounterRegistryTestsSuite];
+}
+
+- (void)tearDown {
+    [[NSUserDefaults standardUserDefaults] removePersistentDomainForName:kCLXCounterRegistryTestsSuite];
+    self.defaults = nil;
+    [super tearDown];
+}
+
+- (CLXCounterRegistry *)makeRegistry {
+    CLXCounterRegistry *registry = [[CLXCounterRegistry alloc] initWithDefaultsKey:kCLXCounterRegistryTestsKey userDefaults:self.defaults];
+    registry.persistDelay = 0;
+    return registry;
+}
+
+#pragma mark - Counting
+
+- (void)testIncrementReturnsRunningValue {
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    XCTAssertEqual([registry valueForCounter:@"network_call_bid_req"], 0);
+    XCTAssertEqual([registry incrementCounter:@"network_call_bid_req"], 1);
+    XCTAssertEqual([registry incrementCounter:@"network_call_bid_req"], 2);
+    XCTAssertEqual([registry incrementCounter:@"method_sdk_init"], 1);
+    XCTAssertEqual([registry valueForCounter:@"network_call_bid_req"], 2);
+}
+
+- (void)testConcurrentIncrementsAreNotLost {
+    CLXCounterRegistry *registry = [self makeRegistry];
+    NSArray<NSString *> *names = @[@"network_call_bid_req", @"method_sdk_init", @"method_banner_refresh", @"network_call_geo_req"];
+    const size_t iterations = 40000;
+
+    dispatch_apply(iterations, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        [registry incrementCounter:names[i % names.count]];
+    });
+    [registry flush];
+
+    NSDictionary *stored = [self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey];
+    for (NSString *name in names) {
+        XCTAssertEqual([registry valueForCounter:name], (int64_t)(iterations / names.count));
+        XCTAssertEqualObjects(stored[name], ([NSString stringWithFormat:@"%zu", iterations / names.count]));
+    }
+}
+
+- (void)testConcurrentIncrementsWhilePersisting {
+    CLXCounterRegistry *registry = [self makeRegistry];
+    registry.persistDelay = 0.001;
+    const size_t iterations = 10000;
+
+    dispatch_apply(iterations, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        [registry incrementCounter:@"network_call_bid_req"];
+        if (i % 1000 == 0) {
+            [registry flush];
+        }
+    });
+    [registry flush];
+
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey][@"network_call_bid_req"],
+                          ([NSString stringWithFormat:@"%zu", iterations]));
+}
+
+#pragma mark - Persistence
+
+- (void)testIncrementDoesNotWriteUntilFlush {
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    [registry incrementCounter:@"method_sdk_init"];
+    XCTAssertNil([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey]);
+
+    [registry flush];
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey], @{@"method_sdk_init": @"1"});
+}
+
+- (void)testChangesPersistAfterDelay {
+    CLXCounterRegistry *registry = [self makeRegistry];
+    registry.persistDelay = 0.05;
+
+    [registry incrementCounter:@"method_sdk_init"];
+    [registry incrementCounter:@"method_sdk_init"];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Persisted"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey][@"method_sdk_init"], @"2");
+}
+
+- (void)testBackgroundingFlushes {
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    [registry incrementCounter:@"method_banner_refresh"];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey][@"method_banner_refresh"], @"1");
+}
+
+- (void)testFlushKeepsEntriesThatAreNotCounters {
+    [self.defaults setObject:@{@"external": @"bidding_data"} forKey:kCLXCounterRegistryTestsKey];
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    [registry incrementCounter:@"network_call_bid_req"];
+    [registry flush];
+
+    NSDictionary *expected = @{@"external": @"bidding_data", @"network_call_bid_req": @"1"};
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey], expected);
+    XCTAssertEqualObjects([registry snapshot], expected);
+}
+
+- (void)testCountersContinueFromStoredDictionary {
+    [self.defaults setObject:@{@"method_sdk_init": @"41", @"network_call_geo_req": @7, @"external": @"data"}
+                      forKey:kCLXCounterRegistryTestsKey];
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    XCTAssertEqual([registry valueForCounter:@"method_sdk_init"], 41);
+    XCTAssertEqual([registry valueForCounter:@"network_call_geo_req"], 7);
+    XCTAssertEqual([registry valueForCounter:@"external"], 0);
+
+    XCTAssertEqual([registry incrementCounter:@"method_sdk_init"], 42);
+    [registry flush];
+
+    NSDictionary *stored = [self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey];
+    XCTAssertEqualObjects(stored[@"method_sdk_init"], @"42");
+    XCTAssertEqualObjects(stored[@"network_call_geo_req"], @"7");
+    XCTAssertEqualObjects(stored[@"external"], @"data");
+}
+
+- (void)testSnapshotIncludesUnpersistedCounters {
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    [registry incrementCounter:@"method_set_hashed_user_id"];
+
+    XCTAssertEqualObjects([registry snapshot], @{@"method_set_hashed_user_id": @"1"});
+    XCTAssertNil([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey]);
+}
+
+- (void)testResetZeroesCountersAndClearsStoredDictionary {
+    [self.defaults setObject:@{@"method_sdk_init": @"3", @"external": @"data"} forKey:kCLXCounterRegistryTestsKey];
+    CLXCounterRegistry *registry = [self makeRegistry];
+
+    [registry reset];
+
+    XCTAssertEqual([registry valueForCounter:@"method_sdk_init"], 0);
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey], @{});
+
+    XCTAssertEqual([registry incrementCounter:@"method_sdk_init"], 1);
+    [registry flush];
+    XCTAssertEqualObjects([self.defaults dictionaryForKey:kCLXCounterRegistryTestsKey], @{@"method_sdk_init": @"1"});
+}
+
+#pragma mark - Performance
+
+- (void)testPerformanceRegistryIncrement {
+    CLXCounterRegistry *registry = [self makeRegistry];
+    registry.persistDelay = CLXCounterRegistryDefaultPersistDelay;
+
+    [self measureWithMetrics:@[[[XCTCPUMetric alloc] init], [[XCTClockMetric alloc] init]] block:^{
+        for (NSInteger i = 0; i < 10000; i++) {
+            [registry incrementCounter:@"network_call_bid_req"];
+        }
+    }];
+}
+
+// The read-modify-write the registry replaced, for comparison
+- (void)testPerformanceUserDefaultsReadModifyWrite {
+    NSUserDefaults *defaults = self.defaults;
+
+    [self measureWithMetrics:@[[[XCTCPUMetric alloc] init], [[XCTClockMetric alloc] init]] block:^{
+        for (NSInteger i = 0; i < 10000; i++) {
+            NSMutableDictionary *metricsDict = [[defaults dictionaryForKey:kCLXCounterRegistryTestsKey] mutableCopy] ?: [NSMutableDictionary dictionary];
+            int number = [metricsDict[@"network_call_bid_req"] intValue];
+            metricsDict[@"network_call_bid_req"] = [NSString stringWithFormat:@"%d", number + 1];
+            [defaults setObject:metricsDict forKey:kCLXCounterRegistryTestsKey];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
+#import <CloudXCore/CLXFlushScheduler.h>
+
+@interface CLXFlushSchedulerTests : XCTestCase
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) CLXFlushScheduler *scheduler;
+@property (nonatomic, assign) NSInteger flushCount;
+@property (nonatomic, assign) BOOL completesImmediately;
+@property (nonatomic, copy, nullable) dispatch_block_t pendingCompletion;
+@end
+
+@implementation CLXFlushSchedulerTests
+
+- (void)setUp {
+    [super setUp];
+    self.queue = dispatch_queue_create("com.cloudx.test.flushscheduler", DISPATCH_QUEUE_SERIAL);
+    self.flushCount = 0;
+    self.completesImmediately = YES;
+    self.pendingCompletion = nil;
+
+    __weak typeof(self) weakSelf = self;
+    self.scheduler = [[CLXFlushScheduler alloc] initWithName:@"test"
+                                                     interval:60
+                                                        queue:self.queue
+                                                   flushBlock:^(dispatch_block_t completion) {
+        weakSelf.flushCount += 1;
+        if (weakSelf.completesImmediately) {
+            completion();
+        } else {
+            weakSelf.pendingCompletion = completion;
+        }
+    }];
+    self.scheduler.randomSourceForTesting = ^double{ return 0.5; }; // No jitter
+    [self.scheduler enableVirtualClockForTesting];
+}
+
+- (void)tearDown {
+    [self.scheduler stop];
+    self.scheduler = nil;
+    [super tearDown];
+}
+
+- (void)testPeriodicFlushOnVirtualClock {
+    [self.scheduler start];
+    [self.scheduler advanceVirtualClockBy:59];
+    XCTAssertEqual(self.flushCount, 0);
+
+    [self.scheduler advanceVirtualClockBy:1];
+    XCTAssertEqual(self.flushCount, 1);
+
+    // Several intervals elapsing at once fire once per interval
+    [self.scheduler advanceVirtualClockBy:180];
+    XCTAssertEqual(self.flushCount, 4);
+}
+
+- (void)testJitterStaysWithinFraction {
+    __block double random = 0.0;
+    self.scheduler.randomSourceForTesting = ^double{ return random; };
+    self.scheduler.jitterFraction = 0.2;
+
+    [self.scheduler start];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqualWithAccuracy(self.scheduler.nextFireTimeForTesting, 48, 0.001);
+
+    random = 0.999;
+    [self.scheduler advanceVirtualClockBy:48];
+    XCTAssertEqual(self.flushCount, 1);
+    XCTAssertEqualWithAccuracy(self.scheduler.nextFireTimeForTesting, 48 + 71.976, 0.001);
+}
+
+- (void)testEventThresholdTriggersEarlyFlushAndRestartsCadence {
+    self.scheduler.pendingEventThreshold = 3;
+    [self.scheduler start];
+    [self.scheduler advanceVirtualClockBy:30];
+
+    [self.scheduler noteEnqueuedEvents:2 bytes:0];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 0);
+
+    [self.scheduler noteEnqueuedEvents:1 bytes:0];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 1);
+
+    // Next periodic flush is a full interval after the threshold flush
+    XCTAssertEqualWithAccuracy(self.scheduler.nextFireTimeForTesting, 90, 0.001);
+    [self.scheduler advanceVirtualClockBy:59];
+    XCTAssertEqual(self.flushCount, 1);
+}
+
+- (void)testBytesThresholdTriggersFlush {
+    self.scheduler.pendingBytesThreshold = 1024;
+    [self.scheduler start];
+
+    [self.scheduler noteEnqueuedEvents:1 bytes:600];
+    [self.scheduler noteEnqueuedEvents:1 bytes:600];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 1);
+}
+
+- (void)testRequestsDuringInFlightFlushCoalesceIntoOneFollowUp {
+    self.completesImmediately = NO;
+    [self.scheduler start];
+
+    [self.scheduler requestFlush];
+    [self.scheduler requestFlush];
+    [self.scheduler requestFlush];
+    [self.scheduler advanceVirtualClockBy:120]; // Timer fires twice while in flight
+    XCTAssertEqual(self.flushCount, 1);
+
+    self.completesImmediately = YES;
+    self.pendingCompletion();
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 2);
+}
+
+- (void)testStaleCompletionDoesNotEndNewerFlush {
+    self.completesImmediately = NO;
+    [self.scheduler start];
+    [self.scheduler requestFlush];
+    [self.scheduler advanceVirtualClockBy:0];
+
+    dispatch_block_t firstCompletion = self.pendingCompletion;
+    firstCompletion();
+    [self.scheduler requestFlush];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 2);
+
+    // Second flush is still in flight, so this request must coalesce
+    firstCompletion();
+    [self.scheduler requestFlush];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 2);
+}
+
+- (void)testPauseDefersFlushesUntilResume {
+    self.scheduler.pendingEventThreshold = 1;
+    [self.scheduler start];
+    [self.scheduler pause];
+
+    [self.scheduler advanceVirtualClockBy:600];
+    [self.scheduler noteEnqueuedEvents:5 bytes:0];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 0);
+    XCTAssertTrue(self.scheduler.isPaused);
+
+    [self.scheduler resume];
+    [self.scheduler advanceVirtualClockBy:0];
+    XCTAssertEqual(self.flushCount, 1);
+}
+
+- (void)testBackgroundNotificationsPauseAndResume {
+    [self.scheduler start];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+    [self.scheduler advanceVirtualClockBy:600];
+    XCTAssertEqual(self.flushCount, 0);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    [self.scheduler advanceVirtualClockBy:60];
+    XCTAssertEqual(self.flushCount, 1);
+}
+
+- (void)testStopCancelsTimerAndThresholds {
+    self.scheduler.pendingEventThreshold = 1;
+    [self.scheduler start];
+    [self.scheduler stop];
+
+    [self.scheduler noteEnqueuedEvents:10 bytes:0];
+    [self.scheduler advanceVirtualClockBy:600];
+    XCTAssertEqual(self.flushCount, 0);
+    XCTAssertFalse(self.scheduler.isRunning);
+    XCTAssertEqual(self.scheduler.nextFireTimeForTesting, -1);
+}
+
+- (void)testRealTimerFiresOnQueueWithoutRunLoop {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Timer fired"];
+    __block BOOL fulfilled = NO;
+    CLXFlushScheduler *scheduler = [[CLXFlushScheduler alloc] initWithName:@"realtime"
+                                                                   interval:0.05
+                                                                      queue:dispatch_queue_create("com.cloudx.test.flushscheduler.rt", DISPATCH_QUEUE_SERIAL)
+                                                                 flushBlock:^(dispatch_block_t completion) {
+        if (!fulfilled) {
+            fulfilled = YES;
+            [expectation fulfill];
+        }
+        completion();
+    }];
+    [scheduler start];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    [scheduler stop];
+}
+
+@end
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import "Mocks/MockCLXWinLossTracker.h"
+
+static NSString * const kTestAuctionID = @"hedged-auction";
+
+// Stand-in adapter that remembers which bid it was created for
+@interface CLXHedgedWaterfallMockAdapter : NSObject
+@property (nonatomic, copy) NSString *bidID;
+@end
+
+@implementation CLXHedgedWaterfallMockAdapter
+@end
+
+@interface CLXHedgedWaterfallTests : XCTestCase
+@property (nonatomic, strong) MockCLXWinLossTracker *mockTracker;
+// Filled on the main queue by the loader and canceller
+@property (nonatomic, strong) NSMutableArray<NSString *> *startedBidIDs;
+@property (nonatomic, strong) NSMutableArray<NSString *> *cancelledBidIDs;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXHedgedLoadCompletion> *pendingLoads;
+@property (nonatomic, strong, nullable) XCTestExpectation *loadsStarted;
+@end
+
+@implementation CLXHedgedWaterfallTests
+
+- (void)setUp {
+    [super setUp];
+    self.mockTracker = [[MockCLXWinLossTracker alloc] init];
+    [CLXWinLossTracker setSharedInstanceForTesting:self.mockTracker];
+    self.startedBidIDs = [NSMutableArray array];
+    self.cancelledBidIDs = [NSMutableArray array];
+    self.pendingLoads = [NSMutableDictionary dictionary];
+}
+
+- (void)tearDown {
+    [CLXWinLossTracker resetSharedInstance];
+    self.mockTracker = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (NSArray<CLXBidAdSourceResponse *> *)_candidatesWithBidIDs:(NSArray<NSString *> *)bidIDs {
+    NSMutableArray<CLXBidAdSourceResponse *> *candidates = [NSMutableArray array];
+    for (NSString *bidID in bidIDs) {
+        CLXBidResponseBid *bid = [[CLXBidResponseBid alloc] init];
+        bid.id = bidID;
+        CLXBidAdSourceResponse *candidate = [[CLXBidAdSourceResponse alloc] initWithPrice:1.0
+                                                                               auctionId:kTestAuctionID
+                                                                                  dealId:nil
+                                                                                 latency:0.0
+                                                                                    nurl:nil
+                                                                                   bidID:bidID
+                                                                                     bid:bid
+                                                                              bidRequest:@{}
+                                                                             networkName:@"test-network"
+                                                                                   clxAd:nil
+                                                                             createBidAd:^id{
+            if ([bidID hasPrefix:@"uncreatable"]) {
+                return nil;
+            }
+            CLXHedgedWaterfallMockAdapter *adapter = [[CLXHedgedWaterfallMockAdapter alloc] init];
+            adapter.bidID = bidID;
+            return adapter;
+        }];
+        [candidates addObject:candidate];
+    }
+    return candidates;
+}
+
+- (void)_runWaterfall:(CLXHedgedWaterfall *)waterfall
+           candidates:(NSArray<CLXBidAdSourceResponse *> *)candidates
+           completion:(void (^)(CLXBidAdSourceResponse * _Nullable winner, id _Nullable adapter, NSError * _Nullable error))completion {
+    __weak typeof(self) weakSelf = self;
+    [waterfall runWithCandidates:candidates
+                          loader:^(CLXBidAdSourceResponse *candidate, id adapter, CLXHedgedLoadCompletion done) {
+        [weakSelf.startedBidIDs addObject:candidate.bidID];
+        weakSelf.pendingLoads[candidate.bidID] = done;
+        [weakSelf.loadsStarted fulfill];
+    }
+                       canceller:^(id adapter) {
+        [weakSelf.cancelledBidIDs addObject:((CLXHedgedWaterfallMockAdapter *)adapter).bidID];
+    }
+                      completion:completion];
+}
+
+- (void)_waitForLoadsToStart:(NSInteger)count {
+    self.loadsStarted = [self expectationWithDescription:@"loads started"];
+    self.loadsStarted.expectedFulfillmentCount = count;
+    self.loadsStarted.assertForOverFulfill = NO;
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+    self.loadsStarted = nil;
+}
+
+// Lets queued main-queue work run without expecting anything to happen
+- (void)_drainMainQueue {
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+}
+
+- (nullable NSNumber *)_lossReasonForBid:(NSString *)bidID {
+    for (NSDictionary *result in self.mockTracker.bidResults) {
+        if ([result[@"bidId"] isEqualToString:bidID] && ![result[@"success"] boolValue]) {
+            return result[@"lossReason"];
+        }
+    }
+    return nil;
+}
+
+#pragma mark - Tests
+
+- (void)testTopBidsStartLoadingTogether {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0];
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"bid2", @"bid3"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {}];
+
+    [self _waitForLoadsToStart:2];
+    [self _drainMainQueue];
+
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1", @"bid2"]));
+}
+
+- (void)testLowerBidThatLoadsFirstWaitsForHigherBid {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0];
+    __block CLXBidAdSourceResponse *result = nil;
+    __block id resultAdapter = nil;
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"bid2", @"bid3"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {
+        result = winner;
+        resultAdapter = adapter;
+    }];
+    [self _waitForLoadsToStart:2];
+
+    self.pendingLoads[@"bid2"](nil);
+    [self _drainMainQueue];
+    XCTAssertNil(result, @"bid2 must wait while bid1 is still loading");
+
+    self.pendingLoads[@"bid1"](nil);
+    [self _drainMainQueue];
+
+    XCTAssertEqualObjects(result.bidID, @"bid1");
+    XCTAssertEqualObjects(((CLXHedgedWaterfallMockAdapter *)resultAdapter).bidID, @"bid1");
+    XCTAssertEqualObjects(self.cancelledBidIDs, (@[@"bid2"]));
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid2"], @(CLXLossReasonLostToHigherBid));
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid3"], @(CLXLossReasonLostToHigherBid));
+    XCTAssertNil([self _lossReasonForBid:@"bid1"]);
+}
+
+- (void)testFailedHigherBidLetsLoadedLowerBidWin {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0];
+    __block CLXBidAdSourceResponse *result = nil;
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"bid2", @"bid3"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {
+        result = winner;
+    }];
+    [self _waitForLoadsToStart:2];
+
+    self.pendingLoads[@"bid2"](nil);
+    self.pendingLoads[@"bid1"]([CLXError errorWithCode:CLXErrorCodeLoadFailed description:@"no fill"]);
+    [self _drainMainQueue];
+
+    XCTAssertEqualObjects(result.bidID, @"bid2");
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1", @"bid2"]), @"bid3 must not start once bid2 has won");
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid1"], @(CLXLossReasonTechnicalError));
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid3"], @(CLXLossReasonLostToHigherBid));
+}
+
+- (void)testFailedLoadHandsItsSlotToTheNextBid {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0];
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"uncreatable2", @"bid3", @"bid4"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {}];
+    [self _waitForLoadsToStart:2];
+
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1", @"bid3"]), @"A bid without an adapter is skipped");
+    XCTAssertEqualObjects([self _lossReasonForBid:@"uncreatable2"], @(CLXLossReasonTechnicalError));
+
+    self.pendingLoads[@"bid1"]([CLXError errorWithCode:CLXErrorCodeLoadFailed description:@"no fill"]);
+    [self _waitForLoadsToStart:1];
+
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1", @"bid3", @"bid4"]));
+}
+
+- (void)testAllFailedLoadsEndWithNoBid {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0];
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    __block NSError *resultError = nil;
+    __block CLXBidAdSourceResponse *result = nil;
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"bid2"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {
+        result = winner;
+        resultError = error;
+        [finished fulfill];
+    }];
+    [self _drainMainQueue];
+
+    NSError *loadError = [CLXError errorWithCode:CLXErrorCodeLoadFailed description:@"no fill"];
+    self.pendingLoads[@"bid1"](loadError);
+    self.pendingLoads[@"bid2"](loadError);
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+
+    XCTAssertNil(result);
+    XCTAssertEqualObjects(resultError.domain, @"CLXBidAdSource");
+    XCTAssertEqual(resultError.code, CLXBidAdSourceErrorNoBid);
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid1"], @(CLXLossReasonTechnicalError));
+    XCTAssertEqualObjects([self _lossReasonForBid:@"bid2"], @(CLXLossReasonTechnicalError));
+}
+
+- (void)testHedgeDelayStaggersLoads {
+    CLXHedgedWaterfall *waterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:2 hedgeDelay:0.3];
+    [self _runWaterfall:waterfall candidates:[self _candidatesWithBidIDs:@[@"bid1", @"bid2"]] completion:^(CLXBidAdSourceResponse *winner, id adapter, NSError *error) {}];
+
+    [self _waitForLoadsToStart:1];
+    [self _drainMainQueue];
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1"]));
+
+    [self _waitForLoadsToStart:1];
+    XCTAssertEqualObjects(self.startedBidIDs, (@[@"bid1", @"bid2"]));
+}
+
+@end
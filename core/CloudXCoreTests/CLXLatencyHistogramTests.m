@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CLXLatencyHistogram.h>
+#import <CloudXCore/CLXMetricsEvent.h>
+#import <CloudXCore/CLXMetricsConfig.h>
+
+@interface CLXLatencyHistogramTests : XCTestCase
+@end
+
+@implementation CLXLatencyHistogramTests
+
+- (void)testBucketIndexLayout {
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:-5], 0);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:0], 0);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:1], 1);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:2], 3);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:3], 4);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:4], 5);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:1000], 20);
+    XCTAssertEqual([CLXLatencyHistogram bucketIndexForLatency:NSIntegerMax], CLXLatencyHistogramBucketCount - 1);
+}
+
+- (void)testRecordAndPercentiles {
+    // Given - 98 fast calls and 2 slow outliers
+    CLXLatencyHistogram *histogram = [[CLXLatencyHistogram alloc] init];
+    for (NSInteger i = 0; i < 98; i++) {
+        [histogram recordLatency:120];
+    }
+    [histogram recordLatency:2500];
+    [histogram recordLatency:2600];
+    
+    // Then - p50 stays in the fast bucket, p99 surfaces the tail
+    XCTAssertEqual(histogram.totalCount, 100);
+    NSInteger p50 = [histogram latencyAtPercentile:50];
+    NSInteger p99 = [histogram latencyAtPercentile:99];
+    XCTAssertGreaterThan(p50, 120);
+    XCTAssertLessThanOrEqual(p50, 182);
+    XCTAssertGreaterThan(p99, 2600);
+    XCTAssertEqual([[[CLXLatencyHistogram alloc] init] latencyAtPercentile:99], 0);
+}
+
+- (void)testSerializationRoundTrip {
+    CLXLatencyHistogram *histogram = [[CLXLatencyHistogram alloc] init];
+    [histogram recordLatency:0];
+    [histogram recordLatency:250];
+    [histogram recordLatency:250];
+    
+    NSString *serialized = [histogram serializedString];
+    XCTAssertEqualObjects(serialized, @"0:1,16:2");
+    XCTAssertEqualObjects([CLXLatencyHistogram histogramFromSerializedString:serialized], histogram);
+    
+    XCTAssertTrue([CLXLatencyHistogram histogramFromSerializedString:nil].isEmpty);
+    XCTAssertTrue([CLXLatencyHistogram histogramFromSerializedString:@"garbage,99:3,-1:2"].isEmpty);
+}
+
+- (void)testMergeAndSubtract {
+    CLXLatencyHistogram *deviceA = [CLXLatencyHistogram histogramFromSerializedString:@"10:3,12:1"];
+    CLXLatencyHistogram *deviceB = [CLXLatencyHistogram histogramFromSerializedString:@"12:2,20:5"];
+    
+    [deviceA mergeHistogram:deviceB];
+    XCTAssertEqualObjects([deviceA serializedString], @"10:3,12:3,20:5");
+    XCTAssertEqual(deviceA.totalCount, 11);
+    
+    [deviceA subtractHistogram:deviceB];
+    XCTAssertEqualObjects([deviceA serializedString], @"10:3,12:1");
+    XCTAssertEqual(deviceA.totalCount, 4);
+}
+
+- (void)testMetricsEventPersistsHistogram {
+    CLXMetricsEvent *event = [CLXMetricsEvent fromDictionary:@{
+        @"id": @"event-id",
+        @"metricName": @"network_call_bid_req",
+        @"counter": @2,
+        @"totalLatency": @500,
+        @"sessionId": @"session",
+        @"auctionId": @"auction",
+        @"latencyHistogram": @"16:2"
+    }];
+    
+    XCTAssertEqual(event.latencyHistogram.totalCount, 2);
+    XCTAssertEqualObjects([event toDictionary][@"latencyHistogram"], @"16:2");
+}
+
+- (void)testConfigFlag {
+    CLXMetricsConfig *config = [CLXMetricsConfig fromDictionary:@{
+        @"network_calls.enabled": @YES,
+        @"network_calls.latency_histogram.enabled": @YES
+    }];
+    XCTAssertTrue([config isLatencyHistogramEnabled]);
+    
+    config.networkCallsEnabled = @NO;
+    XCTAssertFalse([config isLatencyHistogramEnabled], @"Histograms follow the global network calls flag");
+    XCTAssertFalse([[[CLXMetricsConfig alloc] init] isLatencyHistogramEnabled]);
+}
+
+@end
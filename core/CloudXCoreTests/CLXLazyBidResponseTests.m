@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+static NSString *const kCLXLazyAuctionId = @"lazy-auction";
+static const NSInteger kCLXLazyParticipantCount = 500;
+static const NSInteger kCLXLazyAuctionCount = 32;
+
+@interface CLXLazyBidResponseTests : XCTestCase
+@property (nonatomic, strong) NSData *responseData;
+@end
+
+@implementation CLXLazyBidResponseTests
+
+- (void)setUp {
+    [super setUp];
+
+    // Few bids, but a large participant list and prebid ext blob the typed model never reads
+    NSMutableArray *participants = [NSMutableArray array];
+    for (NSInteger i = 0; i < kCLXLazyParticipantCount; i++) {
+        [participants addObject:@{@"bidder": [NSString stringWithFormat:@"bidder-%ld", (long)i],
+                                  @"rank": @(i + 1), @"round": @1,
+                                  @"lineItemId": [NSString stringWithFormat:@"line-item-%ld", (long)i],
+                                  @"responseTimeMillis": @(100 + i),
+                                  @"bid": @(5.0 - i * 0.001)}];
+    }
+    NSMutableArray *bids = [NSMutableArray array];
+    for (NSInteger i = 0; i < 3; i++) {
+        [bids addObject:@{@"id": [NSString stringWithFormat:@"bid-%ld", (long)i],
+                          @"impid": @"imp-1",
+                          @"price": @(3.0 - i),
+                          @"adm": @"<html><body>creative</body></html>",
+                          @"ext": @{@"cloudx": @{@"rank": @(i + 1)},
+                                    @"prebid": @{@"meta": @{@"adaptercode": @"bidder-1"},
+                                                 @"targeting": @{@"hb_pb": @"3.00", @"hb_bidder": @"bidder-1"}}}}];
+    }
+    NSDictionary *response = @{@"id": kCLXLazyAuctionId,
+                               @"cur": @"USD",
+                               @"seatbid": @[@{@"seat": @"cloudx", @"bid": bids}],
+                               @"ext": @{@"cloudx": @{@"auction": @{@"participants": participants}}}};
+    self.responseData = [NSJSONSerialization dataWithJSONObject:response options:0 error:nil];
+}
+
+#pragma mark - Parsing
+
+- (void)testParseFromDataKeepsBytesAndTypedFields {
+    NSError *error = nil;
+    CLXBidResponse *response = [CLXBidResponse parseBidResponseFromData:self.responseData error:&error];
+
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(response.id, kCLXLazyAuctionId);
+    XCTAssertEqual([response getAllBidsForWaterfall].count, 3);
+    XCTAssertEqualObjects([response getAllBidsForWaterfall].firstObject.ext.prebid.meta.adaptercode, @"bidder-1");
+    XCTAssertEqualObjects(response.rawData, self.responseData);
+}
+
+- (void)testParseFromDataRejectsNonObjects {
+    NSError *error = nil;
+    XCTAssertNil([CLXBidResponse parseBidResponseFromData:[@"[1,2]" dataUsingEncoding:NSUTF8StringEncoding] error:&error]);
+    XCTAssertNotNil(error);
+
+    error = nil;
+    XCTAssertNil([CLXBidResponse parseBidResponseFromData:[@"{" dataUsingEncoding:NSUTF8StringEncoding] error:&error]);
+    XCTAssertNotNil(error);
+}
+
+#pragma mark - Tracking Store
+
+- (void)testStoredBytesResolveLikeTheDictionary {
+    CLXTrackingFieldResolver *resolver = [[CLXTrackingFieldResolver alloc] init];
+    CLXSDKConfigResponse *config = [[CLXSDKConfigResponse alloc] init];
+    config.tracking = @[@"bid.price", @"bidResponse.cur",
+                        @"bidResponse.ext.cloudx.auction.participants[rank=${bid.ext.cloudx.rank}].lineItemId"];
+    [resolver setConfig:config];
+    [resolver saveLoadedBid:kCLXLazyAuctionId bidId:@"bid-1"];
+
+    NSDictionary *json = [NSJSONSerialization JSONObjectWithData:self.responseData options:0 error:nil];
+    [resolver setResponseData:kCLXLazyAuctionId bidResponseJSON:json];
+    NSString *fromDictionary = [resolver buildPayload:kCLXLazyAuctionId];
+
+    [resolver setResponseData:kCLXLazyAuctionId bidResponseData:self.responseData];
+    NSString *fromBytes = [resolver buildPayload:kCLXLazyAuctionId];
+
+    XCTAssertEqualObjects(fromBytes, @"2;USD;line-item-1");
+    XCTAssertEqualObjects(fromBytes, fromDictionary);
+}
+
+- (void)testStoredBytesAreAccountedAtTheirSize {
+    CLXTrackingAuctionStore *dictionaryStore = [[CLXTrackingAuctionStore alloc] init];
+    NSDictionary *json = [NSJSONSerialization JSONObjectWithData:self.responseData options:0 error:nil];
+    [dictionaryStore setResponseData:json forAuction:kCLXLazyAuctionId];
+
+    CLXTrackingAuctionStore *byteStore = [[CLXTrackingAuctionStore alloc] init];
+    [byteStore setResponseJSONData:self.responseData forAuction:kCLXLazyAuctionId];
+
+    XCTAssertLessThan(byteStore.retainedBytes, self.responseData.length + 64);
+    XCTAssertLessThan(byteStore.retainedBytes, dictionaryStore.retainedBytes);
+
+    CLXTrackingAuctionEntry *entry = [byteStore entryForAuction:kCLXLazyAuctionId];
+    XCTAssertEqualObjects(entry.responseJSONData, self.responseData);
+    XCTAssertEqualObjects(entry.responseData, json);
+}
+
+- (void)testReplacingBytesWithDictionaryDropsBytes {
+    CLXTrackingAuctionStore *store = [[CLXTrackingAuctionStore alloc] init];
+    [store setResponseJSONData:self.responseData forAuction:kCLXLazyAuctionId];
+    [store setResponseData:@{@"id": @"replacement"} forAuction:kCLXLazyAuctionId];
+
+    CLXTrackingAuctionEntry *entry = [store entryForAuction:kCLXLazyAuctionId];
+    XCTAssertNil(entry.responseJSONData);
+    XCTAssertEqualObjects(entry.responseData[@"id"], @"replacement");
+}
+
+#pragma mark - Performance
+
+// A full store of auctions retained as parsed JSON, the previous behavior
+- (void)testMemoryRetainingParsedResponses {
+    [self measureWithMetrics:@[[[XCTMemoryMetric alloc] init]] block:^{
+        CLXTrackingAuctionStore *store = [[CLXTrackingAuctionStore alloc] init];
+        for (NSInteger i = 0; i < kCLXLazyAuctionCount; i++) {
+            @autoreleasepool {
+                NSDictionary *json = [NSJSONSerialization JSONObjectWithData:self.responseData options:0 error:nil];
+                [CLXBidResponse parseBidResponseFromDictionary:json];
+                [store setResponseData:json forAuction:[NSString stringWithFormat:@"auction-%ld", (long)i]];
+            }
+        }
+        XCTAssertEqual(store.liveAuctionCount, kCLXLazyAuctionCount);
+    }];
+}
+
+// The same auctions retained as bytes
+- (void)testMemoryRetainingResponseBytes {
+    [self measureWithMetrics:@[[[XCTMemoryMetric alloc] init]] block:^{
+        CLXTrackingAuctionStore *store = [[CLXTrackingAuctionStore alloc] init];
+        for (NSInteger i = 0; i < kCLXLazyAuctionCount; i++) {
+            @autoreleasepool {
+                NSData *body = [self.responseData copy];
+                CLXBidResponse *response = [CLXBidResponse parseBidResponseFromData:body error:nil];
+                [store setResponseJSONData:response.rawData forAuction:[NSString stringWithFormat:@"auction-%ld", (long)i]];
+            }
+        }
+        XCTAssertEqual(store.liveAuctionCount, kCLXLazyAuctionCount);
+    }];
+}
+
+@end
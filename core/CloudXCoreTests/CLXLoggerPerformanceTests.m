@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CLXLogger.h>
+
+/**
+ * Counts how often it is formatted into a log message
+ */
+@interface CLXDescriptionCountingObject : NSObject
+@property (nonatomic, assign) NSInteger descriptionCount;
+@end
+
+@implementation CLXDescriptionCountingObject
+- (NSString *)description {
+    self.descriptionCount += 1;
+    return @"counted";
+}
+@end
+
+@interface CLXLoggerPerformanceTests : XCTestCase
+@property (nonatomic, strong) CLXLogger *logger;
+@property (nonatomic, strong) NSDictionary *bidResponseJSON;
+@end
+
+@implementation CLXLoggerPerformanceTests
+
+static const NSInteger kCLXAuctionLogIterations = 1000;
+
+- (BOOL)setUpWithError:(NSError *__autoreleasing  _Nullable *)error {
+    if (CLXLoggerIsEnabled()) {
+        XCTSkip(@"Verbose logging is enabled for this process; disabled-logging costs cannot be measured");
+    }
+
+    self.logger = [[CLXLogger alloc] initWithCategory:@"LoggerPerformanceTests"];
+
+    // Representative bid response, as logged on the auction path
+    NSMutableArray *bids = [NSMutableArray array];
+    for (NSInteger i = 0; i < 10; i++) {
+        [bids addObject:@{
+            @"id": [NSString stringWithFormat:@"bid-%ld", (long)i],
+            @"impid": @"imp-1",
+            @"price": @(1.5 + i),
+            @"adm": @"<html><body>creative</body></html>",
+            @"ext": @{@"prebid": @{@"meta": @{@"adaptercode": @"meta"}}, @"cloudx": @{@"rank": @(i + 1)}}
+        }];
+    }
+    self.bidResponseJSON = @{@"id": @"auction-1", @"seatbid": @[@{@"seat": @"cloudx", @"bid": bids}]};
+    return YES;
+}
+
+#pragma mark - Helpers
+
+- (void)_logAuctionEagerly {
+    [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Auction response: %@", self.bidResponseJSON]];
+    [self.logger debug:[NSString stringWithFormat:@"🔄 [CLXBidAdSource] Starting waterfall with %lu bids", (unsigned long)10]];
+    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolving field: %@ for auction: %@", @"bid.price", @"auction-1"]];
+}
+
+- (void)_logAuctionLazily {
+    CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] Auction response: %@", self.bidResponseJSON);
+    CLX_LOG_DEBUG(self.logger, @"🔄 [CLXBidAdSource] Starting waterfall with %lu bids", (unsigned long)10);
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolving field: %@ for auction: %@", @"bid.price", @"auction-1");
+}
+
+- (NSArray<id<XCTMetric>> *)_loggingMetrics {
+    return @[[[XCTClockMetric alloc] init], [[XCTCPUMetric alloc] init], [[XCTMemoryMetric alloc] init]];
+}
+
+#pragma mark - Tests
+
+- (void)testDisabledMacroDoesNotEvaluateArguments {
+    CLXDescriptionCountingObject *object = [[CLXDescriptionCountingObject alloc] init];
+
+    CLX_LOG_DEBUG(self.logger, @"debug %@", object);
+    CLX_LOG_INFO(self.logger, @"info %@", object);
+    CLX_LOG_ERROR(self.logger, @"error %@", object);
+    XCTAssertEqual(object.descriptionCount, 0);
+
+    // The eager form always formats, even though the message is then dropped
+    [self.logger debug:[NSString stringWithFormat:@"debug %@", object]];
+    XCTAssertEqual(object.descriptionCount, 1);
+}
+
+// Compare with testPerformanceLazyLoggingDisabled; the eager form formats every message it then drops
+- (void)testPerformanceEagerLoggingDisabled {
+    [self measureWithMetrics:[self _loggingMetrics] block:^{
+        for (NSInteger i = 0; i < kCLXAuctionLogIterations; i++) {
+            [self _logAuctionEagerly];
+        }
+    }];
+}
+
+- (void)testPerformanceLazyLoggingDisabled {
+    [self measureWithMetrics:[self _loggingMetrics] block:^{
+        for (NSInteger i = 0; i < kCLXAuctionLogIterations; i++) {
+            [self _logAuctionLazily];
+        }
+    }];
+}
+
+@end
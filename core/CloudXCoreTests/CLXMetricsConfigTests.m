@@ -173,6 +173,27 @@
     XCTAssertFalse([config2 isGeoNetworkCallsEnabled]);
 }
 
+- (void)testPerformanceMetricsAreSwitchedIndependentlyOfNetworkCalls {
+    // Test parsed from the performance keys
+    CLXMetricsConfig *config1 = [CLXMetricsConfig fromDictionary:@{
+        @"performance.enabled": @YES,
+        @"performance.auction_stages.enabled": @YES,
+        @"performance.connection.enabled": @NO,
+        @"performance.cache_refill.enabled": @YES
+    }];
+    XCTAssertFalse([config1 isNetworkCallsEnabled]);
+    XCTAssertTrue([config1 isPerformanceMetricsEnabled]);
+    XCTAssertTrue([config1 isAuctionStageMetricsEnabled]);
+    XCTAssertFalse([config1 isConnectionMetricsEnabled]);
+    XCTAssertTrue([config1 isCacheRefillMetricsEnabled]);
+
+    // Test network calls enabled does not turn performance metrics on
+    CLXMetricsConfig *config2 = [[CLXMetricsConfig alloc] init];
+    config2.networkCallsEnabled = @YES;
+    config2.performanceCacheRefillEnabled = @YES;
+    XCTAssertFalse([config2 isCacheRefillMetricsEnabled]);
+}
+
 - (void)testDescription {
     // Given
     CLXMetricsConfig *config = [[CLXMetricsConfig alloc] init];
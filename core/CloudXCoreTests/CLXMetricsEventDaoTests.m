@@ -222,6 +222,54 @@
     // Database operations should be executed
 }
 
+- (void)testInsertAllUsesSingleTransaction {
+    // Given
+    NSMutableArray<CLXMetricsEvent *> *events = [NSMutableArray array];
+    for (NSInteger i = 0; i < 5; i++) {
+        [events addObject:[[CLXMetricsEvent alloc] initWithEventId:[NSString stringWithFormat:@"id-%ld", (long)i]
+                                                        metricName:@"method_create_banner"
+                                                           counter:i
+                                                      totalLatency:0
+                                                         sessionId:@"session"
+                                                         auctionId:@"auction"]];
+    }
+    [self.mockDatabase.executedQueries removeAllObjects];
+    
+    // When
+    BOOL result = [self.dao insertAll:events];
+    
+    // Then
+    XCTAssertTrue(result);
+    NSPredicate *inserts = [NSPredicate predicateWithFormat:@"SELF CONTAINS 'INSERT OR REPLACE'"];
+    XCTAssertEqual([self.mockDatabase.executedQueries filteredArrayUsingPredicate:inserts].count, 5);
+}
+
+- (void)testDeleteByIdsChunksIntoInStatements {
+    // Given - more IDs than fit in one statement
+    NSMutableArray<NSString *> *ids = [NSMutableArray array];
+    for (NSInteger i = 0; i < 450; i++) {
+        [ids addObject:[NSString stringWithFormat:@"id-%ld", (long)i]];
+    }
+    [self.mockDatabase.executedQueries removeAllObjects];
+    [self.mockDatabase.executedParameters removeAllObjects];
+    
+    // When
+    BOOL result = [self.dao deleteByIds:ids];
+    
+    // Then
+    XCTAssertTrue(result);
+    XCTAssertEqual(self.mockDatabase.executedQueries.count, 3, @"450 IDs should be deleted with 3 IN (...) statements");
+    XCTAssertTrue([self.mockDatabase.executedQueries.firstObject containsString:@"WHERE id IN ("]);
+    XCTAssertEqual(self.mockDatabase.executedParameters[0].count, 200);
+    XCTAssertEqual(self.mockDatabase.executedParameters[2].count, 50);
+}
+
+- (void)testDeleteByIdsEmpty {
+    [self.mockDatabase.executedQueries removeAllObjects];
+    XCTAssertTrue([self.dao deleteByIds:@[]]);
+    XCTAssertEqual(self.mockDatabase.executedQueries.count, 0);
+}
+
 - (void)testGetAll {
     // Given
     NSArray *mockResults = @[
@@ -94,7 +94,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodCreateInterstitial];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify metrics are persisted correctly
     CLXMetricsEvent *bannerEvent = [self.dao getAllByMetric:CLXMetricsTypeMethodCreateBanner];
@@ -128,7 +128,7 @@
     [self.metricsTracker trackNetworkCall:CLXMetricsTypeNetworkSdkInit latency:150];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify metrics are persisted and aggregated correctly
     CLXMetricsEvent *bidEvent = [self.dao getAllByMetric:CLXMetricsTypeNetworkBidRequest];
@@ -165,7 +165,7 @@
     [self.metricsTracker trackNetworkCall:CLXMetricsTypeNetworkGeoApi latency:100];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify all metrics are tracked correctly
     NSArray<CLXMetricsEvent *> *allEvents = [self.dao getAll];
@@ -204,7 +204,7 @@
     [self.metricsTracker trackNetworkCall:CLXMetricsTypeNetworkBidRequest latency:250];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - only method calls should be persisted
     NSArray<CLXMetricsEvent *> *allEvents = [self.dao getAll];
@@ -230,7 +230,7 @@
     [self.metricsTracker trackNetworkCall:CLXMetricsTypeNetworkGeoApi latency:150];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - only enabled network calls should be persisted
     NSArray<CLXMetricsEvent *> *allEvents = [self.dao getAll];
@@ -257,7 +257,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodCreateRewarded];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify session data is included
     CLXMetricsEvent *event = [self.dao getAllByMetric:CLXMetricsTypeMethodCreateRewarded];
@@ -302,7 +302,7 @@
     dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC));
     
     // Additional wait for async database operations
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify data integrity
     CLXMetricsEvent *methodEvent = [self.dao getAllByMetric:CLXMetricsTypeMethodCreateBanner];
@@ -330,7 +330,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodSdkInit];
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Verify first tracking
     CLXMetricsEvent *event1 = [self.dao getAllByMetric:CLXMetricsTypeMethodSdkInit];
@@ -343,7 +343,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodSdkInit]; // Track again
     
     // Wait for async operations to complete
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - verify aggregation continues correctly
     CLXMetricsEvent *event2 = [self.dao getAllByMetric:CLXMetricsTypeMethodSdkInit];
@@ -365,7 +365,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodCreateBanner];
     
     // Wait for async operations
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - should work (using impression URL internally)
     CLXMetricsEvent *event1 = [self.dao getAllByMetric:CLXMetricsTypeMethodCreateBanner];
@@ -386,7 +386,7 @@
     [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodCreateInterstitial];
     
     // Wait for async operations
-    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [self.metricsTracker flushPendingOperations]; // Drains the queue and checkpoints aggregates
     
     // Then - should still work (using metrics URL as fallback)
     CLXMetricsEvent *event2 = [self.dao getAllByMetric:CLXMetricsTypeMethodCreateInterstitial];
@@ -87,6 +87,38 @@
     // This should be very fast as it's just in-memory aggregation + database insert
 }
 
+- (void)testSingleMethodCallPerformance_DrainedWithAggregation {
+    // Same call as testSingleMethodCallPerformance, but waits for the metrics queue to drain
+    // so the measurement includes the work done per call plus one checkpoint
+    NSInteger callCount = 1000;
+    
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < callCount; i++) {
+            [self.metricsTracker trackMethodCall:CLXMetricsTypeMethodCreateBanner];
+        }
+        [self.metricsTracker flushPendingOperations];
+    }];
+}
+
+- (void)testSingleMethodCallPerformance_DrainedPerCallSQLiteBaseline {
+    // Baseline for the test above: the previous per-call path (SELECT ... LIMIT 1 followed by INSERT OR REPLACE)
+    NSInteger callCount = 1000;
+    CLXMetricsEventDao *dao = [[CLXMetricsEventDao alloc] initWithDatabase:self.testDatabase];
+    
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < callCount; i++) {
+            CLXMetricsEvent *existing = [dao getAllByMetric:CLXMetricsTypeMethodCreateInterstitial];
+            CLXMetricsEvent *updated = [[CLXMetricsEvent alloc] initWithEventId:existing.eventId ?: [[NSUUID UUID] UUIDString]
+                                                                     metricName:CLXMetricsTypeMethodCreateInterstitial
+                                                                        counter:existing.counter + 1
+                                                                   totalLatency:existing.totalLatency
+                                                                      sessionId:@"perf-test-session"
+                                                                      auctionId:existing.auctionId ?: [[NSUUID UUID] UUIDString]];
+            [dao insert:updated];
+        }
+    }];
+}
+
 - (void)testSingleNetworkCallPerformance {
     // Test single network call overhead
     [self measureBlock:^{
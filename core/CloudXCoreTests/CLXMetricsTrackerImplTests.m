@@ -226,6 +226,17 @@
     XCTAssertNoThrow([self.metricsTracker trackNetworkCall:CLXMetricsTypeNetworkSdkInit latency:0]);
 }
 
+- (void)testTrackPerformanceMetric {
+    // When/Then
+    XCTAssertNoThrow([self.metricsTracker trackPerformanceMetric:CLXMetricsTypeCacheShowMiss value:0]);
+    XCTAssertNoThrow([self.metricsTracker trackPerformanceMetric:CLXMetricsTypeAuctionStageBidRequest value:120]);
+}
+
+- (void)testTrackPerformanceMetricWithNetworkCallType {
+    // When/Then - network calls are not accepted as performance metrics
+    XCTAssertNoThrow([self.metricsTracker trackPerformanceMetric:CLXMetricsTypeNetworkBidRequest value:100]);
+}
+
 - (void)testTrySendingPendingMetrics {
     // TEMPORARILY DISABLED: This test has complex mock database interactions
     // that are causing crashes. The core functionality is validated by other tests.
@@ -79,6 +79,26 @@
     XCTAssertTrue([networkTypes containsObject:CLXMetricsTypeNetworkBidRequest]);
 }
 
+- (void)testAllPerformanceTypes {
+    // Test that performance metrics are their own category
+    NSArray<NSString *> *performanceTypes = [CLXMetricsType allPerformanceTypes];
+    
+    XCTAssertNotNil(performanceTypes);
+    XCTAssertEqual(performanceTypes.count, 10);
+    XCTAssertEqual([CLXMetricsType allAuctionStageTypes].count, 3);
+    XCTAssertEqual([CLXMetricsType allConnectionTypes].count, 2);
+    XCTAssertEqual([CLXMetricsType allCacheRefillTypes].count, 5);
+    for (NSString *type in performanceTypes) {
+        XCTAssertTrue([CLXMetricsType isPerformanceType:type]);
+        XCTAssertFalse([CLXMetricsType isNetworkCallType:type]);
+        XCTAssertTrue([CLXMetricsType isValidMetricType:type]);
+    }
+    XCTAssertTrue([performanceTypes containsObject:CLXMetricsTypeAuctionStageBidTokens]);
+    XCTAssertTrue([performanceTypes containsObject:CLXMetricsTypeNetworkConnectionReused]);
+    XCTAssertTrue([performanceTypes containsObject:CLXMetricsTypeCacheShowMiss]);
+    XCTAssertFalse([CLXMetricsType isPerformanceType:CLXMetricsTypeNetworkBidRequest]);
+}
+
 - (void)testAllMethodCallTypes {
     // Test that all method call types are returned
     NSArray<NSString *> *methodTypes = [CLXMetricsType allMethodCallTypes];
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+@interface CLXPayloadCaptureMockTask : NSObject
+- (void)resume;
+@end
+
+@implementation CLXPayloadCaptureMockTask
+- (void)resume {
+}
+@end
+
+// Records the request it was handed and answers with a canned response
+@interface CLXPayloadCaptureMockSession : NSURLSession
+@property (nonatomic, strong) NSURLRequest *lastRequest;
+@property (nonatomic, strong) NSData *responseData;
+@end
+
+@implementation CLXPayloadCaptureMockSession
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                            completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
+    self.lastRequest = request;
+    NSHTTPURLResponse *httpResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:@{}];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        completionHandler(self.responseData, httpResponse, nil);
+    });
+    return (NSURLSessionDataTask *)[[CLXPayloadCaptureMockTask alloc] init];
+}
+
+@end
+
+@interface CLXPayloadCaptureTests : XCTestCase
+@property (nonatomic, strong) CLXPayloadCapture *capture;
+@property (nonatomic, assign) BOOL wasEnabled;
+@end
+
+@implementation CLXPayloadCaptureTests
+
+- (void)setUp {
+    [super setUp];
+    self.capture = [[CLXPayloadCapture alloc] init];
+    self.capture.enabled = YES;
+    self.wasEnabled = [CLXPayloadCapture shared].enabled;
+}
+
+- (void)tearDown {
+    [CLXPayloadCapture shared].enabled = self.wasEnabled;
+    [[CLXPayloadCapture shared] removeAllPayloads];
+    [super tearDown];
+}
+
+- (NSData *)_body:(NSInteger)index {
+    return [[NSString stringWithFormat:@"{\"n\":%ld}", (long)index] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - Ring Buffer
+
+- (void)testKeepsMostRecentPayloadsOldestFirst {
+    self.capture.capacity = 3;
+    NSURL *url = [NSURL URLWithString:@"https://test.cloudx.io/auction"];
+    for (NSInteger i = 0; i < 5; i++) {
+        [self.capture recordRequestBody:[self _body:i] url:url];
+    }
+
+    NSArray<CLXCapturedPayload *> *payloads = self.capture.recentPayloads;
+    XCTAssertEqual(payloads.count, 3);
+    XCTAssertEqualObjects(payloads[0].bodyString, @"{\"n\":2}");
+    XCTAssertEqualObjects(payloads[2].bodyString, @"{\"n\":4}");
+    XCTAssertEqualObjects(payloads[2].url, @"https://test.cloudx.io/auction");
+}
+
+- (void)testShrinkingCapacityKeepsNewest {
+    self.capture.capacity = 4;
+    for (NSInteger i = 0; i < 6; i++) {
+        [self.capture recordResponseBody:[self _body:i] url:nil statusCode:200];
+    }
+
+    self.capture.capacity = 2;
+    NSArray<CLXCapturedPayload *> *payloads = self.capture.recentPayloads;
+    XCTAssertEqual(payloads.count, 2);
+    XCTAssertEqualObjects(payloads[0].bodyString, @"{\"n\":4}");
+    XCTAssertEqualObjects(payloads[1].bodyString, @"{\"n\":5}");
+    XCTAssertEqual(payloads[1].direction, CLXCapturedPayloadDirectionResponse);
+    XCTAssertEqual(payloads[1].statusCode, 200);
+}
+
+- (void)testDisabledCaptureRecordsNothing {
+    self.capture.enabled = NO;
+    [self.capture recordRequestBody:[self _body:1] url:nil];
+    XCTAssertEqual(self.capture.recentPayloads.count, 0);
+}
+
+#pragma mark - Network Path
+
+- (void)testSDKInitSendsCompactBodyAndCapturesIt {
+    CLXPayloadCaptureMockSession *session = [[CLXPayloadCaptureMockSession alloc] init];
+    session.responseData = [@"{}" dataUsingEncoding:NSUTF8StringEncoding];
+    CLXSDKInitNetworkService *service = [[CLXSDKInitNetworkService alloc] initWithBaseURL:@"https://test.cloudx.io/init" urlSession:session];
+
+    [CLXPayloadCapture shared].enabled = YES;
+    [[CLXPayloadCapture shared] removeAllPayloads];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"SDK init completes"];
+    [service initSDKWithAppKey:@"test-app-key" completion:^(CLXSDKConfigResponse * _Nullable config, NSError * _Nullable error) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    NSData *sentBody = session.lastRequest.HTTPBody;
+    XCTAssertNotNil(sentBody);
+    NSString *sentString = [[NSString alloc] initWithData:sentBody encoding:NSUTF8StringEncoding];
+    XCTAssertFalse([sentString containsString:@"\n"], @"Body should be compact JSON");
+
+    NSArray<CLXCapturedPayload *> *payloads = [CLXPayloadCapture shared].recentPayloads;
+    XCTAssertGreaterThanOrEqual(payloads.count, 2);
+    XCTAssertEqual(payloads[0].direction, CLXCapturedPayloadDirectionRequest);
+    XCTAssertEqualObjects(payloads[0].body, sentBody);
+    XCTAssertEqual(payloads[1].direction, CLXCapturedPayloadDirectionResponse);
+}
+
+@end
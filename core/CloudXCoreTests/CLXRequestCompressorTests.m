@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import <CloudXCore/CLXRequestCompressor.h>
+#import <CloudXCore/CLXEventTrackerBulkApi.h>
+#import <CloudXCore/CLXEventAM.h>
+#import <CloudXCore/CLXXorEncryption.h>
+#import <CloudXCore/CLXMetricsConfig.h>
+#import <zlib.h>
+#import "CLXLocalHTTPServer.h"
+
+@interface CLXRequestCompressorTests : XCTestCase
+@property (nonatomic, strong) CLXRequestCompressor *compressor;
+@end
+
+@implementation CLXRequestCompressorTests
+
+- (void)setUp {
+    [super setUp];
+    self.compressor = [[CLXRequestCompressor alloc] init];
+}
+
+- (void)tearDown {
+    [[CLXRequestCompressor shared] applyMetricsConfig:nil];
+    [[CLXRequestCompressor shared] resetRejectedHosts];
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// inflate with automatic zlib/gzip header detection
+- (NSData *)_inflate:(NSData *)data {
+    z_stream stream = {0};
+    XCTAssertEqual(inflateInit2(&stream, 15 + 32), Z_OK);
+    NSMutableData *output = [NSMutableData dataWithLength:data.length * 8 + 1024];
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    stream.next_out = (Bytef *)output.mutableBytes;
+    stream.avail_out = (uInt)output.length;
+    int status = inflate(&stream, Z_FINISH);
+    output.length = stream.total_out;
+    inflateEnd(&stream);
+    XCTAssertEqual(status, Z_STREAM_END);
+    return output;
+}
+
+// JSON body the bulk API sends for a batch of SDK_METRICS events
+- (NSData *)_bulkBodyWithEventCount:(NSUInteger)count {
+    NSData *secret = [@"0123456789abcdef" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *impression = [NSString stringWithFormat:@"session-1;account-1;ios_sdk;network_call_bid_req;%lu;%lu",
+                                (unsigned long)(i + 1), (unsigned long)(i * 37 % 900)];
+        CLXEventAM *event = [[CLXEventAM alloc] initWithImpression:[CLXXorEncryption encrypt:impression secret:secret]
+                                                        campaignId:@"YWNjb3VudC0x"
+                                                        eventValue:@"N/A"
+                                                         eventName:@"SDK_METRICS"
+                                                              type:@"SDK_METRICS"];
+        [items addObject:[event toDictionary]];
+    }
+    return [NSJSONSerialization dataWithJSONObject:items options:0 error:nil];
+}
+
+#pragma mark - Encoding
+
+- (void)testGzipRoundTrip {
+    NSData *body = [self _bulkBodyWithEventCount:50];
+    NSData *compressed = [CLXRequestCompressor compressData:body encoding:CLXContentEncodingGzip];
+
+    XCTAssertNotNil(compressed);
+    const uint8_t *bytes = compressed.bytes;
+    XCTAssertEqual(bytes[0], 0x1f);
+    XCTAssertEqual(bytes[1], 0x8b);
+    XCTAssertEqualObjects([self _inflate:compressed], body);
+}
+
+- (void)testDeflateRoundTrip {
+    NSData *body = [self _bulkBodyWithEventCount:50];
+    NSData *compressed = [CLXRequestCompressor compressData:body encoding:CLXContentEncodingDeflate];
+
+    XCTAssertNotNil(compressed);
+    const uint8_t *bytes = compressed.bytes;
+    XCTAssertEqual(bytes[0] & 0x0f, Z_DEFLATED, @"zlib header, as HTTP deflate expects");
+    XCTAssertEqualObjects([self _inflate:compressed], body);
+}
+
+- (void)testIdentityReturnsBodyUnchanged {
+    NSData *body = [self _bulkBodyWithEventCount:5];
+    XCTAssertEqualObjects([CLXRequestCompressor compressData:body encoding:CLXContentEncodingIdentity], body);
+    XCTAssertNil([CLXRequestCompressor headerValueForEncoding:CLXContentEncodingIdentity]);
+}
+
+#pragma mark - Policy
+
+- (void)testDisabledByDefault {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://tracker.example.com/bulk"]];
+    request.HTTPBody = [self _bulkBodyWithEventCount:50];
+
+    XCTAssertEqual([self.compressor compressBodyOfRequest:request], CLXContentEncodingIdentity);
+    XCTAssertNil([request valueForHTTPHeaderField:@"Content-Encoding"]);
+}
+
+- (void)testBodiesBelowThresholdAreNotCompressed {
+    self.compressor.encoding = CLXContentEncodingGzip;
+    self.compressor.minimumBodyBytes = 64 * 1024;
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://tracker.example.com/bulk"]];
+    NSData *body = [self _bulkBodyWithEventCount:5];
+    request.HTTPBody = body;
+
+    XCTAssertEqual([self.compressor compressBodyOfRequest:request], CLXContentEncodingIdentity);
+    XCTAssertEqualObjects(request.HTTPBody, body);
+}
+
+- (void)testLargeBodyIsCompressedWithHeader {
+    self.compressor.encoding = CLXContentEncodingGzip;
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://tracker.example.com/bulk"]];
+    NSData *body = [self _bulkBodyWithEventCount:50];
+    request.HTTPBody = body;
+
+    XCTAssertEqual([self.compressor compressBodyOfRequest:request], CLXContentEncodingGzip);
+    XCTAssertEqualObjects([request valueForHTTPHeaderField:@"Content-Encoding"], @"gzip");
+    XCTAssertLessThan(request.HTTPBody.length, body.length);
+    XCTAssertEqualObjects([self _inflate:request.HTTPBody], body);
+}
+
+- (void)testRejectingHostGetsUncompressedBodies {
+    self.compressor.encoding = CLXContentEncodingDeflate;
+    NSURL *url = [NSURL URLWithString:@"https://tracker.example.com/bulk"];
+
+    XCTAssertFalse([self.compressor shouldRetryUncompressedAfterEncoding:CLXContentEncodingIdentity statusCode:415 url:url]);
+    XCTAssertFalse([self.compressor shouldRetryUncompressedAfterEncoding:CLXContentEncodingDeflate statusCode:500 url:url]);
+    XCTAssertTrue([self.compressor shouldRetryUncompressedAfterEncoding:CLXContentEncodingDeflate statusCode:415 url:url]);
+    XCTAssertTrue([self.compressor hasHostRejectedCompression:@"tracker.example.com"]);
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    request.HTTPBody = [self _bulkBodyWithEventCount:50];
+    XCTAssertEqual([self.compressor compressBodyOfRequest:request], CLXContentEncodingIdentity);
+
+    NSMutableURLRequest *otherHost = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://winloss.example.com/"]];
+    otherHost.HTTPBody = [self _bulkBodyWithEventCount:50];
+    XCTAssertEqual([self.compressor compressBodyOfRequest:otherHost], CLXContentEncodingDeflate);
+}
+
+- (void)testAppliesMetricsConfig {
+    CLXMetricsConfig *config = [CLXMetricsConfig fromDictionary:@{@"bulk_compression.encoding": @"GZIP",
+                                                                  @"bulk_compression.min_bytes": @2048}];
+    XCTAssertEqualObjects([config bulkContentEncoding], @"gzip");
+
+    [self.compressor applyMetricsConfig:config];
+    XCTAssertEqual(self.compressor.encoding, CLXContentEncodingGzip);
+    XCTAssertEqual(self.compressor.minimumBodyBytes, 2048u);
+
+    [self.compressor applyMetricsConfig:[CLXMetricsConfig fromDictionary:@{@"bulk_compression.encoding": @"br"}]];
+    XCTAssertEqual(self.compressor.encoding, CLXContentEncodingIdentity);
+    XCTAssertEqual(self.compressor.minimumBodyBytes, CLXRequestCompressorDefaultMinimumBodyBytes);
+}
+
+#pragma mark - Fallback
+
+- (void)testBulkApiResendsUncompressedWhenServerRejectsEncoding {
+    CLXLocalHTTPServer *server = [[CLXLocalHTTPServer alloc] init];
+    XCTAssertTrue([server start]);
+    server.responseStatusCode = 415;
+
+    CLXRequestCompressor *shared = [CLXRequestCompressor shared];
+    shared.encoding = CLXContentEncodingGzip;
+    shared.minimumBodyBytes = 1;
+
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSInteger i = 0; i < 20; i++) {
+        [items addObject:[[CLXEventAM alloc] initWithImpression:@"aW1wcmVzc2lvbg==" campaignId:@"Y2FtcGFpZ24=" eventValue:@"N/A" eventName:@"SDK_METRICS" type:@"SDK_METRICS"]];
+    }
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"bulk send"];
+    CLXEventTrackerBulkApiImpl *api = [[CLXEventTrackerBulkApiImpl alloc] initWithTimeoutMillis:5000];
+    NSString *endpoint = [server.baseURL URLByAppendingPathComponent:@"bulk"].absoluteString;
+    [api sendToEndpoint:endpoint items:items completion:^(BOOL success, NSError * _Nullable error) {
+        XCTAssertFalse(success);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    // The compressed attempt and one uncompressed resend
+    XCTAssertEqual(server.servedRequestCount, 2);
+    XCTAssertTrue([shared hasHostRejectedCompression:@"127.0.0.1"]);
+    [server stop];
+}
+
+#pragma mark - Benchmark
+
+// Bytes on the wire per batch, logged for comparison across payload shapes
+- (void)testBytesOnWirePerBatch {
+    for (NSNumber *count in @[@10, @50, @200]) {
+        NSData *body = [self _bulkBodyWithEventCount:count.unsignedIntegerValue];
+        NSData *gzip = [CLXRequestCompressor compressData:body encoding:CLXContentEncodingGzip];
+        NSData *deflate = [CLXRequestCompressor compressData:body encoding:CLXContentEncodingDeflate];
+        NSLog(@"📊 %@ events: identity %lu B, gzip %lu B (%.0f%%), deflate %lu B (%.0f%%)",
+              count, (unsigned long)body.length,
+              (unsigned long)gzip.length, 100.0 * gzip.length / body.length,
+              (unsigned long)deflate.length, 100.0 * deflate.length / body.length);
+        XCTAssertLessThan(gzip.length, body.length);
+        XCTAssertLessThan(deflate.length, gzip.length, @"deflate skips the gzip header and trailer");
+    }
+}
+
+// CPU spent compressing one 200-event batch
+- (void)testCompressionCPUPerBatch {
+    NSData *body = [self _bulkBodyWithEventCount:200];
+    [self measureWithMetrics:@[[[XCTCPUMetric alloc] init], [[XCTClockMetric alloc] init]] block:^{
+        for (NSInteger i = 0; i < 10; i++) {
+            @autoreleasepool {
+                [CLXRequestCompressor compressData:body encoding:CLXContentEncodingGzip];
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXRetryBudgetTests.m
+ * @brief Tests for jittered backoff, the shared retry budget and the per-host circuit breakers
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import <CloudXCore/CLXRetryBudget.h>
+#import <CloudXCore/CLXEventTrackerBulkApi.h>
+#import <CloudXCore/CLXEventAM.h>
+#import "CLXLocalHTTPServer.h"
+
+@interface CLXRetryBudgetMockTask : NSObject
+- (void)resume;
+@end
+
+@implementation CLXRetryBudgetMockTask
+- (void)resume {
+}
+@end
+
+static NSString *const kCLXRetryBudgetTestHost = @"test.cloudx.io";
+
+// Answers with the queued status codes, then 200, and records when each request came.
+// With connectionError set, every request fails with it and gets no response.
+@interface CLXRetryBudgetMockSession : NSURLSession
+@property (atomic, strong) NSMutableArray<NSNumber *> *statusCodes;
+@property (atomic, strong, nullable) NSError *connectionError;
+@property (atomic, copy) NSDictionary<NSString *, NSString *> *failureHeaders;
+@property (atomic, strong) NSMutableArray<NSDate *> *requestDates;
+@end
+
+@implementation CLXRetryBudgetMockSession
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _statusCodes = [NSMutableArray array];
+        _requestDates = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                            completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
+    NSInteger statusCode = 200;
+    @synchronized (self) {
+        [self.requestDates addObject:[NSDate date]];
+        if (self.statusCodes.count > 0) {
+            statusCode = self.statusCodes.firstObject.integerValue;
+            [self.statusCodes removeObjectAtIndex:0];
+        }
+    }
+    NSError *connectionError = self.connectionError;
+    if (connectionError) {
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            completionHandler(nil, nil, connectionError);
+        });
+        return (NSURLSessionDataTask *)[[CLXRetryBudgetMockTask alloc] init];
+    }
+    NSDictionary *headers = statusCode == 200 ? @{} : (self.failureHeaders ?: @{});
+    NSHTTPURLResponse *httpResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        completionHandler(nil, httpResponse, nil);
+    });
+    return (NSURLSessionDataTask *)[[CLXRetryBudgetMockTask alloc] init];
+}
+
+@end
+
+@interface CLXRetryBudgetTests : XCTestCase
+@property (nonatomic, strong) CLXRetryBudget *budget;
+@property (atomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXRetryBudgetTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 100;
+    self.budget = [[CLXRetryBudget alloc] init];
+    __weak typeof(self) weakSelf = self;
+    self.budget.clockForTesting = ^NSTimeInterval{
+        return weakSelf.now;
+    };
+}
+
+#pragma mark - Helpers
+
+// Random source replaying values in order, repeating the last
+- (double (^)(void))_randomSourceWithValues:(NSArray<NSNumber *> *)values {
+    __block NSUInteger index = 0;
+    return ^double{
+        double value = values[MIN(index, values.count - 1)].doubleValue;
+        index += 1;
+        return value;
+    };
+}
+
+- (NSError *)_sendWithService:(CLXBaseNetworkService *)service maxRetries:(NSInteger)maxRetries delay:(NSTimeInterval)delay {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    __block NSError *resultError = nil;
+    [service executeRequestWithEndpoint:@""
+                          urlParameters:nil
+                            requestBody:[@"{}" dataUsingEncoding:NSUTF8StringEncoding]
+                                headers:nil
+                             maxRetries:maxRetries
+                                  delay:delay
+                             completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
+        resultError = error;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    return resultError;
+}
+
+- (CLXBaseNetworkService *)_serviceWithSession:(NSURLSession *)session {
+    CLXBaseNetworkService *service = [[CLXBaseNetworkService alloc] initWithBaseURL:@"https://test.cloudx.io/auction" urlSession:session];
+    service.retryBudget = self.budget;
+    service.randomSourceForTesting = [self _randomSourceWithValues:@[@0]];
+    return service;
+}
+
+#pragma mark - Jitter
+
+- (void)testDecorrelatedDelayStaysBetweenBaseAndThreeTimesPrevious {
+    XCTAssertEqualWithAccuracy([CLXExponentialBackoffStrategy decorrelatedDelayAfter:4 baseDelay:1 maxDelay:60 unit:0], 1, 1e-9);
+    XCTAssertEqualWithAccuracy([CLXExponentialBackoffStrategy decorrelatedDelayAfter:4 baseDelay:1 maxDelay:60 unit:0.5], 6.5, 1e-9);
+    XCTAssertEqualWithAccuracy([CLXExponentialBackoffStrategy decorrelatedDelayAfter:4 baseDelay:1 maxDelay:10 unit:0.99], 10, 1e-9);
+
+    for (NSInteger i = 0; i < 1000; i++) {
+        double unit = [CLXExponentialBackoffStrategy randomUnit];
+        XCTAssertGreaterThanOrEqual(unit, 0.0);
+        XCTAssertLessThan(unit, 1.0);
+    }
+}
+
+- (void)testStrategyGrowsFromPreviousDelayAndResets {
+    CLXExponentialBackoffStrategy *strategy = [[CLXExponentialBackoffStrategy alloc] initWithInitialDelay:1 maxDelay:20];
+    strategy.randomSourceForTesting = [self _randomSourceWithValues:@[@1.0, @1.0, @1.0, @0.1]];
+
+    XCTAssertEqual([strategy nextDelayWithError:nil], 0, @"First attempt goes without delay");
+    XCTAssertEqualWithAccuracy([strategy nextDelayWithError:nil], 3, 1e-9);
+    XCTAssertEqualWithAccuracy([strategy nextDelayWithError:nil], 9, 1e-9);
+    XCTAssertEqualWithAccuracy([strategy nextDelayWithError:nil], 20, 1e-9, @"Capped at max delay");
+    XCTAssertEqualWithAccuracy([strategy nextDelayWithError:nil], 1 + 0.1 * (60 - 1), 1e-9, @"Grows from the capped previous delay");
+
+    [strategy reset];
+    strategy.randomSourceForTesting = [self _randomSourceWithValues:@[@1.0]];
+    XCTAssertEqual([strategy nextDelayWithError:nil], 0);
+    XCTAssertEqualWithAccuracy([strategy nextDelayWithError:nil], 3, 1e-9);
+}
+
+- (void)testDevicesThatFailTogetherSpreadOut {
+    NSMutableSet<NSNumber *> *delays = [NSMutableSet set];
+    for (NSInteger device = 0; device < 20; device++) {
+        CLXExponentialBackoffStrategy *strategy = [[CLXExponentialBackoffStrategy alloc] initWithInitialDelay:1 maxDelay:60];
+        [strategy nextDelayWithError:nil];
+        [delays addObject:@([strategy nextDelayWithError:nil])];
+    }
+    XCTAssertGreaterThan(delays.count, 10u, @"Retries are not in lockstep");
+}
+
+#pragma mark - Budget
+
+- (void)testBudgetDrainsAndRefillsOverTime {
+    self.budget.capacity = 3;
+    self.budget.refillPerSecond = 0.5;
+    [self.budget reset];
+
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+
+    self.now += 2.0;
+    XCTAssertEqualWithAccuracy(self.budget.availableTokens, 1.0, 1e-9);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+}
+
+- (void)testSuccessesEarnRetries {
+    self.budget.capacity = 1;
+    self.budget.refillPerSecond = 0;
+    self.budget.successDeposit = 0.25;
+    [self.budget reset];
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+
+    for (NSInteger i = 0; i < 4; i++) {
+        [self.budget recordSuccessForHost:kCLXRetryBudgetTestHost];
+    }
+    XCTAssertEqualWithAccuracy(self.budget.availableTokens, 1.0, 1e-9);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+}
+
+#pragma mark - Circuit Breaker
+
+- (void)testCircuitOpensAfterConsecutiveFailuresAndProbes {
+    self.budget.failureThreshold = 3;
+    self.budget.openInterval = 30;
+
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    [self.budget recordSuccessForHost:kCLXRetryBudgetTestHost];
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateClosed, @"A success resets the run");
+
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateOpen);
+    XCTAssertFalse([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+
+    self.now += 30;
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateHalfOpen);
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost], @"One probe");
+    XCTAssertFalse([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+
+    [self.budget recordSuccessForHost:kCLXRetryBudgetTestHost];
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateClosed);
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+}
+
+- (void)testFailedProbeReopensForRetryAfter {
+    self.budget.failureThreshold = 1;
+    self.budget.openInterval = 30;
+
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    self.now += 30;
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:45];
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateOpen);
+
+    self.now += 44;
+    XCTAssertFalse([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost], @"The server's Retry-After outlasts the cooldown");
+    self.now += 1;
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+}
+
+- (void)testAbandonedProbeFreesItsSlot {
+    self.budget.failureThreshold = 1;
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    self.now += self.budget.openInterval;
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+
+    self.now += self.budget.openInterval;
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+}
+
+- (void)testCircuitsAreKeptPerHostAndShareTheBucket {
+    self.budget.failureThreshold = 1;
+    self.budget.capacity = 2;
+    [self.budget reset];
+
+    [self.budget recordFailureForHost:@"Metrics.CloudX.io" retryAfter:0];
+    XCTAssertEqual([self.budget circuitStateForHost:@"metrics.cloudx.io"], CLXCircuitStateOpen);
+    XCTAssertFalse([self.budget shouldAllowRequestToHost:@"metrics.cloudx.io"]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:@"metrics.cloudx.io"]);
+
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateClosed);
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost]);
+    XCTAssertTrue([self.budget tryAcquireRetryForHost:nil]);
+    XCTAssertFalse([self.budget tryAcquireRetryForHost:kCLXRetryBudgetTestHost], @"Retries to every host spend one bucket");
+}
+
+#pragma mark - Network Service
+
+- (void)testRetryAfterIsHonoredOn503 {
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    [session.statusCodes addObject:@503];
+    session.failureHeaders = @{@"Retry-After": @"1"};
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:1 delay:0.05];
+
+    XCTAssertNil(error);
+    XCTAssertEqual(session.requestDates.count, 2u);
+    XCTAssertGreaterThanOrEqual([session.requestDates[1] timeIntervalSinceDate:session.requestDates[0]], 0.9,
+                                @"Waited for Retry-After rather than the 50ms jitter floor");
+}
+
+- (void)testRetryWaitsForJitteredDelay {
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    [session.statusCodes addObjectsFromArray:@[@500, @500]];
+    CLXBaseNetworkService *service = [self _serviceWithSession:session];
+    service.randomSourceForTesting = [self _randomSourceWithValues:@[@0.0, @1.0]];
+
+    NSError *error = [self _sendWithService:service maxRetries:2 delay:0.1];
+
+    XCTAssertNil(error);
+    XCTAssertEqual(session.requestDates.count, 3u);
+    NSTimeInterval first = [session.requestDates[1] timeIntervalSinceDate:session.requestDates[0]];
+    NSTimeInterval second = [session.requestDates[2] timeIntervalSinceDate:session.requestDates[1]];
+    XCTAssertGreaterThanOrEqual(first, 0.09);
+    XCTAssertLessThan(first, 0.25);
+    XCTAssertGreaterThanOrEqual(second, 0.29, @"Second delay drawn up to three times the first");
+}
+
+- (void)testSpentBudgetStopsRetries {
+    self.budget.capacity = 0;
+    [self.budget reset];
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    [session.statusCodes addObject:@503];
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:1 delay:0.05];
+
+    XCTAssertNotNil(error);
+    XCTAssertEqual(session.requestDates.count, 1u);
+}
+
+- (void)testOpenCircuitSendsNothing {
+    self.budget.failureThreshold = 1;
+    [self.budget recordFailureForHost:kCLXRetryBudgetTestHost retryAfter:0];
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:1 delay:0.05];
+
+    XCTAssertEqual(error.code, CLXErrorCodeServiceUnavailable);
+    XCTAssertEqual(session.requestDates.count, 0u);
+}
+
+- (void)testOpenCircuitOnlyStopsItsHost {
+    self.budget.failureThreshold = 1;
+    [self.budget recordFailureForHost:@"other.cloudx.io" retryAfter:0];
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:1 delay:0.05];
+
+    XCTAssertNil(error);
+    XCTAssertEqual(session.requestDates.count, 1u);
+}
+
+- (void)testOverloadAnswersOpenTheCircuit {
+    self.budget.failureThreshold = 2;
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    [session.statusCodes addObjectsFromArray:@[@503, @429]];
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:1 delay:0.05];
+
+    XCTAssertNotNil(error);
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateOpen);
+}
+
+- (void)testConnectivityErrorsDoNotOpenTheCircuit {
+    self.budget.failureThreshold = 1;
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    session.connectionError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil];
+
+    NSError *error = [self _sendWithService:[self _serviceWithSession:session] maxRetries:2 delay:0.05];
+
+    XCTAssertNotNil(error);
+    XCTAssertEqual(session.requestDates.count, 3u);
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateClosed);
+}
+
+- (void)testTimeoutsDoNotOpenTheCircuit {
+    self.budget.failureThreshold = 1;
+    CLXRetryBudgetMockSession *session = [[CLXRetryBudgetMockSession alloc] init];
+    session.connectionError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+
+    [self _sendWithService:[self _serviceWithSession:session] maxRetries:0 delay:0.05];
+
+    XCTAssertEqual([self.budget circuitStateForHost:kCLXRetryBudgetTestHost], CLXCircuitStateClosed);
+    XCTAssertTrue([self.budget shouldAllowRequestToHost:kCLXRetryBudgetTestHost]);
+}
+
+#pragma mark - Metrics Uploads
+
+- (BOOL)_uploadMetricsWithApi:(CLXEventTrackerBulkApiImpl *)api toServer:(CLXLocalHTTPServer *)server error:(NSError **)error {
+    CLXEventAM *event = [[CLXEventAM alloc] initWithImpression:@"aW1wcmVzc2lvbg==" campaignId:@"Y2FtcGFpZ24=" eventValue:@"N/A" eventName:@"SDK_METRICS" type:@"SDK_METRICS"];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    __block BOOL result = NO;
+    __block NSError *resultError = nil;
+    [api sendToEndpoint:[server.baseURL URLByAppendingPathComponent:@"metrics"].absoluteString items:@[event] completion:^(BOOL success, NSError * _Nullable uploadError) {
+        result = success;
+        resultError = uploadError;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    if (error) {
+        *error = resultError;
+    }
+    return result;
+}
+
+- (void)testMetricsUploadsOpenAndRespectTheHostCircuit {
+    CLXLocalHTTPServer *server = [[CLXLocalHTTPServer alloc] init];
+    XCTAssertTrue([server start]);
+    server.responseStatusCode = 503;
+    self.budget.failureThreshold = 2;
+    CLXEventTrackerBulkApiImpl *api = [[CLXEventTrackerBulkApiImpl alloc] initWithTimeoutMillis:5000];
+    api.retryBudget = self.budget;
+    NSString *host = server.baseURL.host;
+
+    XCTAssertFalse([self _uploadMetricsWithApi:api toServer:server error:nil]);
+    XCTAssertFalse([self _uploadMetricsWithApi:api toServer:server error:nil]);
+    XCTAssertEqual([self.budget circuitStateForHost:host], CLXCircuitStateOpen);
+
+    // Batches stay on the device until the cooldown ends
+    NSError *error = nil;
+    XCTAssertFalse([self _uploadMetricsWithApi:api toServer:server error:&error]);
+    XCTAssertEqual(error.code, CLXErrorCodeServiceUnavailable);
+    XCTAssertEqual(server.servedRequestCount, 2);
+
+    // The probe after the cooldown closes the circuit again
+    server.responseStatusCode = 200;
+    self.now += self.budget.openInterval + 1;
+    XCTAssertTrue([self _uploadMetricsWithApi:api toServer:server error:nil]);
+    XCTAssertEqual(server.servedRequestCount, 3);
+    XCTAssertEqual([self.budget circuitStateForHost:host], CLXCircuitStateClosed);
+    [server stop];
+}
+
+@end
@@ -17,6 +17,7 @@
 @interface CLXSQLiteDatabase (Testing)
 @property (nonatomic, assign, readonly) sqlite3 *database;
 @property (nonatomic, strong, readonly) dispatch_queue_t databaseQueue;
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, NSValue *> *statementCache;
 - (NSString *)databasePath;
 @end
 
@@ -38,7 +39,9 @@
     
     // Clean up test database file
     NSString *dbPath = [self.database databasePath];
-    [[NSFileManager defaultManager] removeItemAtPath:dbPath error:nil];
+    for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+        [[NSFileManager defaultManager] removeItemAtPath:[dbPath stringByAppendingString:suffix] error:nil];
+    }
     
     self.database = nil;
     self.testDatabaseName = nil;
@@ -207,6 +210,55 @@
     XCTAssertEqual([results[0][@"count"] integerValue], 3, @"Should have all three records");
 }
 
+/**
+ * Test that a failed statement in a joined transaction fails the joined call and rolls back the outer one
+ */
+- (void)testTransaction_JoinedFailure_ShouldReachOuterCaller {
+    XCTAssertTrue([self.database executeSQL:@"CREATE TABLE joined_test (id INTEGER PRIMARY KEY);"]);
+    
+    __block BOOL joinedResult = YES;
+    BOOL outerResult = [self.database executeInTransaction:^{
+        [self.database executeSQL:@"INSERT INTO joined_test (id) VALUES (1);"];
+        joinedResult = [self.database executeInTransaction:^{
+            [self.database executeSQL:@"INSERT INTO missing_table (id) VALUES (2);"];
+        }];
+    }];
+    
+    XCTAssertFalse(joinedResult, @"Joined call should report its failed statement");
+    XCTAssertFalse(outerResult, @"Outer transaction should fail with the joined one");
+    NSArray *results = [self.database executeQuery:@"SELECT COUNT(*) as count FROM joined_test;"];
+    XCTAssertEqual([results[0][@"count"] integerValue], 0, @"Outer transaction should be rolled back");
+    
+    // The next transaction starts clean
+    XCTAssertTrue([self.database executeInTransaction:^{
+        [self.database executeSQL:@"INSERT INTO joined_test (id) VALUES (3);"];
+    }]);
+}
+
+/**
+ * Test deleting more rows than fit in one IN (...) list, without caching the odd-sized tail statement
+ */
+- (void)testDeleteFromTable_ManyValues_ShouldDeleteInChunks {
+    XCTAssertTrue([self.database executeSQL:@"CREATE TABLE chunk_test (id TEXT PRIMARY KEY);"]);
+    NSMutableArray<NSString *> *ids = [NSMutableArray array];
+    [self.database executeInTransaction:^{
+        for (NSInteger i = 0; i < 500; i++) {
+            NSString *rowId = [NSString stringWithFormat:@"row-%ld", (long)i];
+            [ids addObject:rowId];
+            [self.database executeSQL:@"INSERT INTO chunk_test (id) VALUES (?);" withParameters:@[rowId]];
+        }
+    }];
+    NSUInteger cachedBefore = self.database.statementCache.count;
+    
+    XCTAssertTrue([self.database deleteFromTable:@"chunk_test" whereColumn:@"id" inValues:[ids subarrayWithRange:NSMakeRange(0, 450)]]);
+    
+    NSArray *results = [self.database executeQuery:@"SELECT COUNT(*) as count FROM chunk_test;"];
+    XCTAssertEqual([results[0][@"count"] integerValue], 50);
+    XCTAssertLessThanOrEqual(self.database.statementCache.count, cachedBefore + 1,
+                             @"Only the full-chunk statement should be cached");
+    XCTAssertTrue([self.database deleteFromTable:@"chunk_test" whereColumn:@"id" inValues:@[]]);
+}
+
 #pragma mark - Concurrent Access Tests
 
 /**
@@ -410,6 +462,175 @@
     XCTAssertTrue([self.database tableExists:@"Test_Exists"]);
 }
 
+#pragma mark - Configuration Tests
+
+/**
+ * Test that the default configuration opens the database in WAL mode with tuned pragmas
+ */
+- (void)testConfiguration_Default_ShouldUseWALAndTunedPragmas {
+    NSArray *journal = [self.database executeQuery:@"PRAGMA journal_mode;"];
+    XCTAssertEqualObjects([journal[0][@"journal_mode"] lowercaseString], @"wal");
+    
+    NSArray *synchronous = [self.database executeQuery:@"PRAGMA synchronous;"];
+    XCTAssertEqual([synchronous[0][@"synchronous"] integerValue], 1, @"synchronous should be NORMAL");
+    
+    NSArray *tempStore = [self.database executeQuery:@"PRAGMA temp_store;"];
+    XCTAssertEqual([tempStore[0][@"temp_store"] integerValue], 2, @"temp_store should be MEMORY");
+    
+    NSArray *cacheSize = [self.database executeQuery:@"PRAGMA cache_size;"];
+    XCTAssertEqual([cacheSize[0][@"cache_size"] integerValue], -512);
+}
+
+/**
+ * Test that the legacy configuration keeps SQLite's rollback journal defaults
+ */
+- (void)testConfiguration_Legacy_ShouldKeepRollbackJournal {
+    NSString *name = [NSString stringWithFormat:@"legacy_config_%@", [[NSUUID UUID] UUIDString]];
+    CLXSQLiteDatabase *legacyDb = [[CLXSQLiteDatabase alloc] initWithDatabaseName:name
+                                                                    configuration:[CLXSQLiteDatabaseConfiguration legacyConfiguration]];
+    
+    NSArray *journal = [legacyDb executeQuery:@"PRAGMA journal_mode;"];
+    XCTAssertEqualObjects([journal[0][@"journal_mode"] lowercaseString], @"delete");
+    
+    [legacyDb closeDatabase];
+    [[NSFileManager defaultManager] removeItemAtPath:[legacyDb databasePath] error:nil];
+}
+
+/**
+ * Test moving a table from a standalone legacy file into a shared database
+ */
+- (void)testImportTable_LegacyDatabase_ShouldMoveRowsAndRemoveFile {
+    NSString *legacyName = [NSString stringWithFormat:@"legacy_store_%@", [[NSUUID UUID] UUIDString]];
+    CLXSQLiteDatabase *legacyDb = [[CLXSQLiteDatabase alloc] initWithDatabaseName:legacyName
+                                                                    configuration:[CLXSQLiteDatabaseConfiguration legacyConfiguration]];
+    [legacyDb executeSQL:@"CREATE TABLE import_test (id TEXT PRIMARY KEY, payload TEXT);"];
+    [legacyDb executeSQL:@"INSERT INTO import_test (id, payload) VALUES (?, ?);" withParameters:@[@"a", @"one"]];
+    [legacyDb executeSQL:@"INSERT INTO import_test (id, payload) VALUES (?, ?);" withParameters:@[@"b", @"two"]];
+    NSString *legacyPath = [legacyDb databasePath];
+    [legacyDb closeDatabase];
+    
+    [self.database executeSQL:@"CREATE TABLE import_test (id TEXT PRIMARY KEY, payload TEXT);"];
+    [self.database executeSQL:@"INSERT INTO import_test (id, payload) VALUES (?, ?);" withParameters:@[@"a", @"existing"]];
+    
+    XCTAssertTrue([self.database importTable:@"import_test" fromLegacyDatabaseNamed:legacyName]);
+    
+    NSArray *rows = [self.database executeQuery:@"SELECT * FROM import_test ORDER BY id;"];
+    XCTAssertEqual(rows.count, 2);
+    XCTAssertEqualObjects(rows[0][@"payload"], @"existing", @"Existing rows should win over imported duplicates");
+    XCTAssertEqualObjects(rows[1][@"payload"], @"two");
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:legacyPath], @"Legacy file should be removed once empty");
+    
+    // Nothing left to import
+    XCTAssertFalse([self.database importTable:@"import_test" fromLegacyDatabaseNamed:legacyName]);
+}
+
+/**
+ * Test importing a metrics table written before latencyHistogram was added into the current schema
+ */
+- (void)testImportTable_LegacyMetricsSchema_ShouldCopySharedColumns {
+    NSString *legacyName = [NSString stringWithFormat:@"legacy_metrics_%@", [[NSUUID UUID] UUIDString]];
+    CLXSQLiteDatabase *legacyDb = [[CLXSQLiteDatabase alloc] initWithDatabaseName:legacyName
+                                                                    configuration:[CLXSQLiteDatabaseConfiguration legacyConfiguration]];
+    [legacyDb executeSQL:@"CREATE TABLE metrics_event_table (id TEXT PRIMARY KEY, metricName TEXT NOT NULL, counter INTEGER DEFAULT 0, "
+                         @"totalLatency INTEGER DEFAULT 0, sessionId TEXT NOT NULL, auctionId TEXT NOT NULL);"];
+    [legacyDb executeSQL:@"INSERT INTO metrics_event_table (id, metricName, counter, totalLatency, sessionId, auctionId) VALUES (?, ?, ?, ?, ?, ?);"
+          withParameters:@[@"legacy-id", @"network_call_bid_req", @3, @450, @"session", @"auction"]];
+    NSString *legacyPath = [legacyDb databasePath];
+    [legacyDb closeDatabase];
+    
+    CLXMetricsEventDao *dao = [[CLXMetricsEventDao alloc] initWithDatabase:self.database];
+    
+    XCTAssertTrue([self.database importTable:@"metrics_event_table" fromLegacyDatabaseNamed:legacyName]);
+    
+    CLXMetricsEvent *event = [dao getAllByMetric:@"network_call_bid_req"];
+    XCTAssertNotNil(event, @"Legacy row should be imported despite the added column");
+    XCTAssertEqual(event.counter, 3);
+    XCTAssertEqual(event.totalLatency, 450);
+    NSArray *rows = [self.database executeQuery:@"SELECT latencyHistogram FROM metrics_event_table WHERE id = ?;" withParameters:@[@"legacy-id"]];
+    XCTAssertEqualObjects(rows.firstObject[@"latencyHistogram"], @"", @"Columns missing from the legacy table should take their defaults");
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:legacyPath], @"Legacy file should be removed after a successful import");
+}
+
+#pragma mark - Statement Cache Tests
+
+/**
+ * Test that repeated SQL reuses a single cached statement with fresh bindings each time
+ */
+- (void)testStatementCache_RepeatedSQL_ShouldReuseStatementWithFreshBindings {
+    BOOL created = [self.database executeSQL:@"CREATE TABLE cache_test (id INTEGER PRIMARY KEY, name TEXT);"];
+    XCTAssertTrue(created);
+    
+    NSString *insertSQL = @"INSERT INTO cache_test (id, name) VALUES (?, ?);";
+    XCTAssertTrue([self.database executeSQL:insertSQL withParameters:@[@1, @"first"]]);
+    NSValue *firstStatement = self.database.statementCache[insertSQL];
+    XCTAssertNotNil(firstStatement, @"Statement should be cached after first use");
+    
+    // Fewer parameters than placeholders - cleared bindings must leave the column NULL
+    XCTAssertTrue([self.database executeSQL:insertSQL withParameters:@[@2]]);
+    XCTAssertEqualObjects(self.database.statementCache[insertSQL], firstStatement, @"Same statement handle should be reused");
+    
+    NSArray *rows = [self.database executeQuery:@"SELECT name FROM cache_test WHERE id = ?;" withParameters:@[@2]];
+    XCTAssertEqual(rows.count, 1);
+    XCTAssertTrue([rows[0][@"name"] isKindOfClass:[NSNull class]], @"Bindings from previous use should be cleared");
+    
+    // Re-running a cached query must not leak rows from the previous execution
+    NSArray *first = [self.database executeQuery:@"SELECT name FROM cache_test WHERE id = ?;" withParameters:@[@1]];
+    XCTAssertEqual(first.count, 1);
+    XCTAssertEqualObjects(first[0][@"name"], @"first");
+}
+
+/**
+ * Test that the cache never holds more statements than its capacity
+ */
+- (void)testStatementCache_Capacity_ShouldEvictLeastRecentlyUsed {
+    self.database.statementCacheCapacity = 4;
+    [self.database executeSQL:@"CREATE TABLE evict_test (id INTEGER);"];
+    
+    for (NSInteger i = 0; i < 10; i++) {
+        NSString *sql = [NSString stringWithFormat:@"SELECT id FROM evict_test WHERE id = %ld;", (long)i];
+        [self.database executeQuery:sql];
+    }
+    
+    XCTAssertEqual(self.database.statementCache.count, 4, @"Cache should be bounded by its capacity");
+    XCTAssertNotNil(self.database.statementCache[@"SELECT id FROM evict_test WHERE id = 9;"]);
+    XCTAssertNil(self.database.statementCache[@"SELECT id FROM evict_test WHERE id = 0;"]);
+    
+    self.database.statementCacheCapacity = 0;
+    XCTAssertEqual(self.database.statementCache.count, 0, @"Disabling the cache should finalize cached statements");
+    XCTAssertEqual([self.database executeQuery:@"SELECT id FROM evict_test;"].count, 0);
+    XCTAssertEqual(self.database.statementCache.count, 0);
+}
+
+/**
+ * Benchmark: per-op cost of the metrics upsert without the statement cache (baseline)
+ */
+- (void)testStatementCachePerformance_Disabled {
+    self.database.statementCacheCapacity = 0;
+    [self _measureMetricsUpsertLoop];
+}
+
+/**
+ * Benchmark: per-op cost of the metrics upsert with the statement cache
+ */
+- (void)testStatementCachePerformance_Enabled {
+    [self _measureMetricsUpsertLoop];
+}
+
+- (void)_measureMetricsUpsertLoop {
+    [self.database executeSQL:@"CREATE TABLE bench_metrics (id TEXT PRIMARY KEY, metricName TEXT, counter INTEGER);"];
+    NSString *upsertSQL = @"INSERT OR REPLACE INTO bench_metrics (id, metricName, counter) VALUES (?, ?, ?);";
+    NSString *selectSQL = @"SELECT * FROM bench_metrics WHERE metricName = ? LIMIT 1;";
+    
+    [self measureBlock:^{
+        [self.database executeInTransaction:^{
+            for (NSInteger i = 0; i < 1000; i++) {
+                [self.database executeQuery:selectSQL withParameters:@[@"method_create_banner"]];
+                [self.database executeSQL:upsertSQL withParameters:@[@"metric-id", @"method_create_banner", @(i)]];
+            }
+        }];
+    }];
+}
+
 #pragma mark - Resource Management Tests
 
 /**
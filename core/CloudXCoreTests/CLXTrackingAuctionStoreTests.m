@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+static const NSInteger kCLXRefreshCycles = 10000;
+
+@interface CLXTrackingAuctionStoreTests : XCTestCase
+@property (nonatomic, strong) CLXTrackingAuctionStore *store;
+@property (nonatomic, assign) NSTimeInterval now;
+@end
+
+@implementation CLXTrackingAuctionStoreTests
+
+- (void)setUp {
+    [super setUp];
+    self.now = 1000;
+    self.store = [[CLXTrackingAuctionStore alloc] init];
+    __weak typeof(self) weakSelf = self;
+    self.store.clockForTesting = ^NSTimeInterval{
+        return weakSelf.now;
+    };
+}
+
+- (NSDictionary *)_bidRequestForAuction:(NSString *)auctionId {
+    return @{@"id": auctionId,
+             @"imp": @[@{@"id": @"imp-1", @"tagid": @"placement-1"}],
+             @"device": @{@"model": @"iPhone", @"os": @"iOS"}};
+}
+
+- (NSDictionary *)_bidResponseForAuction:(NSString *)auctionId {
+    return @{@"id": auctionId,
+             @"seatbid": @[@{@"bid": @[@{@"id": @"bid-1", @"impid": @"imp-1", @"price": @1.5,
+                                          @"adm": @"<html><body>creative</body></html>"}]}]};
+}
+
+#pragma mark - Tests
+
+- (void)testEvictsLeastRecentlyUsedAuctionOverCapacity {
+    self.store.capacity = 3;
+    [self.store setLoopIndex:0 forAuction:@"a1"];
+    [self.store setLoopIndex:0 forAuction:@"a2"];
+    [self.store setLoopIndex:0 forAuction:@"a3"];
+
+    // Reading a1 makes a2 the least recently used
+    XCTAssertNotNil([self.store entryForAuction:@"a1"]);
+    [self.store setLoopIndex:0 forAuction:@"a4"];
+
+    XCTAssertEqual(self.store.liveAuctionCount, 3);
+    XCTAssertEqual(self.store.evictedAuctionCount, 1);
+    XCTAssertNil([self.store entryForAuction:@"a2"]);
+    XCTAssertNotNil([self.store entryForAuction:@"a1"]);
+    XCTAssertNotNil([self.store entryForAuction:@"a4"]);
+}
+
+- (void)testExpiresAuctionAfterTimeToLiveWithoutAccess {
+    self.store.timeToLive = 60;
+    [self.store setLoadedBidId:@"bid-1" forAuction:@"a1"];
+
+    self.now += 59;
+    XCTAssertEqualObjects([self.store entryForAuction:@"a1"].loadedBidId, @"bid-1");
+
+    // Access refreshed the entry, so it survives another 59 seconds
+    self.now += 59;
+    XCTAssertNotNil([self.store entryForAuction:@"a1"]);
+
+    self.now += 60;
+    XCTAssertNil([self.store entryForAuction:@"a1"]);
+    XCTAssertEqual(self.store.liveAuctionCount, 0);
+}
+
+- (void)testRetiredAuctionStaysReadableForGracePeriod {
+    self.store.retirementGracePeriod = 30;
+    [self.store setRequestData:[self _bidRequestForAuction:@"a1"] forAuction:@"a1"];
+    [self.store retireAuction:@"a1"];
+
+    self.now += 29;
+    XCTAssertNotNil([self.store entryForAuction:@"a1"].requestData);
+
+    // Reads during the grace period do not postpone retirement
+    self.now += 1;
+    XCTAssertNil([self.store entryForAuction:@"a1"]);
+    XCTAssertEqual(self.store.retainedBytes, 0);
+}
+
+- (void)testPinnedAuctionOutlivesTimeToLiveAndEviction {
+    self.store.capacity = 2;
+    self.store.timeToLive = 60;
+    [self.store pinAuction:@"cached"];
+    [self.store setLoadedBidId:@"bid-1" forAuction:@"cached"];
+
+    self.now += 3600;
+    [self.store setLoopIndex:0 forAuction:@"a1"];
+    [self.store setLoopIndex:0 forAuction:@"a2"];
+    [self.store setLoopIndex:0 forAuction:@"a3"];
+
+    XCTAssertEqualObjects([self.store entryForAuction:@"cached"].loadedBidId, @"bid-1");
+    XCTAssertNil([self.store entryForAuction:@"a1"]);
+    XCTAssertNil([self.store entryForAuction:@"a2"]);
+    XCTAssertEqual(self.store.liveAuctionCount, 2);
+}
+
+- (void)testPinsAreCountedAndReleaseRestartsTheClock {
+    self.store.timeToLive = 60;
+    self.store.retirementGracePeriod = 30;
+    [self.store pinAuction:@"a1"];
+    [self.store pinAuction:@"a1"];
+    [self.store setRequestData:[self _bidRequestForAuction:@"a1"] forAuction:@"a1"];
+    [self.store retireAuction:@"a1"];
+
+    self.now += 3600;
+    [self.store unpinAuction:@"a1"];
+    XCTAssertTrue([self.store isAuctionPinned:@"a1"]);
+    XCTAssertNotNil([self.store entryForAuction:@"a1"]);
+
+    // The last release leaves the retired auction a full grace period for its win/loss payload
+    [self.store unpinAuction:@"a1"];
+    XCTAssertFalse([self.store isAuctionPinned:@"a1"]);
+    self.now += 29;
+    XCTAssertNotNil([self.store entryForAuction:@"a1"].requestData);
+    self.now += 1;
+    XCTAssertNil([self.store entryForAuction:@"a1"]);
+}
+
+- (void)testRetainedBytesTrackRequestAndResponseData {
+    XCTAssertEqual(self.store.retainedBytes, 0);
+
+    NSDictionary *request = [self _bidRequestForAuction:@"a1"];
+    NSDictionary *response = [self _bidResponseForAuction:@"a1"];
+    [self.store setRequestData:request forAuction:@"a1"];
+    [self.store setResponseData:response forAuction:@"a1"];
+
+    NSUInteger expected = [CLXTrackingAuctionStore estimatedBytesForJSONObject:request] +
+                          [CLXTrackingAuctionStore estimatedBytesForJSONObject:response];
+    XCTAssertGreaterThan(expected, 0);
+    XCTAssertEqual(self.store.retainedBytes, expected);
+    XCTAssertEqual([self.store entryForAuction:@"a1"].estimatedBytes, expected);
+
+    // Replacing data adjusts rather than accumulates
+    [self.store setResponseData:response forAuction:@"a1"];
+    XCTAssertEqual(self.store.retainedBytes, expected);
+
+    [self.store removeAuction:@"a1"];
+    XCTAssertEqual(self.store.retainedBytes, 0);
+}
+
+- (void)testResolverClearAuctionRetiresAuction {
+    CLXTrackingFieldResolver *resolver = [[CLXTrackingFieldResolver alloc] init];
+    resolver.auctionStore.clockForTesting = self.store.clockForTesting;
+    resolver.auctionStore.retirementGracePeriod = 10;
+
+    [resolver setLoopIndex:@"a1" loopIndex:3];
+    [resolver setRequestData:@"a1" bidRequestJSON:[self _bidRequestForAuction:@"a1"]];
+    XCTAssertEqual(resolver.liveAuctionCount, 1);
+    XCTAssertGreaterThan(resolver.retainedBytes, 0);
+
+    [resolver clearAuction:@"a1"];
+    XCTAssertEqualObjects([resolver resolveField:@"sdk.loopIndex" forAuction:@"a1"], @"3");
+
+    self.now += 10;
+    XCTAssertNil([resolver resolveField:@"sdk.loopIndex" forAuction:@"a1"]);
+    XCTAssertEqual(resolver.liveAuctionCount, 0);
+    XCTAssertEqual(resolver.retainedBytes, 0);
+}
+
+- (void)testMemoryStaysBoundedOverRefreshCycles {
+    CLXTrackingFieldResolver *resolver = [[CLXTrackingFieldResolver alloc] init];
+    resolver.auctionStore.clockForTesting = self.store.clockForTesting;
+    NSUInteger capacity = resolver.auctionStore.capacity;
+
+    NSUInteger perAuctionBytes = [CLXTrackingAuctionStore estimatedBytesForJSONObject:[self _bidRequestForAuction:@"auction-00000"]] +
+                                 [CLXTrackingAuctionStore estimatedBytesForJSONObject:[self _bidResponseForAuction:@"auction-00000"]];
+    NSUInteger peakBytes = 0;
+    NSUInteger peakAuctions = 0;
+
+    for (NSInteger i = 0; i < kCLXRefreshCycles; i++) {
+        @autoreleasepool {
+            // Banner refresh: auction, load, and only some impressions reach a win
+            NSString *auctionId = [NSString stringWithFormat:@"auction-%05ld", (long)i];
+            [resolver setLoopIndex:auctionId loopIndex:i];
+            [resolver setRequestData:auctionId bidRequestJSON:[self _bidRequestForAuction:auctionId]];
+            [resolver setResponseData:auctionId bidResponseJSON:[self _bidResponseForAuction:auctionId]];
+            [resolver saveLoadedBid:auctionId bidId:@"bid-1"];
+            [resolver buildPayload:auctionId];
+            if (i % 3 == 0) {
+                [resolver clearAuction:auctionId];
+            }
+            self.now += 1;
+
+            peakAuctions = MAX(peakAuctions, resolver.liveAuctionCount);
+            peakBytes = MAX(peakBytes, resolver.retainedBytes);
+        }
+    }
+
+    NSLog(@"📊 Tracking store after %ld refresh cycles - peak auctions: %lu, peak bytes: %lu, evicted: %lu",
+          (long)kCLXRefreshCycles, (unsigned long)peakAuctions, (unsigned long)peakBytes,
+          (unsigned long)resolver.auctionStore.evictedAuctionCount);
+    XCTAssertLessThanOrEqual(peakAuctions, capacity);
+    XCTAssertLessThanOrEqual(peakBytes, capacity * perAuctionBytes);
+    XCTAssertGreaterThan(resolver.auctionStore.evictedAuctionCount, 0);
+
+    [resolver clear];
+    XCTAssertEqual(resolver.liveAuctionCount, 0);
+    XCTAssertEqual(resolver.retainedBytes, 0);
+}
+
+@end
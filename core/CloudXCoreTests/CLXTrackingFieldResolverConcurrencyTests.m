@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+static const NSInteger kCLXConcurrentAuctions = 2000;
+static const NSInteger kCLXReadsPerAuction = 4;
+
+/**
+ * Hammers the resolver from many threads at once. Run with the Thread Sanitizer enabled
+ * to catch unsynchronized access; without it, the tests still check payload consistency.
+ */
+@interface CLXTrackingFieldResolverConcurrencyTests : XCTestCase
+@property (nonatomic, strong) CLXTrackingFieldResolver *resolver;
+@end
+
+@implementation CLXTrackingFieldResolverConcurrencyTests
+
+- (void)setUp {
+    [super setUp];
+    self.resolver = [[CLXTrackingFieldResolver alloc] init];
+    self.resolver.auctionStore.capacity = 64;
+    [self.resolver setConfig:[self _configWithTracking:@[@"bidRequest.id", @"bidResponse.id", @"bid.price", @"bidRequest.loopIndex"]]];
+    [self.resolver setSessionConstData:@"session-1" sdkVersion:@"1.0.0" deviceType:@"phone" abTestGroup:@"RandomTest"];
+}
+
+- (CLXSDKConfigResponse *)_configWithTracking:(NSArray<NSString *> *)tracking {
+    CLXSDKConfigResponse *config = [[CLXSDKConfigResponse alloc] init];
+    config.accountID = @"account-1";
+    config.tracking = tracking;
+    return config;
+}
+
+- (void)_runAuction:(NSString *)auctionId index:(NSInteger)index {
+    [self.resolver setLoopIndex:auctionId loopIndex:index];
+    [self.resolver setRequestData:auctionId bidRequestJSON:@{@"id": auctionId, @"imp": @[@{@"id": @"imp-1"}]}];
+    [self.resolver setResponseData:auctionId bidResponseJSON:@{
+        @"id": auctionId,
+        @"seatbid": @[@{@"bid": @[@{@"id": @"bid-1", @"impid": @"imp-1", @"price": @(index)}]}]
+    }];
+    [self.resolver saveLoadedBid:auctionId bidId:@"bid-1"];
+}
+
+#pragma mark - Tests
+
+- (void)testConcurrentAuctionsProduceConsistentPayloads {
+    __block NSInteger inconsistent = 0;
+    NSObject *counterLock = [[NSObject alloc] init];
+
+    dispatch_apply(kCLXConcurrentAuctions, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            NSString *auctionId = [NSString stringWithFormat:@"auction-%zu", i];
+            [self _runAuction:auctionId index:(NSInteger)i];
+
+            // Payload builds race against writers on other auctions and against evictions
+            for (NSInteger read = 0; read < kCLXReadsPerAuction; read++) {
+                NSString *payload = [self.resolver buildPayload:auctionId];
+                NSArray<NSString *> *values = [payload componentsSeparatedByString:@";"];
+                if (values.count != 4) {
+                    @synchronized (counterLock) {
+                        inconsistent += 1;
+                    }
+                    continue;
+                }
+
+                // An evicted auction yields empty fields; a live one must be internally consistent
+                BOOL consistent = [values[0] isEqualToString:auctionId] &&
+                                  [values[1] isEqualToString:auctionId] &&
+                                  [values[2] isEqualToString:values[3]];
+                if (values[0].length > 0 && !consistent) {
+                    @synchronized (counterLock) {
+                        inconsistent += 1;
+                    }
+                }
+            }
+
+            if (i % 2 == 0) {
+                [self.resolver clearAuction:auctionId];
+            }
+        }
+    });
+
+    XCTAssertEqual(inconsistent, 0);
+    XCTAssertLessThanOrEqual(self.resolver.liveAuctionCount, (NSUInteger)64);
+}
+
+- (void)testConfigAndSessionUpdatesDuringPayloadBuilds {
+    NSArray<NSString *> *shortTracking = @[@"sdk.sessionId", @"bidRequest.id"];
+    NSArray<NSString *> *longTracking = @[@"sdk.sessionId", @"bidRequest.id", @"bid.price", @"config.accountID"];
+    [self _runAuction:@"auction-shared" index:7];
+
+    __block NSInteger malformed = 0;
+    NSObject *counterLock = [[NSObject alloc] init];
+
+    dispatch_apply(kCLXConcurrentAuctions, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        @autoreleasepool {
+            switch (i % 4) {
+                case 0:
+                    [self.resolver setConfig:[self _configWithTracking:(i % 8 == 0) ? shortTracking : longTracking]];
+                    break;
+                case 1:
+                    [self.resolver setSessionConstData:[NSString stringWithFormat:@"session-%zu", i]
+                                            sdkVersion:@"1.0.0"
+                                            deviceType:@"phone"
+                                           abTestGroup:@"RandomTest"];
+                    break;
+                default: {
+                    // Every payload must match one whole config, never a mix of two
+                    NSString *payload = [self.resolver buildPayload:@"auction-shared"];
+                    NSUInteger count = [payload componentsSeparatedByString:@";"].count;
+                    BOOL wellFormed = (count == 2 && [payload hasSuffix:@";auction-shared"]) ||
+                                      (count == 4 && [payload hasSuffix:@";auction-shared;7;account-1"]);
+                    if (!wellFormed) {
+                        @synchronized (counterLock) {
+                            malformed += 1;
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    });
+
+    XCTAssertEqual(malformed, 0);
+}
+
+- (void)testUnchangedConfigKeepsResolvingAfterReapply {
+    [self _runAuction:@"auction-1" index:3];
+    NSString *before = [self.resolver buildPayload:@"auction-1"];
+
+    // Config is re-applied on every impression with the same field list
+    for (NSInteger i = 0; i < 100; i++) {
+        [self.resolver setConfig:[self _configWithTracking:@[@"bidRequest.id", @"bidResponse.id", @"bid.price", @"bidRequest.loopIndex"]]];
+    }
+    XCTAssertEqualObjects([self.resolver buildPayload:@"auction-1"], before);
+    XCTAssertEqualObjects(before, @"auction-1;auction-1;3;3");
+}
+
+@end
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+
+// Private interface to access the interpreted per-field resolution for comparison
+@interface CLXTrackingFieldResolver (PerformanceTesting)
+- (nullable id)resolveField:(NSString *)auctionId field:(NSString *)field;
+@end
+
+static NSString *const kCLXPerfAuctionId = @"perf-auction-1";
+static const NSInteger kCLXPayloadIterations = 1000;
+
+@interface CLXTrackingFieldResolverPerformanceTests : XCTestCase
+@property (nonatomic, strong) CLXTrackingFieldResolver *resolver;
+@property (nonatomic, copy) NSArray<NSString *> *trackingFields;
+@end
+
+@implementation CLXTrackingFieldResolverPerformanceTests
+
+- (void)setUp {
+    [super setUp];
+    self.resolver = [[CLXTrackingFieldResolver alloc] init];
+
+    // Realistic 40-field server config mixing every source and array predicates
+    self.trackingFields = @[
+        @"bid.ext.prebid.meta.adaptercode", @"bid.w", @"bid.h", @"bid.dealid", @"bid.creativeId",
+        @"bid.price", @"bid.adomain", @"bid.ext.cloudx.rank", @"bid.ext.cloudx.meta.adaptercode", @"bid.cat",
+        @"sdk.responseTimeMillis", @"sdk.releaseVersion", @"sdk.deviceType", @"sdk.sessionId", @"sdk.unknownParam",
+        @"bidRequest.id", @"bidRequest.app.bundle", @"bidRequest.app.id", @"bidRequest.imp.tagid", @"bidRequest.imp.id",
+        @"bidRequest.device.model", @"bidRequest.device.os", @"bidRequest.device.osv", @"bidRequest.device.make",
+        @"bidRequest.device.ifa", @"bidRequest.loopIndex", @"bidRequest.device.geo.country", @"bidRequest.device.geo.region",
+        @"bidRequest.regs.ext.gdpr", @"bidRequest.user.ext.consent",
+        @"config.accountID", @"config.organizationID", @"config.testGroupName",
+        @"config.placements[id=${bidRequest.imp.tagid}].name",
+        @"bidResponse.id", @"bidResponse.cur",
+        @"bidResponse.ext.cloudx.auction.participants[rank=${bid.ext.cloudx.rank}].round",
+        @"bidResponse.ext.cloudx.auction.participants[rank=${bid.ext.cloudx.rank}].lineItemId",
+        @"bidResponse.ext.cloudx.auction.participants[rank=2].bidder",
+        @"bidResponse.ext.cloudx.auction.participants[bidder=${ext.cloudx.auction.winner}].responseTimeMillis"
+    ];
+    XCTAssertEqual(self.trackingFields.count, 40);
+
+    CLXSDKConfigResponse *config = [[CLXSDKConfigResponse alloc] init];
+    config.accountID = @"perf-account";
+    config.organizationID = @"perf-org";
+    config.tracking = self.trackingFields;
+    [self.resolver setConfig:config];
+
+    [self.resolver setSessionConstData:@"perf-session" sdkVersion:@"1.2.3" deviceType:@"phone" abTestGroup:@"RandomTest"];
+    [self.resolver setLoopIndex:kCLXPerfAuctionId loopIndex:2];
+    [self.resolver setRequestData:kCLXPerfAuctionId bidRequestJSON:@{
+        @"id": kCLXPerfAuctionId,
+        @"app": @{@"id": @"perf-app", @"bundle": @"io.cloudx.perf"},
+        @"imp": @[@{@"id": @"imp-1", @"tagid": @"placement-1", @"banner": @{@"format": @[@{@"w": @320, @"h": @50}]}}],
+        @"device": @{@"model": @"iPhone", @"make": @"Apple", @"os": @"iOS", @"osv": @"18.5",
+                     @"ifa": @"EC1E5FC5-67B0-4584-AFD8-0E09114A6B3A",
+                     @"geo": @{@"country": @"USA", @"region": @"CA"}},
+        @"regs": @{@"ext": @{@"gdpr": @0}},
+        @"user": @{@"ext": @{@"consent": @"consent-string"}}
+    }];
+
+    NSMutableArray *bids = [NSMutableArray array];
+    NSMutableArray *participants = [NSMutableArray array];
+    for (NSInteger i = 0; i < 10; i++) {
+        NSString *bidder = [NSString stringWithFormat:@"bidder-%ld", (long)i];
+        [bids addObject:@{
+            @"id": [NSString stringWithFormat:@"bid-%ld", (long)i],
+            @"impid": @"imp-1",
+            @"price": @(10.0 - i),
+            @"crid": [NSString stringWithFormat:@"creative-%ld", (long)i],
+            @"adomain": @[@"advertiser.com"],
+            @"cat": @[@"IAB1"],
+            @"ext": @{@"prebid": @{@"meta": @{@"adaptercode": bidder}},
+                      @"cloudx": @{@"rank": @(i + 1), @"meta": @{@"adaptercode": bidder}}}
+        }];
+        [participants addObject:@{@"bidder": bidder, @"rank": @(i + 1), @"round": @1,
+                                  @"lineItemId": [NSString stringWithFormat:@"line-item-%ld", (long)i],
+                                  @"responseTimeMillis": @(100 + i)}];
+    }
+    [self.resolver setResponseData:kCLXPerfAuctionId bidResponseJSON:@{
+        @"id": kCLXPerfAuctionId,
+        @"cur": @"USD",
+        @"seatbid": @[@{@"seat": @"cloudx", @"bid": bids}],
+        @"ext": @{@"cloudx": @{@"rank": @1, @"auction": @{@"winner": @"bidder-3", @"participants": participants}}}
+    }];
+    [self.resolver saveLoadedBid:kCLXPerfAuctionId bidId:@"bid-4"];
+}
+
+- (NSString *)_interpretedPayload {
+    NSMutableArray<NSString *> *values = [NSMutableArray arrayWithCapacity:self.trackingFields.count];
+    for (NSString *field in self.trackingFields) {
+        id value = [self.resolver resolveField:kCLXPerfAuctionId field:field];
+        [values addObject:value ? [value description] : @""];
+    }
+    return [values componentsJoinedByString:@";"];
+}
+
+#pragma mark - Tests
+
+- (void)testCompiledPayloadMatchesInterpretedResolution {
+    NSString *compiled = [self.resolver buildPayload:kCLXPerfAuctionId];
+    XCTAssertEqualObjects(compiled, [self _interpretedPayload]);
+
+    NSArray<NSString *> *values = [compiled componentsSeparatedByString:@";"];
+    XCTAssertEqual(values.count, 40);
+    XCTAssertEqualObjects(values[0], @"bidder-4");   // bid.ext.prebid.meta.adaptercode
+    XCTAssertEqualObjects(values[1], @"320");        // bid.w falls back to the request format
+    XCTAssertEqualObjects(values[5], @"6");          // bid.price
+    XCTAssertEqualObjects(values[11], @"1.2.3");     // sdk.releaseVersion
+    XCTAssertEqualObjects(values[25], @"2");         // bidRequest.loopIndex
+    XCTAssertEqualObjects(values[37], @"line-item-0"); // participants[rank=${bid.ext.cloudx.rank}] uses the response rank
+    XCTAssertEqualObjects(values[38], @"bidder-1");  // literal predicate
+    XCTAssertEqualObjects(values[39], @"103");       // predicate resolved from another response path
+}
+
+- (void)testRecompilesWhenConfigChanges {
+    CLXSDKConfigResponse *config = [[CLXSDKConfigResponse alloc] init];
+    config.tracking = @[@"bid.price", @"sdk.sessionId"];
+    [self.resolver setConfig:config];
+
+    XCTAssertEqualObjects([self.resolver buildPayload:kCLXPerfAuctionId], @"6;perf-session");
+}
+
+- (void)testPerformanceInterpretedPayload {
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < kCLXPayloadIterations; i++) {
+            @autoreleasepool {
+                [self _interpretedPayload];
+            }
+        }
+    }];
+}
+
+- (void)testPerformanceCompiledPayload {
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < kCLXPayloadIterations; i++) {
+            @autoreleasepool {
+                [self.resolver buildPayload:kCLXPerfAuctionId];
+            }
+        }
+    }];
+}
+
+@end
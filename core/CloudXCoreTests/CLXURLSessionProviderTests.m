@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import "CLXLocalHTTPServer.h"
+
+// Records the performance metrics it is given
+@interface CLXURLSessionProviderMockTracker : NSObject <CLXMetricsTrackerProtocol>
+@property (nonatomic, strong) NSMutableArray<NSString *> *performanceMetrics;
+@end
+
+@implementation CLXURLSessionProviderMockTracker
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _performanceMetrics = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)startWithConfig:(CLXSDKConfig *)config {}
+- (void)setBasicDataWithSessionId:(NSString *)sessionId accountId:(NSString *)accountId basePayload:(NSString *)basePayload {}
+- (void)trackMethodCall:(NSString *)methodType {}
+- (void)trySendingPendingMetrics {}
+- (void)stop {}
+- (void)debugPrintStatus {}
+- (NSArray<NSString *> *)validateSystem { return @[]; }
+- (void)flushPendingOperations {}
+
+- (void)trackNetworkCall:(NSString *)networkType latency:(NSInteger)latencyMs {}
+
+- (void)trackPerformanceMetric:(NSString *)metricType value:(NSInteger)valueMs {
+    @synchronized (self) {
+        [self.performanceMetrics addObject:metricType];
+    }
+}
+
+@end
+
+@interface CLXURLSessionProviderTests : XCTestCase
+@property (nonatomic, strong) CLXLocalHTTPServer *server;
+@property (nonatomic, strong) CLXURLSessionProvider *provider;
+@property (nonatomic, strong) CLXURLSessionProviderMockTracker *tracker;
+@end
+
+@implementation CLXURLSessionProviderTests
+
+- (void)setUp {
+    [super setUp];
+    self.server = [[CLXLocalHTTPServer alloc] init];
+    XCTAssertTrue([self.server start]);
+    self.tracker = [[CLXURLSessionProviderMockTracker alloc] init];
+    self.provider = [[CLXURLSessionProvider alloc] init];
+    self.provider.metricsTracker = self.tracker;
+}
+
+- (void)tearDown {
+    [self.provider invalidateSessions];
+    [self.server stop];
+    self.provider = nil;
+    self.server = nil;
+    [super tearDown];
+}
+
+// Metrics are delivered before the completion handler runs
+- (void)_sendRequestWithSession:(NSURLSession *)session {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"request"];
+    NSURL *url = [self.server.baseURL URLByAppendingPathComponent:@"auction"];
+    [[session dataTaskWithURL:url completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(((NSHTTPURLResponse *)response).statusCode, 200);
+        [expectation fulfill];
+    }] resume];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+#pragma mark - Configuration
+
+- (void)testAuctionSessionDoesNotWaitForConnectivity {
+    NSURLSessionConfiguration *config = [CLXURLSessionProvider configurationForPurpose:CLXURLSessionPurposeAuction];
+    XCTAssertFalse(config.waitsForConnectivity);
+    XCTAssertNil(config.URLCache);
+    XCTAssertGreaterThan(config.HTTPMaximumConnectionsPerHost, 1);
+    XCTAssertLessThanOrEqual(config.timeoutIntervalForResource, 15);
+}
+
+- (void)testTrackingSessionWaitsForConnectivity {
+    NSURLSessionConfiguration *config = [CLXURLSessionProvider configurationForPurpose:CLXURLSessionPurposeTracking];
+    XCTAssertTrue(config.waitsForConnectivity);
+    XCTAssertNil(config.URLCache);
+    XCTAssertTrue([CLXURLSessionProvider configurationForPurpose:CLXURLSessionPurposeInit].waitsForConnectivity);
+}
+
+- (void)testSessionIsCreatedOncePerPurpose {
+    NSURLSession *auction = [self.provider sessionForPurpose:CLXURLSessionPurposeAuction];
+    XCTAssertEqual([self.provider sessionForPurpose:CLXURLSessionPurposeAuction], auction);
+    XCTAssertNotEqual([self.provider sessionForPurpose:CLXURLSessionPurposeTracking], auction);
+    XCTAssertEqualObjects(auction.sessionDescription, @"cloudx.sdk.auction");
+    XCTAssertFalse(auction.configuration.waitsForConnectivity);
+}
+
+- (void)testLegacyIdentifiersMapToSharedSessions {
+    CLXURLSessionProvider *shared = [CLXURLSessionProvider shared];
+    XCTAssertEqual([NSURLSession cloudxSessionWithIdentifier:@"auction"], [shared sessionForPurpose:CLXURLSessionPurposeAuction]);
+    XCTAssertEqual([NSURLSession cloudxSessionWithIdentifier:@"winloss"], [shared sessionForPurpose:CLXURLSessionPurposeTracking]);
+    XCTAssertEqual([NSURLSession cloudxSessionWithIdentifier:@"event"], [NSURLSession cloudxSessionWithIdentifier:@"winloss"]);
+}
+
+#pragma mark - Connection Reuse
+
+- (void)testSequentialRequestsReuseTheConnection {
+    NSURLSession *session = [self.provider sessionForPurpose:CLXURLSessionPurposeAuction];
+
+    [self _sendRequestWithSession:session];
+    [self _sendRequestWithSession:session];
+    [self _sendRequestWithSession:session];
+
+    XCTAssertEqual(self.server.servedRequestCount, 3);
+    XCTAssertEqual(self.server.acceptedConnectionCount, 1);
+    XCTAssertEqual(self.provider.openedConnectionCount, 1);
+    XCTAssertEqual(self.provider.reusedConnectionCount, 2);
+    XCTAssertEqualObjects(self.tracker.performanceMetrics, (@[CLXMetricsTypeNetworkConnectionNew,
+                                                              CLXMetricsTypeNetworkConnectionReused,
+                                                              CLXMetricsTypeNetworkConnectionReused]));
+}
+
+- (void)testWinLossEndpointChangeKeepsTheSession {
+    CLXWinLossTracker *tracker = [[CLXWinLossTracker alloc] init];
+    [tracker setEndpoint:@"https://a.cloudx.io/win"];
+    NSURLSession *first = [tracker valueForKeyPath:@"networkService.baseNetworkService.urlSession"];
+    [tracker setEndpoint:@"https://b.cloudx.io/win"];
+    NSURLSession *second = [tracker valueForKeyPath:@"networkService.baseNetworkService.urlSession"];
+
+    XCTAssertNotNil(first);
+    XCTAssertEqual(first, second);
+    [tracker setEndpoint:nil];
+}
+
+@end
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXWinLossBatchingTests.m
+ * @brief Tests for coalescing win/loss notifications into batch requests
+ */
+
+#import <XCTest/XCTest.h>
+#import <CloudXCore/CloudXCore.h>
+#import "CLXLocalHTTPServer.h"
+
+@interface CLXWinLossTracker (BatchingTesting)
+- (void)trackWinLoss:(NSDictionary<NSString *, id> *)payload;
+@end
+
+@interface CLXWinLossBatchingTests : XCTestCase
+@property (nonatomic, strong) CLXLocalHTTPServer *server;
+@property (nonatomic, strong) CLXWinLossTracker *tracker;
+@end
+
+@implementation CLXWinLossBatchingTests
+
+- (void)setUp {
+    [super setUp];
+    [[CLXRetryBudget shared] reset];
+    self.server = [[CLXLocalHTTPServer alloc] init];
+    XCTAssertTrue([self.server start]);
+
+    self.tracker = [[CLXWinLossTracker alloc] init];
+    [self.tracker deleteAllEvents];
+    [self.tracker setAppKey:@"test-app-key"];
+    [self.tracker setEndpoint:[self.server.baseURL URLByAppendingPathComponent:@"winloss"].absoluteString];
+    [self.tracker setBatchEndpoint:[self.server.baseURL URLByAppendingPathComponent:@"winloss/batch"].absoluteString];
+}
+
+- (void)tearDown {
+    [self.tracker setEndpoint:nil];
+    [self.tracker deleteAllEvents];
+    [self.server stop];
+    self.tracker = nil;
+    self.server = nil;
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+// An auction's win plus two losses, reported within one batch window
+- (void)_trackAuction {
+    [self.tracker trackWinLoss:@{@"auction_id": @"auction-1", @"bid_id": @"bid-1", @"clearing_price": @2.5}];
+    [self.tracker trackWinLoss:@{@"auction_id": @"auction-1", @"bid_id": @"bid-2", @"loss_reason": @4}];
+    [self.tracker trackWinLoss:@{@"auction_id": @"auction-1", @"bid_id": @"bid-3", @"loss_reason": @4}];
+}
+
+- (void)_waitUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition() && [deadline timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    }
+}
+
+#pragma mark - Tests
+
+- (void)testEventsWithinWindowShareOneRequest {
+    [self _trackAuction];
+
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 1 && [self.tracker getAllCachedBatches].count == 0;
+    } timeout:5.0];
+
+    XCTAssertEqual(self.server.servedRequestCount, 1, @"Win and losses go out in one request");
+    XCTAssertEqual([self.tracker getAllCachedBatches].count, 0u, @"Accepted batch is removed");
+    XCTAssertEqual([self.tracker getAllCachedEvents].count, 0u, @"Batched events are never stored one by one");
+}
+
+- (void)testRejectedEventsAreDroppedWithTheBatch {
+    self.server.responseBody = [@"{\"rejected\":[1]}" dataUsingEncoding:NSUTF8StringEncoding];
+    [self _trackAuction];
+
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 1 && [self.tracker getAllCachedBatches].count == 0;
+    } timeout:5.0];
+
+    XCTAssertEqual([self.tracker getAllCachedBatches].count, 0u, @"A rejection inside a 2xx answer is a refusal");
+    XCTAssertEqual([self.tracker getAllCachedEvents].count, 0u);
+
+    // Later flushes do not send the rejected event again
+    [self.tracker trySendingPendingWinLossEvents];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqual(self.server.servedRequestCount, 1);
+}
+
+- (void)testServerWithoutBatchSupportFallsBackToSingleEvents {
+    self.server.responseStatusCode = 404;
+    [self _trackAuction];
+
+    // One refused batch, then one request per event, which this server refuses for good
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 4;
+    } timeout:5.0];
+    [self _waitUntil:^BOOL{
+        return [self.tracker getAllCachedEvents].count == 0;
+    } timeout:2.0];
+
+    XCTAssertEqual(self.server.servedRequestCount, 4);
+    XCTAssertEqual([self.tracker getAllCachedBatches].count, 0u, @"The batch row becomes single events");
+    XCTAssertEqual([self.tracker getAllCachedEvents].count, 0u, @"Events refused with a 4xx are not retried");
+}
+
+- (void)testServerErrorKeepsSingleEventsForRetry {
+    [self.tracker setBatchEndpoint:nil];
+    self.server.responseStatusCode = 503;
+    [self _trackAuction];
+
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 3 && [self.tracker getAllCachedEvents].count == 3;
+    } timeout:5.0];
+
+    XCTAssertEqual([self.tracker getAllCachedEvents].count, 3u, @"Events failed with a 5xx are kept for retry");
+}
+
+- (void)testRejectedCachedEventsAreDeletedOnRetry {
+    [self.tracker setBatchEndpoint:nil];
+    self.server.responseStatusCode = 400;
+    [self.tracker insertEventWithId:@"cached-1" endpointUrl:@"" payload:@"{\"bid_id\":\"bid-1\"}"];
+    [self.tracker insertEventWithId:@"cached-2" endpointUrl:@"" payload:@"not json"];
+
+    [self.tracker trySendingPendingWinLossEvents];
+    [self _waitUntil:^BOOL{
+        return [self.tracker getAllCachedEvents].count == 0;
+    } timeout:5.0];
+
+    XCTAssertEqual([self.tracker getAllCachedEvents].count, 0u, @"Refused and unreadable rows are dropped");
+    XCTAssertEqual(self.server.servedRequestCount, 1, @"The unreadable row is never sent");
+}
+
+- (void)testRetryPassSkipsEventsWithSendInFlight {
+    [self.tracker setBatchEndpoint:nil];
+    [self.tracker trackWinLoss:@{@"auction_id": @"auction-1", @"bid_id": @"bid-1", @"clearing_price": @2.5}];
+    [self.tracker trySendingPendingWinLossEvents];
+
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 1 && [self.tracker getAllCachedEvents].count == 0;
+    } timeout:5.0];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+
+    XCTAssertEqual(self.server.servedRequestCount, 1, @"The retry pass must not resend an event still being sent");
+}
+
+- (void)testWithoutBatchEndpointEachEventIsSentAlone {
+    [self.tracker setBatchEndpoint:nil];
+    [self _trackAuction];
+
+    [self _waitUntil:^BOOL{
+        return self.server.servedRequestCount >= 3 && [self.tracker getAllCachedEvents].count == 0;
+    } timeout:5.0];
+
+    XCTAssertEqual(self.server.servedRequestCount, 3);
+    XCTAssertEqual([self.tracker getAllCachedBatches].count, 0u);
+}
+
+@end
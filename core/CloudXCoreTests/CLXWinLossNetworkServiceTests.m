@@ -25,6 +25,7 @@
 @property (nonatomic, assign) NSInteger callCount;
 @property (nonatomic, strong) NSData *lastRequestBody;
 @property (nonatomic, strong) NSDictionary *lastHeaders;
+@property (nonatomic, strong) id simulatedResponseObject;
 @end
 
 @implementation MockCLXBaseNetworkService
@@ -50,6 +51,9 @@
             completion(nil, timeoutError, NO);
         } else if (self.simulatedError) {
             completion(nil, self.simulatedError, NO);
+        } else if (self.simulatedResponseObject) {
+            // Parsed JSON body of a 2xx response, as the base service hands it over
+            completion(self.simulatedResponseObject, nil, NO);
         } else {
             // Create mock HTTP response
             NSHTTPURLResponse *httpResponse = [[NSHTTPURLResponse alloc] 
@@ -90,6 +94,7 @@
     self.mockBaseService.callCount = 0;
     self.mockBaseService.lastRequestBody = nil;
     self.mockBaseService.lastHeaders = nil;
+    self.mockBaseService.simulatedResponseObject = nil;
 }
 
 - (void)tearDown {
@@ -372,4 +377,99 @@
     XCTAssertEqual(self.mockBaseService.callCount, requestCount, @"Should have made all requests");
 }
 
+#pragma mark - Batch Tests
+
+- (NSArray<NSDictionary *> *)_batchPayloads {
+    return @[@{@"eventType": @"win", @"bidId": @"bid-1"},
+             @{@"eventType": @"loss", @"bidId": @"bid-2"},
+             @{@"eventType": @"loss", @"bidId": @"bid-3"}];
+}
+
+/**
+ * Test that a batch goes out as one request with every payload under "events"
+ */
+- (void)testSendBatch_ShouldSendAllPayloadsInOneBody {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Batch"];
+    NSArray *payloads = [self _batchPayloads];
+    
+    [self.networkService sendBatchWithAppKey:@"test-app-key"
+                                 endpointUrl:@"https://test.cloudx.com/win-loss/batch"
+                                    payloads:payloads
+                                  completion:^(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error) {
+        XCTAssertEqual(result, CLXWinLossBatchResultSent);
+        XCTAssertEqual(acceptedIndexes.count, payloads.count);
+        XCTAssertNil(error);
+        
+        NSDictionary *body = [NSJSONSerialization JSONObjectWithData:self.mockBaseService.lastRequestBody options:0 error:nil];
+        XCTAssertEqualObjects(body[@"events"], payloads);
+        XCTAssertEqualObjects(self.mockBaseService.lastHeaders[@"Authorization"], @"Bearer test-app-key");
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(self.mockBaseService.callCount, 1);
+}
+
+/**
+ * Test that events the server lists as rejected are not reported as accepted
+ */
+- (void)testSendBatch_PartialSuccess_ShouldReportAcceptedIndexes {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Partial batch"];
+    self.mockBaseService.simulatedResponseObject = @{@"rejected": @[@1]};
+    
+    [self.networkService sendBatchWithAppKey:@"test-app-key"
+                                 endpointUrl:@"https://test.cloudx.com/win-loss/batch"
+                                    payloads:[self _batchPayloads]
+                                  completion:^(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error) {
+        XCTAssertEqual(result, CLXWinLossBatchResultSent);
+        NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+        [expected addIndex:2];
+        XCTAssertEqualObjects(acceptedIndexes, expected);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+/**
+ * Test that an endpoint without batch support is reported as such
+ */
+- (void)testSendBatch_NotFound_ShouldReportUnsupported {
+    for (NSNumber *statusCode in @[@404, @405, @501]) {
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"HTTP %@", statusCode]];
+        self.mockBaseService.simulatedStatusCode = statusCode.integerValue;
+        
+        [self.networkService sendBatchWithAppKey:@"test-app-key"
+                                     endpointUrl:@"https://test.cloudx.com/win-loss/batch"
+                                        payloads:[self _batchPayloads]
+                                      completion:^(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error) {
+            XCTAssertEqual(result, CLXWinLossBatchResultUnsupported, @"HTTP %@", statusCode);
+            XCTAssertEqual(acceptedIndexes.count, 0u);
+            [expectation fulfill];
+        }];
+        
+        [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    }
+}
+
+/**
+ * Test that server and network errors fail the whole batch
+ */
+- (void)testSendBatch_ServerError_ShouldFailWholeBatch {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Failed batch"];
+    self.mockBaseService.simulatedStatusCode = 503;
+    
+    [self.networkService sendBatchWithAppKey:@"test-app-key"
+                                 endpointUrl:@"https://test.cloudx.com/win-loss/batch"
+                                    payloads:[self _batchPayloads]
+                                  completion:^(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error) {
+        XCTAssertEqual(result, CLXWinLossBatchResultFailed);
+        XCTAssertEqual(acceptedIndexes.count, 0u);
+        XCTAssertNotNil(error);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
 @end
\ No newline at end of file
@@ -587,6 +587,32 @@ static const NSInteger kTestRank3 = 3;
     [tracker deleteAllEvents];
 }
 
+/**
+ * Test batched deletion of cached events in one transaction
+ */
+- (void)testDatabasePersistence_DeleteEventsWithIds_ShouldRemoveAllTargetEvents {
+    CLXWinLossTracker *tracker = [[CLXWinLossTracker alloc] init];
+    [tracker deleteAllEvents];
+    
+    // Given: More events than fit in a single IN (...) chunk
+    NSMutableArray<NSString *> *idsToDelete = [NSMutableArray array];
+    for (NSInteger i = 0; i < 250; i++) {
+        NSString *eventId = [NSString stringWithFormat:@"batch-event-%ld", (long)i];
+        [tracker insertEventWithId:eventId endpointUrl:@"https://api.com" payload:@"{}"];
+        [idsToDelete addObject:eventId];
+    }
+    [tracker insertEventWithId:@"event-to-keep" endpointUrl:@"https://api.com" payload:@"{}"];
+    
+    // When
+    [tracker deleteEventsWithIds:idsToDelete];
+    
+    // Then
+    NSArray *remainingEvents = [tracker getAllCachedEvents];
+    XCTAssertEqual(remainingEvents.count, 1, @"Only the untargeted event should remain");
+    
+    [tracker deleteAllEvents];
+}
+
 /**
  * Test the complete retry flow for pending win/loss events
  * This tests the integration between database persistence and retry logic
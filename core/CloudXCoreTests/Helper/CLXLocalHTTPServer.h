@@ -0,0 +1,47 @@
+//
+//  CLXLocalHTTPServer.h
+//  CloudXCoreTests
+//
+//  Minimal HTTP/1.1 stand-in server for network tests
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Keep-alive HTTP/1.1 server on 127.0.0.1 that answers every request with the same
+ * canned response. Counts the connections it accepts and the requests it serves, so
+ * tests can tell whether a client reused a connection.
+ *
+ * Plain HTTP to an IP address is exempt from App Transport Security, so no Info.plist
+ * changes are needed in the test host.
+ */
+@interface CLXLocalHTTPServer : NSObject
+
+/// Port picked by the system once started; 0 before
+@property (nonatomic, assign, readonly) uint16_t port;
+
+/// http://127.0.0.1:<port>
+@property (nonatomic, strong, readonly, nullable) NSURL *baseURL;
+
+@property (atomic, assign) NSInteger responseStatusCode;
+@property (atomic, copy) NSData *responseBody;
+
+@property (atomic, assign, readonly) NSInteger acceptedConnectionCount;
+@property (atomic, assign, readonly) NSInteger servedRequestCount;
+
+/**
+ * Binds to a free port and starts accepting connections
+ * @return NO if the socket could not be set up
+ */
+- (BOOL)start;
+
+/**
+ * Closes the listening socket and every open connection
+ */
+- (void)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
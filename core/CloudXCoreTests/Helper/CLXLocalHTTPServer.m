@@ -0,0 +1,164 @@
+//
+//  CLXLocalHTTPServer.m
+//  CloudXCoreTests
+//
+//  Minimal HTTP/1.1 stand-in server for network tests
+//
+
+#import "CLXLocalHTTPServer.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+@interface CLXLocalHTTPServer ()
+@property (nonatomic, assign, readwrite) uint16_t port;
+@property (atomic, assign, readwrite) NSInteger acceptedConnectionCount;
+@property (atomic, assign, readwrite) NSInteger servedRequestCount;
+@property (nonatomic, assign) int listenSocket;
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *clientSockets;
+@end
+
+@implementation CLXLocalHTTPServer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _listenSocket = -1;
+        _clientSockets = [NSMutableSet set];
+        _responseStatusCode = 200;
+        _responseBody = [@"{}" dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self stop];
+}
+
+- (nullable NSURL *)baseURL {
+    return self.port ? [NSURL URLWithString:[NSString stringWithFormat:@"http://127.0.0.1:%u", self.port]] : nil;
+}
+
+- (BOOL)start {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return NO;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = {0};
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(fd, 16) != 0 ||
+        getsockname(fd, (struct sockaddr *)&address, &length) != 0) {
+        close(fd);
+        return NO;
+    }
+    self.listenSocket = fd;
+    self.port = ntohs(address.sin_port);
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        [self _acceptLoop:fd];
+    });
+    return YES;
+}
+
+- (void)stop {
+    NSArray<NSNumber *> *clients;
+    @synchronized (self) {
+        clients = self.clientSockets.allObjects;
+        [self.clientSockets removeAllObjects];
+    }
+    for (NSNumber *client in clients) {
+        shutdown(client.intValue, SHUT_RDWR);
+    }
+    if (self.listenSocket >= 0) {
+        shutdown(self.listenSocket, SHUT_RDWR);
+        close(self.listenSocket);
+        self.listenSocket = -1;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)_acceptLoop:(int)listenSocket {
+    while (YES) {
+        int client = accept(listenSocket, NULL, NULL);
+        if (client < 0) {
+            return;
+        }
+        self.acceptedConnectionCount += 1;
+        @synchronized (self) {
+            [self.clientSockets addObject:@(client)];
+        }
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            [self _serveConnection:client];
+        });
+    }
+}
+
+// Serves requests on one connection until the client closes it
+- (void)_serveConnection:(int)client {
+    NSMutableData *buffer = [NSMutableData data];
+    NSData *headerEnd = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+    uint8_t chunk[4096];
+
+    while (YES) {
+        NSRange headerRange = [buffer rangeOfData:headerEnd options:0 range:NSMakeRange(0, buffer.length)];
+        if (headerRange.location == NSNotFound) {
+            ssize_t count = read(client, chunk, sizeof(chunk));
+            if (count <= 0) {
+                break;
+            }
+            [buffer appendBytes:chunk length:(NSUInteger)count];
+            continue;
+        }
+
+        NSUInteger headerLength = NSMaxRange(headerRange);
+        NSString *headers = [[NSString alloc] initWithData:[buffer subdataWithRange:NSMakeRange(0, headerLength)] encoding:NSUTF8StringEncoding];
+        NSUInteger bodyLength = [self _contentLengthInHeaders:headers];
+        while (buffer.length < headerLength + bodyLength) {
+            ssize_t count = read(client, chunk, sizeof(chunk));
+            if (count <= 0) {
+                break;
+            }
+            [buffer appendBytes:chunk length:(NSUInteger)count];
+        }
+        if (buffer.length < headerLength + bodyLength) {
+            break;
+        }
+        [buffer replaceBytesInRange:NSMakeRange(0, headerLength + bodyLength) withBytes:NULL length:0];
+
+        self.servedRequestCount += 1;
+        NSData *body = self.responseBody;
+        NSString *head = [NSString stringWithFormat:@"HTTP/1.1 %ld Test\r\nContent-Type: application/json\r\nContent-Length: %lu\r\nConnection: keep-alive\r\n\r\n",
+                          (long)self.responseStatusCode, (unsigned long)body.length];
+        NSMutableData *response = [[head dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+        [response appendData:body];
+        if (write(client, response.bytes, response.length) < 0) {
+            break;
+        }
+    }
+
+    @synchronized (self) {
+        [self.clientSockets removeObject:@(client)];
+    }
+    close(client);
+}
+
+- (NSUInteger)_contentLengthInHeaders:(NSString *)headers {
+    for (NSString *line in [headers componentsSeparatedByString:@"\r\n"]) {
+        if ([line.lowercaseString hasPrefix:@"content-length:"]) {
+            return (NSUInteger)MAX([[line substringFromIndex:15] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]].integerValue, 0);
+        }
+    }
+    return 0;
+}
+
+@end
@@ -19,6 +19,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, strong, nullable) NSTimer *loadingTimer;
 @property (nonatomic, copy, nullable) void (^loadCompletion)(NSError * _Nullable error);
+@property (nonatomic, assign, getter=isExpired) BOOL expired;
 
 @end
 
@@ -58,6 +59,13 @@ static void initializeLogger() {
     return self.interstitial.network;
 }
 
+- (NSTimeInterval)expirationInterval {
+    if ([self.interstitial respondsToSelector:@selector(expirationInterval)]) {
+        return self.interstitial.expirationInterval;
+    }
+    return 0;
+}
+
 - (void)loadWithTimeout:(NSTimeInterval)timeout
              completion:(void (^)(NSError * _Nullable error))completion {
     [logger debug:[NSString stringWithFormat:@"🔧 [CachedInterstitial] loadWithTimeout: %f called", timeout]];
@@ -191,6 +199,7 @@ static void initializeLogger() {
 
 - (void)expiredWithInterstitial:(id<CLXAdapterInterstitial>)interstitial {
     [logger debug:@"🔧 [CachedInterstitial] expiredWithInterstitial called"];
+    self.expired = YES;
     
     // Forward to delegate
     if ([self.delegate respondsToSelector:@selector(expiredWithInterstitial:)]) {
@@ -19,6 +19,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, strong, nullable) NSTimer *loadingTimer;
 @property (nonatomic, copy, nullable) void (^loadCompletion)(NSError * _Nullable error);
+@property (nonatomic, assign, getter=isExpired) BOOL expired;
 
 @end
 
@@ -58,6 +59,13 @@ static void initializeLogger() {
     return self.rewarded.network;
 }
 
+- (NSTimeInterval)expirationInterval {
+    if ([self.rewarded respondsToSelector:@selector(expirationInterval)]) {
+        return self.rewarded.expirationInterval;
+    }
+    return 0;
+}
+
 - (void)loadWithTimeout:(NSTimeInterval)timeout
              completion:(void (^)(NSError * _Nullable error))completion {
     [logger debug:[NSString stringWithFormat:@"🔧 [CachedRewarded] loadWithTimeout: %f called", timeout]];
@@ -202,6 +210,7 @@ static void initializeLogger() {
 
 - (void)expiredWithRewarded:(id<CLXAdapterRewarded>)rewarded {
     [logger debug:@"🔧 [CachedRewarded] expiredWithRewarded called"];
+    self.expired = YES;
     
     // Forward to delegate
     if ([self.delegate respondsToSelector:@selector(expiredWithRewarded:)]) {
@@ -24,6 +24,7 @@
 #import <CloudXCore/CLXAdReportingNetworkService.h>
 #import <CloudXCore/CLXBaseNetworkService.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
+#import <CloudXCore/CLXCounterRegistry.h>
 #import <CloudXCore/CLXLogger.h>
 #import <CloudXCore/CLXXorEncryption.h>
 #import <CloudXCore/CLXDIContainer.h>
@@ -65,7 +66,7 @@
     NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
     request.HTTPMethod = @"GET";
     
-    NSURLSession *session = [NSURLSession sharedSession];
+    NSURLSession *session = self.baseNetworkService.urlSession;
     NSURLSessionDataTask *task = [session dataTaskWithRequest:request
                                             completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         // Track geo API network call latency
@@ -114,7 +115,8 @@
     NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:fullURL];
     request.HTTPMethod = @"POST";
     
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
+    // Counters not yet persisted are included; the stored dictionary alone can lag behind them
+    NSDictionary *metricsDictionary = [[CLXCounterRegistry coreMetrics] snapshot];
     NSString *encodedString = [[NSUserDefaults standardUserDefaults] stringForKey:kCLXCoreEncodedStringKey];
     
     NSMutableArray<NSDictionary<NSString *, NSString *> *> *items = [NSMutableArray array];
@@ -153,7 +155,7 @@
     [request setHTTPBody:jsonData];
     
     __block NSError * __autoreleasing *blockError = error;
-    NSURLSession *session = [NSURLSession sharedSession];
+    NSURLSession *session = self.baseNetworkService.urlSession;
     NSURLSessionDataTask *task = [session dataTaskWithRequest:request
                                             completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         if (error) {
@@ -234,7 +236,7 @@
     request.HTTPMethod = @"GET";
     
     __block NSError * __autoreleasing *blockError = error;
-    NSURLSession *session = [NSURLSession sharedSession];
+    NSURLSession *session = self.baseNetworkService.urlSession;
     NSURLSessionDataTask *task = [session dataTaskWithRequest:request
                                             completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         // Print the complete response JSON
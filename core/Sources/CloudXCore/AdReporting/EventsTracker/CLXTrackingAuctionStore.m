@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXTrackingAuctionStore.m
+ * @brief Bounded, auction-scoped storage backing CLXTrackingFieldResolver
+ */
+
+#import <CloudXCore/CLXTrackingAuctionStore.h>
+#import <CloudXCore/CLXLogger.h>
+#import <os/lock.h>
+
+static const NSUInteger kCLXDefaultAuctionCapacity = 32;
+static const NSTimeInterval kCLXDefaultAuctionTimeToLive = 600.0;
+static const NSTimeInterval kCLXDefaultRetirementGracePeriod = 30.0;
+static const NSUInteger kCLXDefaultParsedResponseCacheLimit = 4;
+
+// Rough per-object overhead used for size estimates
+static const NSUInteger kCLXEstimatedObjectOverhead = 16;
+
+/**
+ * Raw bid response bytes, parsed on demand into the store's shared cache
+ */
+@interface CLXTrackingResponseDocument : NSObject
+@property (nonatomic, strong, readonly) NSData *data;
+@property (nonatomic, strong, readonly) NSCache *parsedResponses;
+- (instancetype)initWithData:(NSData *)data parsedResponses:(NSCache *)parsedResponses;
+- (nullable NSDictionary *)object;
+@end
+
+@implementation CLXTrackingResponseDocument
+
+- (instancetype)initWithData:(NSData *)data parsedResponses:(NSCache *)parsedResponses {
+    self = [super init];
+    if (self) {
+        _data = data;
+        _parsedResponses = parsedResponses;
+    }
+    return self;
+}
+
+- (nullable NSDictionary *)object {
+    NSDictionary *object = [self.parsedResponses objectForKey:self];
+    if (object) {
+        return object;
+    }
+    // Two threads may both parse a cold document; either result is equivalent
+    id parsed = [NSJSONSerialization JSONObjectWithData:self.data options:0 error:nil];
+    if (![parsed isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    [self.parsedResponses setObject:parsed forKey:self cost:self.data.length];
+    return parsed;
+}
+
+@end
+
+@interface CLXTrackingAuctionEntry () <NSCopying>
+@property (nonatomic, copy, readwrite) NSString *auctionId;
+@property (nonatomic, strong, readwrite, nullable) NSDictionary *requestData;
+@property (nonatomic, strong, readwrite, nullable) NSDictionary *responseData;
+@property (nonatomic, copy, readwrite, nullable) NSString *loadedBidId;
+@property (nonatomic, strong, readwrite, nullable) NSNumber *loopIndex;
+@property (nonatomic, copy, readwrite, nullable) NSDictionary<NSString *, NSString *> *sdkValues;
+@property (nonatomic, assign, readwrite) NSUInteger estimatedBytes;
+@property (nonatomic, assign) NSUInteger requestBytes;
+@property (nonatomic, assign) NSUInteger responseBytes;
+@property (nonatomic, strong, nullable) CLXTrackingResponseDocument *responseDocument;
+
+// Store bookkeeping, only touched while holding the store lock
+@property (nonatomic, assign) NSTimeInterval lastAccessTime;
+@property (nonatomic, assign) NSTimeInterval retireTime; // 0 while the auction is active
+@end
+
+@implementation CLXTrackingAuctionEntry
+
+- (nullable NSDictionary *)responseData {
+    return _responseData ?: [self.responseDocument object];
+}
+
+- (nullable NSData *)responseJSONData {
+    return self.responseDocument.data;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    CLXTrackingAuctionEntry *copy = [[CLXTrackingAuctionEntry alloc] init];
+    copy.auctionId = self.auctionId;
+    copy.requestData = self.requestData;
+    copy.responseData = _responseData;
+    copy.responseDocument = self.responseDocument;
+    copy.loadedBidId = self.loadedBidId;
+    copy.loopIndex = self.loopIndex;
+    copy.sdkValues = self.sdkValues;
+    copy.estimatedBytes = self.estimatedBytes;
+    copy.requestBytes = self.requestBytes;
+    copy.responseBytes = self.responseBytes;
+    copy.lastAccessTime = self.lastAccessTime;
+    copy.retireTime = self.retireTime;
+    return copy;
+}
+
+@end
+
+@interface CLXTrackingAuctionStore () {
+    os_unfair_lock _lock;
+}
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXTrackingAuctionEntry *> *entries;
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *recencyOrder; // Least recently used first
+@property (nonatomic, strong) NSCountedSet<NSString *> *pinnedAuctions; // One count per pinAuction: not yet unpinned
+@property (nonatomic, assign) NSUInteger bytes;
+@property (nonatomic, assign) NSUInteger evictions;
+@property (nonatomic, strong) NSCache<CLXTrackingResponseDocument *, NSDictionary *> *parsedResponses;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXTrackingAuctionStore
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _capacity = kCLXDefaultAuctionCapacity;
+        _timeToLive = kCLXDefaultAuctionTimeToLive;
+        _retirementGracePeriod = kCLXDefaultRetirementGracePeriod;
+        _entries = [NSMutableDictionary dictionary];
+        _recencyOrder = [NSMutableOrderedSet orderedSet];
+        _pinnedAuctions = [NSCountedSet set];
+        _parsedResponses = [[NSCache alloc] init];
+        _parsedResponses.name = @"io.cloudx.trackingauctionstore.responses";
+        _parsedResponses.countLimit = kCLXDefaultParsedResponseCacheLimit;
+        _logger = [[CLXLogger alloc] initWithCategory:@"TrackingAuctionStore"];
+    }
+    return self;
+}
+
+- (NSUInteger)parsedResponseCacheLimit {
+    return self.parsedResponses.countLimit;
+}
+
+- (void)setParsedResponseCacheLimit:(NSUInteger)parsedResponseCacheLimit {
+    self.parsedResponses.countLimit = parsedResponseCacheLimit;
+}
+
+#pragma mark - Metrics
+
+- (NSUInteger)liveAuctionCount {
+    NSTimeInterval now = [self _now];
+    os_unfair_lock_lock(&_lock);
+    [self _purgeExpiredAuctionsAt:now];
+    NSUInteger count = self.entries.count;
+    os_unfair_lock_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)retainedBytes {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger bytes = self.bytes;
+    os_unfair_lock_unlock(&_lock);
+    return bytes;
+}
+
+- (NSUInteger)evictedAuctionCount {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger evictions = self.evictions;
+    os_unfair_lock_unlock(&_lock);
+    return evictions;
+}
+
+#pragma mark - Reads
+
+- (nullable CLXTrackingAuctionEntry *)entryForAuction:(NSString *)auctionId {
+    if (!auctionId) {
+        return nil;
+    }
+
+    NSTimeInterval now = [self _now];
+    os_unfair_lock_lock(&_lock);
+    CLXTrackingAuctionEntry *entry = self.entries[auctionId];
+    if (entry && [self _isEntryExpired:entry now:now]) {
+        [self _removeEntry:entry];
+        entry = nil;
+    }
+    if (entry) {
+        [self _touchEntry:entry now:now];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    // Entries are replaced rather than mutated, so the caller can read this one without the lock
+    return entry;
+}
+
+#pragma mark - Writes
+
+- (void)setRequestData:(nullable NSDictionary *)requestData forAuction:(NSString *)auctionId {
+    NSUInteger bytes = [CLXTrackingAuctionStore estimatedBytesForJSONObject:requestData];
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        entry.requestData = requestData;
+        entry.requestBytes = bytes;
+    }];
+}
+
+- (void)setResponseData:(nullable NSDictionary *)responseData forAuction:(NSString *)auctionId {
+    NSUInteger bytes = [CLXTrackingAuctionStore estimatedBytesForJSONObject:responseData];
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        entry.responseData = responseData;
+        entry.responseDocument = nil;
+        entry.responseBytes = bytes;
+    }];
+}
+
+- (void)setResponseJSONData:(nullable NSData *)responseJSONData forAuction:(NSString *)auctionId {
+    CLXTrackingResponseDocument *document = responseJSONData ? [[CLXTrackingResponseDocument alloc] initWithData:[responseJSONData copy] parsedResponses:self.parsedResponses] : nil;
+    NSUInteger bytes = document ? kCLXEstimatedObjectOverhead + document.data.length : 0;
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        entry.responseData = nil;
+        entry.responseDocument = document;
+        entry.responseBytes = bytes;
+    }];
+}
+
+- (void)setLoadedBidId:(nullable NSString *)bidId forAuction:(NSString *)auctionId {
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        entry.loadedBidId = bidId;
+    }];
+}
+
+- (void)setLoopIndex:(NSInteger)loopIndex forAuction:(NSString *)auctionId {
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        entry.loopIndex = @(loopIndex);
+    }];
+}
+
+- (void)setSdkValue:(nullable NSString *)value forKey:(NSString *)key auction:(NSString *)auctionId {
+    [self _updateAuction:auctionId changes:^(CLXTrackingAuctionEntry *entry) {
+        NSMutableDictionary<NSString *, NSString *> *sdkValues = [entry.sdkValues mutableCopy] ?: [NSMutableDictionary dictionary];
+        sdkValues[key] = value;
+        entry.sdkValues = sdkValues;
+    }];
+}
+
+#pragma mark - Retirement
+
+- (void)retireAuction:(NSString *)auctionId {
+    if (!auctionId) {
+        return;
+    }
+
+    NSTimeInterval retireTime = [self _now] + self.retirementGracePeriod;
+    os_unfair_lock_lock(&_lock);
+    CLXTrackingAuctionEntry *entry = self.entries[auctionId];
+    if (entry && (entry.retireTime == 0 || retireTime < entry.retireTime)) {
+        entry.retireTime = retireTime;
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (entry) {
+        CLX_LOG_DEBUG(self.logger, @"🗂️ [TrackingAuctionStore] Retiring auction %@ in %.0fs", auctionId, self.retirementGracePeriod);
+    }
+}
+
+#pragma mark - Pinning
+
+- (void)pinAuction:(NSString *)auctionId {
+    if (!auctionId) {
+        return;
+    }
+
+    os_unfair_lock_lock(&_lock);
+    [self.pinnedAuctions addObject:auctionId];
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)unpinAuction:(NSString *)auctionId {
+    if (!auctionId) {
+        return;
+    }
+
+    NSTimeInterval now = [self _now];
+    os_unfair_lock_lock(&_lock);
+    [self.pinnedAuctions removeObject:auctionId];
+    CLXTrackingAuctionEntry *entry = self.entries[auctionId];
+    if (entry && [self.pinnedAuctions countForObject:auctionId] == 0) {
+        // The pin may have outlived the TTL or the grace period; give the payloads about to be
+        // built for the released ad a full window before the entry can go
+        [self _touchEntry:entry now:now];
+        if (entry.retireTime > 0) {
+            entry.retireTime = MAX(entry.retireTime, now + self.retirementGracePeriod);
+        }
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (BOOL)isAuctionPinned:(NSString *)auctionId {
+    if (!auctionId) {
+        return NO;
+    }
+
+    os_unfair_lock_lock(&_lock);
+    BOOL pinned = [self.pinnedAuctions countForObject:auctionId] > 0;
+    os_unfair_lock_unlock(&_lock);
+    return pinned;
+}
+
+#pragma mark - Removal
+
+- (void)removeAuction:(NSString *)auctionId {
+    if (!auctionId) {
+        return;
+    }
+
+    os_unfair_lock_lock(&_lock);
+    CLXTrackingAuctionEntry *entry = self.entries[auctionId];
+    if (entry) {
+        [self _removeEntry:entry];
+    }
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)removeAllAuctions {
+    os_unfair_lock_lock(&_lock);
+    [self.entries removeAllObjects];
+    [self.recencyOrder removeAllObjects];
+    [self.pinnedAuctions removeAllObjects];
+    self.bytes = 0;
+    os_unfair_lock_unlock(&_lock);
+    [self.parsedResponses removeAllObjects];
+}
+
+#pragma mark - Size Estimation
+
++ (NSUInteger)estimatedBytesForJSONObject:(nullable id)object {
+    if (!object) {
+        return 0;
+    }
+
+    if ([object isKindOfClass:[NSString class]]) {
+        return kCLXEstimatedObjectOverhead + [(NSString *)object lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        __block NSUInteger bytes = kCLXEstimatedObjectOverhead;
+        [(NSDictionary *)object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+            bytes += [self estimatedBytesForJSONObject:key] + [self estimatedBytesForJSONObject:value];
+        }];
+        return bytes;
+    }
+
+    if ([object isKindOfClass:[NSArray class]]) {
+        NSUInteger bytes = kCLXEstimatedObjectOverhead;
+        for (id element in (NSArray *)object) {
+            bytes += [self estimatedBytesForJSONObject:element];
+        }
+        return bytes;
+    }
+
+    // NSNumber, NSNull and anything else
+    return kCLXEstimatedObjectOverhead;
+}
+
+#pragma mark - Private Methods
+
+- (NSTimeInterval)_now {
+    return self.clockForTesting ? self.clockForTesting() : [NSProcessInfo processInfo].systemUptime;
+}
+
+/**
+ * Copy-on-write update: the changes are applied to a private copy which then replaces the
+ * published entry, so readers holding the previous entry never see a partial write.
+ */
+- (void)_updateAuction:(NSString *)auctionId changes:(void (^)(CLXTrackingAuctionEntry *entry))changes {
+    if (!auctionId) {
+        return;
+    }
+
+    NSTimeInterval now = [self _now];
+    os_unfair_lock_lock(&_lock);
+    [self _purgeExpiredAuctionsAt:now];
+
+    CLXTrackingAuctionEntry *current = self.entries[auctionId];
+    CLXTrackingAuctionEntry *next = current ? [current copy] : [[CLXTrackingAuctionEntry alloc] init];
+    next.auctionId = auctionId;
+    changes(next);
+    next.estimatedBytes = next.requestBytes + next.responseBytes;
+
+    self.bytes = self.bytes - current.estimatedBytes + next.estimatedBytes;
+    self.entries[auctionId] = next;
+    [self _touchEntry:next now:now];
+    NSUInteger evicted = [self _enforceCapacity];
+    os_unfair_lock_unlock(&_lock);
+
+    if (evicted > 0) {
+        CLX_LOG_DEBUG(self.logger, @"🗂️ [TrackingAuctionStore] Evicted %lu least recently used auction(s)", (unsigned long)evicted);
+    }
+}
+
+// The following helpers expect the store lock to be held
+
+- (BOOL)_isEntryExpired:(CLXTrackingAuctionEntry *)entry now:(NSTimeInterval)now {
+    if ([self.pinnedAuctions countForObject:entry.auctionId] > 0) {
+        return NO;
+    }
+    if (entry.retireTime > 0 && now >= entry.retireTime) {
+        return YES;
+    }
+    return self.timeToLive > 0 && now - entry.lastAccessTime >= self.timeToLive;
+}
+
+- (void)_touchEntry:(CLXTrackingAuctionEntry *)entry now:(NSTimeInterval)now {
+    entry.lastAccessTime = now;
+    [self.recencyOrder removeObject:entry.auctionId];
+    [self.recencyOrder addObject:entry.auctionId];
+}
+
+- (void)_removeEntry:(CLXTrackingAuctionEntry *)entry {
+    self.bytes -= entry.estimatedBytes;
+    [self.entries removeObjectForKey:entry.auctionId];
+    [self.recencyOrder removeObject:entry.auctionId];
+    if (entry.responseDocument) {
+        [self.parsedResponses removeObjectForKey:entry.responseDocument];
+    }
+}
+
+- (void)_purgeExpiredAuctionsAt:(NSTimeInterval)now {
+    for (CLXTrackingAuctionEntry *entry in [self.entries allValues]) {
+        if ([self _isEntryExpired:entry now:now]) {
+            [self _removeEntry:entry];
+        }
+    }
+}
+
+// Pinned auctions are skipped, so the store can stay over capacity while cached ads hold them
+- (NSUInteger)_enforceCapacity {
+    NSUInteger capacity = MAX(self.capacity, (NSUInteger)1);
+    NSUInteger evicted = 0;
+    while (self.entries.count > capacity) {
+        NSString *victim = nil;
+        for (NSString *auctionId in self.recencyOrder) {
+            if ([self.pinnedAuctions countForObject:auctionId] == 0) {
+                victim = auctionId;
+                break;
+            }
+        }
+        if (!victim) {
+            break;
+        }
+        [self _removeEntry:self.entries[victim]];
+        evicted += 1;
+    }
+    self.evictions += evicted;
+    return evicted;
+}
+
+@end
@@ -1,26 +1,142 @@
 #import <CloudXCore/CLXTrackingFieldResolver.h>
+#import <CloudXCore/CLXTrackingAuctionStore.h>
 #import <CloudXCore/CLXSDKConfig.h>
 #import <CloudXCore/CLXSystemInformation.h>
 #import <CloudXCore/CLXLogger.h>
 #import <CloudXCore/CLXPrivacyService.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
 
+#pragma mark - Compiled Field Programs
+
+/**
+ * Data source selected by a tracking field's prefix
+ */
+typedef NS_ENUM(NSInteger, CLXTrackingFieldSource) {
+    CLXTrackingFieldSourceUnknown,
+    CLXTrackingFieldSourceSdk,
+    CLXTrackingFieldSourceBidRequest,
+    CLXTrackingFieldSourceBid,
+    CLXTrackingFieldSourceConfig,
+    CLXTrackingFieldSourceBidResponse
+};
+
+/**
+ * How a tracking field reads its source: a generic dotted path, or one of the special cases
+ */
+typedef NS_ENUM(NSInteger, CLXTrackingFieldAccessor) {
+    CLXTrackingFieldAccessorPath,
+    CLXTrackingFieldAccessorSessionId,
+    CLXTrackingFieldAccessorReleaseVersion,
+    CLXTrackingFieldAccessorDeviceType,
+    CLXTrackingFieldAccessorAuctionSdkValue,
+    CLXTrackingFieldAccessorLoopIndex,
+    CLXTrackingFieldAccessorDeviceIfa,
+    CLXTrackingFieldAccessorBidAdapterCode,
+    CLXTrackingFieldAccessorBidCreativeId,
+    CLXTrackingFieldAccessorBidPrice,
+    CLXTrackingFieldAccessorBidWidth,
+    CLXTrackingFieldAccessorBidHeight,
+    CLXTrackingFieldAccessorBidDealId,
+    CLXTrackingFieldAccessorTestGroupName
+};
+
+/**
+ * Right-hand side of an array predicate like [rank=${bid.ext.cloudx.rank}]
+ */
+typedef NS_ENUM(NSInteger, CLXTrackingConditionKind) {
+    CLXTrackingConditionKindLiteral,
+    CLXTrackingConditionKindWinningRank,
+    CLXTrackingConditionKindPath
+};
+
+/**
+ * One pre-parsed path segment: a dictionary key or an array predicate
+ */
+@interface CLXTrackingPathSegment : NSObject
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, assign) BOOL isArrayPredicate;
+@property (nonatomic, assign) BOOL isValidPredicate;
+@property (nonatomic, copy, nullable) NSString *conditionField;
+@property (nonatomic, assign) CLXTrackingConditionKind conditionKind;
+@property (nonatomic, copy, nullable) NSString *conditionLiteral;
+@property (nonatomic, copy, nullable) NSArray<CLXTrackingPathSegment *> *conditionPath;
+@end
+
+@implementation CLXTrackingPathSegment
+@end
+
+/**
+ * A tracking field compiled once per config into its source, accessor and path segments
+ */
+@interface CLXTrackingFieldProgram : NSObject
+@property (nonatomic, copy) NSString *field;
+@property (nonatomic, assign) CLXTrackingFieldSource source;
+@property (nonatomic, assign) CLXTrackingFieldAccessor accessor;
+@property (nonatomic, copy) NSArray<CLXTrackingPathSegment *> *segments;
+@end
+
+@implementation CLXTrackingFieldProgram
+@end
+
+/**
+ * Immutable config and session state. Writers publish a new copy; payload builds read one
+ * snapshot up front so they never observe a half-applied config.
+ */
+@interface CLXTrackingResolverSnapshot : NSObject <NSCopying>
+@property (nonatomic, copy, nullable) NSArray<NSString *> *tracking;
+@property (nonatomic, copy, nullable) NSArray<CLXTrackingFieldProgram *> *trackingPrograms;
+@property (nonatomic, copy, nullable) NSDictionary *configDataMap;
+@property (nonatomic, copy, nullable) NSString *accountId;
+@property (nonatomic, copy, nullable) NSString *sessionId;
+@property (nonatomic, copy, nullable) NSString *sdkVersion;
+@property (nonatomic, copy, nullable) NSString *deviceType;
+@property (nonatomic, copy, nullable) NSString *abTestGroup;
+@property (nonatomic, copy, nullable) NSString *hashedGeoIp;
+@end
+
+@implementation CLXTrackingResolverSnapshot
+
+- (id)copyWithZone:(NSZone *)zone {
+    CLXTrackingResolverSnapshot *copy = [[CLXTrackingResolverSnapshot alloc] init];
+    copy.tracking = self.tracking;
+    copy.trackingPrograms = self.trackingPrograms;
+    copy.configDataMap = self.configDataMap;
+    copy.accountId = self.accountId;
+    copy.sessionId = self.sessionId;
+    copy.sdkVersion = self.sdkVersion;
+    copy.deviceType = self.deviceType;
+    copy.abTestGroup = self.abTestGroup;
+    copy.hashedGeoIp = self.hashedGeoIp;
+    return copy;
+}
+
+@end
+
+/**
+ * Per-payload lookups shared by every program, so the winning bid is located once per build
+ */
+@interface CLXTrackingPayloadContext : NSObject
+@property (nonatomic, copy) NSString *auctionId;
+@property (nonatomic, strong) CLXTrackingResolverSnapshot *snapshot;
+@property (nonatomic, strong, nullable) NSDictionary *requestData;
+@property (nonatomic, strong, nullable) NSDictionary *responseData;
+@property (nonatomic, strong, nullable) NSDictionary *bidObj;
+@property (nonatomic, copy, nullable) NSString *impid;
+@property (nonatomic, copy, nullable) NSString *loadedBidId;
+@property (nonatomic, strong, nullable) NSNumber *loopIndex;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *sdkValues;
+@property (nonatomic, assign) BOOL bidLookupDone;
+@end
+
+@implementation CLXTrackingPayloadContext
+@end
+
 @interface CLXTrackingFieldResolver ()
 
-@property (nonatomic, strong) NSArray<NSString *> *tracking;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *requestDataMap;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *responseDataMap;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *loadedBidMap;
-@property (nonatomic, strong) NSDictionary *configDataMap;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSString *> *> *sdkMap;
-@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *auctionedLoopIndex;
-
-@property (nonatomic, copy) NSString *sessionId;
-@property (nonatomic, copy) NSString *sdkVersion;
-@property (nonatomic, copy) NSString *deviceType;
-@property (nonatomic, copy) NSString *abTestGroup;
-@property (nonatomic, copy) NSString *accountId;
-@property (nonatomic, copy) NSString *hashedGeoIp;
+@property (nonatomic, strong, readwrite) CLXTrackingAuctionStore *auctionStore;
+
+// Published atomically; only replaced, never mutated in place
+@property (atomic, strong) CLXTrackingResolverSnapshot *snapshot;
 
 @property (nonatomic, strong) CLXLogger *logger;
 
@@ -44,20 +160,26 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _requestDataMap = [NSMutableDictionary dictionary];
-        _responseDataMap = [NSMutableDictionary dictionary];
-        _loadedBidMap = [NSMutableDictionary dictionary];
-        _sdkMap = [NSMutableDictionary dictionary];
-        _auctionedLoopIndex = [NSMutableDictionary dictionary];
+        _auctionStore = [[CLXTrackingAuctionStore alloc] init];
+        _snapshot = [[CLXTrackingResolverSnapshot alloc] init];
         _logger = [[CLXLogger alloc] initWithCategory:@"TrackingFieldResolver"];
     }
     return self;
 }
 
+/**
+ * Copies the current snapshot, applies the changes and publishes the result.
+ * Writers are serialized so concurrent updates are not lost; readers never wait.
+ */
+- (void)updateSnapshot:(void (^)(CLXTrackingResolverSnapshot *snapshot))changes {
+    @synchronized (self) {
+        CLXTrackingResolverSnapshot *next = [self.snapshot copy];
+        changes(next);
+        self.snapshot = next;
+    }
+}
+
 - (void)setConfig:(CLXSDKConfigResponse *)config {
-    self.accountId = config.accountID;
-    self.tracking = config.tracking;
-    
     // Store raw config as dictionary for field resolution
     // Note: In a real implementation, you'd want to store the original JSON
     // For now, we'll create a basic representation
@@ -65,85 +187,131 @@
     if (config.accountID) configDict[@"accountID"] = config.accountID;
     if (config.organizationID) configDict[@"organizationID"] = config.organizationID;
     if (config.sessionID) configDict[@"sessionID"] = config.sessionID;
-    self.configDataMap = [configDict copy];
     
-    [self.logger debug:[NSString stringWithFormat:@"Config set with %lu tracking fields", (unsigned long)self.tracking.count]];
+    [self updateSnapshot:^(CLXTrackingResolverSnapshot *snapshot) {
+        // Config is re-applied on every impression; only recompile when the field list changes
+        if (!snapshot.trackingPrograms || ![snapshot.tracking isEqualToArray:config.tracking]) {
+            snapshot.trackingPrograms = [self compileTrackingFields:config.tracking];
+        }
+        snapshot.tracking = config.tracking;
+        snapshot.accountId = config.accountID;
+        snapshot.configDataMap = configDict;
+    }];
+    
+    CLX_LOG_DEBUG(self.logger, @"Config set with %lu tracking fields", (unsigned long)config.tracking.count);
 }
 
 - (void)setRequestData:(NSString *)auctionId bidRequestJSON:(NSDictionary *)bidRequestJSON {
-    self.requestDataMap[auctionId] = bidRequestJSON;
-    [self.logger debug:[NSString stringWithFormat:@"Request data set for auction: %@", auctionId]];
+    [self.auctionStore setRequestData:bidRequestJSON forAuction:auctionId];
+    CLX_LOG_DEBUG(self.logger, @"Request data set for auction: %@", auctionId);
 }
 
 - (void)setResponseData:(NSString *)auctionId bidResponseJSON:(NSDictionary *)bidResponseJSON {
-    self.responseDataMap[auctionId] = bidResponseJSON;
-    [self.logger debug:[NSString stringWithFormat:@"Response data set for auction: %@", auctionId]];
+    [self.auctionStore setResponseData:bidResponseJSON forAuction:auctionId];
+    CLX_LOG_DEBUG(self.logger, @"Response data set for auction: %@", auctionId);
+}
+
+- (void)setResponseData:(NSString *)auctionId bidResponseData:(NSData *)bidResponseData {
+    [self.auctionStore setResponseJSONData:bidResponseData forAuction:auctionId];
+    CLX_LOG_DEBUG(self.logger, @"Response bytes (%lu) set for auction: %@", (unsigned long)bidResponseData.length, auctionId);
 }
 
 - (void)saveLoadedBid:(NSString *)auctionId bidId:(NSString *)bidId {
-    self.loadedBidMap[auctionId] = bidId;
-    [self.logger debug:[NSString stringWithFormat:@"Loaded bid saved: %@ for auction: %@", bidId, auctionId]];
+    [self.auctionStore setLoadedBidId:bidId forAuction:auctionId];
+    CLX_LOG_DEBUG(self.logger, @"Loaded bid saved: %@ for auction: %@", bidId, auctionId);
 }
 
 - (void)setLoopIndex:(NSString *)auctionId loopIndex:(NSInteger)loopIndex {
-    self.auctionedLoopIndex[auctionId] = @(loopIndex);
-    [self.logger debug:[NSString stringWithFormat:@"Loop index set: %ld for auction: %@", (long)loopIndex, auctionId]];
+    [self.auctionStore setLoopIndex:loopIndex forAuction:auctionId];
+    CLX_LOG_DEBUG(self.logger, @"Loop index set: %ld for auction: %@", (long)loopIndex, auctionId);
 }
 
 - (void)setSessionConstData:(NSString *)sessionId
                  sdkVersion:(NSString *)sdkVersion
                  deviceType:(NSString *)deviceType
                 abTestGroup:(NSString *)abTestGroup {
-    self.sessionId = sessionId;
-    self.sdkVersion = sdkVersion;
-    self.deviceType = deviceType;
-    self.abTestGroup = abTestGroup;
+    [self updateSnapshot:^(CLXTrackingResolverSnapshot *snapshot) {
+        snapshot.sessionId = sessionId;
+        snapshot.sdkVersion = sdkVersion;
+        snapshot.deviceType = deviceType;
+        snapshot.abTestGroup = abTestGroup;
+    }];
     
     [self.logger debug:@"Session constant data set"];
 }
 
 - (void)setHashedGeoIp:(nullable NSString *)hashedGeoIp {
-    _hashedGeoIp = [hashedGeoIp copy];
-    [self.logger debug:[NSString stringWithFormat:@"Set hashed geo IP: %@", hashedGeoIp ? @"(present)" : @"(none)"]];
+    [self updateSnapshot:^(CLXTrackingResolverSnapshot *snapshot) {
+        snapshot.hashedGeoIp = hashedGeoIp;
+    }];
+    CLX_LOG_DEBUG(self.logger, @"Set hashed geo IP: %@", hashedGeoIp ? @"(present)" : @"(none)");
 }
 
 - (nullable NSString *)buildPayload:(NSString *)auctionId {
-    if (!self.tracking || self.tracking.count == 0) {
+    CLXTrackingResolverSnapshot *snapshot = self.snapshot;
+    if (!snapshot.tracking || snapshot.tracking.count == 0) {
         [self.logger debug:@"No tracking configuration available"];
         return nil;
     }
     
-    NSMutableArray<NSString *> *values = [NSMutableArray array];
+    NSArray<CLXTrackingFieldProgram *> *programs = snapshot.trackingPrograms;
+    NSMutableArray<NSString *> *values = [NSMutableArray arrayWithCapacity:programs.count];
+    
+    CLX_LOG_DEBUG(self.logger, @"🔍 [PAYLOAD DEBUG] Building payload for auction: %@ with %lu fields", auctionId, (unsigned long)programs.count);
     
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [PAYLOAD DEBUG] Building payload for auction: %@ with %lu fields", auctionId, (unsigned long)self.tracking.count]];
+    CLXTrackingPayloadContext *context = [[CLXTrackingPayloadContext alloc] init];
+    context.auctionId = auctionId;
+    context.snapshot = snapshot;
+    CLXTrackingAuctionEntry *entry = [self.auctionStore entryForAuction:auctionId];
+    context.requestData = entry.requestData;
+    context.responseData = entry.responseData;
+    context.loadedBidId = entry.loadedBidId;
+    context.loopIndex = entry.loopIndex;
+    context.sdkValues = entry.sdkValues;
     
-    for (NSString *field in self.tracking) {
-        id resolvedValue = [self resolveField:auctionId field:field];
+    for (CLXTrackingFieldProgram *program in programs) {
+        id resolvedValue = [self executeProgram:program context:context];
         NSString *stringValue = resolvedValue ? [resolvedValue description] : @"";
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] %@ = '%@'", field, stringValue]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] %@ = '%@'", program.field, stringValue);
         [values addObject:stringValue];
     }
     
     NSString *payload = [values componentsJoinedByString:@";"];
-    [self.logger debug:[NSString stringWithFormat:@"Built payload with %lu fields for auction: %@ - Payload: %@", (unsigned long)values.count, auctionId, payload]];
+    CLX_LOG_DEBUG(self.logger, @"Built payload with %lu fields for auction: %@ - Payload: %@", (unsigned long)values.count, auctionId, payload);
     
     return payload;
 }
 
 - (nullable NSString *)getAccountId {
-    return self.accountId;
+    return self.snapshot.accountId;
 }
 
 - (void)clear {
-    [self.requestDataMap removeAllObjects];
-    [self.responseDataMap removeAllObjects];
-    [self.loadedBidMap removeAllObjects];
-    [self.sdkMap removeAllObjects];
-    [self.auctionedLoopIndex removeAllObjects];
+    [self.auctionStore removeAllAuctions];
     
     [self.logger debug:@"All tracking data cleared"];
 }
 
+- (void)clearAuction:(NSString *)auctionId {
+    [self.auctionStore retireAuction:auctionId];
+}
+
+- (void)holdAuction:(NSString *)auctionId {
+    [self.auctionStore pinAuction:auctionId];
+}
+
+- (void)releaseAuction:(NSString *)auctionId {
+    [self.auctionStore unpinAuction:auctionId];
+}
+
+- (NSUInteger)liveAuctionCount {
+    return self.auctionStore.liveAuctionCount;
+}
+
+- (NSUInteger)retainedBytes {
+    return self.auctionStore.retainedBytes;
+}
+
 #pragma mark - Private Methods
 
 /**
@@ -176,32 +344,30 @@
         return [self resolveBidResponseField:auctionId field:field];
     }
     
-    [self.logger debug:[NSString stringWithFormat:@"Unknown field prefix: %@", field]];
+    CLX_LOG_DEBUG(self.logger, @"Unknown field prefix: %@", field);
     return nil;
 }
 
 - (nullable id)resolveSdkField:(NSString *)auctionId field:(NSString *)field {
     if ([field isEqualToString:@"sdk.sessionId"]) {
-        return self.sessionId;
+        return self.snapshot.sessionId;
     } else if ([field isEqualToString:@"sdk.releaseVersion"]) {
-        return self.sdkVersion ?: @"1.0.0";
+        return self.snapshot.sdkVersion ?: @"1.0.0";
     } else if ([field isEqualToString:@"sdk.deviceType"]) {
-        return self.deviceType;
+        return self.snapshot.deviceType;
     } else if ([field isEqualToString:@"sdk.responseTimeMillis"]) {
         // This should be set dynamically per auction
-        NSMutableDictionary *auctionSdkMap = self.sdkMap[auctionId];
-        return auctionSdkMap[field];
+        return [self.auctionStore entryForAuction:auctionId].sdkValues[field];
     } else {
         // Check auction-specific SDK parameters
-        NSMutableDictionary *auctionSdkMap = self.sdkMap[auctionId];
-        return auctionSdkMap[field];
+        return [self.auctionStore entryForAuction:auctionId].sdkValues[field];
     }
 }
 
 - (nullable id)resolveBidRequestField:(NSString *)auctionId field:(NSString *)field {
     // Handle special cases first
     if ([field isEqualToString:@"bidRequest.loopIndex"]) {
-        return self.auctionedLoopIndex[auctionId];
+        return [self.auctionStore entryForAuction:auctionId].loopIndex;
     }
     
     if ([field isEqualToString:@"bidRequest.device.ifa"]) {
@@ -211,11 +377,11 @@
         // Check if personal data should be cleared due to privacy settings
         if ([privacyService shouldClearPersonalData]) {
             [self.logger debug:@"🔒 [CLXTrackingFieldResolver] Privacy settings require clearing personal data - using session ID"];
-            return self.sessionId ?: @"";
+            return self.snapshot.sessionId ?: @"";
         }
         
         // Check DNT (Do Not Track) flag from bid request
-        NSDictionary *requestData = self.requestDataMap[auctionId];
+        NSDictionary *requestData = [self.auctionStore entryForAuction:auctionId].requestData;
         NSDictionary *device = [requestData objectForKey:kCLXCoreDeviceKey];
         NSNumber *dntValue = [device objectForKey:kCLXCoreDntKey];
         BOOL isLimitedAdTrackingEnabled = [dntValue intValue] == 1;
@@ -231,9 +397,10 @@
             }
             
             // Fallback to hashed geo IP
-            if (self.hashedGeoIp && self.hashedGeoIp.length > 0) {
+            NSString *hashedGeoIp = self.snapshot.hashedGeoIp;
+            if (hashedGeoIp && hashedGeoIp.length > 0) {
                 [self.logger debug:@"🔒 [CLXTrackingFieldResolver] Using hashed geo IP"];
-                return self.hashedGeoIp;
+                return hashedGeoIp;
             }
             
             [self.logger debug:@"🔒 [CLXTrackingFieldResolver] No privacy-safe identifiers available - returning empty string"];
@@ -242,12 +409,12 @@
         
         // Normal case: return the actual IFA
         NSString *ifa = [self resolveNestedField:requestData path:@"device.ifa"];
-        [self.logger debug:[NSString stringWithFormat:@"✅ [CLXTrackingFieldResolver] Using device IFA: %@", ifa ? @"(present)" : @"(none)"]];
+        CLX_LOG_DEBUG(self.logger, @"✅ [CLXTrackingFieldResolver] Using device IFA: %@", ifa ? @"(present)" : @"(none)");
         return ifa;
     }
     
     // General case: resolve using dot notation
-    NSDictionary *requestData = self.requestDataMap[auctionId];
+    NSDictionary *requestData = [self.auctionStore entryForAuction:auctionId].requestData;
     if (!requestData) {
         return nil;
     }
@@ -258,30 +425,30 @@
     if ([path isEqualToString:@"device.geo.country"]) {
         NSDictionary *device = requestData[@"device"];
         NSDictionary *geo = device[@"geo"];
-        [self.logger debug:[NSString stringWithFormat:@"🌍 [CLXTrackingFieldResolver] Resolving device.geo.country: '%@' (device:%@, geo:%@)", 
-                           geo[@"country"], device ? @"✓" : @"✗", geo ? @"✓" : @"✗"]];
+        CLX_LOG_DEBUG(self.logger, @"🌍 [CLXTrackingFieldResolver] Resolving device.geo.country: '%@' (device:%@, geo:%@)",
+                      geo[@"country"], device ? @"✓" : @"✗", geo ? @"✓" : @"✗");
     }
     
     return [self resolveNestedField:requestData path:path];
 }
 
 - (nullable id)resolveBidField:(NSString *)auctionId field:(NSString *)field {
-    NSString *bidId = self.loadedBidMap[auctionId];
+    NSString *bidId = [self.auctionStore entryForAuction:auctionId].loadedBidId;
     if (!bidId) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No bidId found for auction: %@", auctionId]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No bidId found for auction: %@", auctionId);
         return nil;
     }
     
-    NSDictionary *responseData = self.responseDataMap[auctionId];
+    NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
     if (!responseData) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No response data for auction: %@", auctionId]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No response data for auction: %@", auctionId);
         return nil;
     }
     
     // Find the winning bid object in seatbid array
     NSArray *seatbids = responseData[@"seatbid"];
     if (![seatbids isKindOfClass:[NSArray class]]) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No seatbid array found in response"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No seatbid array found in response");
         return nil;
     }
     
@@ -295,7 +462,7 @@
             if ([bid[@"id"] isEqualToString:bidId]) {
                 bidObj = bid;
                 impid = bid[@"impid"];  // 🔗 Get the impression ID
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Found bid object for bidId: %@", bidId]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Found bid object for bidId: %@", bidId);
                 break;
             }
         }
@@ -303,7 +470,7 @@
     }
     
     if (!bidObj) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No bid object found for bidId: %@", bidId]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No bid object found for bidId: %@", bidId);
         return nil;
     }
     
@@ -311,7 +478,7 @@
     if ([field isEqualToString:@"bid.ext.prebid.meta.adaptercode"]) {
         // Direct access to the bidder field
         id result = bidObj[@"ext"][@"prebid"][@"meta"][@"adaptercode"];
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Direct access to bidder: %@", result ?: @"(nil)"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Direct access to bidder: %@", result ?: @"(nil)");
         return result;
     }
     
@@ -330,7 +497,7 @@
         if (!width) {
             // Fallback: get from original bid request impression format
             // Find the matching impression by impid
-            NSDictionary *requestData = self.requestDataMap[auctionId];
+            NSDictionary *requestData = [self.auctionStore entryForAuction:auctionId].requestData;
             NSArray *impressions = requestData[@"imp"];
             if ([impressions isKindOfClass:[NSArray class]]) {
                 for (NSDictionary *imp in impressions) {
@@ -353,7 +520,7 @@
         if (!height) {
             // Fallback: get from original bid request impression format
             // Find the matching impression by impid
-            NSDictionary *requestData = self.requestDataMap[auctionId];
+            NSDictionary *requestData = [self.auctionStore entryForAuction:auctionId].requestData;
             NSArray *impressions = requestData[@"imp"];
             if ([impressions isKindOfClass:[NSArray class]]) {
                 for (NSDictionary *imp in impressions) {
@@ -372,12 +539,12 @@
     
     if ([field isEqualToString:@"bid.dealid"]) {
         id dealid = bidObj[@"dealid"];
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] bid.dealid lookup - bidObj keys: %@", [bidObj allKeys]]];
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] bid.dealid direct value: '%@' (type: %@)", dealid ?: @"(nil)", dealid ? NSStringFromClass([dealid class]) : @"nil"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] bid.dealid lookup - bidObj keys: %@", [bidObj allKeys]);
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] bid.dealid direct value: '%@' (type: %@)", dealid ?: @"(nil)", dealid ? NSStringFromClass([dealid class]) : @"nil");
         
         // If not found in bid object, look in the resolved request debug data
         if (!dealid) {
-            NSDictionary *responseData = self.responseDataMap[auctionId];
+            NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
             if (responseData) {
                 // Look for deal ID in ext.debug.rounds.1.resolvedrequest.imp[0].ext.prebid.bidder.meta.line_items[0].deal.id
                 id debugData = responseData[@"ext"][@"debug"][@"rounds"][@"1"][@"resolvedrequest"][@"imp"];
@@ -387,13 +554,13 @@
                     if ([lineItems isKindOfClass:[NSArray class]] && [(NSArray *)lineItems count] > 0) {
                         NSDictionary *lineItem = lineItems[0];
                         dealid = lineItem[@"deal"][@"id"];
-                        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] bid.dealid found in resolved request: '%@'", dealid ?: @"(nil)"]];
+                        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] bid.dealid found in resolved request: '%@'", dealid ?: @"(nil)");
                     }
                 }
             }
         }
         
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] bid.dealid final value: '%@'", dealid ?: @"(nil)"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] bid.dealid final value: '%@'", dealid ?: @"(nil)");
         return dealid;
     }
     
@@ -405,9 +572,9 @@
         path = field;
     }
     
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Fallback path resolution for '%@' -> '%@'", field, path]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Fallback path resolution for '%@' -> '%@'", field, path);
     id result = [self resolveNestedField:bidObj path:path];
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Result for %@: %@", field, result ?: @"(nil)"]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Result for %@: %@", field, result ?: @"(nil)");
     return result;
 }
 
@@ -434,7 +601,7 @@
         return nil;
     }
     
-    NSDictionary *requestData = self.requestDataMap[auctionId];
+    NSDictionary *requestData = [self.auctionStore entryForAuction:auctionId].requestData;
     if (!requestData) {
         return nil;
     }
@@ -485,16 +652,16 @@
 
 - (nullable id)resolveConfigField:(NSString *)field {
     if ([field isEqualToString:@"config.testGroupName"]) {
-        return self.abTestGroup;
+        return self.snapshot.abTestGroup;
     }
     
     // General config field resolution
     NSString *path = [field stringByReplacingOccurrencesOfString:@"config." withString:@""];
-    return [self resolveNestedField:self.configDataMap path:path];
+    return [self resolveNestedField:self.snapshot.configDataMap path:path];
 }
 
 - (nullable id)resolveBidResponseField:(NSString *)auctionId field:(NSString *)field {
-    NSDictionary *responseData = self.responseDataMap[auctionId];
+    NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
     if (!responseData) {
         return nil;
     }
@@ -518,16 +685,16 @@
 - (nullable id)resolveNestedField:(id)current path:(NSString *)path withFullResponseData:(nullable NSDictionary *)fullResponseData auctionId:(nullable NSString *)auctionId {
     // Smart path splitting that handles array lookup expressions with dots inside
     NSArray<NSString *> *segments = [self splitPathIntoSegments:path];
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolving path: %@ with %lu segments (auctionId: %@)", path, (unsigned long)segments.count, auctionId ?: @"none"]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolving path: %@ with %lu segments (auctionId: %@)", path, (unsigned long)segments.count, auctionId ?: @"none");
     
     for (NSString *segment in segments) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Processing segment: %@, current type: %@", segment, [current class]]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Processing segment: %@, current type: %@", segment, [current class]);
         
         // Check if this segment contains array lookup syntax like: participants[rank=${bid.ext.cloudx.rank}]
         if ([segment containsString:@"["] && [segment containsString:@"]"]) {
             current = [self resolveArrayLookup:current segment:segment withFullResponseData:fullResponseData auctionId:auctionId];
             if (!current) {
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Array lookup failed for segment: %@", segment]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Array lookup failed for segment: %@", segment);
                 return nil;
             }
         } else {
@@ -535,22 +702,22 @@
             if ([current isKindOfClass:[NSArray class]]) {
                 NSArray *array = (NSArray *)current;
                 current = array.count > 0 ? array[0] : nil;
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Array access, took first element: %@", current ?: @"(nil)"]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Array access, took first element: %@", current ?: @"(nil)");
             }
             
             // Handle dictionary access
             if ([current isKindOfClass:[NSDictionary class]]) {
                 NSDictionary *dict = (NSDictionary *)current;
                 current = dict[segment];
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Dict access [%@] = %@", segment, current ?: @"(nil)"]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Dict access [%@] = %@", segment, current ?: @"(nil)");
             } else {
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Current is not a dictionary, returning nil"]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Current is not a dictionary, returning nil");
                 return nil;
             }
         }
         
         if (!current) {
-            [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Current is nil after segment %@, returning nil", segment]];
+            CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Current is nil after segment %@, returning nil", segment);
             return nil;
         }
     }
@@ -627,7 +794,7 @@
     NSRange bracketEnd = [segment rangeOfString:@"]"];
     
     if (bracketStart.location == NSNotFound || bracketEnd.location == NSNotFound) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Invalid array lookup syntax: %@", segment]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Invalid array lookup syntax: %@", segment);
         return nil;
     }
     
@@ -635,7 +802,7 @@
     NSString *condition = [segment substringWithRange:NSMakeRange(bracketStart.location + 1, 
                                                                   bracketEnd.location - bracketStart.location - 1)];
     
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Array lookup - name: %@, condition: %@", arrayName, condition]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Array lookup - name: %@, condition: %@", arrayName, condition);
     
     // Get the array from current object
     if (![current isKindOfClass:[NSDictionary class]]) {
@@ -646,14 +813,14 @@
     NSDictionary *dict = (NSDictionary *)current;
     NSArray *array = dict[arrayName];
     if (![array isKindOfClass:[NSArray class]]) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No array found for key: %@", arrayName]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No array found for key: %@", arrayName);
         return nil;
     }
     
     // Parse condition like: rank=${bid.ext.cloudx.rank}
     NSArray *conditionParts = [condition componentsSeparatedByString:@"="];
     if (conditionParts.count != 2) {
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Invalid condition syntax: %@", condition]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Invalid condition syntax: %@", condition);
         return nil;
     }
     
@@ -663,28 +830,28 @@
     // Resolve the condition value (e.g., ${bid.ext.cloudx.rank})
     // Use full response data if available, otherwise fall back to current context
     NSDictionary *contextForResolution = fullResponseData ?: dict;
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Array lookup context - fullResponseData: %@, dict: %@, auctionId: %@", fullResponseData ? @"present" : @"nil", dict ? @"present" : @"nil", auctionId ?: @"none"]];
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Condition expression: %@", conditionValueExpression]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Array lookup context - fullResponseData: %@, dict: %@, auctionId: %@", fullResponseData ? @"present" : @"nil", dict ? @"present" : @"nil", auctionId ?: @"none");
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Condition expression: %@", conditionValueExpression);
     id conditionValue = [self resolveConditionValue:conditionValueExpression withBidResponseData:contextForResolution auctionId:auctionId];
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Condition field: %@, resolved value: %@ (type: %@)", conditionField, conditionValue, conditionValue ? NSStringFromClass([conditionValue class]) : @"nil"]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Condition field: %@, resolved value: %@ (type: %@)", conditionField, conditionValue, conditionValue ? NSStringFromClass([conditionValue class]) : @"nil");
     
     // Find matching element in array
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Searching %lu elements for %@=%@", (unsigned long)[array count], conditionField, conditionValue]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Searching %lu elements for %@=%@", (unsigned long)[array count], conditionField, conditionValue);
     for (NSDictionary *element in array) {
         if (![element isKindOfClass:[NSDictionary class]]) {
             continue;
         }
         
         id elementValue = element[conditionField];
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Comparing element[%@]=%@ (type: %@) with condition value %@ (type: %@)", conditionField, elementValue, elementValue ? NSStringFromClass([elementValue class]) : @"nil", conditionValue, conditionValue ? NSStringFromClass([conditionValue class]) : @"nil"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Comparing element[%@]=%@ (type: %@) with condition value %@ (type: %@)", conditionField, elementValue, elementValue ? NSStringFromClass([elementValue class]) : @"nil", conditionValue, conditionValue ? NSStringFromClass([conditionValue class]) : @"nil");
         
         if ([self valuesAreEqual:elementValue to:conditionValue]) {
-            [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Found matching element: %@", element]];
+            CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Found matching element: %@", element);
             return element;
         }
     }
     
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] No matching element found for condition %@=%@", conditionField, conditionValue]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] No matching element found for condition %@=%@", conditionField, conditionValue);
     return nil;
 }
 
@@ -711,7 +878,7 @@
     if ([expression hasPrefix:@"${"] && [expression hasSuffix:@"}"]) {
         // Extract the field path from ${...}
         NSString *fieldPath = [expression substringWithRange:NSMakeRange(2, expression.length - 3)];
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolving condition expression: %@ (auctionId: %@)", fieldPath, auctionId ?: @"none"]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolving condition expression: %@ (auctionId: %@)", fieldPath, auctionId ?: @"none");
         
         // Handle bid.ext.cloudx.rank by looking it up in the bid response data
         if ([fieldPath isEqualToString:@"bid.ext.cloudx.rank"]) {
@@ -719,23 +886,23 @@
             if (bidResponseData) {
                 id rankValue = [self resolveNestedField:bidResponseData path:@"ext.cloudx.rank"];
                 if (rankValue) {
-                    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Found rank in bidResponseData: %@", rankValue]];
+                    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Found rank in bidResponseData: %@", rankValue);
                     return rankValue;
                 }
             }
             
             // If we have an auction ID, try to get the actual bid response data
             if (auctionId) {
-                NSDictionary *responseData = self.responseDataMap[auctionId];
+                NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
                 if (responseData) {
                     // Look for the winning bid's rank in the bid response
                     // In most auction scenarios, the winning bid has rank 1
-                    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Looking up rank from auction %@ response data", auctionId]];
+                    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Looking up rank from auction %@ response data", auctionId);
                     
                     // Try to find rank in the bid response ext.cloudx.rank
                     id rankValue = [self resolveNestedField:responseData path:@"ext.cloudx.rank"];
                     if (rankValue) {
-                        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Found rank in auction response: %@", rankValue]];
+                        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Found rank in auction response: %@", rankValue);
                         return rankValue;
                     }
                 }
@@ -751,25 +918,25 @@
         if (bidResponseData) {
             id result = [self resolveNestedField:bidResponseData path:fieldPath];
             if (result) {
-                [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolved field path %@ from context: %@", fieldPath, result]];
+                CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolved field path %@ from context: %@", fieldPath, result);
                 return result;
             }
         }
         
         // Try to resolve from auction-specific response data if available
         if (auctionId) {
-            NSDictionary *responseData = self.responseDataMap[auctionId];
+            NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
             if (responseData) {
                 id result = [self resolveNestedField:responseData path:fieldPath];
                 if (result) {
-                    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolved field path %@ from auction response: %@", fieldPath, result]];
+                    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolved field path %@ from auction response: %@", fieldPath, result);
                     return result;
                 }
             }
         }
         
         // For other field paths, return nil as we don't have full context resolution yet
-        [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Unsupported field path in condition: %@", fieldPath]];
+        CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Unsupported field path in condition: %@", fieldPath);
         return nil;
     }
     
@@ -809,14 +976,386 @@
     return [value1 isEqual:value2];
 }
 
+#pragma mark - Field Program Compilation
+
+/**
+ * Compiles the server-provided tracking list once per config, so buildPayload: runs
+ * pre-parsed programs instead of re-dispatching on prefixes and re-splitting paths
+ */
+- (NSArray<CLXTrackingFieldProgram *> *)compileTrackingFields:(nullable NSArray<NSString *> *)fields {
+    NSMutableArray<CLXTrackingFieldProgram *> *programs = [NSMutableArray arrayWithCapacity:fields.count];
+    for (NSString *field in fields) {
+        [programs addObject:[self compileTrackingField:field]];
+    }
+    return [programs copy];
+}
+
+/**
+ * Mirrors the prefix dispatch of resolveField:field: and its per-source special cases
+ */
+- (CLXTrackingFieldProgram *)compileTrackingField:(NSString *)field {
+    CLXTrackingFieldProgram *program = [[CLXTrackingFieldProgram alloc] init];
+    program.source = CLXTrackingFieldSourceUnknown;
+    program.accessor = CLXTrackingFieldAccessorPath;
+    program.segments = @[];
+    
+    if (![field isKindOfClass:[NSString class]]) {
+        program.field = @"";
+        return program;
+    }
+    program.field = field;
+    
+    if ([field hasPrefix:@"sdk."]) {
+        program.source = CLXTrackingFieldSourceSdk;
+        if ([field isEqualToString:@"sdk.sessionId"]) {
+            program.accessor = CLXTrackingFieldAccessorSessionId;
+        } else if ([field isEqualToString:@"sdk.releaseVersion"]) {
+            program.accessor = CLXTrackingFieldAccessorReleaseVersion;
+        } else if ([field isEqualToString:@"sdk.deviceType"]) {
+            program.accessor = CLXTrackingFieldAccessorDeviceType;
+        } else {
+            program.accessor = CLXTrackingFieldAccessorAuctionSdkValue;
+        }
+    } else if ([field hasPrefix:@"bidRequest."]) {
+        program.source = CLXTrackingFieldSourceBidRequest;
+        if ([field isEqualToString:@"bidRequest.loopIndex"]) {
+            program.accessor = CLXTrackingFieldAccessorLoopIndex;
+        } else if ([field isEqualToString:@"bidRequest.device.ifa"]) {
+            program.accessor = CLXTrackingFieldAccessorDeviceIfa;
+        } else {
+            program.segments = [self compilePath:[field stringByReplacingOccurrencesOfString:@"bidRequest." withString:@""]];
+        }
+    } else if ([field hasPrefix:@"bid."]) {
+        program.source = CLXTrackingFieldSourceBid;
+        if ([field isEqualToString:@"bid.ext.prebid.meta.adaptercode"]) {
+            program.accessor = CLXTrackingFieldAccessorBidAdapterCode;
+        } else if ([field isEqualToString:@"bid.creativeId"]) {
+            program.accessor = CLXTrackingFieldAccessorBidCreativeId;
+        } else if ([field isEqualToString:@"bid.price"]) {
+            program.accessor = CLXTrackingFieldAccessorBidPrice;
+        } else if ([field isEqualToString:@"bid.w"]) {
+            program.accessor = CLXTrackingFieldAccessorBidWidth;
+        } else if ([field isEqualToString:@"bid.h"]) {
+            program.accessor = CLXTrackingFieldAccessorBidHeight;
+        } else if ([field isEqualToString:@"bid.dealid"]) {
+            program.accessor = CLXTrackingFieldAccessorBidDealId;
+        } else {
+            program.segments = [self compilePath:[field substringFromIndex:4]]; // Remove "bid."
+        }
+    } else if ([field hasPrefix:@"config."]) {
+        program.source = CLXTrackingFieldSourceConfig;
+        if ([field isEqualToString:@"config.testGroupName"]) {
+            program.accessor = CLXTrackingFieldAccessorTestGroupName;
+        } else {
+            program.segments = [self compilePath:[field stringByReplacingOccurrencesOfString:@"config." withString:@""]];
+        }
+    } else if ([field hasPrefix:@"bidResponse."]) {
+        program.source = CLXTrackingFieldSourceBidResponse;
+        program.segments = [self compilePath:[field stringByReplacingOccurrencesOfString:@"bidResponse." withString:@""]];
+    }
+    
+    return program;
+}
+
+- (NSArray<CLXTrackingPathSegment *> *)compilePath:(NSString *)path {
+    NSArray<NSString *> *parts = [self splitPathIntoSegments:path];
+    NSMutableArray<CLXTrackingPathSegment *> *segments = [NSMutableArray arrayWithCapacity:parts.count];
+    for (NSString *part in parts) {
+        [segments addObject:[self compilePathSegment:part]];
+    }
+    return [segments copy];
+}
+
+/**
+ * Pre-parses array predicates like participants[rank=${bid.ext.cloudx.rank}], including the
+ * condition's own path, using the same rules as resolveArrayLookup:segment:...
+ */
+- (CLXTrackingPathSegment *)compilePathSegment:(NSString *)part {
+    CLXTrackingPathSegment *segment = [[CLXTrackingPathSegment alloc] init];
+    segment.key = part;
+    
+    if (!([part containsString:@"["] && [part containsString:@"]"])) {
+        return segment;
+    }
+    
+    segment.isArrayPredicate = YES;
+    NSRange bracketStart = [part rangeOfString:@"["];
+    NSRange bracketEnd = [part rangeOfString:@"]"];
+    if (bracketEnd.location < bracketStart.location) {
+        return segment;
+    }
+    
+    segment.key = [part substringToIndex:bracketStart.location];
+    NSString *condition = [part substringWithRange:NSMakeRange(bracketStart.location + 1,
+                                                               bracketEnd.location - bracketStart.location - 1)];
+    NSArray<NSString *> *conditionParts = [condition componentsSeparatedByString:@"="];
+    if (conditionParts.count != 2) {
+        return segment;
+    }
+    
+    segment.isValidPredicate = YES;
+    segment.conditionField = conditionParts[0];
+    NSString *expression = conditionParts[1];
+    
+    if ([expression hasPrefix:@"${"] && [expression hasSuffix:@"}"]) {
+        NSString *fieldPath = [expression substringWithRange:NSMakeRange(2, expression.length - 3)];
+        if ([fieldPath isEqualToString:@"bid.ext.cloudx.rank"]) {
+            segment.conditionKind = CLXTrackingConditionKindWinningRank;
+            segment.conditionPath = [self compilePath:@"ext.cloudx.rank"];
+        } else {
+            segment.conditionKind = CLXTrackingConditionKindPath;
+            segment.conditionPath = [self compilePath:fieldPath];
+        }
+    } else {
+        segment.conditionKind = CLXTrackingConditionKindLiteral;
+        segment.conditionLiteral = expression;
+    }
+    
+    return segment;
+}
+
+#pragma mark - Field Program Execution
+
+- (nullable id)executeProgram:(CLXTrackingFieldProgram *)program context:(CLXTrackingPayloadContext *)context {
+    NSString *auctionId = context.auctionId;
+    
+    switch (program.source) {
+        case CLXTrackingFieldSourceSdk:
+            switch (program.accessor) {
+                case CLXTrackingFieldAccessorSessionId:
+                    return context.snapshot.sessionId;
+                case CLXTrackingFieldAccessorReleaseVersion:
+                    return context.snapshot.sdkVersion ?: @"1.0.0";
+                case CLXTrackingFieldAccessorDeviceType:
+                    return context.snapshot.deviceType;
+                default:
+                    return context.sdkValues[program.field];
+            }
+            
+        case CLXTrackingFieldSourceBidRequest:
+            if (program.accessor == CLXTrackingFieldAccessorLoopIndex) {
+                return context.loopIndex;
+            }
+            if (program.accessor == CLXTrackingFieldAccessorDeviceIfa) {
+                // Privacy state can change between auctions, so the IFA rules are evaluated live
+                return [self resolveBidRequestField:auctionId field:program.field];
+            }
+            if (!context.requestData) {
+                return nil;
+            }
+            return [self evaluateSegments:program.segments on:context.requestData fullResponseData:nil auctionId:nil];
+            
+        case CLXTrackingFieldSourceBid:
+            return [self executeBidProgram:program context:context];
+            
+        case CLXTrackingFieldSourceConfig:
+            if (program.accessor == CLXTrackingFieldAccessorTestGroupName) {
+                return context.snapshot.abTestGroup;
+            }
+            return [self evaluateSegments:program.segments on:context.snapshot.configDataMap fullResponseData:nil auctionId:nil];
+            
+        case CLXTrackingFieldSourceBidResponse:
+            if (!context.responseData) {
+                return nil;
+            }
+            return [self evaluateSegments:program.segments on:context.responseData fullResponseData:context.responseData auctionId:auctionId];
+            
+        case CLXTrackingFieldSourceUnknown:
+            CLX_LOG_DEBUG(self.logger, @"Unknown field prefix: %@", program.field);
+            return nil;
+    }
+    return nil;
+}
+
+- (nullable id)executeBidProgram:(CLXTrackingFieldProgram *)program context:(CLXTrackingPayloadContext *)context {
+    if (!context.bidLookupDone) {
+        context.bidLookupDone = YES;
+        [self locateLoadedBidInContext:context];
+    }
+    
+    NSDictionary *bidObj = context.bidObj;
+    if (!bidObj) {
+        return nil;
+    }
+    
+    switch (program.accessor) {
+        case CLXTrackingFieldAccessorBidAdapterCode:
+            return bidObj[@"ext"][@"prebid"][@"meta"][@"adaptercode"];
+        case CLXTrackingFieldAccessorBidCreativeId:
+            // Map bid.creativeId to bid.crid (OpenRTB standard field name)
+            return bidObj[@"crid"];
+        case CLXTrackingFieldAccessorBidPrice:
+            return bidObj[@"price"];
+        case CLXTrackingFieldAccessorBidWidth:
+            return bidObj[@"w"] ?: [self requestFormatValue:@"w" impid:context.impid requestData:context.requestData];
+        case CLXTrackingFieldAccessorBidHeight:
+            return bidObj[@"h"] ?: [self requestFormatValue:@"h" impid:context.impid requestData:context.requestData];
+        case CLXTrackingFieldAccessorBidDealId: {
+            id dealid = bidObj[@"dealid"];
+            if (!dealid && context.responseData) {
+                // Look for deal ID in ext.debug.rounds.1.resolvedrequest.imp[0].ext.prebid.bidder.meta.line_items[0].deal.id
+                id debugData = context.responseData[@"ext"][@"debug"][@"rounds"][@"1"][@"resolvedrequest"][@"imp"];
+                if ([debugData isKindOfClass:[NSArray class]] && [(NSArray *)debugData count] > 0) {
+                    NSDictionary *imp = debugData[0];
+                    id lineItems = imp[@"ext"][@"prebid"][@"bidder"][@"meta"][@"line_items"];
+                    if ([lineItems isKindOfClass:[NSArray class]] && [(NSArray *)lineItems count] > 0) {
+                        NSDictionary *lineItem = lineItems[0];
+                        dealid = lineItem[@"deal"][@"id"];
+                    }
+                }
+            }
+            return dealid;
+        }
+        default:
+            return [self evaluateSegments:program.segments on:bidObj fullResponseData:nil auctionId:nil];
+    }
+}
+
+/**
+ * Finds the loaded bid and its impid in the auction's seatbid array
+ */
+- (void)locateLoadedBidInContext:(CLXTrackingPayloadContext *)context {
+    NSString *bidId = context.loadedBidId;
+    if (!bidId || !context.responseData) {
+        return;
+    }
+    
+    NSArray *seatbids = context.responseData[@"seatbid"];
+    if (![seatbids isKindOfClass:[NSArray class]]) {
+        return;
+    }
+    
+    for (NSDictionary *seatbid in seatbids) {
+        NSArray *bids = seatbid[@"bid"];
+        if (![bids isKindOfClass:[NSArray class]]) continue;
+        
+        for (NSDictionary *bid in bids) {
+            if ([bid[@"id"] isEqualToString:bidId]) {
+                context.bidObj = bid;
+                context.impid = bid[@"impid"];
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * Width/height fallback from imp.banner.format[0] of the impression matching the bid's impid
+ */
+- (nullable id)requestFormatValue:(NSString *)key impid:(nullable NSString *)impid requestData:(nullable NSDictionary *)requestData {
+    NSArray *impressions = requestData[@"imp"];
+    if (![impressions isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+    
+    for (NSDictionary *imp in impressions) {
+        if ([imp[@"id"] isEqualToString:impid]) {
+            NSArray *formats = imp[@"banner"][@"format"];
+            if ([formats isKindOfClass:[NSArray class]] && formats.count > 0) {
+                return formats[0][key];
+            }
+            return nil;
+        }
+    }
+    return nil;
+}
+
+/**
+ * Walks pre-parsed segments with the same semantics as resolveNestedField:path:...
+ */
+- (nullable id)evaluateSegments:(NSArray<CLXTrackingPathSegment *> *)segments
+                             on:(nullable id)current
+               fullResponseData:(nullable NSDictionary *)fullResponseData
+                      auctionId:(nullable NSString *)auctionId {
+    for (CLXTrackingPathSegment *segment in segments) {
+        if (segment.isArrayPredicate) {
+            current = [self evaluateArrayPredicate:segment on:current fullResponseData:fullResponseData auctionId:auctionId];
+        } else {
+            // Handle simple array access - if current is array, take first element
+            if ([current isKindOfClass:[NSArray class]]) {
+                current = [(NSArray *)current firstObject];
+            }
+            if (![current isKindOfClass:[NSDictionary class]]) {
+                return nil;
+            }
+            current = ((NSDictionary *)current)[segment.key];
+        }
+        
+        if (!current) {
+            return nil;
+        }
+    }
+    
+    // If final result is array, take first element
+    if ([current isKindOfClass:[NSArray class]]) {
+        current = [(NSArray *)current firstObject];
+    }
+    return current;
+}
+
+- (nullable id)evaluateArrayPredicate:(CLXTrackingPathSegment *)segment
+                                   on:(nullable id)current
+                     fullResponseData:(nullable NSDictionary *)fullResponseData
+                            auctionId:(nullable NSString *)auctionId {
+    if (![current isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    
+    NSDictionary *dict = (NSDictionary *)current;
+    NSArray *array = dict[segment.key];
+    if (![array isKindOfClass:[NSArray class]] || !segment.isValidPredicate) {
+        return nil;
+    }
+    
+    id conditionValue = [self evaluateCondition:segment context:fullResponseData ?: dict auctionId:auctionId];
+    for (NSDictionary *element in array) {
+        if (![element isKindOfClass:[NSDictionary class]]) {
+            continue;
+        }
+        if ([self valuesAreEqual:element[segment.conditionField] to:conditionValue]) {
+            return element;
+        }
+    }
+    return nil;
+}
+
+/**
+ * Evaluates a pre-parsed condition with the same fallbacks as resolveConditionValue:withBidResponseData:auctionId:
+ */
+- (nullable id)evaluateCondition:(CLXTrackingPathSegment *)segment
+                         context:(NSDictionary *)context
+                       auctionId:(nullable NSString *)auctionId {
+    if (segment.conditionKind == CLXTrackingConditionKindLiteral) {
+        return segment.conditionLiteral;
+    }
+    
+    id result = [self evaluateSegments:segment.conditionPath on:context fullResponseData:nil auctionId:nil];
+    if (result) {
+        return result;
+    }
+    
+    if (auctionId) {
+        NSDictionary *responseData = [self.auctionStore entryForAuction:auctionId].responseData;
+        if (responseData) {
+            result = [self evaluateSegments:segment.conditionPath on:responseData fullResponseData:nil auctionId:nil];
+            if (result) {
+                return result;
+            }
+        }
+    }
+    
+    // In array lookup scenarios, the winning bid rank is conventionally 1
+    return segment.conditionKind == CLXTrackingConditionKindWinningRank ? @1 : nil;
+}
+
 #pragma mark - Win/Loss Field Resolution
 
 - (nullable id)resolveField:(NSString *)fieldPath forAuction:(NSString *)auctionId {
-    [self.logger debug:[NSString stringWithFormat:@"🔍 [CLXTrackingFieldResolver] Resolving field: %@ for auction: %@", fieldPath, auctionId]];
+    CLX_LOG_DEBUG(self.logger, @"🔍 [CLXTrackingFieldResolver] Resolving field: %@ for auction: %@", fieldPath, auctionId);
     
     // Handle SDK-level constants
     if ([fieldPath isEqualToString:@"sdk.loopIndex"]) {
-        NSNumber *loopIndex = self.auctionedLoopIndex[auctionId];
+        NSNumber *loopIndex = [self.auctionStore entryForAuction:auctionId].loopIndex;
         return loopIndex ? [loopIndex stringValue] : nil;
     }
     
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCounterRegistry.m
+ * @brief In-memory SDK usage counters persisted lazily to NSUserDefaults
+ */
+
+#import <CloudXCore/CLXCounterRegistry.h>
+#import <CloudXCore/CLXUserDefaultsKeys.h>
+#import <CloudXCore/CLXLogger.h>
+#import <UIKit/UIKit.h>
+#import <os/lock.h>
+#import <stdatomic.h>
+
+const NSTimeInterval CLXCounterRegistryDefaultPersistDelay = 5.0;
+
+// One counter; its value is only touched through atomics
+@interface CLXCounterSlot : NSObject {
+@public
+    atomic_llong _value;
+}
+@end
+
+@implementation CLXCounterSlot
+@end
+
+@interface CLXCounterRegistry () {
+    os_unfair_lock _slotsLock;
+    atomic_bool _persistScheduled;
+}
+@property (nonatomic, copy) NSString *defaultsKey;
+@property (nonatomic, strong) NSUserDefaults *userDefaults;
+// Counter name -> slot; guarded by _slotsLock, slots are never removed
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXCounterSlot *> *slots;
+@property (nonatomic, strong) dispatch_queue_t persistQueue;
+@property (nonatomic, strong) NSArray<id> *lifecycleObservers;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXCounterRegistry
+
++ (instancetype)coreMetrics {
+    static CLXCounterRegistry *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] initWithDefaultsKey:kCLXCoreMetricsDictKey userDefaults:[NSUserDefaults standardUserDefaults]];
+    });
+    return sharedInstance;
+}
+
++ (instancetype)bannerMetrics {
+    static CLXCounterRegistry *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] initWithDefaultsKey:kCLXCoreBannerMetricsDictKey userDefaults:[NSUserDefaults standardUserDefaults]];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)initWithDefaultsKey:(NSString *)defaultsKey userDefaults:(NSUserDefaults *)userDefaults {
+    self = [super init];
+    if (self) {
+        _defaultsKey = [defaultsKey copy];
+        _userDefaults = userDefaults;
+        _slotsLock = OS_UNFAIR_LOCK_INIT;
+        atomic_init(&_persistScheduled, false);
+        _persistDelay = CLXCounterRegistryDefaultPersistDelay;
+        _slots = [NSMutableDictionary dictionary];
+        _persistQueue = dispatch_queue_create("com.cloudx.counterregistry", DISPATCH_QUEUE_SERIAL);
+        _logger = [[CLXLogger alloc] initWithCategory:@"CounterRegistry"];
+        [self _loadStoredCounters];
+
+        __weak typeof(self) weakSelf = self;
+        void (^flushBlock)(NSNotification *) = ^(NSNotification *note) {
+            [weakSelf flush];
+        };
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        _lifecycleObservers = @[
+            [center addObserverForName:UIApplicationDidEnterBackgroundNotification object:nil queue:nil usingBlock:flushBlock],
+            [center addObserverForName:UIApplicationWillTerminateNotification object:nil queue:nil usingBlock:flushBlock]
+        ];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (id observer in _lifecycleObservers) {
+        [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    }
+}
+
+#pragma mark - Counters
+
+- (int64_t)incrementCounter:(NSString *)name {
+    CLXCounterSlot *slot = [self _slotNamed:name create:YES];
+    int64_t value = atomic_fetch_add_explicit(&slot->_value, 1, memory_order_relaxed) + 1;
+    [self _schedulePersist];
+    return value;
+}
+
+- (int64_t)valueForCounter:(NSString *)name {
+    CLXCounterSlot *slot = [self _slotNamed:name create:NO];
+    return slot ? atomic_load_explicit(&slot->_value, memory_order_relaxed) : 0;
+}
+
+- (NSDictionary<NSString *, id> *)snapshot {
+    NSMutableDictionary<NSString *, id> *dictionary = [[self.userDefaults dictionaryForKey:self.defaultsKey] mutableCopy] ?: [NSMutableDictionary dictionary];
+    [self _overlayCountersOnto:dictionary];
+    return [dictionary copy];
+}
+
+- (CLXCounterSlot *)_slotNamed:(NSString *)name create:(BOOL)create {
+    os_unfair_lock_lock(&_slotsLock);
+    CLXCounterSlot *slot = self.slots[name];
+    if (!slot && create) {
+        slot = [[CLXCounterSlot alloc] init];
+        atomic_init(&slot->_value, 0);
+        self.slots[name] = slot;
+    }
+    os_unfair_lock_unlock(&_slotsLock);
+    return slot;
+}
+
+#pragma mark - Persistence
+
+- (void)flush {
+    dispatch_sync(self.persistQueue, ^{
+        [self _persistLocked];
+    });
+}
+
+- (void)reset {
+    os_unfair_lock_lock(&_slotsLock);
+    for (CLXCounterSlot *slot in self.slots.allValues) {
+        atomic_store_explicit(&slot->_value, 0, memory_order_relaxed);
+    }
+    [self.slots removeAllObjects];
+    os_unfair_lock_unlock(&_slotsLock);
+
+    dispatch_sync(self.persistQueue, ^{
+        [self.userDefaults setObject:@{} forKey:self.defaultsKey];
+    });
+}
+
+// Coalesces every change within persistDelay into one write
+- (void)_schedulePersist {
+    NSTimeInterval delay = self.persistDelay;
+    if (delay <= 0 || atomic_exchange(&_persistScheduled, true)) {
+        return;
+    }
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.persistQueue, ^{
+        [weakSelf _persistLocked];
+    });
+}
+
+- (void)_persistLocked {
+    atomic_store(&_persistScheduled, false);
+    NSMutableDictionary<NSString *, id> *dictionary = [[self.userDefaults dictionaryForKey:self.defaultsKey] mutableCopy] ?: [NSMutableDictionary dictionary];
+    if (![self _overlayCountersOnto:dictionary]) {
+        return;
+    }
+    [self.userDefaults setObject:dictionary forKey:self.defaultsKey];
+    CLX_LOG_DEBUG(self.logger, @"💾 [CounterRegistry] Persisted %lu entries under %@", (unsigned long)dictionary.count, self.defaultsKey);
+}
+
+// Returns whether any counter was written
+- (BOOL)_overlayCountersOnto:(NSMutableDictionary<NSString *, id> *)dictionary {
+    os_unfair_lock_lock(&_slotsLock);
+    NSDictionary<NSString *, CLXCounterSlot *> *slots = [self.slots copy];
+    os_unfair_lock_unlock(&_slotsLock);
+
+    [slots enumerateKeysAndObjectsUsingBlock:^(NSString *name, CLXCounterSlot *slot, BOOL *stop) {
+        dictionary[name] = [NSString stringWithFormat:@"%lld", (long long)atomic_load_explicit(&slot->_value, memory_order_relaxed)];
+    }];
+    return slots.count > 0;
+}
+
+// Counters carry on from what an earlier session, or an older SDK, stored
+- (void)_loadStoredCounters {
+    NSDictionary *stored = [self.userDefaults dictionaryForKey:self.defaultsKey];
+    [stored enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        if (![key isKindOfClass:[NSString class]]) {
+            return;
+        }
+        long long number = 0;
+        BOOL numeric = NO;
+        if ([value isKindOfClass:[NSNumber class]]) {
+            number = [value longLongValue];
+            numeric = YES;
+        } else if ([value isKindOfClass:[NSString class]]) {
+            NSScanner *scanner = [NSScanner scannerWithString:value];
+            numeric = [scanner scanLongLong:&number] && scanner.isAtEnd;
+        }
+        if (numeric) {
+            CLXCounterSlot *slot = [[CLXCounterSlot alloc] init];
+            atomic_init(&slot->_value, number);
+            self.slots[key] = slot;
+        }
+    }];
+}
+
+@end
@@ -6,6 +6,9 @@
 #import "CLXEventAM.h"
 #import <CloudXCore/CLXLogger.h>
 #import <CloudXCore/CLXError.h>
+#import <CloudXCore/CLXURLSessionProvider.h>
+#import <CloudXCore/CLXRequestCompressor.h>
+#import <CloudXCore/CLXRetryBudget.h>
 
 @interface CLXEventTrackerBulkApiImpl ()
 @property (nonatomic, assign) NSInteger timeoutMillis;
@@ -19,6 +22,7 @@
     if (self) {
         _timeoutMillis = timeoutMillis > 0 ? timeoutMillis : 10000; // Default 10 seconds
         _logger = [[CLXLogger alloc] initWithCategory:@"EventTrackerBulkApi"];
+        _retryBudget = [CLXRetryBudget shared];
     }
     return self;
 }
@@ -62,19 +66,48 @@
         return;
     }
     
+    // Log request details
+    [self.logger debug:[NSString stringWithFormat:@"📊 [EventTrackerBulkApi] Request body size: %lu bytes", (unsigned long)requestBody.length]];
+    
+    [self _postBody:requestBody
+              toURL:[NSURL URLWithString:endpointUrl]
+          itemCount:items.count
+   allowCompression:YES
+         completion:completion];
+}
+
+/**
+ * Posts the JSON body, compressed when the shared compressor says so. A server that
+ * rejects the compressed body gets it once more uncompressed. Nothing is sent while the
+ * host's circuit is open, and the host's answers move its circuit like any other client's.
+ */
+- (void)_postBody:(NSData *)requestBody
+            toURL:(NSURL *)url
+        itemCount:(NSUInteger)itemCount
+ allowCompression:(BOOL)allowCompression
+       completion:(void (^)(BOOL success, NSError * _Nullable error))completion {
+    NSString *host = url.host;
+    CLXRetryBudget *retryBudget = self.retryBudget;
+    if (![retryBudget shouldAllowRequestToHost:host]) {
+        [self.logger error:[NSString stringWithFormat:@"🔌 [EventTrackerBulkApi] Circuit for %@ open, keeping %lu metrics events", host, (unsigned long)itemCount]];
+        if (completion) {
+            completion(NO, [CLXError errorWithCode:CLXErrorCodeServiceUnavailable description:@"Server overloaded, circuit open"]);
+        }
+        return;
+    }
+    
     // Create request
-    NSURL *url = [NSURL URLWithString:endpointUrl];
     NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
     request.HTTPMethod = @"POST";
     request.HTTPBody = requestBody;
     [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
     request.timeoutInterval = self.timeoutMillis / 1000.0; // Convert to seconds
     
-    // Log request details
-    [self.logger debug:[NSString stringWithFormat:@"📊 [EventTrackerBulkApi] Request body size: %lu bytes", (unsigned long)requestBody.length]];
+    CLXRequestCompressor *compressor = [CLXRequestCompressor shared];
+    CLXContentEncoding encoding = allowCompression ? [compressor compressBodyOfRequest:request] : CLXContentEncodingIdentity;
     
     // Execute request
-    NSURLSession *session = [NSURLSession sharedSession];
+    NSURLSession *session = [[CLXURLSessionProvider shared] sessionForPurpose:CLXURLSessionPurposeTracking];
     NSURLSessionDataTask *task = [session dataTaskWithRequest:request
                                             completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         if (error) {
@@ -88,12 +121,22 @@
         NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
         NSInteger statusCode = httpResponse.statusCode;
         
+        // Connectivity errors returned above say nothing about the server; its answers do
+        if (statusCode == 429 || statusCode >= 500) {
+            NSTimeInterval retryAfter = MAX(0, [httpResponse.allHeaderFields[@"Retry-After"] doubleValue]);
+            [retryBudget recordFailureForHost:host retryAfter:retryAfter];
+        } else {
+            [retryBudget recordSuccessForHost:host];
+        }
+        
         if (statusCode >= 200 && statusCode < 300) {
             [self.logger debug:[NSString stringWithFormat:@"✅ [EventTrackerBulkApi] Successfully sent %lu metrics events (status: %ld)", 
-                               (unsigned long)items.count, (long)statusCode]];
+                               (unsigned long)itemCount, (long)statusCode]];
             if (completion) {
                 completion(YES, nil);
             }
+        } else if ([compressor shouldRetryUncompressedAfterEncoding:encoding statusCode:statusCode url:url]) {
+            [self _postBody:requestBody toURL:url itemCount:itemCount allowCompression:NO completion:completion];
         } else {
             NSString *errorMessage = [NSString stringWithFormat:@"HTTP %ld", (long)statusCode];
             [self.logger error:[NSString stringWithFormat:@"❌ [EventTrackerBulkApi] HTTP error: %@", errorMessage]];
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+#import "CLXLatencyHistogram.h"
+#include <math.h>
+
+// 2 buckets per octave up to 2^20 ms (~17 minutes) plus the sub-millisecond bucket
+#define CLX_LATENCY_BUCKET_COUNT 41
+
+const NSUInteger CLXLatencyHistogramBucketCount = CLX_LATENCY_BUCKET_COUNT;
+
+@implementation CLXLatencyHistogram {
+    uint32_t _counts[CLX_LATENCY_BUCKET_COUNT];
+    NSInteger _totalCount;
+}
+
++ (instancetype)histogramFromSerializedString:(nullable NSString *)serialized {
+    CLXLatencyHistogram *histogram = [[CLXLatencyHistogram alloc] init];
+    if (serialized.length == 0) {
+        return histogram;
+    }
+    
+    for (NSString *pair in [serialized componentsSeparatedByString:@","]) {
+        NSRange separator = [pair rangeOfString:@":"];
+        if (separator.location == NSNotFound) {
+            continue;
+        }
+        NSInteger index = [[pair substringToIndex:separator.location] integerValue];
+        NSInteger count = [[pair substringFromIndex:separator.location + 1] integerValue];
+        if (index < 0 || index >= CLX_LATENCY_BUCKET_COUNT || count <= 0) {
+            continue;
+        }
+        histogram->_counts[index] += (uint32_t)count;
+        histogram->_totalCount += count;
+    }
+    return histogram;
+}
+
++ (NSUInteger)bucketIndexForLatency:(NSInteger)latencyMs {
+    if (latencyMs < 1) {
+        return 0;
+    }
+    NSInteger index = (NSInteger)floor(2.0 * log2((double)latencyMs)) + 1;
+    return (NSUInteger)MIN(index, CLX_LATENCY_BUCKET_COUNT - 1);
+}
+
++ (NSInteger)upperBoundForBucket:(NSUInteger)bucketIndex {
+    if (bucketIndex >= CLX_LATENCY_BUCKET_COUNT - 1) {
+        return NSIntegerMax;
+    }
+    return (NSInteger)ceil(pow(2.0, bucketIndex / 2.0));
+}
+
+- (NSInteger)totalCount {
+    return _totalCount;
+}
+
+- (BOOL)isEmpty {
+    return _totalCount == 0;
+}
+
+- (void)recordLatency:(NSInteger)latencyMs {
+    _counts[[CLXLatencyHistogram bucketIndexForLatency:latencyMs]] += 1;
+    _totalCount += 1;
+}
+
+- (NSInteger)countForBucket:(NSUInteger)bucketIndex {
+    return bucketIndex < CLX_LATENCY_BUCKET_COUNT ? _counts[bucketIndex] : 0;
+}
+
+- (void)mergeHistogram:(CLXLatencyHistogram *)other {
+    for (NSUInteger i = 0; i < CLX_LATENCY_BUCKET_COUNT; i++) {
+        _counts[i] += other->_counts[i];
+    }
+    _totalCount += other->_totalCount;
+}
+
+- (void)subtractHistogram:(CLXLatencyHistogram *)other {
+    _totalCount = 0;
+    for (NSUInteger i = 0; i < CLX_LATENCY_BUCKET_COUNT; i++) {
+        _counts[i] = _counts[i] > other->_counts[i] ? _counts[i] - other->_counts[i] : 0;
+        _totalCount += _counts[i];
+    }
+}
+
+- (NSInteger)latencyAtPercentile:(double)percentile {
+    if (_totalCount == 0) {
+        return 0;
+    }
+    
+    double clamped = MAX(0.0, MIN(100.0, percentile));
+    NSInteger rank = MAX((NSInteger)ceil(clamped / 100.0 * _totalCount), 1);
+    NSInteger seen = 0;
+    for (NSUInteger i = 0; i < CLX_LATENCY_BUCKET_COUNT; i++) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return [CLXLatencyHistogram upperBoundForBucket:i];
+        }
+    }
+    return NSIntegerMax;
+}
+
+- (NSString *)serializedString {
+    NSMutableString *result = [NSMutableString string];
+    for (NSUInteger i = 0; i < CLX_LATENCY_BUCKET_COUNT; i++) {
+        if (_counts[i] == 0) {
+            continue;
+        }
+        if (result.length > 0) {
+            [result appendString:@","];
+        }
+        [result appendFormat:@"%lu:%u", (unsigned long)i, _counts[i]];
+    }
+    return [result copy];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    CLXLatencyHistogram *copy = [[[self class] allocWithZone:zone] init];
+    [copy mergeHistogram:self];
+    return copy;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) {
+        return YES;
+    }
+    if (![object isKindOfClass:[CLXLatencyHistogram class]]) {
+        return NO;
+    }
+    CLXLatencyHistogram *other = object;
+    return memcmp(_counts, other->_counts, sizeof(_counts)) == 0;
+}
+
+- (NSUInteger)hash {
+    return [[self serializedString] hash];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"CLXLatencyHistogram{n=%ld, p50=%ld, p95=%ld, p99=%ld}",
+            (long)_totalCount,
+            (long)[self latencyAtPercentile:50],
+            (long)[self latencyAtPercentile:95],
+            (long)[self latencyAtPercentile:99]];
+}
+
+@end
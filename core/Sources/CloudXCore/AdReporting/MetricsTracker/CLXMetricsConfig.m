@@ -47,6 +47,38 @@
         config.networkCallsGeoReqEnabled = dictionary[@"network_calls.geo_req.enabled"];
     }
     
+    if ([dictionary objectForKey:@"network_calls.latency_histogram.enabled"]) {
+        config.networkCallsLatencyHistogramEnabled = dictionary[@"network_calls.latency_histogram.enabled"];
+    }
+    
+    // Parse performance metrics enablements
+    if ([dictionary objectForKey:@"performance.enabled"]) {
+        config.performanceEnabled = dictionary[@"performance.enabled"];
+    }
+    
+    if ([dictionary objectForKey:@"performance.auction_stages.enabled"]) {
+        config.performanceAuctionStagesEnabled = dictionary[@"performance.auction_stages.enabled"];
+    }
+    
+    if ([dictionary objectForKey:@"performance.connection.enabled"]) {
+        config.performanceConnectionEnabled = dictionary[@"performance.connection.enabled"];
+    }
+    
+    if ([dictionary objectForKey:@"performance.cache_refill.enabled"]) {
+        config.performanceCacheRefillEnabled = dictionary[@"performance.cache_refill.enabled"];
+    }
+    
+    // Parse bulk upload compression
+    id bulkEncoding = dictionary[@"bulk_compression.encoding"];
+    if ([bulkEncoding isKindOfClass:[NSString class]]) {
+        config.bulkCompressionEncoding = bulkEncoding;
+    }
+    
+    id bulkMinBytes = dictionary[@"bulk_compression.min_bytes"];
+    if ([bulkMinBytes isKindOfClass:[NSNumber class]]) {
+        config.bulkCompressionMinBytes = bulkMinBytes;
+    }
+    
     return config;
 }
 
@@ -76,14 +108,52 @@
            (self.networkCallsGeoReqEnabled ? self.networkCallsGeoReqEnabled.boolValue : NO);
 }
 
+- (BOOL)isLatencyHistogramEnabled {
+    return [self isNetworkCallsEnabled] &&
+           (self.networkCallsLatencyHistogramEnabled ? self.networkCallsLatencyHistogramEnabled.boolValue : NO);
+}
+
+- (BOOL)isPerformanceMetricsEnabled {
+    return self.performanceEnabled ? self.performanceEnabled.boolValue : NO;
+}
+
+- (BOOL)isAuctionStageMetricsEnabled {
+    return [self isPerformanceMetricsEnabled] &&
+           (self.performanceAuctionStagesEnabled ? self.performanceAuctionStagesEnabled.boolValue : NO);
+}
+
+- (BOOL)isConnectionMetricsEnabled {
+    return [self isPerformanceMetricsEnabled] &&
+           (self.performanceConnectionEnabled ? self.performanceConnectionEnabled.boolValue : NO);
+}
+
+- (BOOL)isCacheRefillMetricsEnabled {
+    return [self isPerformanceMetricsEnabled] &&
+           (self.performanceCacheRefillEnabled ? self.performanceCacheRefillEnabled.boolValue : NO);
+}
+
+- (nullable NSString *)bulkContentEncoding {
+    NSString *encoding = self.bulkCompressionEncoding.lowercaseString;
+    if ([encoding isEqualToString:@"gzip"] || [encoding isEqualToString:@"deflate"]) {
+        return encoding;
+    }
+    return nil;
+}
+
 - (NSString *)description {
-    return [NSString stringWithFormat:@"CLXMetricsConfig{interval=%ld, sdkApi=%@, network=%@, bidReq=%@, initSdk=%@, geo=%@}",
+    return [NSString stringWithFormat:@"CLXMetricsConfig{interval=%ld, sdkApi=%@, network=%@, bidReq=%@, initSdk=%@, geo=%@, histogram=%@, performance=%@, auctionStages=%@, connection=%@, cacheRefill=%@, bulkEncoding=%@}",
             (long)self.sendIntervalSeconds,
             self.sdkApiCallsEnabled ?: @"nil",
             self.networkCallsEnabled ?: @"nil",
             self.networkCallsBidReqEnabled ?: @"nil",
             self.networkCallsInitSdkReqEnabled ?: @"nil",
-            self.networkCallsGeoReqEnabled ?: @"nil"];
+            self.networkCallsGeoReqEnabled ?: @"nil",
+            self.networkCallsLatencyHistogramEnabled ?: @"nil",
+            self.performanceEnabled ?: @"nil",
+            self.performanceAuctionStagesEnabled ?: @"nil",
+            self.performanceConnectionEnabled ?: @"nil",
+            self.performanceCacheRefillEnabled ?: @"nil",
+            self.bulkCompressionEncoding ?: @"nil"];
 }
 
 @end
@@ -98,6 +98,10 @@ static CLXLogger *_debugLogger = nil;
     [_debugLogger info:[NSString stringWithFormat:@"  📊 Bid Request Calls: %@", [self boolToString:[config isBidRequestNetworkCallsEnabled]]]];
     [_debugLogger info:[NSString stringWithFormat:@"  🚀 Init SDK Calls: %@", [self boolToString:[config isInitSdkNetworkCallsEnabled]]]];
     [_debugLogger info:[NSString stringWithFormat:@"  🌍 Geo Calls: %@", [self boolToString:[config isGeoNetworkCallsEnabled]]]];
+    [_debugLogger info:[NSString stringWithFormat:@"⏱️ Performance Metrics Enabled: %@", [self boolToString:[config isPerformanceMetricsEnabled]]]];
+    [_debugLogger info:[NSString stringWithFormat:@"  🏁 Auction Stages: %@", [self boolToString:[config isAuctionStageMetricsEnabled]]]];
+    [_debugLogger info:[NSString stringWithFormat:@"  🔌 Connections: %@", [self boolToString:[config isConnectionMetricsEnabled]]]];
+    [_debugLogger info:[NSString stringWithFormat:@"  🗄️ Cache Refill: %@", [self boolToString:[config isCacheRefillMetricsEnabled]]]];
 }
 
 + (void)printAllMetrics:(CLXMetricsEventDao *)dao {
@@ -3,6 +3,7 @@
  */
 
 #import "CLXMetricsEvent.h"
+#import "CLXLatencyHistogram.h"
 
 @implementation CLXMetricsEvent
 
@@ -20,17 +21,24 @@
         _totalLatency = totalLatency;
         _sessionId = [sessionId copy];
         _auctionId = [auctionId copy];
+        _latencyHistogram = [[CLXLatencyHistogram alloc] init];
     }
     return self;
 }
 
 + (instancetype)fromDictionary:(NSDictionary *)dictionary {
-    return [[CLXMetricsEvent alloc] initWithEventId:dictionary[@"id"] ?: @""
-                                         metricName:dictionary[@"metricName"] ?: @""
-                                            counter:[dictionary[@"counter"] integerValue]
-                                       totalLatency:[dictionary[@"totalLatency"] integerValue]
-                                          sessionId:dictionary[@"sessionId"] ?: @""
-                                          auctionId:dictionary[@"auctionId"] ?: @""];
+    CLXMetricsEvent *event = [[CLXMetricsEvent alloc] initWithEventId:dictionary[@"id"] ?: @""
+                                                           metricName:dictionary[@"metricName"] ?: @""
+                                                              counter:[dictionary[@"counter"] integerValue]
+                                                         totalLatency:[dictionary[@"totalLatency"] integerValue]
+                                                            sessionId:dictionary[@"sessionId"] ?: @""
+                                                            auctionId:dictionary[@"auctionId"] ?: @""];
+    
+    id histogram = dictionary[@"latencyHistogram"];
+    if ([histogram isKindOfClass:[NSString class]]) {
+        event.latencyHistogram = [CLXLatencyHistogram histogramFromSerializedString:histogram];
+    }
+    return event;
 }
 
 - (NSDictionary *)toDictionary {
@@ -40,7 +48,8 @@
         @"counter": @(self.counter),
         @"totalLatency": @(self.totalLatency),
         @"sessionId": self.sessionId,
-        @"auctionId": self.auctionId
+        @"auctionId": self.auctionId,
+        @"latencyHistogram": [self.latencyHistogram serializedString]
     };
 }
 
@@ -4,6 +4,7 @@
 
 #import "CLXMetricsEventDao.h"
 #import "CLXMetricsEvent.h"
+#import "CLXLatencyHistogram.h"
 #import <CloudXCore/CLXSQLiteDatabase.h>
 #import <CloudXCore/CLXLogger.h>
 
@@ -31,10 +32,14 @@
                               @"counter INTEGER DEFAULT 0, "
                               @"totalLatency INTEGER DEFAULT 0, "
                               @"sessionId TEXT NOT NULL, "
-                              @"auctionId TEXT NOT NULL"
+                              @"auctionId TEXT NOT NULL, "
+                              @"latencyHistogram TEXT DEFAULT ''"
                               @");";
     
     BOOL success = [self.database executeSQL:createTableSQL];
+    if (success) {
+        success = [self _addLatencyHistogramColumnIfNeeded];
+    }
     if (success) {
         [self.logger debug:@"📊 [MetricsEventDao] Metrics table created successfully"];
     } else {
@@ -43,15 +48,63 @@
     return success;
 }
 
+/**
+ * Tables created before latency histograms existed are migrated in place
+ */
+- (BOOL)_addLatencyHistogramColumnIfNeeded {
+    NSArray<NSDictionary *> *columns = [self.database executeQuery:@"PRAGMA table_info(metrics_event_table);"];
+    for (NSDictionary *column in columns) {
+        if ([column[@"name"] isEqual:@"latencyHistogram"]) {
+            return YES;
+        }
+    }
+    if (columns.count == 0) {
+        return YES;
+    }
+    return [self.database executeSQL:@"ALTER TABLE metrics_event_table ADD COLUMN latencyHistogram TEXT DEFAULT '';"];
+}
+
 - (BOOL)insert:(CLXMetricsEvent *)event {
     if (!event) {
         [self.logger error:@"❌ [MetricsEventDao] Cannot insert nil event"];
         return NO;
     }
     
+    BOOL success = [self _insertEvent:event];
+    if (success) {
+        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsEventDao] Inserted metric: %@ (counter: %ld, latency: %ld)", 
+                           event.metricName, (long)event.counter, (long)event.totalLatency]];
+    } else {
+        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsEventDao] Failed to insert metric: %@", event.metricName]];
+    }
+    
+    return success;
+}
+
+- (BOOL)insertAll:(NSArray<CLXMetricsEvent *> *)events {
+    if (events.count == 0) {
+        return YES;
+    }
+    
+    __block BOOL allInserted = YES;
+    BOOL committed = [self.database executeInTransaction:^{
+        for (CLXMetricsEvent *event in events) {
+            allInserted = [self _insertEvent:event] && allInserted;
+        }
+    }];
+    
+    if (committed && allInserted) {
+        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsEventDao] Inserted %lu metrics in one transaction", (unsigned long)events.count]];
+    } else {
+        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsEventDao] Failed to insert batch of %lu metrics", (unsigned long)events.count]];
+    }
+    return committed && allInserted;
+}
+
+- (BOOL)_insertEvent:(CLXMetricsEvent *)event {
     NSString *insertSQL = @"INSERT OR REPLACE INTO metrics_event_table "
-                         @"(id, metricName, counter, totalLatency, sessionId, auctionId) "
-                         @"VALUES (?, ?, ?, ?, ?, ?);";
+                         @"(id, metricName, counter, totalLatency, sessionId, auctionId, latencyHistogram) "
+                         @"VALUES (?, ?, ?, ?, ?, ?, ?);";
     
     NSArray *parameters = @[
         event.eventId,
@@ -59,18 +112,11 @@
         @(event.counter),
         @(event.totalLatency),
         event.sessionId,
-        event.auctionId
+        event.auctionId,
+        [event.latencyHistogram serializedString] ?: @""
     ];
     
-    BOOL success = [self.database executeSQL:insertSQL withParameters:parameters];
-    if (success) {
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsEventDao] Inserted metric: %@ (counter: %ld, latency: %ld)", 
-                           event.metricName, (long)event.counter, (long)event.totalLatency]];
-    } else {
-        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsEventDao] Failed to insert metric: %@", event.metricName]];
-    }
-    
-    return success;
+    return [self.database executeSQL:insertSQL withParameters:parameters];
 }
 
 - (nullable CLXMetricsEvent *)getAllByMetric:(NSString *)metricName {
@@ -114,6 +160,20 @@
     return success;
 }
 
+- (BOOL)deleteByIds:(NSArray<NSString *> *)eventIds {
+    if (eventIds.count == 0) {
+        return YES;
+    }
+    
+    BOOL deleted = [self.database deleteFromTable:@"metrics_event_table" whereColumn:@"id" inValues:eventIds];
+    if (deleted) {
+        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsEventDao] Deleted %lu metrics in one transaction", (unsigned long)eventIds.count]];
+    } else {
+        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsEventDao] Failed to delete batch of %lu metrics", (unsigned long)eventIds.count]];
+    }
+    return deleted;
+}
+
 - (NSArray<CLXMetricsEvent *> *)getAll {
     NSString *selectSQL = @"SELECT * FROM metrics_event_table ORDER BY metricName;";
     
@@ -7,6 +7,7 @@
 #import "CLXMetricsEvent.h"
 #import "CLXMetricsConfig.h"
 #import "CLXMetricsType.h"
+#import "CLXLatencyHistogram.h"
 #import "CLXEventTrackerBulkApi.h"
 #import "CLXEventAM.h"
 #import <CloudXCore/CLXSQLiteDatabase.h>
@@ -14,6 +15,10 @@
 #import <CloudXCore/CLXSDKConfig.h>
 #import <CloudXCore/CLXXorEncryption.h>
 #import <CloudXCore/CLXMetricsDebugger.h>
+#import <CloudXCore/CLXFlushScheduler.h>
+#import <UIKit/UIKit.h>
+
+static const NSTimeInterval kCLXDefaultCheckpointIntervalSeconds = 5.0;
 
 @interface CLXMetricsTrackerImpl ()
 @property (nonatomic, strong) CLXSQLiteDatabase *database;
@@ -23,18 +28,30 @@
 @property (nonatomic, strong) id<CLXEventTrackerBulkApi> bulkApi;
 @property (nonatomic, assign) NSInteger sendIntervalSeconds;
 @property (nonatomic, copy, nullable) NSString *endpoint;
-@property (nonatomic, strong, nullable) NSTimer *sendTimer;
+@property (nonatomic, strong) CLXFlushScheduler *flushScheduler;
 @property (nonatomic, copy) NSString *sessionId;
 @property (nonatomic, copy) NSString *basePayload;
 @property (nonatomic, copy) NSString *accountId;
 @property (nonatomic, strong) dispatch_queue_t metricsQueue;
+
+// In-memory aggregation table keyed by metric name (accessed only on metricsQueue)
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXMetricsEvent *> *aggregates;
+@property (nonatomic, strong) NSMutableSet<NSString *> *dirtyMetricNames;
+@property (nonatomic, assign) BOOL aggregatesLoaded;
+@property (nonatomic, strong, nullable) dispatch_source_t checkpointTimer;
+@property (nonatomic, strong, nullable) id didEnterBackgroundObserver;
 @end
 
 @implementation CLXMetricsTrackerImpl
 
 - (instancetype)init {
-    CLXSQLiteDatabase *database = [[CLXSQLiteDatabase alloc] initWithDatabaseName:@"cloudx_metrics"];
-    return [self initWithDatabase:database];
+    // Metrics share the SDK's single WAL connection with the win/loss cache
+    CLXSQLiteDatabase *database = [CLXSQLiteDatabase sharedDatabase];
+    self = [self initWithDatabase:database];
+    if (self) {
+        [database importTable:@"metrics_event_table" fromLegacyDatabaseNamed:@"cloudx_metrics"];
+    }
+    return self;
 }
 
 - (instancetype)initWithDatabase:(CLXSQLiteDatabase *)database {
@@ -49,15 +66,52 @@
         _basePayload = @"";
         _accountId = @"";
         
+        _checkpointIntervalSeconds = kCLXDefaultCheckpointIntervalSeconds;
+        _aggregates = [NSMutableDictionary dictionary];
+        _dirtyMetricNames = [NSMutableSet set];
+        
         // Create serial queue for thread safety
         _metricsQueue = dispatch_queue_create("com.cloudx.metrics", DISPATCH_QUEUE_SERIAL);
+        
+        // Periodic sends run on metricsQueue via a dispatch_source timer. There is no early flush:
+        // calls aggregate into one row per metric type, so the pending payload stays small.
+        __weak typeof(self) weakSelf = self;
+        _flushScheduler = [[CLXFlushScheduler alloc] initWithName:@"metrics"
+                                                          interval:_sendIntervalSeconds
+                                                             queue:_metricsQueue
+                                                        flushBlock:^(dispatch_block_t completion) {
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf) {
+                [strongSelf _sendPendingMetricsWithCompletion:completion];
+            } else {
+                completion();
+            }
+        }];
+        
+        // Persist aggregates before the app can be suspended or killed in background
+        _didEnterBackgroundObserver = [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidEnterBackgroundNotification
+                                                                                        object:nil
+                                                                                         queue:nil
+                                                                                    usingBlock:^(NSNotification * _Nonnull note) {
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf) {
+                dispatch_async(strongSelf.metricsQueue, ^{
+                    [strongSelf _checkpointAggregates];
+                });
+            }
+        }];
     }
     return self;
 }
 
 - (void)dealloc {
+    if (_didEnterBackgroundObserver) {
+        [[NSNotificationCenter defaultCenter] removeObserver:_didEnterBackgroundObserver];
+    }
+    
     // Synchronously stop without using dispatch queue to avoid crashes
     [self _stopPeriodicSending];
+    [self _stopCheckpointTimer];
 }
 
 #pragma mark - CLXMetricsTrackerProtocol
@@ -74,18 +128,19 @@
         NSString *metricsURL = config.impressionTrackerURL ?: config.metricsEndpointURL;
         if (metricsURL && metricsURL.length > 0) {
             self.endpoint = [NSString stringWithFormat:@"%@/bulk?debug=true", metricsURL];
-            [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Using endpoint: %@ (from %@)", 
-                               self.endpoint, config.impressionTrackerURL ? @"impressionTrackerURL" : @"metricsEndpointURL"]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Using endpoint: %@ (from %@)",
+                          self.endpoint, config.impressionTrackerURL ? @"impressionTrackerURL" : @"metricsEndpointURL");
         } else {
             self.endpoint = nil;
             [self.logger info:@"⚠️ [MetricsTrackerImpl] No impression tracker or metrics endpoint URL provided, metrics sending disabled"];
         }
         self.sendIntervalSeconds = self.metricsConfig.sendIntervalSeconds ?: 60;
         
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Starting metrics tracker with cycle duration: %ld seconds", 
-                           (long)self.sendIntervalSeconds]];
+        CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Starting metrics tracker with cycle duration: %ld seconds",
+                      (long)self.sendIntervalSeconds);
         
         [self _startPeriodicSending];
+        [self _startCheckpointTimer];
     });
 }
 
@@ -97,14 +152,14 @@
         self.accountId = [accountId copy] ?: @"";
         self.basePayload = [basePayload copy] ?: @"";
         
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Basic data set - sessionId: %@, accountId: %@", 
-                           sessionId ? @"YES" : @"NO", accountId ? @"YES" : @"NO"]];
+        CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Basic data set - sessionId: %@, accountId: %@",
+                      sessionId ? @"YES" : @"NO", accountId ? @"YES" : @"NO");
     });
 }
 
 - (void)trackMethodCall:(NSString *)methodType {
     if (![CLXMetricsType isMethodCallType:methodType]) {
-        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsTrackerImpl] Invalid method type: %@", methodType]];
+        CLX_LOG_ERROR(self.logger, @"❌ [MetricsTrackerImpl] Invalid method type: %@", methodType);
         return;
     }
     
@@ -112,18 +167,18 @@
         // Check if SDK API calls are enabled
         BOOL isMethodCallMetricsEnabled = [self.metricsConfig isSdkApiCallsEnabled];
         if (!isMethodCallMetricsEnabled) {
-            [self.logger info:[NSString stringWithFormat:@"⚠️ [MetricsTrackerImpl] SDK API call metrics tracking is disabled for %@", methodType]];
+            CLX_LOG_INFO(self.logger, @"⚠️ [MetricsTrackerImpl] SDK API call metrics tracking is disabled for %@", methodType);
             return;
         }
         
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Tracking SDK API call: %@", methodType]];
+        CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Tracking SDK API call: %@", methodType);
         [self _trackMetric:methodType latency:0];
     });
 }
 
 - (void)trackNetworkCall:(NSString *)networkType latency:(NSInteger)latencyMs {
     if (![CLXMetricsType isNetworkCallType:networkType]) {
-        [self.logger error:[NSString stringWithFormat:@"❌ [MetricsTrackerImpl] Invalid network type: %@", networkType]];
+        CLX_LOG_ERROR(self.logger, @"❌ [MetricsTrackerImpl] Invalid network type: %@", networkType);
         return;
     }
     
@@ -140,11 +195,37 @@
         }
         
         if (isNetworkCallMetricsEnabled && isCallMetricsEnabled) {
-            [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Tracking network request: %@ with latency: %ld ms", 
-                               networkType, (long)latencyMs]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Tracking network request: %@ with latency: %ld ms",
+                          networkType, (long)latencyMs);
             [self _trackMetric:networkType latency:latencyMs];
         } else {
-            [self.logger info:[NSString stringWithFormat:@"⚠️ [MetricsTrackerImpl] Network call metrics tracking is disabled for %@", networkType]];
+            CLX_LOG_INFO(self.logger, @"⚠️ [MetricsTrackerImpl] Network call metrics tracking is disabled for %@", networkType);
+        }
+    });
+}
+
+- (void)trackPerformanceMetric:(NSString *)metricType value:(NSInteger)valueMs {
+    if (![CLXMetricsType isPerformanceType:metricType]) {
+        CLX_LOG_ERROR(self.logger, @"❌ [MetricsTrackerImpl] Invalid performance metric type: %@", metricType);
+        return;
+    }
+    
+    dispatch_async(self.metricsQueue, ^{
+        BOOL isMetricEnabled = NO;
+        if ([[CLXMetricsType allAuctionStageTypes] containsObject:metricType]) {
+            isMetricEnabled = [self.metricsConfig isAuctionStageMetricsEnabled];
+        } else if ([[CLXMetricsType allConnectionTypes] containsObject:metricType]) {
+            isMetricEnabled = [self.metricsConfig isConnectionMetricsEnabled];
+        } else if ([[CLXMetricsType allCacheRefillTypes] containsObject:metricType]) {
+            isMetricEnabled = [self.metricsConfig isCacheRefillMetricsEnabled];
+        }
+        
+        if (isMetricEnabled) {
+            CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Tracking performance metric: %@ with value: %ld ms",
+                          metricType, (long)valueMs);
+            [self _trackMetric:metricType latency:valueMs];
+        } else {
+            CLX_LOG_INFO(self.logger, @"⚠️ [MetricsTrackerImpl] Performance metrics tracking is disabled for %@", metricType);
         }
     });
 }
@@ -152,7 +233,7 @@
 - (void)trySendingPendingMetrics {
     dispatch_async(self.metricsQueue, ^{
         [self.logger debug:@"📊 [MetricsTrackerImpl] Attempting to send pending metrics"];
-        [self _sendPendingMetrics];
+        [self _sendPendingMetricsWithCompletion:nil];
     });
 }
 
@@ -160,6 +241,8 @@
     if (self.metricsQueue) {
         dispatch_async(self.metricsQueue, ^{
             [self _stopPeriodicSending];
+            [self _stopCheckpointTimer];
+            [self _checkpointAggregates];
             [self.logger debug:@"📊 [MetricsTrackerImpl] Metrics tracker stopped"];
         });
     } else {
@@ -172,34 +255,127 @@
 #pragma mark - Private Methods
 
 - (void)_trackMetric:(NSString *)metricType latency:(NSInteger)latency {
-    [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Tracking metric: %@ with latency: %ld ms", 
-                       metricType, (long)latency]];
-    
-    // Get existing metric for aggregation (matching Android logic)
-    CLXMetricsEvent *existingMetric = [self.metricsDao getAllByMetric:metricType];
-    [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Existing metric for %@: %@", 
-                       metricType, existingMetric ? @"YES" : @"NO"]];
-    
-    CLXMetricsEvent *updatedMetric;
-    if (!existingMetric) {
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Creating new metric for %@", metricType]];
-        updatedMetric = [[CLXMetricsEvent alloc] initWithEventId:[[NSUUID UUID] UUIDString]
-                                                      metricName:metricType
-                                                         counter:1
-                                                    totalLatency:latency
-                                                       sessionId:self.sessionId
-                                                       auctionId:[[NSUUID UUID] UUIDString]];
-    } else {
-        [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Updating existing metric for %@", metricType]];
-        updatedMetric = [[CLXMetricsEvent alloc] initWithEventId:existingMetric.eventId
-                                                      metricName:existingMetric.metricName
-                                                         counter:existingMetric.counter + 1
-                                                    totalLatency:existingMetric.totalLatency + latency
-                                                       sessionId:existingMetric.sessionId
-                                                       auctionId:existingMetric.auctionId];
+    CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Tracking metric: %@ with latency: %ld ms",
+                  metricType, (long)latency);
+    
+    [self _loadAggregatesIfNeeded];
+    
+    // Aggregate in memory (matching Android's counter/latency logic); SQLite is updated on checkpoint
+    CLXMetricsEvent *aggregate = self.aggregates[metricType];
+    if (!aggregate) {
+        aggregate = [[CLXMetricsEvent alloc] initWithEventId:[[NSUUID UUID] UUIDString]
+                                                  metricName:metricType
+                                                     counter:0
+                                                totalLatency:0
+                                                   sessionId:self.sessionId
+                                                   auctionId:[[NSUUID UUID] UUIDString]];
+        self.aggregates[metricType] = aggregate;
+    }
+    aggregate.counter += 1;
+    aggregate.totalLatency += latency;
+    if ([CLXMetricsType isNetworkCallType:metricType]) {
+        [aggregate.latencyHistogram recordLatency:latency];
+    }
+    [self.dirtyMetricNames addObject:metricType];
+}
+
+#pragma mark - Aggregation
+
+/**
+ * Seeds the aggregation table from rows persisted by a previous checkpoint or session
+ */
+- (void)_loadAggregatesIfNeeded {
+    if (self.aggregatesLoaded) {
+        return;
+    }
+    self.aggregatesLoaded = YES;
+    
+    for (CLXMetricsEvent *event in [self.metricsDao getAll]) {
+        if (event.metricName.length > 0 && !self.aggregates[event.metricName]) {
+            self.aggregates[event.metricName] = event;
+        }
+    }
+}
+
+/**
+ * Writes every aggregate changed since the last checkpoint in a single transaction
+ */
+- (void)_checkpointAggregates {
+    if (self.dirtyMetricNames.count == 0) {
+        return;
+    }
+    
+    NSMutableArray<CLXMetricsEvent *> *dirtyEvents = [NSMutableArray arrayWithCapacity:self.dirtyMetricNames.count];
+    for (NSString *metricName in self.dirtyMetricNames) {
+        CLXMetricsEvent *aggregate = self.aggregates[metricName];
+        if (aggregate) {
+            [dirtyEvents addObject:aggregate];
+        }
+    }
+    
+    if ([self.metricsDao insertAll:dirtyEvents]) {
+        [self.dirtyMetricNames removeAllObjects];
+        CLX_LOG_DEBUG(self.logger, @"💾 [MetricsTrackerImpl] Checkpointed %lu metrics", (unsigned long)dirtyEvents.count);
+    }
+}
+
+/**
+ * Subtracts a successfully sent snapshot from the live aggregates so counts recorded
+ * while the request was in flight are kept for the next send
+ */
+- (void)_reconcileSentMetrics:(NSArray<CLXMetricsEvent *> *)sentMetrics {
+    NSMutableArray<NSString *> *idsToDelete = [NSMutableArray array];
+    
+    for (CLXMetricsEvent *sent in sentMetrics) {
+        CLXMetricsEvent *live = self.aggregates[sent.metricName];
+        if (!live || ![live.eventId isEqualToString:sent.eventId]) {
+            [idsToDelete addObject:sent.eventId];
+            continue;
+        }
+        
+        live.counter -= sent.counter;
+        live.totalLatency -= sent.totalLatency;
+        [live.latencyHistogram subtractHistogram:sent.latencyHistogram];
+        if (live.counter <= 0) {
+            [self.aggregates removeObjectForKey:sent.metricName];
+            [self.dirtyMetricNames removeObject:sent.metricName];
+            [idsToDelete addObject:sent.eventId];
+        } else {
+            [self.dirtyMetricNames addObject:sent.metricName];
+        }
+    }
+    
+    // Remove sent rows and persist the remainders together so a crash cannot resend counts
+    [self.database executeInTransaction:^{
+        [self.metricsDao deleteByIds:idsToDelete];
+        [self _checkpointAggregates];
+    }];
+}
+
+- (void)_startCheckpointTimer {
+    [self _stopCheckpointTimer];
+    
+    if (self.checkpointIntervalSeconds <= 0) {
+        return;
     }
     
-    [self.metricsDao insert:updatedMetric];
+    uint64_t interval = (uint64_t)(self.checkpointIntervalSeconds * NSEC_PER_SEC);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.metricsQueue);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, interval / 10);
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(timer, ^{
+        [weakSelf _checkpointAggregates];
+    });
+    dispatch_resume(timer);
+    self.checkpointTimer = timer;
+}
+
+- (void)_stopCheckpointTimer {
+    if (self.checkpointTimer) {
+        dispatch_source_cancel(self.checkpointTimer);
+        self.checkpointTimer = nil;
+    }
 }
 
 - (void)_startPeriodicSending {
@@ -210,39 +386,32 @@
         return;
     }
     
-    // Use weak reference to avoid retain cycle
-    __weak typeof(self) weakSelf = self;
-    self.sendTimer = [NSTimer scheduledTimerWithTimeInterval:self.sendIntervalSeconds
-                                                     repeats:YES
-                                                       block:^(NSTimer * _Nonnull timer) {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if (strongSelf) {
-            [strongSelf _sendPendingMetrics];
-        } else {
-            [timer invalidate];
-        }
-    }];
+    self.flushScheduler.interval = self.sendIntervalSeconds;
+    [self.flushScheduler start];
     
-    [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Started periodic sending every %ld seconds", 
-                       (long)self.sendIntervalSeconds]];
+    CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Started periodic sending every %ld seconds",
+                  (long)self.sendIntervalSeconds);
 }
 
 - (void)_stopPeriodicSending {
-    if (self.sendTimer) {
-        if ([self.sendTimer isValid]) {
-            [self.sendTimer invalidate];
-        }
-        self.sendTimer = nil;
+    if (self.flushScheduler.isRunning) {
+        [self.flushScheduler stop];
         [self.logger debug:@"📊 [MetricsTrackerImpl] Stopped periodic sending"];
     }
 }
 
-- (void)_sendPendingMetrics {
+- (void)_sendPendingMetricsWithCompletion:(nullable dispatch_block_t)completion {
+    [self _loadAggregatesIfNeeded];
+    [self _checkpointAggregates];
+    
     NSArray<CLXMetricsEvent *> *metrics = [self.metricsDao getAll];
-    [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Found %lu pending metrics", 
-                       (unsigned long)metrics.count]];
+    CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Found %lu pending metrics",
+                  (unsigned long)metrics.count);
     
     if (metrics.count == 0 || !self.endpoint || self.endpoint.length == 0) {
+        if (completion) {
+            completion();
+        }
         return;
     }
     
@@ -257,23 +426,30 @@
     
     if (events.count == 0) {
         [self.logger debug:@"📊 [MetricsTrackerImpl] No valid events to send"];
+        if (completion) {
+            completion();
+        }
         return;
     }
     
     // Send via bulk API
     [self.bulkApi sendToEndpoint:self.endpoint items:events completion:^(BOOL success, NSError * _Nullable error) {
         if (success) {
-            [self.logger debug:[NSString stringWithFormat:@"✅ [MetricsTrackerImpl] Successfully sent %lu metrics", (unsigned long)events.count]];
+            CLX_LOG_DEBUG(self.logger, @"✅ [MetricsTrackerImpl] Successfully sent %lu metrics", (unsigned long)events.count);
             
             // Delete successfully sent metrics
             dispatch_async(self.metricsQueue, ^{
-                for (CLXMetricsEvent *metric in metrics) {
-                    [self.metricsDao deleteById:metric.eventId];
+                [self _reconcileSentMetrics:metrics];
+                CLX_LOG_DEBUG(self.logger, @"🗑️ [MetricsTrackerImpl] Cleaned up %lu sent metrics", (unsigned long)metrics.count);
+                if (completion) {
+                    completion();
                 }
-                [self.logger debug:[NSString stringWithFormat:@"🗑️ [MetricsTrackerImpl] Cleaned up %lu sent metrics", (unsigned long)metrics.count]];
             });
         } else {
-            [self.logger error:[NSString stringWithFormat:@"❌ [MetricsTrackerImpl] Failed to send metrics: %@", error.localizedDescription ?: @"Unknown error"]];
+            CLX_LOG_ERROR(self.logger, @"❌ [MetricsTrackerImpl] Failed to send metrics: %@", error.localizedDescription ?: @"Unknown error");
+            if (completion) {
+                completion();
+            }
         }
     }];
 }
@@ -290,7 +466,11 @@
     }
     
     // Build payload matching Android format: basePayload;metricName;counter/totalLatency
+    // With histograms enabled network metrics append the sparse bucket list: counter/totalLatency/idx:count,...
     NSString *metricDetail = [NSString stringWithFormat:@"%ld/%ld", (long)metric.counter, (long)metric.totalLatency];
+    if ([self.metricsConfig isLatencyHistogramEnabled] && !metric.latencyHistogram.isEmpty) {
+        metricDetail = [metricDetail stringByAppendingFormat:@"/%@", [metric.latencyHistogram serializedString]];
+    }
     NSString *payload = [NSString stringWithFormat:@"%@;%@;%@", 
                         self.basePayload ?: @"", 
                         metric.metricName ?: @"", 
@@ -300,8 +480,8 @@
     NSString *auctionId = metric.auctionId ?: @"unknown";
     payload = [payload stringByReplacingOccurrencesOfString:@"{eventId}" withString:auctionId];
     
-    [self.logger debug:[NSString stringWithFormat:@"📊 [MetricsTrackerImpl] Building event for metric: %@ with payload: %@", 
-                       metric.metricName ?: @"unknown", payload]];
+    CLX_LOG_DEBUG(self.logger, @"📊 [MetricsTrackerImpl] Building event for metric: %@ with payload: %@",
+                  metric.metricName ?: @"unknown", payload);
     
     // Generate XOR encryption data matching Android exactly
     NSData *secret = [CLXXorEncryption generateXorSecret:self.accountId];
@@ -326,10 +506,10 @@
     // Additional debug info specific to this tracker instance
     [self.logger info:@"🔍 TRACKER INSTANCE DEBUG"];
     [self.logger info:@"========================="];
-    [self.logger info:[NSString stringWithFormat:@"📱 Session ID: %@", self.sessionId ?: @"(nil)"]];
-    [self.logger info:[NSString stringWithFormat:@"👤 Account ID: %@", self.accountId ?: @"(nil)"]];
-    [self.logger info:[NSString stringWithFormat:@"📦 Base Payload Length: %lu chars", (unsigned long)(self.basePayload ? self.basePayload.length : 0)]];
-    [self.logger info:[NSString stringWithFormat:@"⏰ Send Timer: %@", self.sendTimer ? @"Active" : @"Inactive"]];
+    CLX_LOG_INFO(self.logger, @"📱 Session ID: %@", self.sessionId ?: @"(nil)");
+    CLX_LOG_INFO(self.logger, @"👤 Account ID: %@", self.accountId ?: @"(nil)");
+    CLX_LOG_INFO(self.logger, @"📦 Base Payload Length: %lu chars", (unsigned long)(self.basePayload ? self.basePayload.length : 0));
+    CLX_LOG_INFO(self.logger, @"⏰ Send Timer: %@", self.flushScheduler.isRunning ? @"Active" : @"Inactive");
     
     // Performance report
     NSString *perfReport = [CLXMetricsDebugger generatePerformanceReport:self.metricsDao];
@@ -361,6 +541,10 @@
     
     // Wait for the barrier block to execute (indicating all previous operations are done)
     dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    
+    dispatch_sync(self.metricsQueue, ^{
+        [self _checkpointAggregates];
+    });
 }
 #endif
 
@@ -9,6 +9,22 @@ NSString * const CLXMetricsTypeNetworkSdkInit = @"network_call_sdk_init_req";
 NSString * const CLXMetricsTypeNetworkGeoApi = @"network_call_geo_req";
 NSString * const CLXMetricsTypeNetworkBidRequest = @"network_call_bid_req";
 
+// Auction stage timings
+NSString * const CLXMetricsTypeAuctionStageBidTokens = @"auction_stage_bid_tokens";
+NSString * const CLXMetricsTypeAuctionStageBidRequest = @"auction_stage_bid_req";
+NSString * const CLXMetricsTypeAuctionStageAdapterLoad = @"auction_stage_adapter_load";
+
+// Connection reuse
+NSString * const CLXMetricsTypeNetworkConnectionNew = @"network_conn_new";
+NSString * const CLXMetricsTypeNetworkConnectionReused = @"network_conn_reused";
+
+// Cache refill decisions
+NSString * const CLXMetricsTypeCacheRefillStart = @"cache_refill_start";
+NSString * const CLXMetricsTypeCacheRefillDefer = @"cache_refill_defer";
+NSString * const CLXMetricsTypeCacheAdExpired = @"cache_ad_expired";
+NSString * const CLXMetricsTypeCacheShowReady = @"cache_show_ready";
+NSString * const CLXMetricsTypeCacheShowMiss = @"cache_show_miss";
+
 // Method call metrics types - matching Android exactly
 NSString * const CLXMetricsTypeMethodSdkInit = @"method_sdk_init";
 NSString * const CLXMetricsTypeMethodCreateBanner = @"method_create_banner";
@@ -31,6 +47,10 @@ NSString * const CLXMetricsTypeMethodBannerRefresh = @"method_banner_refresh";
     return [[self allMethodCallTypes] containsObject:metricType];
 }
 
++ (BOOL)isPerformanceType:(NSString *)metricType {
+    return [[self allPerformanceTypes] containsObject:metricType];
+}
+
 + (NSArray<NSString *> *)allNetworkCallTypes {
     static NSArray<NSString *> *networkTypes = nil;
     static dispatch_once_t onceToken;
@@ -64,8 +84,46 @@ NSString * const CLXMetricsTypeMethodBannerRefresh = @"method_banner_refresh";
     return methodTypes;
 }
 
++ (NSArray<NSString *> *)allPerformanceTypes {
+    static NSArray<NSString *> *performanceTypes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray<NSString *> *types = [NSMutableArray array];
+        [types addObjectsFromArray:[self allAuctionStageTypes]];
+        [types addObjectsFromArray:[self allConnectionTypes]];
+        [types addObjectsFromArray:[self allCacheRefillTypes]];
+        performanceTypes = [types copy];
+    });
+    return performanceTypes;
+}
+
++ (NSArray<NSString *> *)allAuctionStageTypes {
+    return @[
+        CLXMetricsTypeAuctionStageBidTokens,
+        CLXMetricsTypeAuctionStageBidRequest,
+        CLXMetricsTypeAuctionStageAdapterLoad
+    ];
+}
+
++ (NSArray<NSString *> *)allConnectionTypes {
+    return @[
+        CLXMetricsTypeNetworkConnectionNew,
+        CLXMetricsTypeNetworkConnectionReused
+    ];
+}
+
++ (NSArray<NSString *> *)allCacheRefillTypes {
+    return @[
+        CLXMetricsTypeCacheRefillStart,
+        CLXMetricsTypeCacheRefillDefer,
+        CLXMetricsTypeCacheAdExpired,
+        CLXMetricsTypeCacheShowReady,
+        CLXMetricsTypeCacheShowMiss
+    ];
+}
+
 + (BOOL)isValidMetricType:(NSString *)metricType {
-    return [self isNetworkCallType:metricType] || [self isMethodCallType:metricType];
+    return [self isNetworkCallType:metricType] || [self isMethodCallType:metricType] || [self isPerformanceType:metricType];
 }
 
 @end
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXAuctionDeadline.m
+ * @brief End-to-end time budget for one auction
+ */
+
+#import <CloudXCore/CLXAuctionDeadline.h>
+#import <CloudXCore/CLXMetricsTrackerProtocol.h>
+
+@interface CLXAuctionDeadline ()
+@property (nonatomic, assign, readwrite) NSTimeInterval budget;
+@property (nonatomic, copy, nullable) NSTimeInterval (^clock)(void);
+@property (nonatomic, assign) NSTimeInterval startTime;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *stageStartTimes;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *completedStages;
+@end
+
+@implementation CLXAuctionDeadline
+
+- (instancetype)initWithBudget:(NSTimeInterval)budget {
+    return [self initWithBudget:budget clock:nil];
+}
+
+- (instancetype)initWithBudget:(NSTimeInterval)budget clock:(nullable NSTimeInterval (^)(void))clock {
+    self = [super init];
+    if (self) {
+        _budget = MAX(budget, 0);
+        _clock = [clock copy];
+        _startTime = [self _now];
+        _stageStartTimes = [NSMutableDictionary dictionary];
+        _completedStages = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSTimeInterval)elapsed {
+    return [self _now] - self.startTime;
+}
+
+- (NSTimeInterval)remaining {
+    return MAX(self.budget - self.elapsed, 0);
+}
+
+- (BOOL)isExpired {
+    return self.remaining <= 0;
+}
+
+- (BOOL)canFinishWithin:(NSTimeInterval)duration {
+    return self.remaining >= duration;
+}
+
+- (NSTimeInterval)timeoutBoundedBy:(NSTimeInterval)timeout {
+    NSTimeInterval remaining = self.remaining;
+    return timeout > 0 ? MIN(timeout, remaining) : remaining;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)stageDurations {
+    @synchronized (self) {
+        return [self.completedStages copy];
+    }
+}
+
+- (void)beginStage:(NSString *)stage {
+    NSTimeInterval now = [self _now];
+    @synchronized (self) {
+        self.stageStartTimes[stage] = @(now);
+    }
+}
+
+- (NSTimeInterval)endStage:(NSString *)stage {
+    NSTimeInterval now = [self _now];
+    NSTimeInterval duration = 0;
+    @synchronized (self) {
+        NSNumber *start = self.stageStartTimes[stage];
+        if (!start) {
+            return 0;
+        }
+        [self.stageStartTimes removeObjectForKey:stage];
+        duration = now - start.doubleValue;
+        self.completedStages[stage] = @((NSInteger)(duration * 1000));
+    }
+    [self.metricsTracker trackPerformanceMetric:stage value:(NSInteger)(duration * 1000)];
+    return duration;
+}
+
+#pragma mark - Private Methods
+
+- (NSTimeInterval)_now {
+    return self.clock ? self.clock() : [NSProcessInfo processInfo].systemUptime;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<CLXAuctionDeadline %.0fms of %.0fms used, stages: %@>",
+            self.elapsed * 1000, self.budget * 1000, self.stageDurations];
+}
+
+@end
@@ -9,7 +9,9 @@
 
 #import <CloudXCore/CLXBidAdSource.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
+#import <CloudXCore/CLXCounterRegistry.h>
 #import <CloudXCore/CLXBidTokenSource.h>
+#import <CloudXCore/CLXBidTokenCache.h>
 #import <CloudXCore/CLXSDKConfigPlacement.h>
 #import <CloudXCore/CLXConfigImpressionModel.h>
 #import <CloudXCore/CLXAdNetworkFactories.h>
@@ -26,9 +28,21 @@
 #import <CloudXCore/CLXDIContainer.h>
 #import <CloudXCore/CLXBidResponse.h>
 #import <CloudXCore/CLXTrackingFieldResolver.h>
+#import <CloudXCore/CLXAuctionDeadline.h>
+#import <CloudXCore/CLXMetricsTrackerProtocol.h>
+#import <CloudXCore/CLXMetricsTrackerImpl.h>
+#import <CloudXCore/CLXMetricsType.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+// Time left for the adapter load after the server-side auction (tmax)
+static const NSTimeInterval kCLXAuctionLoadAllowance = 5.0;
+// Auction budget when the placement has no tmax
+static const NSTimeInterval kCLXDefaultAuctionBudget = 8.0;
+
+// Final step of an auction: picks and prepares the ad from the bid response
+typedef void (^CLXBidWaterfallStep)(CLXBidResponse *response, NSDictionary *bidRequest, CLXAuctionDeadline *deadline);
+
 @interface CLXBidAdSourceResponse ()
 
 @property (nonatomic, assign, readwrite) double price;
@@ -41,6 +55,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readwrite) CLXBidResponseBid *bid;
 @property (nonatomic, strong, readwrite) CLXBiddingConfigRequest *bidRequest;
 @property (nonatomic, copy, readwrite) id (^createBidAd)(void);
+@property (nonatomic, strong, readwrite, nullable) CLXAuctionDeadline *deadline;
 
 @end
 
@@ -125,6 +140,10 @@ NS_ASSUME_NONNULL_BEGIN
         _reportingService = reportingService;
         _logger = [[CLXLogger alloc] initWithCategory:@"CLXBidAdSource"];
         _latency = 0;
+        // tmax is in milliseconds (OpenRTB)
+        _auctionBudget = tmax ? tmax.doubleValue / 1000.0 + kCLXAuctionLoadAllowance : kCLXDefaultAuctionBudget;
+        _maxConcurrentLoads = 1;
+        _hedgeDelay = 0;
         
         // Get services from dependency injection
         CLXDIContainer *container = [CLXDIContainer shared];
@@ -147,24 +166,74 @@ NS_ASSUME_NONNULL_BEGIN
                       impModel:(nullable CLXConfigImpressionModel *)impModel
                       successWin:(BOOL)successWin
                       completion:(void (^)(CLXBidAdSourceResponse * _Nullable response, NSError * _Nullable error))completion {
+    __weak typeof(self) weakSelf = self;
+    [self requestBidWithAdUnitID:adUnitID
+              storedImpressionId:storedImpressionId
+                        impModel:impModel
+                      successWin:successWin
+                       waterfall:^(CLXBidResponse *response, NSDictionary *bidRequest, CLXAuctionDeadline *deadline) {
+        // Implement true waterfall logic 
+        [weakSelf tryWaterfallBidsFromResponse:response 
+                                     auctionID:response.id 
+                                    bidRequest:bidRequest 
+                                      deadline:deadline
+                                    completion:completion];
+    }
+                      completion:completion];
+}
+
+- (void)requestBidWithAdUnitID:(NSString *)adUnitID
+              storedImpressionId:(NSString *)storedImpressionId
+                      impModel:(nullable CLXConfigImpressionModel *)impModel
+                      successWin:(BOOL)successWin
+                   adapterLoader:(CLXHedgedAdapterLoader)loader
+                       canceller:(nullable CLXHedgedAdapterCanceller)canceller
+                      completion:(void (^)(CLXBidAdSourceResponse * _Nullable response, id _Nullable adapter, NSError * _Nullable error))completion {
+    __weak typeof(self) weakSelf = self;
+    [self requestBidWithAdUnitID:adUnitID
+              storedImpressionId:storedImpressionId
+                        impModel:impModel
+                      successWin:successWin
+                       waterfall:^(CLXBidResponse *response, NSDictionary *bidRequest, CLXAuctionDeadline *deadline) {
+        [weakSelf runHedgedWaterfallFromResponse:response
+                                      bidRequest:bidRequest
+                                        deadline:deadline
+                                          loader:loader
+                                       canceller:canceller
+                                      completion:completion];
+    }
+                      completion:^(CLXBidAdSourceResponse * _Nullable response, NSError * _Nullable error) {
+        // Only auction failures arrive here; the waterfall reports through its own completion
+        if (completion) {
+            completion(nil, nil, error);
+        }
+    }];
+}
+
+/**
+ * Runs the auction and hands the bid response to the waterfall step
+ * @param completion Called for failures before the waterfall step
+ */
+- (void)requestBidWithAdUnitID:(NSString *)adUnitID
+              storedImpressionId:(NSString *)storedImpressionId
+                      impModel:(nullable CLXConfigImpressionModel *)impModel
+                      successWin:(BOOL)successWin
+                       waterfall:(CLXBidWaterfallStep)waterfall
+                      completion:(void (^)(CLXBidAdSourceResponse * _Nullable response, NSError * _Nullable error))completion {
     
-    [self.logger info:[NSString stringWithFormat:@"🚀 [CLXBidAdSource] requestBidWithAdUnitID called - AdUnit: %@, Placement: %@, AdType: %ld", adUnitID, self.placementID, (long)self.adType]];
+    CLX_LOG_INFO(self.logger, @"🚀 [CLXBidAdSource] requestBidWithAdUnitID called - AdUnit: %@, Placement: %@, AdType: %ld", adUnitID, self.placementID, (long)self.adType);
     
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-    NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-    if ([metricsDict.allKeys containsObject:@"network_call_bid_req"]) {
-        NSString *value = metricsDict[@"network_call_bid_req"];
-        int number = [value intValue];
-        int new = number + 1;
-        metricsDict[@"network_call_bid_req"] = [NSString stringWithFormat:@"%d", new];
-    } else {
-        metricsDict[@"network_call_bid_req"] = @"1";
-    }
-    [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+    [[CLXCounterRegistry coreMetrics] incrementCounter:@"network_call_bid_req"];
+    
+    // Every stage of this auction draws on one budget and reports its duration
+    CLXAuctionDeadline *deadline = [[CLXAuctionDeadline alloc] initWithBudget:self.auctionBudget];
+    deadline.metricsTracker = [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
     
     // Create network name token dictionary from bidTokenSources
-    [self makeNetworkNameTokenDictWithCompletion:^(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *networkNameTokenDict) {
-        [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Network name token dict: %@", networkNameTokenDict]];
+    [deadline beginStage:CLXMetricsTypeAuctionStageBidTokens];
+    [self makeNetworkNameTokenDictWithDeadline:deadline completion:^(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *networkNameTokenDict) {
+        [deadline endStage:CLXMetricsTypeAuctionStageBidTokens];
+        CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] Network name token dict: %@", networkNameTokenDict);
         
         // Create bid request
         [self.logger debug:@"🔧 [CLXBidAdSource] Creating bid request..."];
@@ -192,24 +261,13 @@ NS_ASSUME_NONNULL_BEGIN
             
             [self.logger debug:@"📥 [CLXBidAdSource] Bid request creation completion called"];
             
-            // Log the actual bid request JSON
-            if (bidRequest) {
-                NSError *jsonError;
-                NSData *jsonData = [NSJSONSerialization dataWithJSONObject:bidRequest options:NSJSONWritingPrettyPrinted error:&jsonError];
-                if (jsonData && !jsonError) {
-                    NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-                    [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] BidRequest JSON:\n%@", jsonString]];
-                } else {
-                    [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] BidRequest: %@", bidRequest]];
-                }
-            } else {
-                [self.logger debug:@"📊 [CLXBidAdSource] BidRequest: (null)"];
-            }
+            // The full body is recorded by CLXPayloadCapture when it is sent, so it is not encoded here
+            CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] BidRequest ID: %@", [bidRequest isKindOfClass:[NSDictionary class]] ? bidRequest[@"id"] : @"(null)");
             
-            [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Error: %@", error]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] Error: %@", error);
             
             if (error) {
-                [self.logger error:[NSString stringWithFormat:@"❌ [CLXBidAdSource] Bid request creation failed with error: %@", error.localizedDescription]];
+                CLX_LOG_ERROR(self.logger, @"❌ [CLXBidAdSource] Bid request creation failed with error: %@", error.localizedDescription);
                 if (completion) {
                     completion(nil, error);
                 }
@@ -223,7 +281,7 @@ NS_ASSUME_NONNULL_BEGIN
                 NSString *auctionId = bidRequest[@"id"];
                 if (auctionId) {
                     [[CLXTrackingFieldResolver shared] setRequestData:auctionId bidRequestJSON:(NSDictionary *)bidRequest];
-                    [self.logger debug:[NSString stringWithFormat:@"Stored bid request JSON for auction: %@", auctionId]];
+                    CLX_LOG_DEBUG(self.logger, @"Stored bid request JSON for auction: %@", auctionId);
                 }
             }
             
@@ -236,10 +294,13 @@ NS_ASSUME_NONNULL_BEGIN
                 }
                 return;
             }
-            [self.logger debug:[NSString stringWithFormat:@"🔧 [CLXBidAdSource] Starting auction with AppKey: %@", currentAppKey]];
+            CLX_LOG_DEBUG(self.logger, @"🔧 [CLXBidAdSource] Starting auction with AppKey: %@", currentAppKey);
+            [deadline beginStage:CLXMetricsTypeAuctionStageBidRequest];
             [strongSelf.bidNetworkService startAuctionWithBidRequest:bidRequest
                                                               appKey:currentAppKey
+                                                            deadline:deadline
                                                           completion:^(CLXBidResponse * _Nullable response, NSDictionary * _Nullable rawJSON, NSError * _Nullable error) {
+                [deadline endStage:CLXMetricsTypeAuctionStageBidRequest];
                 __strong typeof(weakSelf) strongSelf = weakSelf;
                 if (!strongSelf) {
                     [self.logger error:@"❌ [CLXBidAdSource] Self reference lost in auction completion block"];
@@ -249,10 +310,10 @@ NS_ASSUME_NONNULL_BEGIN
                     return;
                 }
 
-                [self.logger debug:[NSString stringWithFormat:@"📥 [CLXBidAdSource] Auction completion - Response: %@, Error: %@", response ? @"YES" : @"NO", error ? error.localizedDescription : @"None"]];
+                CLX_LOG_DEBUG(self.logger, @"📥 [CLXBidAdSource] Auction completion - Response: %@, Error: %@", response ? @"YES" : @"NO", error ? error.localizedDescription : @"None");
                 
                 if (error) {
-                    [self.logger error:[NSString stringWithFormat:@"❌ [CLXBidAdSource] Auction failed with error: %@", error.localizedDescription]];
+                    CLX_LOG_ERROR(self.logger, @"❌ [CLXBidAdSource] Auction failed with error: %@", error.localizedDescription);
                     if (completion) {
                         completion(nil, error);
                     }
@@ -263,9 +324,13 @@ NS_ASSUME_NONNULL_BEGIN
     strongSelf.currentBidResponse = response;
     
     // Store original bid response JSON in tracking field resolver for efficient field resolution
-    if (response.id && rawJSON) {
+    if (response.id && response.rawData) {
+        // Kept as bytes; tracking paths are resolved against it on demand
+        [[CLXTrackingFieldResolver shared] setResponseData:response.id bidResponseData:response.rawData];
+        CLX_LOG_DEBUG(strongSelf.logger, @"Stored original bid response bytes for auction: %@", response.id);
+    } else if (response.id && rawJSON) {
         [[CLXTrackingFieldResolver shared] setResponseData:response.id bidResponseJSON:rawJSON];
-        [strongSelf.logger debug:[NSString stringWithFormat:@"Stored original bid response JSON for auction: %@", response.id]];
+        CLX_LOG_DEBUG(strongSelf.logger, @"Stored original bid response JSON for auction: %@", response.id);
     }
     
     // Add all bids to win/loss tracking
@@ -274,64 +339,53 @@ NS_ASSUME_NONNULL_BEGIN
         for (CLXBidResponseBid *bid in allBids) {
             [[CLXWinLossTracker shared] addBid:response.id bid:bid];
         }
-        [strongSelf.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Added %lu bids to win/loss tracking for auction: %@", 
-                                 (unsigned long)allBids.count, response.id]];
+        CLX_LOG_DEBUG(strongSelf.logger, @"📊 [CLXBidAdSource] Added %lu bids to win/loss tracking for auction: %@",
+                      (unsigned long)allBids.count, response.id);
     }
                 
-                // Implement true waterfall logic 
-                [strongSelf tryWaterfallBidsFromResponse:response 
-                                               auctionID:response.id 
-                                              bidRequest:bidRequest 
-                                              completion:completion];
+                waterfall(response, bidRequest, deadline);
             }];
         }];
     }];
 }
 
-- (void)makeNetworkNameTokenDictWithCompletion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *networkNameTokenDict))completion {
-    NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *networkNameTokenDict = [NSMutableDictionary dictionary];
-    
+- (void)makeNetworkNameTokenDictWithDeadline:(CLXAuctionDeadline *)deadline
+                                  completion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *networkNameTokenDict))completion {
     if (self.bidTokenSources.count == 0) {
         [self.logger debug:@"⚠️ [CLXBidAdSource] No bid token sources available"];
         if (completion) {
-            completion([networkNameTokenDict copy]);
+            completion(@{});
         }
         return;
     }
     
-    dispatch_group_t group = dispatch_group_create();
-    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
-    
-    for (NSString *adapterName in self.bidTokenSources.allKeys) {
-        id<CLXBidTokenSource> tokenSource = self.bidTokenSources[adapterName];
-        
-        dispatch_group_enter(group);
-        [tokenSource getTokenWithCompletion:^(NSDictionary<NSString *,NSString *> * _Nullable token, NSError * _Nullable error) {
-            if (error) {
-                [self.logger error:[NSString stringWithFormat:@"❌ [CLXBidAdSource] Failed to get token for adapter %@: %@", adapterName, error.localizedDescription]];
-            } else if (token) {
-                [self.logger debug:[NSString stringWithFormat:@"✅ [CLXBidAdSource] Got token for adapter %@: %@", adapterName, token]];
-                networkNameTokenDict[adapterName] = token;
-            } else {
-                [self.logger debug:[NSString stringWithFormat:@"⚠️ [CLXBidAdSource] No token returned for adapter %@", adapterName]];
-            }
-            dispatch_group_leave(group);
-        }];
-    }
-    
-    dispatch_group_notify(group, queue, ^{
-        [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Network name token dict created: %@", networkNameTokenDict]];
+    // Tokens come from the prefetch cache; adapters that miss the fetch deadline are skipped for this auction
+    CLXBidTokenCache *tokenCache = [CLXBidTokenCache shared];
+    [tokenCache tokensForSources:self.bidTokenSources
+                         timeout:[deadline timeoutBoundedBy:tokenCache.fetchDeadline]
+                      completion:^(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens) {
+        CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] Network name token dict created: %@ of %lu adapters", [tokens allKeys], (unsigned long)self.bidTokenSources.count);
         if (completion) {
-            completion([networkNameTokenDict copy]);
+            completion(tokens);
         }
-    });
+    }];
 }
 
 - (void)tryWaterfallBidsFromResponse:(CLXBidResponse *)response 
                            auctionID:(nullable NSString *)auctionID 
                           bidRequest:(NSDictionary *)bidRequest 
+                            deadline:(nullable CLXAuctionDeadline *)deadline
                           completion:(void (^)(CLXBidAdSourceResponse * _Nullable, NSError * _Nullable))completion {
     
+    // The bids are no use if nothing is left to load an adapter in
+    if (deadline.isExpired) {
+        CLX_LOG_ERROR(self.logger, @"⏱️ [CLXBidAdSource] Auction budget of %.0fms spent before the waterfall: %@", deadline.budget * 1000, deadline.stageDurations);
+        if (completion) {
+            completion(nil, [CLXError errorWithCode:CLXErrorCodeLoadTimeout description:@"Auction deadline exceeded"]);
+        }
+        return;
+    }
+    
     NSArray<CLXBidResponseBid *> *sortedBids = [response getAllBidsForWaterfall];
     
     if (sortedBids.count == 0) {
@@ -342,13 +396,67 @@ NS_ASSUME_NONNULL_BEGIN
         return;
     }
     
-    [self.logger debug:[NSString stringWithFormat:@"🔄 [CLXBidAdSource] Starting waterfall with %lu bids", (unsigned long)sortedBids.count]];
+    CLX_LOG_DEBUG(self.logger, @"🔄 [CLXBidAdSource] Starting waterfall with %lu bids", (unsigned long)sortedBids.count);
     
     // Try bids in waterfall order 
     [self tryNextBidInWaterfall:sortedBids 
                       bidIndex:0 
                      auctionID:auctionID 
                     bidRequest:bidRequest 
+                      deadline:deadline
+                    completion:completion];
+}
+
+- (void)runHedgedWaterfallFromResponse:(CLXBidResponse *)response
+                            bidRequest:(NSDictionary *)bidRequest
+                              deadline:(nullable CLXAuctionDeadline *)deadline
+                                loader:(CLXHedgedAdapterLoader)loader
+                             canceller:(nullable CLXHedgedAdapterCanceller)canceller
+                            completion:(void (^)(CLXBidAdSourceResponse * _Nullable, id _Nullable, NSError * _Nullable))completion {
+    if (deadline.isExpired) {
+        CLX_LOG_ERROR(self.logger, @"⏱️ [CLXBidAdSource] Auction budget of %.0fms spent before the waterfall: %@", deadline.budget * 1000, deadline.stageDurations);
+        if (completion) {
+            completion(nil, nil, [CLXError errorWithCode:CLXErrorCodeLoadTimeout description:@"Auction deadline exceeded"]);
+        }
+        return;
+    }
+    
+    NSArray<CLXBidResponseBid *> *sortedBids = [response getAllBidsForWaterfall];
+    NSMutableArray<CLXBidAdSourceResponse *> *candidates = [NSMutableArray arrayWithCapacity:sortedBids.count];
+    for (CLXBidResponseBid *bid in sortedBids) {
+        CLXBidAdSourceResponse *candidate = [self createBidAdSourceResponseWithBid:bid auctionID:response.id bidRequest:bidRequest];
+        candidate.deadline = deadline;
+        [candidates addObject:candidate];
+    }
+    
+    CLX_LOG_DEBUG(self.logger, @"🔄 [CLXBidAdSource] Starting hedged waterfall with %lu bids (%ld concurrent)", (unsigned long)candidates.count, (long)self.maxConcurrentLoads);
+    
+    CLXHedgedWaterfall *hedgedWaterfall = [[CLXHedgedWaterfall alloc] initWithMaxConcurrentLoads:self.maxConcurrentLoads hedgeDelay:self.hedgeDelay];
+    __weak typeof(self) weakSelf = self;
+    [hedgedWaterfall runWithCandidates:candidates
+                                loader:loader
+                             canceller:canceller
+                            completion:^(CLXBidAdSourceResponse * _Nullable winner, id _Nullable adapter, NSError * _Nullable error) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (winner) {
+            [strongSelf.appSessionService bidLoadedWithPlacementID:winner.bidID latency:strongSelf.latency];
+        }
+        if (completion) {
+            completion(winner, adapter, error);
+        }
+    }];
+}
+
+- (void)tryNextBidInWaterfall:(NSArray<CLXBidResponseBid *> *)sortedBids 
+                     bidIndex:(NSInteger)bidIndex 
+                    auctionID:(nullable NSString *)auctionID 
+                   bidRequest:(NSDictionary *)bidRequest 
+                   completion:(void (^)(CLXBidAdSourceResponse * _Nullable, NSError * _Nullable))completion {
+    [self tryNextBidInWaterfall:sortedBids 
+                      bidIndex:bidIndex 
+                     auctionID:auctionID 
+                    bidRequest:bidRequest 
+                      deadline:nil
                     completion:completion];
 }
 
@@ -356,6 +464,7 @@ NS_ASSUME_NONNULL_BEGIN
                      bidIndex:(NSInteger)bidIndex 
                     auctionID:(nullable NSString *)auctionID 
                    bidRequest:(NSDictionary *)bidRequest 
+                     deadline:(nullable CLXAuctionDeadline *)deadline
                    completion:(void (^)(CLXBidAdSourceResponse * _Nullable, NSError * _Nullable))completion {
     
     if (bidIndex >= sortedBids.count) {
@@ -367,14 +476,15 @@ NS_ASSUME_NONNULL_BEGIN
     }
     
     CLXBidResponseBid *currentBid = sortedBids[bidIndex];
-    [self.logger debug:[NSString stringWithFormat:@"🔄 [CLXBidAdSource] Trying bid %ld/%lu: rank=%ld, id=%@", 
-                       (long)bidIndex + 1, (unsigned long)sortedBids.count, 
-                       (long)currentBid.ext.cloudx.rank, currentBid.id]];
+    CLX_LOG_DEBUG(self.logger, @"🔄 [CLXBidAdSource] Trying bid %ld/%lu: rank=%ld, id=%@",
+                  (long)bidIndex + 1, (unsigned long)sortedBids.count,
+                  (long)currentBid.ext.cloudx.rank, currentBid.id);
     
     // Create bid response and test if it can create an ad
     CLXBidAdSourceResponse *bidAdSourceResponse = [self createBidAdSourceResponseWithBid:currentBid
                                                                               auctionID:auctionID
                                                                               bidRequest:bidRequest];
+    bidAdSourceResponse.deadline = deadline;
     
     // Test if this bid can create a valid ad
     if (bidAdSourceResponse && bidAdSourceResponse.createBidAd) {
@@ -382,14 +492,14 @@ NS_ASSUME_NONNULL_BEGIN
         
         if (testAd != nil) {
             // SUCCESS - This bid can be created (but not yet confirmed as loaded)
-            [self.logger info:[NSString stringWithFormat:@"✅ [CLXBidAdSource] Waterfall success with bid %ld: rank=%ld, id=%@", 
-                              (long)bidIndex + 1, (long)currentBid.ext.cloudx.rank, currentBid.id]];
+            CLX_LOG_INFO(self.logger, @"✅ [CLXBidAdSource] Waterfall success with bid %ld: rank=%ld, id=%@",
+                         (long)bidIndex + 1, (long)currentBid.ext.cloudx.rank, currentBid.id);
             
             [self.appSessionService bidLoadedWithPlacementID:currentBid.id latency:self.latency];
             
             // NOTE: Don't fire lurls here - wait until winner actually loads successfully
             // This prevents premature lurl firing for bids that might still be needed as fallbacks
-            [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] Deferring lurl firing until winner loads successfully"]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] Deferring lurl firing until winner loads successfully");
             
             if (completion) {
                 completion(bidAdSourceResponse, nil);
@@ -400,8 +510,8 @@ NS_ASSUME_NONNULL_BEGIN
     
     // FIRST FILTERING PHASE - This bid is completely discarded because it couldn't create a banner instance
     // We know it definitely can't show an ad, so send loss notification immediately with TechnicalError
-    [self.logger debug:[NSString stringWithFormat:@"❌ [CLXBidAdSource] Bid %ld failed creation: rank=%ld, id=%@", 
-                       (long)bidIndex + 1, (long)currentBid.ext.cloudx.rank, currentBid.id]];
+    CLX_LOG_DEBUG(self.logger, @"❌ [CLXBidAdSource] Bid %ld failed creation: rank=%ld, id=%@",
+                  (long)bidIndex + 1, (long)currentBid.ext.cloudx.rank, currentBid.id);
     
     // Send server-side loss notification for adapter creation failures (replaces client-side LURL firing)
     if (auctionID && currentBid.id) {
@@ -410,7 +520,7 @@ NS_ASSUME_NONNULL_BEGIN
                                              success:NO 
                                           lossReason:@(CLXLossReasonTechnicalError)];
         [[CLXWinLossTracker shared] sendLoss:auctionID bidId:currentBid.id];
-        [self.logger debug:[NSString stringWithFormat:@"📤 [CLXBidAdSource] Sent server-side loss notification for uncreatable bid rank=%ld, reason=TechnicalError", (long)currentBid.ext.cloudx.rank]];
+        CLX_LOG_DEBUG(self.logger, @"📤 [CLXBidAdSource] Sent server-side loss notification for uncreatable bid rank=%ld, reason=TechnicalError", (long)currentBid.ext.cloudx.rank);
     }
     
     // Try next bid in waterfall
@@ -418,6 +528,7 @@ NS_ASSUME_NONNULL_BEGIN
                       bidIndex:bidIndex + 1 
                      auctionID:auctionID 
                     bidRequest:bidRequest 
+                      deadline:deadline
                     completion:completion];
 }
 
@@ -445,7 +556,7 @@ NS_ASSUME_NONNULL_BEGIN
         if (self.createBidAd) {
             [self.logger debug:@"✅ [CLXBidAdSource] Calling original createBidAd function..."];
             id result = self.createBidAd(bid.adid ?: @"", bid.id ?: @"", bid.adm ?: @"", bid.ext.cloudx.adapterExtras ?: @{}, bid.burl, self.hasCloseButton, networkName);
-            [self.logger debug:[NSString stringWithFormat:@"📊 [CLXBidAdSource] createBidAd result: %@", result]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [CLXBidAdSource] createBidAd result: %@", result);
             return result;
         } else {
             [self.logger debug:@"❌ [CLXBidAdSource] createBidAd function is nil"];
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXBidTokenCache.m
+ * @brief Prefetching cache of adapter bid tokens
+ */
+
+#import <CloudXCore/CLXBidTokenCache.h>
+#import <CloudXCore/CLXBidRequestTemplate.h>
+#import <CloudXCore/CLXLogger.h>
+
+static const NSTimeInterval kCLXDefaultTokenLifetime = 300.0;
+static const double kCLXDefaultRefreshFraction = 0.8;
+static const NSTimeInterval kCLXDefaultFetchDeadline = 0.3;
+static const NSTimeInterval kCLXDefaultFetchTimeout = 10.0;
+
+typedef void (^CLXBidTokenWaiter)(NSDictionary<NSString *, NSString *> * _Nullable token);
+
+/**
+ * Per-adapter state, only touched on the cache queue
+ */
+@interface CLXBidTokenCacheEntry : NSObject
+@property (nonatomic, copy) NSString *adapterName;
+@property (nonatomic, strong) id<CLXBidTokenSource> source;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *token;
+@property (nonatomic, assign) NSTimeInterval refreshTime;
+@property (nonatomic, assign) NSTimeInterval expiryTime;
+@property (nonatomic, assign) BOOL fetching;
+@property (nonatomic, assign) NSUInteger fetchID; // Identifies the fetch in flight; late answers to earlier ones are dropped
+@property (nonatomic, assign) BOOL refetchWhenDone; // Tokens were dropped while a fetch was in flight
+@property (nonatomic, assign) NSUInteger generation; // Bumped whenever the token is replaced or dropped
+@property (nonatomic, strong) NSMutableArray<CLXBidTokenWaiter> *waiters;
+@end
+
+@implementation CLXBidTokenCacheEntry
+@end
+
+@interface CLXBidTokenCache ()
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXBidTokenCacheEntry *> *entries;
+@property (nonatomic, assign, readwrite) NSUInteger hitCount;
+@property (nonatomic, assign, readwrite) NSUInteger missCount;
+@property (nonatomic, assign, readwrite) NSUInteger deadlineMissCount;
+@property (nonatomic, strong, nullable) id inputsObserver;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXBidTokenCache
+
++ (instancetype)shared {
+    static CLXBidTokenCache *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("io.cloudx.bidtokencache", DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary dictionary];
+        _defaultTokenLifetime = kCLXDefaultTokenLifetime;
+        _refreshFraction = kCLXDefaultRefreshFraction;
+        _fetchDeadline = kCLXDefaultFetchDeadline;
+        _fetchTimeout = kCLXDefaultFetchTimeout;
+        _logger = [[CLXLogger alloc] initWithCategory:@"BidTokenCache"];
+
+        __weak typeof(self) weakSelf = self;
+        _inputsObserver = [[NSNotificationCenter defaultCenter] addObserverForName:CLXBidRequestInputsDidChangeNotification
+                                                                            object:nil
+                                                                             queue:nil
+                                                                        usingBlock:^(NSNotification * _Nonnull note) {
+            [weakSelf removeAllTokens];
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_inputsObserver) {
+        [[NSNotificationCenter defaultCenter] removeObserver:_inputsObserver];
+    }
+}
+
+#pragma mark - Metrics
+
+- (NSUInteger)hitCount {
+    __block NSUInteger count;
+    dispatch_sync(self.queue, ^{ count = self->_hitCount; });
+    return count;
+}
+
+- (NSUInteger)missCount {
+    __block NSUInteger count;
+    dispatch_sync(self.queue, ^{ count = self->_missCount; });
+    return count;
+}
+
+- (NSUInteger)deadlineMissCount {
+    __block NSUInteger count;
+    dispatch_sync(self.queue, ^{ count = self->_deadlineMissCount; });
+    return count;
+}
+
+#pragma mark - Public Methods
+
+- (void)prefetchTokenForAdapter:(NSString *)adapterName source:(id<CLXBidTokenSource>)source {
+    if (!adapterName || !source) {
+        return;
+    }
+    dispatch_async(self.queue, ^{
+        CLXBidTokenCacheEntry *entry = [self _entryForAdapter:adapterName source:source];
+        if (!entry.fetching && ![self _isUsable:entry now:[self _now]]) {
+            CLX_LOG_DEBUG(self.logger, @"🔄 [BidTokenCache] Prefetching token for %@", adapterName);
+            [self _fetchEntry:entry];
+        }
+    });
+}
+
+- (void)tokensForSources:(NSDictionary<NSString *, id<CLXBidTokenSource>> *)sources
+              completion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens))completion {
+    [self tokensForSources:sources timeout:self.fetchDeadline completion:completion];
+}
+
+- (void)tokensForSources:(NSDictionary<NSString *, id<CLXBidTokenSource>> *)sources
+                 timeout:(NSTimeInterval)timeout
+              completion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens))completion {
+    dispatch_async(self.queue, ^{
+        NSTimeInterval now = [self _now];
+        NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens = [NSMutableDictionary dictionaryWithCapacity:sources.count];
+        NSMutableSet<NSString *> *pending = [NSMutableSet set];
+        __block BOOL finished = NO;
+
+        void (^finish)(void) = ^{
+            finished = YES;
+            NSDictionary *result = [tokens copy];
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                if (completion) {
+                    completion(result);
+                }
+            });
+        };
+
+        for (NSString *adapterName in sources) {
+            CLXBidTokenCacheEntry *entry = [self _entryForAdapter:adapterName source:sources[adapterName]];
+            if ([self _isUsable:entry now:now]) {
+                self->_hitCount += 1;
+                tokens[adapterName] = entry.token;
+                if (now >= entry.refreshTime && !entry.fetching) {
+                    [self _fetchEntry:entry];
+                }
+                continue;
+            }
+
+            self->_missCount += 1;
+            [pending addObject:adapterName];
+            [entry.waiters addObject:^(NSDictionary<NSString *, NSString *> * _Nullable token) {
+                if (finished) {
+                    return;
+                }
+                if (token) {
+                    tokens[adapterName] = token;
+                }
+                [pending removeObject:adapterName];
+                if (pending.count == 0) {
+                    finish();
+                }
+            }];
+            if (!entry.fetching) {
+                [self _fetchEntry:entry];
+            }
+        }
+
+        if (pending.count == 0) {
+            finish();
+            return;
+        }
+
+        // Sources that miss the deadline are left out of this auction
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MAX(timeout, 0) * NSEC_PER_SEC)), self.queue, ^{
+            if (finished) {
+                return;
+            }
+            self->_deadlineMissCount += pending.count;
+            CLX_LOG_DEBUG(self.logger, @"⏱️ [BidTokenCache] Token deadline missed by %@", [pending allObjects]);
+            finish();
+        });
+    });
+}
+
+- (void)removeAllTokens {
+    dispatch_async(self.queue, ^{
+        for (CLXBidTokenCacheEntry *entry in self.entries.allValues) {
+            entry.token = nil;
+            entry.generation += 1;
+            // Refetch right away so the next auction does not wait on the adapter. A fetch in
+            // flight was asked with the old inputs, so it is repeated once it answers.
+            if (entry.fetching) {
+                entry.refetchWhenDone = YES;
+            } else {
+                [self _fetchEntry:entry];
+            }
+        }
+    });
+}
+
+#pragma mark - Private Methods
+
+- (NSTimeInterval)_now {
+    return self.clockForTesting ? self.clockForTesting() : [NSProcessInfo processInfo].systemUptime;
+}
+
+// The following helpers run on the cache queue
+
+- (CLXBidTokenCacheEntry *)_entryForAdapter:(NSString *)adapterName source:(id<CLXBidTokenSource>)source {
+    CLXBidTokenCacheEntry *entry = self.entries[adapterName];
+    if (!entry || entry.source != source) {
+        // A new source instance (e.g. after adapters are re-resolved) starts from scratch
+        entry = [[CLXBidTokenCacheEntry alloc] init];
+        entry.adapterName = adapterName;
+        entry.source = source;
+        entry.waiters = [NSMutableArray array];
+        self.entries[adapterName] = entry;
+    }
+    return entry;
+}
+
+- (BOOL)_isUsable:(CLXBidTokenCacheEntry *)entry now:(NSTimeInterval)now {
+    return entry.token != nil && now < entry.expiryTime;
+}
+
+- (NSTimeInterval)_lifetimeForSource:(id<CLXBidTokenSource>)source {
+    if ([source respondsToSelector:@selector(tokenExpirationTime)]) {
+        NSTimeInterval lifetime = [source tokenExpirationTime];
+        if (lifetime > 0) {
+            return lifetime;
+        }
+    }
+    return self.defaultTokenLifetime;
+}
+
+- (void)_fetchEntry:(CLXBidTokenCacheEntry *)entry {
+    entry.fetching = YES;
+    entry.refetchWhenDone = NO;
+    entry.fetchID += 1;
+    NSUInteger fetchID = entry.fetchID;
+    NSUInteger generation = entry.generation;
+
+    __weak typeof(self) weakSelf = self;
+    [entry.source getTokenWithCompletion:^(NSDictionary<NSString *, NSString *> * _Nullable token, NSError * _Nullable error) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        dispatch_async(strongSelf.queue, ^{
+            [strongSelf _completeFetchForEntry:entry fetchID:fetchID generation:generation token:token error:error];
+        });
+    }];
+
+    // An adapter that never calls back must not keep the entry fetching and its waiters queued forever
+    NSTimeInterval timeout = self.fetchTimeout;
+    if (timeout > 0) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)), self.queue, ^{
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (!strongSelf || !entry.fetching || entry.fetchID != fetchID) {
+                return;
+            }
+            NSError *error = [NSError errorWithDomain:@"CLXBidTokenCache"
+                                                 code:NSURLErrorTimedOut
+                                             userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"No token after %.0fs", timeout]}];
+            [strongSelf _completeFetchForEntry:entry fetchID:fetchID generation:generation token:nil error:error];
+        });
+    }
+}
+
+- (void)_completeFetchForEntry:(CLXBidTokenCacheEntry *)entry
+                       fetchID:(NSUInteger)fetchID
+                    generation:(NSUInteger)generation
+                         token:(nullable NSDictionary<NSString *, NSString *> *)token
+                         error:(nullable NSError *)error {
+    if (!entry.fetching || entry.fetchID != fetchID) {
+        CLX_LOG_DEBUG(self.logger, @"⏱️ [BidTokenCache] Dropping late token answer from %@", entry.adapterName);
+        return;
+    }
+    entry.fetching = NO;
+
+    // Tokens requested before the inputs changed carry stale consent and are not cached
+    BOOL invalidated = entry.generation != generation;
+    if (invalidated && entry.refetchWhenDone) {
+        // Waiters stay queued for the token asked with the current inputs
+        CLX_LOG_DEBUG(self.logger, @"🔄 [BidTokenCache] Inputs changed during fetch, refetching token for %@", entry.adapterName);
+        [self _fetchEntry:entry];
+        return;
+    }
+    entry.refetchWhenDone = NO;
+
+    if (token && !invalidated) {
+        NSTimeInterval now = [self _now];
+        NSTimeInterval lifetime = [self _lifetimeForSource:entry.source];
+        entry.token = token;
+        entry.expiryTime = now + lifetime;
+        entry.refreshTime = now + lifetime * self.refreshFraction;
+        entry.generation += 1;
+        [self _scheduleRefreshForEntry:entry after:lifetime * self.refreshFraction];
+        CLX_LOG_DEBUG(self.logger, @"✅ [BidTokenCache] Cached token for %@ (lifetime %.0fs)", entry.adapterName, lifetime);
+    } else if (error) {
+        CLX_LOG_ERROR(self.logger, @"❌ [BidTokenCache] Failed to get token for %@: %@", entry.adapterName, error.localizedDescription);
+    }
+
+    NSArray<CLXBidTokenWaiter> *waiters = [entry.waiters copy];
+    [entry.waiters removeAllObjects];
+    for (CLXBidTokenWaiter waiter in waiters) {
+        waiter(invalidated ? nil : token);
+    }
+}
+
+- (void)_scheduleRefreshForEntry:(CLXBidTokenCacheEntry *)entry after:(NSTimeInterval)delay {
+    NSUInteger generation = entry.generation;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        // Skip if the token was replaced, dropped, or the adapter's source changed meanwhile
+        if (!strongSelf || entry.generation != generation || entry.fetching || strongSelf.entries[entry.adapterName] != entry) {
+            return;
+        }
+        CLX_LOG_DEBUG(strongSelf.logger, @"🔄 [BidTokenCache] Refreshing token for %@ before expiry", entry.adapterName);
+        [strongSelf _fetchEntry:entry];
+    });
+}
+
+@end
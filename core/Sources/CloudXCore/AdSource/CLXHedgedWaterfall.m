@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXHedgedWaterfall.m
+ * @brief Parallel adapter loading across the top bids of a waterfall
+ */
+
+#import <CloudXCore/CLXHedgedWaterfall.h>
+#import <CloudXCore/CLXBidAdSource.h>
+#import <CloudXCore/CLXBidResponse.h>
+#import <CloudXCore/CLXWinLossTracker.h>
+#import <CloudXCore/CLXError.h>
+#import <CloudXCore/CLXDestroyable.h>
+#import <CloudXCore/CLXLogger.h>
+
+typedef NS_ENUM(NSInteger, CLXHedgedCandidateState) {
+    CLXHedgedCandidateStatePending = 0,
+    CLXHedgedCandidateStateLoading,
+    CLXHedgedCandidateStateLoaded,
+    CLXHedgedCandidateStateFailed
+};
+
+/**
+ * Per-bid state, only touched on the waterfall queue
+ */
+@interface CLXHedgedCandidate : NSObject
+@property (nonatomic, strong) CLXBidAdSourceResponse *response;
+@property (nonatomic, assign) CLXHedgedCandidateState state;
+@property (nonatomic, strong, nullable) id adapter;
+@end
+
+@implementation CLXHedgedCandidate
+@end
+
+@interface CLXHedgedWaterfall ()
+@property (nonatomic, assign, readwrite) NSInteger maxConcurrentLoads;
+@property (nonatomic, assign, readwrite) NSTimeInterval hedgeDelay;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSArray<CLXHedgedCandidate *> *candidates;
+@property (nonatomic, copy, nullable) CLXHedgedAdapterLoader loader;
+@property (nonatomic, copy, nullable) CLXHedgedAdapterCanceller canceller;
+@property (nonatomic, copy, nullable) void (^completion)(CLXBidAdSourceResponse * _Nullable, id _Nullable, NSError * _Nullable);
+@property (nonatomic, assign) NSUInteger nextIndex;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXHedgedWaterfall
+
+- (instancetype)initWithMaxConcurrentLoads:(NSInteger)maxConcurrentLoads hedgeDelay:(NSTimeInterval)hedgeDelay {
+    self = [super init];
+    if (self) {
+        _maxConcurrentLoads = MAX(maxConcurrentLoads, 1);
+        _hedgeDelay = MAX(hedgeDelay, 0);
+        _queue = dispatch_queue_create("io.cloudx.hedgedwaterfall", DISPATCH_QUEUE_SERIAL);
+        _logger = [[CLXLogger alloc] initWithCategory:@"HedgedWaterfall"];
+    }
+    return self;
+}
+
+- (void)runWithCandidates:(NSArray<CLXBidAdSourceResponse *> *)candidates
+                   loader:(CLXHedgedAdapterLoader)loader
+                canceller:(nullable CLXHedgedAdapterCanceller)canceller
+               completion:(void (^)(CLXBidAdSourceResponse * _Nullable winner, id _Nullable adapter, NSError * _Nullable error))completion {
+    dispatch_async(self.queue, ^{
+        NSMutableArray<CLXHedgedCandidate *> *states = [NSMutableArray arrayWithCapacity:candidates.count];
+        for (CLXBidAdSourceResponse *response in candidates) {
+            CLXHedgedCandidate *candidate = [[CLXHedgedCandidate alloc] init];
+            candidate.response = response;
+            [states addObject:candidate];
+        }
+        self.candidates = [states copy];
+        self.loader = loader;
+        self.canceller = canceller;
+        self.completion = completion;
+
+        CLX_LOG_DEBUG(self.logger, @"🔄 [HedgedWaterfall] Starting with %lu bids, %ld concurrent, hedge delay %.0fms",
+                      (unsigned long)candidates.count, (long)self.maxConcurrentLoads, self.hedgeDelay * 1000);
+
+        if (self.hedgeDelay > 0) {
+            [self _startNextLoad];
+            [self _scheduleHedge];
+        } else {
+            [self _fillLoadSlots];
+        }
+        [self _evaluate];
+    });
+}
+
+#pragma mark - Private Methods
+
+// The following run on the waterfall queue
+
+- (NSInteger)_loadingCount {
+    NSInteger count = 0;
+    for (CLXHedgedCandidate *candidate in self.candidates) {
+        if (candidate.state == CLXHedgedCandidateStateLoading) {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+- (void)_fillLoadSlots {
+    while (!self.finished && self.nextIndex < self.candidates.count && [self _loadingCount] < self.maxConcurrentLoads) {
+        [self _startNextLoad];
+    }
+}
+
+- (void)_scheduleHedge {
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.hedgeDelay * NSEC_PER_SEC)), self.queue, ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf.finished || strongSelf.nextIndex >= strongSelf.candidates.count) {
+            return;
+        }
+        if ([strongSelf _loadingCount] < strongSelf.maxConcurrentLoads) {
+            CLX_LOG_DEBUG(strongSelf.logger, @"🔄 [HedgedWaterfall] Hedge delay passed, starting bid %lu", (unsigned long)strongSelf.nextIndex + 1);
+            [strongSelf _startNextLoad];
+            [strongSelf _evaluate];
+        }
+        [strongSelf _scheduleHedge];
+    });
+}
+
+- (void)_startNextLoad {
+    while (self.nextIndex < self.candidates.count) {
+        NSUInteger index = self.nextIndex;
+        self.nextIndex += 1;
+        CLXHedgedCandidate *candidate = self.candidates[index];
+
+        id adapter = candidate.response.createBidAd ? candidate.response.createBidAd() : nil;
+        if (!adapter) {
+            CLX_LOG_DEBUG(self.logger, @"❌ [HedgedWaterfall] Bid %lu could not create an adapter", (unsigned long)index + 1);
+            [self _markFailed:candidate];
+            continue;
+        }
+
+        candidate.adapter = adapter;
+        candidate.state = CLXHedgedCandidateStateLoading;
+        CLX_LOG_DEBUG(self.logger, @"🔧 [HedgedWaterfall] Loading bid %lu: %@", (unsigned long)index + 1, candidate.response.networkName);
+
+        // Outstanding loads keep the waterfall alive until they report back
+        CLXHedgedLoadCompletion done = ^(NSError * _Nullable error) {
+            dispatch_async(self.queue, ^{
+                [self _candidate:candidate didFinishLoadWithError:error];
+            });
+        };
+        CLXHedgedAdapterLoader loader = self.loader;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            loader(candidate.response, adapter, done);
+        });
+        return;
+    }
+}
+
+- (void)_candidate:(CLXHedgedCandidate *)candidate didFinishLoadWithError:(nullable NSError *)error {
+    if (self.finished || candidate.state != CLXHedgedCandidateStateLoading) {
+        return;
+    }
+    if (error) {
+        CLX_LOG_DEBUG(self.logger, @"❌ [HedgedWaterfall] %@ failed to load: %@", candidate.response.networkName, error.localizedDescription);
+        [self _markFailed:candidate];
+        [self _cancelAdapterOf:candidate];
+    } else {
+        CLX_LOG_DEBUG(self.logger, @"✅ [HedgedWaterfall] %@ loaded", candidate.response.networkName);
+        candidate.state = CLXHedgedCandidateStateLoaded;
+    }
+    [self _evaluate];
+    // A failed load's slot goes to the next bid, unless a bid already won
+    [self _fillLoadSlots];
+    [self _evaluate];
+}
+
+- (void)_evaluate {
+    if (self.finished) {
+        return;
+    }
+    // The best bid still in the running decides: it either won, or everyone below it waits
+    for (CLXHedgedCandidate *candidate in self.candidates) {
+        switch (candidate.state) {
+            case CLXHedgedCandidateStateFailed:
+                continue;
+            case CLXHedgedCandidateStateLoaded:
+                [self _finishWithWinner:candidate];
+                return;
+            case CLXHedgedCandidateStateLoading:
+                return;
+            case CLXHedgedCandidateStatePending:
+                if ([self _loadingCount] == 0) {
+                    [self _fillLoadSlots];
+                    [self _evaluate];
+                }
+                return;
+        }
+    }
+    [self _finishWithWinner:nil];
+}
+
+- (void)_finishWithWinner:(nullable CLXHedgedCandidate *)winner {
+    self.finished = YES;
+    id<CLXWinLossTracking> tracker = [CLXWinLossTracker shared];
+    NSString *auctionId = winner.response.auctionId;
+    if (winner && auctionId && winner.response.bidID) {
+        [tracker setWinner:auctionId winningBidId:winner.response.bidID];
+    }
+
+    NSInteger lostCount = 0;
+    for (CLXHedgedCandidate *candidate in self.candidates) {
+        if (candidate == winner || candidate.state == CLXHedgedCandidateStateFailed) {
+            continue;
+        }
+        [self _cancelAdapterOf:candidate];
+        [self _sendLossFor:candidate reason:CLXLossReasonLostToHigherBid];
+        lostCount += 1;
+    }
+
+    CLX_LOG_INFO(self.logger, @"🏁 [HedgedWaterfall] Finished - winner: %@, lost to it: %ld", winner ? winner.response.networkName : @"none", (long)lostCount);
+
+    void (^completion)(CLXBidAdSourceResponse * _Nullable, id _Nullable, NSError * _Nullable) = self.completion;
+    self.completion = nil;
+    self.loader = nil;
+    CLXBidAdSourceResponse *response = winner.response;
+    id adapter = winner.adapter;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (!completion) {
+            return;
+        }
+        if (response) {
+            completion(response, adapter, nil);
+        } else {
+            completion(nil, nil, [NSError errorWithDomain:@"CLXBidAdSource" code:CLXBidAdSourceErrorNoBid userInfo:@{NSLocalizedDescriptionKey: @"All bids failed in waterfall."}]);
+        }
+    });
+}
+
+- (void)_markFailed:(CLXHedgedCandidate *)candidate {
+    candidate.state = CLXHedgedCandidateStateFailed;
+    [self _sendLossFor:candidate reason:CLXLossReasonTechnicalError];
+}
+
+- (void)_sendLossFor:(CLXHedgedCandidate *)candidate reason:(CLXLossReason)reason {
+    NSString *auctionId = candidate.response.auctionId;
+    NSString *bidId = candidate.response.bidID;
+    if (!auctionId || !bidId) {
+        return;
+    }
+    id<CLXWinLossTracking> tracker = [CLXWinLossTracker shared];
+    [tracker setBidLoadResult:auctionId bidId:bidId success:NO lossReason:@(reason)];
+    [tracker sendLoss:auctionId bidId:bidId];
+}
+
+- (void)_cancelAdapterOf:(CLXHedgedCandidate *)candidate {
+    id adapter = candidate.adapter;
+    candidate.adapter = nil;
+    if (!adapter) {
+        return;
+    }
+    CLXHedgedAdapterCanceller canceller = self.canceller;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (canceller) {
+            canceller(adapter);
+        } else if ([adapter respondsToSelector:@selector(destroy)]) {
+            [adapter destroy];
+        }
+    });
+}
+
+@end
@@ -37,6 +37,11 @@ NS_ASSUME_NONNULL_BEGIN
 /// - Parameter viewController: view controller where the interstitial will be displayed
 - (void)showFromViewController:(UIViewController *)viewController;
 
+@optional
+
+/// Seconds the loaded ad stays showable, if the network documents a limit; 0 when unknown.
+@property (nonatomic, assign, readonly) NSTimeInterval expirationInterval;
+
 @end
 
 /// Delegate for the rewarded adapter.
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXAuctionDeadline.h
+ * @brief End-to-end time budget for one auction
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol CLXMetricsTrackerProtocol;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Time budget shared by every stage of one auction: bid token collection, the bid
+ * request (including retries) and the adapter load. Each stage bounds its own timeout
+ * by what is left, skips work that cannot finish in time, and records its duration.
+ *
+ * Stage names are the metric types they are reported under (see CLXMetricsType.h).
+ * Thread-safe.
+ */
+@interface CLXAuctionDeadline : NSObject
+
+/**
+ * Total budget in seconds
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval budget;
+
+@property (nonatomic, assign, readonly) NSTimeInterval elapsed;
+
+/**
+ * Seconds left, never negative
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval remaining;
+
+@property (nonatomic, assign, readonly, getter=isExpired) BOOL expired;
+
+/**
+ * Completed stage durations in milliseconds, keyed by stage name
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *stageDurations;
+
+/**
+ * Receives each completed stage's duration. Optional.
+ */
+@property (nonatomic, strong, nullable) id<CLXMetricsTrackerProtocol> metricsTracker;
+
+- (instancetype)initWithBudget:(NSTimeInterval)budget;
+
+/**
+ * @param clock Returns seconds on any monotonic scale; nil uses system uptime
+ */
+- (instancetype)initWithBudget:(NSTimeInterval)budget
+                         clock:(nullable NSTimeInterval (^)(void))clock NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Whether work expected to take duration seconds still fits in the budget
+ */
+- (BOOL)canFinishWithin:(NSTimeInterval)duration;
+
+/**
+ * The stage's own timeout capped at the remaining budget. A timeout <= 0 means
+ * "no timeout of its own" and yields the remaining budget.
+ */
+- (NSTimeInterval)timeoutBoundedBy:(NSTimeInterval)timeout;
+
+- (void)beginStage:(NSString *)stage;
+
+/**
+ * Records the stage's duration and reports it to the metrics tracker
+ * @return Duration in seconds, or 0 if the stage was not begun
+ */
+- (NSTimeInterval)endStage:(NSString *)stage;
+
+@end
+
+NS_ASSUME_NONNULL_END
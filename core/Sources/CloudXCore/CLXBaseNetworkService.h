@@ -9,6 +9,9 @@
 
 #import <Foundation/Foundation.h>
 
+@class CLXAuctionDeadline;
+@class CLXRetryBudget;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -16,6 +19,11 @@ NS_ASSUME_NONNULL_BEGIN
  * @brief Base class for all network services in the SDK
  * @discussion This class provides common networking functionality including request execution,
  * retry logic, and error handling. All network services should inherit from this class.
+ *
+ * Network errors, 429 and 5xx responses are retried after the server's Retry-After when it
+ * sends one, otherwise after a decorrelated-jitter delay starting from the caller's delay.
+ * Every retry spends from retryBudget, and requests fail with CLXErrorCodeServiceUnavailable,
+ * without being sent, while the circuit for their host is open.
  */
 @interface CLXBaseNetworkService : NSObject
 
@@ -25,6 +33,15 @@ NS_ASSUME_NONNULL_BEGIN
 /** The URL session used for network requests */
 @property (nonatomic, strong) NSURLSession *urlSession;
 
+/** Retry budget and circuit breaker; the one shared by all SDK clients unless replaced */
+@property (nonatomic, strong) CLXRetryBudget *retryBudget;
+
+/** Longest retry delay drawn by the jitter; Retry-After is honored up to 60s regardless */
+@property (nonatomic, assign) NSTimeInterval maxRetryDelay;
+
+/** Overrides the random source of the retry jitter. Returns a value in [0, 1). */
+@property (nonatomic, copy, nullable) double (^randomSourceForTesting)(void);
+
 /**
  * @brief Initializes the network service with base URL and session
  * @param baseURL The base URL for API requests
@@ -46,7 +63,7 @@ NS_ASSUME_NONNULL_BEGIN
  * @param requestBody The request body data
  * @param headers Dictionary of request headers
  * @param maxRetries Maximum number of retry attempts
- * @param delay Delay between retry attempts in seconds
+ * @param delay Smallest delay before a retry in seconds; 0 means 1s
  * @param completion Completion handler called with the response or error
  */
 - (void)executeRequestWithEndpoint:(NSString *)endpoint
@@ -57,6 +74,36 @@ NS_ASSUME_NONNULL_BEGIN
                           delay:(NSTimeInterval)delay
                      completion:(void (^)(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion;
 
+/**
+ * @brief Executes a network request within an auction's time budget
+ * @discussion Each attempt's timeout is capped at the deadline's remaining time. A retry is
+ * skipped when the retry delay plus the previous attempt's duration no longer fits, and the
+ * request fails with CLXErrorCodeNetworkTimeout without being sent once the deadline has passed.
+ * @param deadline Auction deadline; nil behaves like the variant without one
+ */
+- (void)executeRequestWithEndpoint:(NSString *)endpoint
+                    urlParameters:(nullable NSDictionary *)urlParameters
+                     requestBody:(nullable NSData *)requestBody
+                         headers:(nullable NSDictionary *)headers
+                      maxRetries:(NSInteger)maxRetries
+                          delay:(NSTimeInterval)delay
+                        deadline:(nullable CLXAuctionDeadline *)deadline
+                     completion:(void (^)(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion;
+
+/**
+ * @brief Same as the deadline variant, but hands back the 2xx response body unparsed
+ * @discussion For callers that parse the body themselves or keep it as bytes
+ * @param completion Called with the body, or nil for an empty body
+ */
+- (void)executeRawRequestWithEndpoint:(NSString *)endpoint
+                       urlParameters:(nullable NSDictionary *)urlParameters
+                        requestBody:(nullable NSData *)requestBody
+                            headers:(nullable NSDictionary *)headers
+                         maxRetries:(NSInteger)maxRetries
+                              delay:(NSTimeInterval)delay
+                           deadline:(nullable CLXAuctionDeadline *)deadline
+                         completion:(void (^)(NSData * _Nullable data, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion;
+
 @end
 
 NS_ASSUME_NONNULL_END 
@@ -13,8 +13,9 @@
 #import <CloudXCore/CLXConfigImpressionModel.h>
 #import <CloudXCore/CLXAdNetworkFactories.h>
 #import <CloudXCore/CLXError.h>
+#import <CloudXCore/CLXHedgedWaterfall.h>
 
-@class CLXBidResponseBid, CLXBiddingConfigRequest, CLXBidResponse, CLXAd, CLXEnvironmentConfig;
+@class CLXBidResponseBid, CLXBiddingConfigRequest, CLXBidResponse, CLXAd, CLXEnvironmentConfig, CLXAuctionDeadline;
 @protocol CLXAdEventReporting;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -47,6 +48,11 @@ typedef NS_ENUM(NSInteger, CLXBidAdSourceError) {
 @property (nonatomic, copy, readonly) id (^createBidAd)(void);
 @property (nonatomic, strong, readonly, nullable) CLXAd *clxAd;
 
+/**
+ * Deadline of the auction that produced this bid; the adapter load should stay within it
+ */
+@property (nonatomic, strong, readonly, nullable) CLXAuctionDeadline *deadline;
+
 - (instancetype)initWithPrice:(double)price
                    auctionId:(nullable NSString *)auctionId
                       dealId:(nullable NSString *)dealId
@@ -78,6 +84,23 @@ typedef NS_ENUM(NSInteger, CLXBidAdSourceError) {
  */
 - (nullable CLXBidResponse *)getCurrentBidResponse;
 
+@optional
+
+/**
+ * Runs the auction and loads adapters for the top bids in parallel (see CLXHedgedWaterfall).
+ * Win/loss outcomes for every bid in the auction are reported before the completion runs.
+ * @param loader Starts loading an adapter created for a bid
+ * @param canceller Tears down adapters that lost; nil destroys them
+ * @param completion Called on the main queue with the winning bid and its loaded adapter
+ */
+- (void)requestBidWithAdUnitID:(NSString *)adUnitID
+              storedImpressionId:(NSString *)storedImpressionId
+                      impModel:(nullable CLXConfigImpressionModel *)impModel
+                      successWin:(BOOL)successWin
+                   adapterLoader:(CLXHedgedAdapterLoader)loader
+                       canceller:(nullable CLXHedgedAdapterCanceller)canceller
+                      completion:(void (^)(CLXBidAdSourceResponse * _Nullable response, id _Nullable adapter, NSError * _Nullable error))completion;
+
 @end
 
 /**
@@ -86,6 +109,22 @@ typedef NS_ENUM(NSInteger, CLXBidAdSourceError) {
  */
 @interface CLXBidAdSource : NSObject <CLXBidAdSourceProtocol>
 
+/**
+ * Time budget in seconds for one auction, from token collection through the adapter load.
+ * Defaults to tmax plus an allowance for the adapter load, or 8s when tmax is not set.
+ */
+@property (nonatomic, assign) NSTimeInterval auctionBudget;
+
+/**
+ * Adapters loaded at once by the adapterLoader variant of requestBid. Default: 1
+ */
+@property (nonatomic, assign) NSInteger maxConcurrentLoads;
+
+/**
+ * Seconds between starting successive parallel loads; 0 starts them together. Default: 0
+ */
+@property (nonatomic, assign) NSTimeInterval hedgeDelay;
+
 /**
  * Initialize a new bid ad source
  * @param userID User identifier
@@ -4,6 +4,7 @@
 #import <CloudXCore/CLXAdType.h>
 
 @class CLXErrorReporter;
+@class CLXAuctionDeadline;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -28,6 +29,15 @@ NS_ASSUME_NONNULL_BEGIN
                             appKey:(NSString *)appKey
                         completion:(void (^)(CLXBidResponse * _Nullable parsedResponse, NSDictionary * _Nullable rawJSON, NSError * _Nullable error))completion;
 
+/**
+ * Runs the auction request within the auction's remaining budget; retries that cannot
+ * finish before the deadline are skipped
+ */
+- (void)startAuctionWithBidRequest:(id)bidRequest
+                            appKey:(NSString *)appKey
+                          deadline:(nullable CLXAuctionDeadline *)deadline
+                        completion:(void (^)(CLXBidResponse * _Nullable parsedResponse, NSDictionary * _Nullable rawJSON, NSError * _Nullable error))completion;
+
 - (void)startCDPFlowWithBidRequest:(id)bidRequest
                        completion:(void (^)(id _Nullable enrichedBidRequest, NSError * _Nullable error))completion;
 
@@ -37,6 +47,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, assign) BOOL isCDPEndpointEmpty;
 
+/**
+ * When YES (the default) the auction response body is kept as bytes on
+ * CLXBidResponse.rawData and rawJSON is nil in the auction completion; the parsed JSON
+ * is released once the typed response is built. NO passes the parsed dictionary as rawJSON.
+ */
+@property (nonatomic, assign) BOOL retainsRawResponse;
+
 - (instancetype)initWithAuctionEndpointUrl:(NSString *)auctionEndpointUrl
                            cdpEndpointUrl:(NSString *)cdpEndpointUrl;
 
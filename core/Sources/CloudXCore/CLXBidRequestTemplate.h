@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXBidRequestTemplate.h
+ * @brief Pre-encoded bid request skeletons patched per auction
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Posted when an input baked into cached bid request templates changes
+ * (privacy setters, user key-values, hashed user ID, geo headers, account ID).
+ * Every template cache observing it drops its templates.
+ */
+FOUNDATION_EXPORT NSNotificationName const CLXBidRequestInputsDidChangeNotification;
+
+/**
+ * A bid request for one placement with the auction-independent parts (app, device, regs,
+ * user, ext.prebid and the impression body) encoded once. Each auction only splices in
+ * id, imp.id, tmax and the adapter tokens.
+ */
+@interface CLXBidRequestTemplate : NSObject
+
+/**
+ * Native ad requirements the template was built with, compared on lookup
+ */
+@property (nonatomic, strong, readonly, nullable) id nativeAdRequirements;
+
+/**
+ * Builds a template from a complete bid request JSON dictionary
+ * @param bidRequestJSON Output of CLXBiddingConfigRequest's json
+ * @param nativeAdRequirements Native requirements used to build the request
+ * @return The template, or nil if the request cannot be split or encoded
+ */
+- (nullable instancetype)initWithBidRequestJSON:(NSDictionary *)bidRequestJSON
+                           nativeAdRequirements:(nullable id)nativeAdRequirements;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Produces the per-auction bid request
+ * @param requestID Auction (request) ID
+ * @param impressionID Impression ID
+ * @param adapterInfo Adapter bid tokens for ext.cloudx.adapter_extras
+ * @param tmax Optional auction timeout in milliseconds
+ * @param encodedBody On return, the JSON body equivalent to the returned dictionary
+ * @return The bid request dictionary, as CLXBiddingConfigRequest's json would produce it
+ */
+- (NSDictionary *)bidRequestWithRequestID:(NSString *)requestID
+                             impressionID:(NSString *)impressionID
+                              adapterInfo:(NSDictionary *)adapterInfo
+                                     tmax:(nullable NSNumber *)tmax
+                              encodedBody:(NSData * _Nullable * _Nullable)encodedBody;
+
+@end
+
+/**
+ * Per-placement template cache. Templates are dropped on CLXBidRequestInputsDidChangeNotification,
+ * on return to foreground, and when the cheap device-state fingerprint changes (GPP strings
+ * written by a CMP, ATT status, connection type, screen bounds after a rotation, UTC offset).
+ */
+@interface CLXBidRequestTemplateCache : NSObject
+
+/**
+ * Number of times templates were dropped
+ */
+@property (nonatomic, assign, readonly) NSUInteger invalidationCount;
+
+- (nullable CLXBidRequestTemplate *)templateForKey:(NSString *)key;
+- (void)setTemplate:(CLXBidRequestTemplate *)bidRequestTemplate forKey:(NSString *)key;
+- (void)invalidate;
+
+/**
+ * Remembers the encoded body for a bid request dictionary produced by a template
+ */
+- (void)setEncodedBody:(NSData *)body forBidRequest:(NSDictionary *)bidRequest;
+
+/**
+ * Returns and forgets the encoded body for this exact dictionary instance, or nil if the
+ * dictionary was not produced by a template (callers then serialize it themselves)
+ */
+- (nullable NSData *)takeEncodedBodyForBidRequest:(NSDictionary *)bidRequest;
+
+#pragma mark - Testing Support
+
+/**
+ * Overrides the device-state fingerprint checked on every lookup
+ */
+@property (nonatomic, copy, nullable) id _Nullable (^fingerprintProviderForTesting)(void);
+
+@end
+
+NS_ASSUME_NONNULL_END
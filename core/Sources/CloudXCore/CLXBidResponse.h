@@ -81,6 +81,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, nullable) NSString *dealid;
 @property (nonatomic, assign) NSInteger w;
 @property (nonatomic, assign) NSInteger h;
+/// Seconds the bidder will wait between auction and impression (OpenRTB "exp"); 0 when not sent
+@property (nonatomic, assign) NSInteger exp;
 @end
 
 // MARK: - Seat Bid
@@ -102,15 +104,31 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, nullable) NSString *cur;
 @property (nonatomic, strong, nullable) CLXBidResponseResponseExt *ext;
 
-// Helper methods to get bids
+/**
+ * Response body as received, kept by parseBidResponseFromData:error: for tracking field
+ * resolution in place of the full parsed JSON
+ */
+@property (nonatomic, copy, readonly, nullable) NSData *rawData;
+
+// Helper methods to get bids. They are served from an index built once per seatbid
+// (at parse time, or on first use); assigning seatbid rebuilds it. Bids are not expected
+// to change after they have been added to the response.
 - (NSArray<CLXBidResponseBid *> *)allBids;
 - (nullable CLXBidResponseBid *)findBidWithID:(NSString *)bidID;
+- (NSArray<CLXBidResponseBid *> *)bidsForImpID:(NSString *)impID;
 
 // Helper method to get all bids sorted by rank for waterfall loading (true Android parity)
 - (NSArray<CLXBidResponseBid *> *)getAllBidsForWaterfall;
 
 + (nullable instancetype)parseBidResponseFromDictionary:(NSDictionary *)dictionary;
 
+/**
+ * Parses the typed fields from the response body and keeps the body as rawData. The
+ * intermediate JSON objects, including ext subtrees the typed model does not use, are
+ * released before this returns.
+ */
++ (nullable instancetype)parseBidResponseFromData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
 // Parsing helper methods
 + (nullable CLXBidResponseSeatBid *)parseSeatBidFromDictionary:(NSDictionary *)dictionary;
 + (nullable CLXBidResponseBid *)parseBidFromDictionary:(NSDictionary *)dictionary;
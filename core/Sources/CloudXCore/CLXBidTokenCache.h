@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXBidTokenCache.h
+ * @brief Prefetching cache of adapter bid tokens
+ */
+
+#import <Foundation/Foundation.h>
+#import <CloudXCore/CLXBidTokenSource.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Keeps one bid token per adapter so auctions do not wait on adapter SDKs.
+ *
+ * - Tokens are prefetched once an adapter finishes initializing.
+ * - A token lives for the source's tokenExpirationTime (or defaultTokenLifetime) and is
+ *   refreshed in the background once refreshFraction of that lifetime has passed.
+ * - Auctions are served from the cache. A source with no usable token is asked for one;
+ *   if it misses fetchDeadline the auction goes ahead without it, and the late token is
+ *   still cached for the next auction. A fetch with no answer after fetchTimeout is given
+ *   up, so a stalled adapter is asked again by the next auction.
+ * - Tokens are dropped on CLXBidRequestInputsDidChangeNotification, since adapters bake
+ *   consent into them, and fetched again; a fetch already in flight is repeated once it answers.
+ */
+@interface CLXBidTokenCache : NSObject
+
++ (instancetype)shared;
+
+/**
+ * Lifetime for tokens from sources that do not report tokenExpirationTime. Default: 300s
+ */
+@property (nonatomic, assign) NSTimeInterval defaultTokenLifetime;
+
+/**
+ * Fraction of a token's lifetime after which it is refreshed in the background. Default: 0.8
+ */
+@property (nonatomic, assign) double refreshFraction;
+
+/**
+ * How long an auction waits for a source that has no cached token. Default: 0.3s
+ */
+@property (nonatomic, assign) NSTimeInterval fetchDeadline;
+
+/**
+ * How long a fetch may go without an answer before it is abandoned. Default: 10s
+ */
+@property (nonatomic, assign) NSTimeInterval fetchTimeout;
+
+/**
+ * Adapter tokens served from cache, fetched on demand, and dropped for missing the deadline
+ */
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+@property (nonatomic, assign, readonly) NSUInteger deadlineMissCount;
+
+/**
+ * Fetches and caches a token for an adapter ahead of its first auction
+ */
+- (void)prefetchTokenForAdapter:(NSString *)adapterName source:(id<CLXBidTokenSource>)source;
+
+/**
+ * Collects tokens for an auction
+ * @param sources Token sources keyed by adapter name
+ * @param completion Called on a background queue with the tokens keyed by adapter name;
+ *                   adapters without a token by the deadline are omitted
+ */
+- (void)tokensForSources:(NSDictionary<NSString *, id<CLXBidTokenSource>> *)sources
+              completion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens))completion;
+
+/**
+ * Same as tokensForSources:completion: with the wait capped at timeout instead of
+ * fetchDeadline, so the token stage fits an auction's remaining budget
+ */
+- (void)tokensForSources:(NSDictionary<NSString *, id<CLXBidTokenSource>> *)sources
+                 timeout:(NSTimeInterval)timeout
+              completion:(void (^)(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *tokens))completion;
+
+- (void)removeAllTokens;
+
+#pragma mark - Testing Support
+
+/**
+ * Overrides the clock used for token expiry. Returns seconds on any monotonic scale.
+ */
+@property (nonatomic, copy, nullable) NSTimeInterval (^clockForTesting)(void);
+
+@end
+
+NS_ASSUME_NONNULL_END
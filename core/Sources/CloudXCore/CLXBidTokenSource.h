@@ -23,6 +23,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getTokenWithCompletion:(void (^)(NSDictionary<NSString *, NSString *> * _Nullable token, NSError * _Nullable error))completion;
 
+@optional
+
+/**
+ * How long a token stays valid, in seconds. CLXBidTokenCache refreshes tokens before
+ * this runs out; sources that do not implement it use the cache's default lifetime.
+ */
+- (NSTimeInterval)tokenExpirationTime;
+
 @end
 
 NS_ASSUME_NONNULL_END 
\ No newline at end of file
@@ -16,6 +16,7 @@ NS_ASSUME_NONNULL_BEGIN
 @protocol CLXCacheableAd;
 @protocol CLXAppSessionService;
 @class CLXEnvironmentConfig;
+@class CLXAuctionDeadline;
 
 /**
  * Error types for cache ad queue operations
@@ -28,8 +29,44 @@ typedef NS_ENUM(NSInteger, CacheAdQueueError) {
     CacheAdQueueErrorFailToCreateAd
 };
 
+/// Lifetime of a cached ad when neither its bid nor its network gives one
+extern const NSTimeInterval CLXCacheAdQueueDefaultTimeToLive;
+
+@class CLXCacheAdQueue;
+
+/**
+ * Observes ads entering and leaving the queue on their own. Called on the main queue.
+ */
+@protocol CLXCacheAdQueueDelegate <NSObject>
+@optional
+
+/**
+ * An ad finished loading and is in the queue
+ * @param lifetime Seconds until it expires
+ */
+- (void)cacheAdQueue:(CLXCacheAdQueue *)queue didCacheAd:(id<CLXCacheableAd>)ad lifetime:(NSTimeInterval)lifetime;
+
+/**
+ * An ad expired before it was popped and has been destroyed
+ * @param cachedFor Seconds it sat in the queue
+ */
+- (void)cacheAdQueue:(CLXCacheAdQueue *)queue didExpireAd:(id<CLXCacheableAd>)ad cachedFor:(NSTimeInterval)cachedFor;
+
+@end
+
 /**
- * Cache ad queue for managing a sorted queue of cacheable ads
+ * Cache ad queue for managing a price-ordered queue of cacheable ads
+ *
+ * Loaded ads are kept in a binary max-heap keyed by price; ads with equal prices come out in
+ * the order they were loaded. Each ad expires at the earliest of its bid's "exp", its network's
+ * expirationInterval and defaultTimeToLive. A sweeper destroys ads as they expire and reports
+ * them to CLXWinLossTracker as losses with CLXLossReasonExpired, so popAd and first only ever
+ * return ads that can still be shown. While an ad is queued its auction is held in
+ * CLXTrackingFieldResolver, so the win or loss it reports at show or expiry time still resolves.
+ *
+ * All methods may be called from any thread; queue state is owned by a private serial queue.
+ * Adapter loads run at most two at a time and start on the main queue, where ads taken out of
+ * the queue are also destroyed.
  */
 @interface CLXCacheAdQueue : NSObject
 
@@ -39,7 +76,27 @@ typedef NS_ENUM(NSInteger, CacheAdQueueError) {
 @property (nonatomic, assign) NSInteger maxCapacity;
 
 /**
- * Whether there is enough space in the queue
+ * Delegate told about ads that are cached or expire
+ */
+@property (nonatomic, weak, nullable) id<CLXCacheAdQueueDelegate> delegate;
+
+/**
+ * Number of loaded ads in the queue, expired or not
+ */
+@property (nonatomic, readonly) NSInteger count;
+
+/**
+ * Number of adapter loads accepted by enqueue that have not finished
+ */
+@property (nonatomic, readonly) NSInteger loadingCount;
+
+/**
+ * Lifetime of an ad whose bid and network give none; CLXCacheAdQueueDefaultTimeToLive by default
+ */
+@property (nonatomic, assign) NSTimeInterval defaultTimeToLive;
+
+/**
+ * Whether there is enough space in the queue, counting loads still in progress
  */
 @property (nonatomic, readonly) BOOL isEnoughSpace;
 
@@ -54,7 +111,7 @@ typedef NS_ENUM(NSInteger, CacheAdQueueError) {
 @property (nonatomic, readonly) BOOL hasItems;
 
 /**
- * The first ad in the queue
+ * The highest priced ad in the queue that has not expired
  */
 @property (nonatomic, readonly, nullable) id<CLXCacheableAd> first;
 
@@ -84,11 +141,29 @@ typedef NS_ENUM(NSInteger, CacheAdQueueError) {
                  completion:(void (^)(NSError * _Nullable error))completion;
 
 /**
- * Pop an ad from the queue
- * @return The popped ad or nil if queue is empty
+ * Enqueue an ad as the last stage of an auction
+ * @param loadTimeout Load timeout in seconds, capped at the deadline's remaining time
+ * @param deadline Deadline of the auction that produced the ad; when it has already passed the ad
+ *                 is not loaded and the completion gets CacheAdQueueErrorTimeout
+ */
+- (void)enqueueAdWithPrice:(double)price
+                loadTimeout:(NSTimeInterval)loadTimeout
+                      bidID:(NSString *)bidID
+                         ad:(nullable id<CLXCacheableAd>)ad
+                   deadline:(nullable CLXAuctionDeadline *)deadline
+                 completion:(void (^)(NSError * _Nullable error))completion;
+
+/**
+ * Pop the highest priced ad that has not expired; expired ads ahead of it are swept
+ * @return The popped ad or nil if queue has no valid ad
  */
 - (nullable id<CLXCacheableAd>)popAd;
 
+/**
+ * Destroy and report every expired ad now rather than at the sweeper's next run
+ */
+- (void)sweepExpiredAds;
+
 /**
  * Remove an ad from the queue
  * @param ad Ad to remove
@@ -96,10 +171,17 @@ typedef NS_ENUM(NSInteger, CacheAdQueueError) {
 - (void)removeAd:(id<CLXCacheableAd>)ad;
 
 /**
- * Destroy the queue and clean up resources
+ * Destroy the queue and clean up resources. Loads still waiting for a slot are abandoned: their
+ * ads are destroyed and their completions get CacheAdQueueErrorFailToLoad. Loads in progress
+ * destroy their ad when they finish.
  */
 - (void)destroy;
 
+/**
+ * Overrides the clock used for expiry. Returns seconds on any monotonic scale.
+ */
+@property (nonatomic, copy, nullable) NSTimeInterval (^clockForTesting)(void);
+
 @end
 
 NS_ASSUME_NONNULL_END 
\ No newline at end of file
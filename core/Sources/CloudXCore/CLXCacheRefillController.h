@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCacheRefillController.h
+ * @brief Decides how many fullscreen ads to keep cached and when to refill
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol CLXMetricsTrackerProtocol;
+
+/// Readiness target used when a placement does not configure one
+extern const double CLXCacheRefillDefaultReadinessTarget;
+
+/**
+ * One refill decision of CLXCacheRefillController
+ */
+@interface CLXCacheRefillDecision : NSObject
+
+/// Ads the cache should hold, counting ads loading and auctions in flight
+@property (nonatomic, assign, readonly) NSInteger targetDepth;
+
+/// Auctions to start now
+@property (nonatomic, assign, readonly) NSInteger auctionsToStart;
+
+/// When positive, nothing starts now and the decision should be asked for again after this many seconds;
+/// a show or a newly cached ad before then makes a new decision due at once
+@property (nonatomic, assign, readonly) NSTimeInterval deferral;
+
+/// Estimated show requests per second
+@property (nonatomic, assign, readonly) double showRate;
+
+/// Chance the next show finds an ad with the current supply, before this decision's auctions
+@property (nonatomic, assign, readonly) double readiness;
+
+@end
+
+/**
+ * Sizes the ad cache of one fullscreen placement so a show request finds an ad ready
+ * with the configured probability, without loading ads that expire unused.
+ *
+ * Show requests are modelled as a Poisson process whose rate is an EWMA of the intervals
+ * between shows; an idle session stretches the interval so the rate decays. A refill
+ * takes the EWMA auction-plus-load time divided by the fill rate. The target depth is the
+ * smallest supply that covers the shows expected during one refill with the readiness
+ * probability, capped at the shows expected within an ad's lifetime (EWMA per network,
+ * weighted by fills) and at the cache capacity. Up to two auctions run together when a
+ * refill is expected to see more than one show. When an ad expired unused and the cache is
+ * empty, its replacement is put off as long as the readiness target still holds.
+ *
+ * Decisions, expiries and show outcomes are reported as CLXMetricsTypeCache* metrics.
+ * Not thread-safe; CLXCacheAdService drives it from the main queue.
+ */
+@interface CLXCacheRefillController : NSObject
+
+/**
+ * @param placementID Placement the cache belongs to, for logs
+ * @param readinessTarget Chance a show should find an ad ready, between 0 and 1
+ * @param maxDepth Cache capacity
+ */
+- (instancetype)initWithPlacementID:(NSString *)placementID
+                    readinessTarget:(double)readinessTarget
+                           maxDepth:(NSInteger)maxDepth;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Cache capacity
+@property (nonatomic, assign) NSInteger maxDepth;
+
+/// Auctions that may run at once; 2 by default, matching the cache's adapter load slots
+@property (nonatomic, assign) NSInteger maxConcurrentAuctions;
+
+/// Tracker that decision metrics go to; nil resolves the SDK metrics tracker
+@property (nonatomic, strong, nullable) id<CLXMetricsTrackerProtocol> metricsTracker;
+
+/**
+ * Overrides the clock used for show intervals. Returns seconds on any monotonic scale.
+ */
+@property (nonatomic, copy, nullable) NSTimeInterval (^clockForTesting)(void);
+
+/**
+ * Records a show request
+ * @param ready Whether the cache had an ad for it
+ */
+- (void)noteShowWithAdReady:(BOOL)ready;
+
+/**
+ * Records the end of a refill
+ * @param duration Seconds from auction start until the ad was cached or the refill failed
+ * @param filled Whether an ad was cached
+ */
+- (void)noteRefillFinishedAfter:(NSTimeInterval)duration filled:(BOOL)filled;
+
+/**
+ * Records the lifetime an ad of a network got when it was cached
+ */
+- (void)noteAdCachedFromNetwork:(NSString *)network lifetime:(NSTimeInterval)lifetime;
+
+/**
+ * Records an ad of a network that expired unused
+ * @param cachedFor Seconds it sat in the cache, which bounds that network's lifetime
+ */
+- (void)noteAdExpiredFromNetwork:(NSString *)network cachedFor:(NSTimeInterval)cachedFor;
+
+/**
+ * Estimated show requests per second
+ */
+- (double)showRate;
+
+/**
+ * EWMA lifetime of a network's cached ads; the default queue lifetime until one is seen
+ */
+- (NSTimeInterval)expectedLifetimeForNetwork:(NSString *)network;
+
+/**
+ * Decides what to refill given the current supply, and reports the decision
+ * @param cachedCount Ads ready in the cache
+ * @param loadingCount Ads won and still loading
+ * @param auctionsInFlight Auctions started and not finished
+ */
+- (CLXCacheRefillDecision *)decisionWithCachedCount:(NSInteger)cachedCount
+                                       loadingCount:(NSInteger)loadingCount
+                                   auctionsInFlight:(NSInteger)auctionsInFlight;
+
+@end
+
+NS_ASSUME_NONNULL_END
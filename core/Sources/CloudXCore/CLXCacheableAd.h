@@ -49,6 +49,18 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)showFromViewController:(UIViewController *)viewController;
 
+@optional
+
+/**
+ * Seconds the loaded ad stays showable according to its network; 0 when unknown
+ */
+@property (nonatomic, readonly) NSTimeInterval expirationInterval;
+
+/**
+ * Whether the network has reported the loaded ad as expired
+ */
+@property (nonatomic, readonly, getter=isExpired) BOOL expired;
+
 @end
 
 NS_ASSUME_NONNULL_END 
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCounterRegistry.h
+ * @brief In-memory SDK usage counters persisted lazily to NSUserDefaults
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Seconds between the first change and the write that persists it, unless flushed earlier
+extern const NSTimeInterval CLXCounterRegistryDefaultPersistDelay;
+
+/**
+ * Named counters such as "network_call_bid_req" and "method_sdk_init", each an atomic
+ * integer slot, so bumping one is a lock-free add instead of rewriting the defaults plist.
+ *
+ * Counters start from the dictionary stored under the registry's defaults key, and are
+ * written back there in the legacy shape (counter name -> decimal string) shortly after they
+ * change, when the app goes to the background or terminates, and on flush. Entries of that
+ * dictionary that are not counters are kept. Code that reads the defaults key directly sees
+ * the counters as of the last write.
+ *
+ * Thread-safe.
+ */
+@interface CLXCounterRegistry : NSObject
+
+/// Counters stored under kCLXCoreMetricsDictKey
++ (instancetype)coreMetrics;
+
+/// Counters stored under kCLXCoreBannerMetricsDictKey
++ (instancetype)bannerMetrics;
+
+/**
+ * @param defaultsKey Key the counters are persisted under
+ * @param userDefaults Defaults to persist to
+ */
+- (instancetype)initWithDefaultsKey:(NSString *)defaultsKey userDefaults:(NSUserDefaults *)userDefaults NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Seconds a change waits before it is persisted; 0 persists on flush and backgrounding only
+@property (atomic, assign) NSTimeInterval persistDelay;
+
+/**
+ * Adds one to a counter, creating it at zero first
+ * @return The new value
+ */
+- (int64_t)incrementCounter:(NSString *)name;
+
+/**
+ * Current value of a counter, 0 if it was never bumped
+ */
+- (int64_t)valueForCounter:(NSString *)name;
+
+/**
+ * The dictionary the defaults key would hold after a flush: stored entries overlaid with
+ * every counter as a decimal string
+ */
+- (NSDictionary<NSString *, id> *)snapshot;
+
+/**
+ * Writes the counters to the defaults now
+ */
+- (void)flush;
+
+/**
+ * Zeroes every counter and clears the stored dictionary
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -14,6 +14,7 @@ NS_ASSUME_NONNULL_BEGIN
  */
 typedef NS_ENUM(NSInteger, CLXLossReason) {
     CLXLossReasonTechnicalError = 1,    // Technical error (adapter creation failed, etc.)
+    CLXLossReasonExpired = 2,           // Loaded ad expired in the cache before it was shown
     CLXLossReasonLostToHigherBid = 4    // Lost to higher bid (not selected in waterfall)
 };
 
@@ -51,6 +52,8 @@ typedef NS_ENUM(NSInteger, CLXErrorCode) {
     CLXErrorCodeInvalidResponse = 202,
     /// Server returned an error
     CLXErrorCodeServerError = 203,
+    /// Request not sent; the server kept answering 429 or 5xx and requests to it are paused
+    CLXErrorCodeServiceUnavailable = 204,
     
     // AD REQUEST/LOADING ERRORS (300-399)
     /// No ad fill available (no ads to show)
@@ -102,6 +105,11 @@ typedef NS_ENUM(NSInteger, CLXErrorCode) {
  */
 extern NSString * const CLXErrorDomain;
 
+/**
+ * userInfo key holding the HTTP status code (NSNumber) of errors made from an HTTP response
+ */
+extern NSString * const CLXErrorHTTPStatusCodeKey;
+
 /**
  * CloudX SDK error class - industry standard error handling
  */
@@ -12,6 +12,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class CLXEventAM;
+@class CLXRetryBudget;
 
 /**
  * Bulk API client for sending metrics events
@@ -36,6 +37,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithTimeoutMillis:(NSInteger)timeoutMillis;
 
+/** Circuit breakers consulted before each upload; the one shared by all SDK clients unless replaced */
+@property (nonatomic, strong) CLXRetryBudget *retryBudget;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -20,9 +20,18 @@ typedef NS_ENUM(NSInteger, ExponentialBackoffStrategyError) {
 
 /**
  * Algorithm to backoff retrying ad.load() when there have been a lot of adLoadFailed events.
+ *
+ * Delays use decorrelated jitter: each one is drawn uniformly between the initial delay and
+ * three times the previous delay, capped at the max delay. Devices that failed together
+ * therefore do not retry together.
  */
 @interface CLXExponentialBackoffStrategy : NSObject
 
+/**
+ * Overrides the random source. Returns a value in [0, 1).
+ */
+@property (nonatomic, copy, nullable) double (^randomSourceForTesting)(void);
+
 /**
  * Initialize a new exponential backoff strategy
  * @param initialDelay Initial delay in seconds
@@ -56,6 +65,24 @@ typedef NS_ENUM(NSInteger, ExponentialBackoffStrategyError) {
  */
 - (NSTimeInterval)reset;
 
+/**
+ * One decorrelated-jitter step
+ * @param previousDelay Delay before the last attempt; the base for the first retry
+ * @param baseDelay Smallest delay
+ * @param maxDelay Largest delay
+ * @param unit Random value in [0, 1)
+ * @return A delay between baseDelay and 3 * previousDelay, capped at maxDelay
+ */
++ (NSTimeInterval)decorrelatedDelayAfter:(NSTimeInterval)previousDelay
+                               baseDelay:(NSTimeInterval)baseDelay
+                                maxDelay:(NSTimeInterval)maxDelay
+                                    unit:(double)unit;
+
+/**
+ * Uniform random value in [0, 1)
+ */
++ (double)randomUnit;
+
 @end
 
 NS_ASSUME_NONNULL_END 
\ No newline at end of file
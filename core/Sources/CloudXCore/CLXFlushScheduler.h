@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXFlushScheduler.h
+ * @brief Dispatch-source based flush scheduler shared by the telemetry pipelines
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Flush block invoked on the scheduler's queue. The block must call completion exactly
+ * once (from any thread) when the flush, including any network I/O, has finished.
+ */
+typedef void (^CLXFlushBlock)(dispatch_block_t completion);
+
+/**
+ * Schedules periodic flushes on a serial dispatch queue using a dispatch_source timer,
+ * so firing does not depend on a run loop.
+ *
+ * - Flushes are coalesced: triggers that arrive while a flush is queued or in flight
+ *   collapse into at most one follow-up flush.
+ * - Each interval is jittered by ±jitterFraction so devices do not flush in lockstep.
+ * - The timer is paused while the app is in background and re-armed on foreground.
+ * - A flush also fires early once pending events or pending bytes reach a threshold.
+ */
+@interface CLXFlushScheduler : NSObject
+
+/**
+ * Base interval between periodic flushes in seconds. Takes effect on the next arm.
+ */
+@property (nonatomic, assign) NSTimeInterval interval;
+
+/**
+ * Fraction of the interval applied as random jitter in each direction. Default: 0.1
+ */
+@property (nonatomic, assign) double jitterFraction;
+
+/**
+ * Pending event count that triggers an early flush. 0 disables. Default: 0
+ */
+@property (nonatomic, assign) NSUInteger pendingEventThreshold;
+
+/**
+ * Pending payload bytes that trigger an early flush. 0 disables. Default: 0
+ */
+@property (nonatomic, assign) NSUInteger pendingBytesThreshold;
+
+/**
+ * Whether the scheduler pauses while the app is in background. Default: YES
+ */
+@property (nonatomic, assign) BOOL pausesInBackground;
+
+@property (nonatomic, assign, readonly) BOOL isRunning;
+@property (nonatomic, assign, readonly) BOOL isPaused;
+
+/**
+ * Creates a scheduler
+ * @param name Name used in log messages
+ * @param interval Base flush interval in seconds
+ * @param queue Serial queue the flush block runs on
+ * @param flushBlock Block performing the flush
+ */
+- (instancetype)initWithName:(NSString *)name
+                    interval:(NSTimeInterval)interval
+                       queue:(dispatch_queue_t)queue
+                  flushBlock:(CLXFlushBlock)flushBlock NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Arms the periodic timer. Calling start on a running scheduler re-arms it.
+ */
+- (void)start;
+
+/**
+ * Cancels the timer and drops pending triggers. A flush already in flight still completes.
+ */
+- (void)stop;
+
+/**
+ * Requests a flush as soon as possible, coalesced with any queued or in-flight flush
+ */
+- (void)requestFlush;
+
+/**
+ * Records newly enqueued telemetry and triggers a flush when a threshold is reached
+ * @param count Number of events enqueued
+ * @param bytes Approximate payload size of those events
+ */
+- (void)noteEnqueuedEvents:(NSUInteger)count bytes:(NSUInteger)bytes;
+
+/**
+ * Pauses the timer (e.g. in background). Triggers while paused are deferred until resume.
+ */
+- (void)pause;
+
+/**
+ * Resumes after pause, flushing immediately if a trigger was deferred
+ */
+- (void)resume;
+
+#pragma mark - Testing Support
+
+/**
+ * Replaces the dispatch_source timer with a virtual clock driven by advanceVirtualClockBy:.
+ * Must be called before start.
+ */
+- (void)enableVirtualClockForTesting;
+
+/**
+ * Advances the virtual clock, synchronously firing every flush that falls due
+ * @param seconds Amount of virtual time to advance
+ */
+- (void)advanceVirtualClockBy:(NSTimeInterval)seconds;
+
+/**
+ * Overrides the jitter random source. The block returns a value in [0, 1).
+ */
+@property (nonatomic, copy, nullable) double (^randomSourceForTesting)(void);
+
+/**
+ * Virtual time at which the next periodic flush is due, or -1 when not armed
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval nextFireTimeForTesting;
+
+@end
+
+NS_ASSUME_NONNULL_END
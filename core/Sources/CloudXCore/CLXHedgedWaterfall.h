@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXHedgedWaterfall.h
+ * @brief Parallel adapter loading across the top bids of a waterfall
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CLXBidAdSourceResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Reports the outcome of one adapter load; nil error means the adapter loaded. May be
+ * called on any thread; calls after the waterfall has finished are ignored.
+ */
+typedef void (^CLXHedgedLoadCompletion)(NSError * _Nullable error);
+
+/**
+ * Starts loading an adapter created for a candidate bid. Called on the main queue.
+ */
+typedef void (^CLXHedgedAdapterLoader)(CLXBidAdSourceResponse *candidate, id adapter, CLXHedgedLoadCompletion done);
+
+/**
+ * Tears down an adapter that lost. Called on the main queue.
+ */
+typedef void (^CLXHedgedAdapterCanceller)(id adapter);
+
+/**
+ * Loads adapters for the top bids of a waterfall in parallel instead of one after another.
+ *
+ * Up to maxConcurrentLoads adapters load at once. Without a hedge delay they all start
+ * together; with one, each further load starts hedgeDelay after the previous. A failed load
+ * frees its slot for the next bid. The highest-ranked bid that loads wins, so a lower bid
+ * that loads first waits for any higher bid still loading.
+ *
+ * Every bid in the waterfall gets its win/loss outcome from the shared CLXWinLossTracker:
+ * - failed creation or load: CLXLossReasonTechnicalError
+ * - loaded, still loading, or never started when another bid won: CLXLossReasonLostToHigherBid
+ *
+ * With maxConcurrentLoads of 1 and no hedge delay this is the plain sequential waterfall.
+ * One instance runs one waterfall.
+ */
+@interface CLXHedgedWaterfall : NSObject
+
+@property (nonatomic, assign, readonly) NSInteger maxConcurrentLoads;
+@property (nonatomic, assign, readonly) NSTimeInterval hedgeDelay;
+
+/**
+ * @param maxConcurrentLoads Adapters allowed to load at once; values below 1 are treated as 1
+ * @param hedgeDelay Seconds between starting successive loads; 0 starts them together
+ */
+- (instancetype)initWithMaxConcurrentLoads:(NSInteger)maxConcurrentLoads
+                                hedgeDelay:(NSTimeInterval)hedgeDelay NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Runs the waterfall
+ * @param candidates Bids in waterfall order; an adapter is created for each via createBidAd when its load starts
+ * @param loader Starts an adapter load
+ * @param canceller Tears down losing adapters; nil calls -destroy on adapters that implement it
+ * @param completion Called once on the main queue with the winning bid and its loaded adapter,
+ *                   or an error when no adapter loaded
+ */
+- (void)runWithCandidates:(NSArray<CLXBidAdSourceResponse *> *)candidates
+                   loader:(CLXHedgedAdapterLoader)loader
+                canceller:(nullable CLXHedgedAdapterCanceller)canceller
+               completion:(void (^)(CLXBidAdSourceResponse * _Nullable winner, id _Nullable adapter, NSError * _Nullable error))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXLatencyHistogram.h
+ * @brief Compact log-bucketed latency histogram for network metrics
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Number of buckets in every histogram. The bucket layout is fixed so histograms
+ * from different devices and sessions can be merged by adding counts per index.
+ */
+extern const NSUInteger CLXLatencyHistogramBucketCount;
+
+/**
+ * Log-bucketed latency histogram with two buckets per power of two.
+ *
+ * Bucket 0 holds latencies below 1 ms. Bucket i (i >= 1) holds latencies in
+ * [2^((i-1)/2), 2^(i/2)) ms. The last bucket also absorbs everything above its lower bound.
+ */
+@interface CLXLatencyHistogram : NSObject <NSCopying>
+
+@property (nonatomic, assign, readonly) NSInteger totalCount;
+@property (nonatomic, assign, readonly, getter=isEmpty) BOOL empty;
+
+/**
+ * Parses the sparse form produced by -serializedString. Returns an empty histogram for nil/empty/invalid input.
+ */
++ (instancetype)histogramFromSerializedString:(nullable NSString *)serialized;
+
+/**
+ * Bucket index a latency falls into
+ */
++ (NSUInteger)bucketIndexForLatency:(NSInteger)latencyMs;
+
+/**
+ * Exclusive upper bound of a bucket in milliseconds (rounded up)
+ */
++ (NSInteger)upperBoundForBucket:(NSUInteger)bucketIndex;
+
+- (void)recordLatency:(NSInteger)latencyMs;
+- (NSInteger)countForBucket:(NSUInteger)bucketIndex;
+
+/**
+ * Adds all counts from another histogram
+ */
+- (void)mergeHistogram:(CLXLatencyHistogram *)other;
+
+/**
+ * Removes counts previously merged or recorded (counts never go below zero)
+ */
+- (void)subtractHistogram:(CLXLatencyHistogram *)other;
+
+/**
+ * Upper bound of the bucket containing the given percentile (0-100), or 0 when empty
+ */
+- (NSInteger)latencyAtPercentile:(double)percentile;
+
+/**
+ * Sparse "index:count" pairs separated by commas, e.g. "13:4,14:9,18:1". Empty string when empty.
+ */
+- (NSString *)serializedString;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -2,6 +2,26 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Returns YES when CLOUDX_VERBOSE_LOG or CLOUDX_FLUTTER_VERBOSE_LOG is set to "1".
+ * The environment is read once per process.
+ */
+FOUNDATION_EXPORT BOOL CLXLoggerIsEnabled(void);
+
+/**
+ * Level-checked logging macros. The format string and its arguments are only
+ * evaluated when logging is enabled, so disabled logging costs a single branch.
+ * Arguments must not have side effects.
+ */
+#define CLX_LOG_DEBUG(logger, fmt, ...) \
+    do { if (CLXLoggerIsEnabled()) { [(logger) debug:[NSString stringWithFormat:(fmt), ##__VA_ARGS__]]; } } while (0)
+
+#define CLX_LOG_INFO(logger, fmt, ...) \
+    do { if (CLXLoggerIsEnabled()) { [(logger) info:[NSString stringWithFormat:(fmt), ##__VA_ARGS__]]; } } while (0)
+
+#define CLX_LOG_ERROR(logger, fmt, ...) \
+    do { if (CLXLoggerIsEnabled()) { [(logger) error:[NSString stringWithFormat:(fmt), ##__VA_ARGS__]]; } } while (0)
+
 @interface CLXLogger : NSObject
 
 - (instancetype)initWithCategory:(NSString *)category;
@@ -11,4 +31,4 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
-NS_ASSUME_NONNULL_END 
\ No newline at end of file
+NS_ASSUME_NONNULL_END
@@ -23,6 +23,13 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) NSNumber *networkCallsBidReqEnabled;   // Bid request specific flag
 @property (nonatomic, strong, nullable) NSNumber *networkCallsInitSdkReqEnabled; // SDK init specific flag
 @property (nonatomic, strong, nullable) NSNumber *networkCallsGeoReqEnabled;   // Geo API specific flag
+@property (nonatomic, strong, nullable) NSNumber *networkCallsLatencyHistogramEnabled; // Append latency histograms to network metrics
+@property (nonatomic, strong, nullable) NSNumber *performanceEnabled;          // Global performance metrics flag
+@property (nonatomic, strong, nullable) NSNumber *performanceAuctionStagesEnabled; // Auction stage timings
+@property (nonatomic, strong, nullable) NSNumber *performanceConnectionEnabled; // Connection reuse metrics
+@property (nonatomic, strong, nullable) NSNumber *performanceCacheRefillEnabled; // Cache refill decision metrics
+@property (nonatomic, copy, nullable) NSString *bulkCompressionEncoding;        // "gzip" or "deflate" for bulk uploads
+@property (nonatomic, strong, nullable) NSNumber *bulkCompressionMinBytes;      // Smallest body worth compressing
 
 - (instancetype)init;
 
@@ -56,6 +63,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)isGeoNetworkCallsEnabled;
 
+/**
+ * Check if network metrics should carry latency histograms in the SDK_METRICS payload
+ */
+- (BOOL)isLatencyHistogramEnabled;
+
+/**
+ * Check if performance metrics are globally enabled
+ */
+- (BOOL)isPerformanceMetricsEnabled;
+
+/**
+ * Check if auction stage timings are enabled
+ */
+- (BOOL)isAuctionStageMetricsEnabled;
+
+/**
+ * Check if new and reused connection metrics are enabled
+ */
+- (BOOL)isConnectionMetricsEnabled;
+
+/**
+ * Check if cache refill decision metrics are enabled
+ */
+- (BOOL)isCacheRefillMetricsEnabled;
+
+/**
+ * Content-Encoding the server accepts for bulk metrics and win/loss uploads
+ * @return "gzip" or "deflate", or nil when bodies must go uncompressed
+ */
+- (nullable NSString *)bulkContentEncoding;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -11,6 +11,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class CLXLatencyHistogram;
+
 /**
  * Metrics event model for SQLite storage
  * Matches Android's @Entity(tableName = "metrics_event_table") MetricsEvent exactly
@@ -23,6 +25,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) NSInteger totalLatency; // Total latency in milliseconds
 @property (nonatomic, copy) NSString *sessionId;      // Current session ID
 @property (nonatomic, copy) NSString *auctionId;      // Unique auction/event ID
+@property (nonatomic, strong) CLXLatencyHistogram *latencyHistogram; // Per-call latency distribution (network metrics only)
 
 - (instancetype)initWithEventId:(NSString *)eventId
                      metricName:(NSString *)metricName
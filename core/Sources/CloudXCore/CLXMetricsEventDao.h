@@ -28,6 +28,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)insert:(CLXMetricsEvent *)event;
 
+/**
+ * Insert or replace several metrics events in one transaction
+ */
+- (BOOL)insertAll:(NSArray<CLXMetricsEvent *> *)events;
+
 /**
  * Get a specific metric by name (for aggregation)
  * Matches Android's @Query("SELECT * FROM metrics_event_table WHERE metricName = :metricName LIMIT 1")
@@ -40,6 +45,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)deleteById:(NSString *)eventId;
 
+/**
+ * Delete several metrics events in one transaction using chunked IN (...) statements
+ */
+- (BOOL)deleteByIds:(NSArray<NSString *> *)eventIds;
+
 /**
  * Get all metrics events
  * Matches Android's @Query("SELECT * FROM metrics_event_table")
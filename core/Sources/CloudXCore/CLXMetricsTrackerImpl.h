@@ -20,9 +20,19 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Metrics tracker implementation
  * Matches Android's internal class MetricsTrackerImpl exactly
+ *
+ * Counters are aggregated in memory per metric type and checkpointed to SQLite
+ * every checkpointIntervalSeconds, when the app enters background, and before each send.
+ * A crash loses at most one checkpoint interval of counts.
  */
 @interface CLXMetricsTrackerImpl : NSObject <CLXMetricsTrackerProtocol>
 
+/**
+ * Interval between in-memory aggregate checkpoints to SQLite. Default: 5 seconds.
+ * Takes effect on the next startWithConfig:.
+ */
+@property (nonatomic, assign) NSTimeInterval checkpointIntervalSeconds;
+
 - (instancetype)init;
 
 /**
@@ -46,6 +46,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)trackNetworkCall:(NSString *)networkType latency:(NSInteger)latencyMs;
 
+/**
+ * Track a performance metric (auction stage, connection reuse, cache refill decision)
+ * @param valueMs Duration the metric carries, 0 for a plain count
+ */
+- (void)trackPerformanceMetric:(NSString *)metricType value:(NSInteger)valueMs;
+
 /**
  * Try sending pending metrics
  * Matches Android's fun trySendingPendingMetrics()
@@ -74,6 +80,7 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Flush all pending async operations (testing only)
  * This method blocks until all pending trackMethodCall operations complete
+ * and in-memory aggregates have been checkpointed to the database
  */
 - (void)flushPendingOperations;
 #endif
@@ -19,6 +19,36 @@ extern NSString * const CLXMetricsTypeNetworkSdkInit;      // "network_call_sdk_
 extern NSString * const CLXMetricsTypeNetworkGeoApi;       // "network_call_geo_req"
 extern NSString * const CLXMetricsTypeNetworkBidRequest;   // "network_call_bid_req"
 
+/**
+ * Performance metrics: SDK-internal timings and decisions, tracked with trackPerformanceMetric:value:
+ * and switched separately from network calls. Their totals are not network latency.
+ */
+
+/**
+ * Auction stage timings
+ * Each is one stage of a CLXAuctionDeadline
+ */
+extern NSString * const CLXMetricsTypeAuctionStageBidTokens;   // "auction_stage_bid_tokens"
+extern NSString * const CLXMetricsTypeAuctionStageBidRequest;  // "auction_stage_bid_req"
+extern NSString * const CLXMetricsTypeAuctionStageAdapterLoad; // "auction_stage_adapter_load"
+
+/**
+ * Connection reuse, reported from URLSessionTaskMetrics of the SDK sessions
+ * A new connection carries its connect and TLS time, a reused one its request time
+ */
+extern NSString * const CLXMetricsTypeNetworkConnectionNew;    // "network_conn_new"
+extern NSString * const CLXMetricsTypeNetworkConnectionReused; // "network_conn_reused"
+
+/**
+ * Cache refill decisions of fullscreen placements, made by CLXCacheRefillController
+ * A start or deferral carries its refill delay, an expiry the time the ad sat unused
+ */
+extern NSString * const CLXMetricsTypeCacheRefillStart;   // "cache_refill_start"
+extern NSString * const CLXMetricsTypeCacheRefillDefer;   // "cache_refill_defer"
+extern NSString * const CLXMetricsTypeCacheAdExpired;     // "cache_ad_expired"
+extern NSString * const CLXMetricsTypeCacheShowReady;     // "cache_show_ready"
+extern NSString * const CLXMetricsTypeCacheShowMiss;      // "cache_show_miss"
+
 /**
  * Method call metrics types
  * Matches Android's sealed class Method(typeCode: String) : MetricsType(typeCode)
@@ -49,6 +79,11 @@ extern NSString * const CLXMetricsTypeMethodBannerRefresh;    // "method_banner_
  */
 + (BOOL)isMethodCallType:(NSString *)metricType;
 
+/**
+ * Check if a metric type is a performance metric type
+ */
++ (BOOL)isPerformanceType:(NSString *)metricType;
+
 /**
  * Get all network call types
  */
@@ -59,6 +94,18 @@ extern NSString * const CLXMetricsTypeMethodBannerRefresh;    // "method_banner_
  */
 + (NSArray<NSString *> *)allMethodCallTypes;
 
+/**
+ * Get all performance metric types
+ */
++ (NSArray<NSString *> *)allPerformanceTypes;
+
+/**
+ * Performance metric types of one kind, each behind its own switch in CLXMetricsConfig
+ */
++ (NSArray<NSString *> *)allAuctionStageTypes;
++ (NSArray<NSString *> *)allConnectionTypes;
++ (NSArray<NSString *> *)allCacheRefillTypes;
+
 /**
  * Validate that a metric type is known
  */
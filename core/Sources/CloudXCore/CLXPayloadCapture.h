@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXPayloadCapture.h
+ * @brief Opt-in ring buffer of recent network request and response bodies for debugging
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, CLXCapturedPayloadDirection) {
+    CLXCapturedPayloadDirectionRequest = 0,
+    CLXCapturedPayloadDirectionResponse
+};
+
+/**
+ * A body exactly as it went over the wire
+ */
+@interface CLXCapturedPayload : NSObject
+
+@property (nonatomic, copy, readonly) NSString *url;
+@property (nonatomic, assign, readonly) CLXCapturedPayloadDirection direction;
+@property (nonatomic, strong, readonly) NSData *body;
+@property (nonatomic, strong, readonly) NSDate *timestamp;
+
+/**
+ * HTTP status code for responses, 0 for requests
+ */
+@property (nonatomic, assign, readonly) NSInteger statusCode;
+
+/**
+ * The body decoded as UTF-8, or nil if it is not valid UTF-8
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *bodyString;
+
+@end
+
+/**
+ * Keeps the most recent request/response bodies seen by CLXBaseNetworkService.
+ *
+ * Capture is off in production: it is enabled by default only when verbose logging is on
+ * (CLOUDX_VERBOSE_LOG / CLOUDX_FLUTTER_VERBOSE_LOG), or explicitly by a debug inspector.
+ * Bodies are stored as the already-encoded NSData, so capturing never re-serializes a payload.
+ */
+@interface CLXPayloadCapture : NSObject
+
++ (instancetype)shared;
+
+/**
+ * Whether bodies are recorded. Default: CLXLoggerIsEnabled()
+ */
+@property (atomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ * Maximum number of payloads kept; the oldest are dropped first. Default: 32
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
+/**
+ * Captured payloads, oldest first
+ */
+@property (nonatomic, copy, readonly) NSArray<CLXCapturedPayload *> *recentPayloads;
+
+- (void)recordRequestBody:(nullable NSData *)body url:(nullable NSURL *)url;
+- (void)recordResponseBody:(nullable NSData *)body url:(nullable NSURL *)url statusCode:(NSInteger)statusCode;
+
+- (void)removeAllPayloads;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXRequestCompressor.h
+ * @brief Content-Encoding for bulk metrics and win/loss upload bodies
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CLXMetricsConfig;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Encodings a request body can be sent with
+ */
+typedef NS_ENUM(NSInteger, CLXContentEncoding) {
+    /// Body sent as-is, no Content-Encoding header
+    CLXContentEncodingIdentity = 0,
+    /// RFC 1952 gzip stream
+    CLXContentEncodingGzip,
+    /// RFC 1950 zlib stream, which is what HTTP "deflate" means
+    CLXContentEncodingDeflate
+};
+
+/// Bodies below this size are sent uncompressed unless the config says otherwise
+extern const NSUInteger CLXRequestCompressorDefaultMinimumBodyBytes;
+
+/**
+ * Compresses bulk upload bodies once they pass a size threshold.
+ *
+ * Off until the SDK config names an encoding (metricsConfig "bulk_compression.encoding").
+ * A host that answers a compressed body with 415 Unsupported Media Type or 400 Bad Request
+ * is remembered and gets uncompressed bodies for the rest of the process; callers resend
+ * the rejected request uncompressed once.
+ */
+@interface CLXRequestCompressor : NSObject
+
++ (instancetype)shared;
+
+/// Encoding used for bodies at or above minimumBodyBytes; Identity turns compression off
+@property (atomic, assign) CLXContentEncoding encoding;
+
+/// Smallest body that is compressed
+@property (atomic, assign) NSUInteger minimumBodyBytes;
+
+/**
+ * Takes encoding and threshold from the SDK metrics config; a nil config turns compression off
+ */
+- (void)applyMetricsConfig:(nullable CLXMetricsConfig *)config;
+
+/**
+ * Compresses a body bound for a URL when it is large enough, the host has not rejected
+ * compression and the compressed body is smaller
+ * @param body Uncompressed body
+ * @param url Request URL
+ * @param encoding Set to the encoding of the returned body
+ * @return The compressed body, or nil when the body should go as-is
+ */
+- (nullable NSData *)compressedBody:(NSData *)body
+                             forURL:(nullable NSURL *)url
+                           encoding:(CLXContentEncoding *)encoding;
+
+/**
+ * Compresses the request body in place and sets Content-Encoding, as compressedBody:forURL:encoding:
+ * @return The encoding the body now has
+ */
+- (CLXContentEncoding)compressBodyOfRequest:(NSMutableURLRequest *)request;
+
+/**
+ * Checks whether a response means the server could not decode the body. If so the host
+ * is sent uncompressed bodies from now on.
+ * @param encoding Encoding the rejected body was sent with
+ * @param statusCode HTTP status of the response
+ * @param url Request URL
+ * @return YES when the caller should resend the body uncompressed
+ */
+- (BOOL)shouldRetryUncompressedAfterEncoding:(CLXContentEncoding)encoding
+                                  statusCode:(NSInteger)statusCode
+                                         url:(nullable NSURL *)url;
+
+/**
+ * Whether a host has rejected compressed bodies
+ */
+- (BOOL)hasHostRejectedCompression:(nullable NSString *)host;
+
+/**
+ * Forgets every host that rejected compression
+ */
+- (void)resetRejectedHosts;
+
+/**
+ * Compresses data with the given encoding
+ * @return The compressed data, the data itself for Identity, or nil if zlib fails
+ */
++ (nullable NSData *)compressData:(NSData *)data encoding:(CLXContentEncoding)encoding;
+
+/**
+ * Value of the Content-Encoding header for an encoding; nil for Identity
+ */
++ (nullable NSString *)headerValueForEncoding:(CLXContentEncoding)encoding;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXRetryBudget.h
+ * @brief Retry budget shared by the SDK's network clients and their per-host circuit breakers
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * State of the circuit breaker in front of one host
+ */
+typedef NS_ENUM(NSInteger, CLXCircuitState) {
+    /// Requests and retries go out
+    CLXCircuitStateClosed = 0,
+    /// The host keeps failing; requests to it fail without being sent until the cooldown ends
+    CLXCircuitStateOpen,
+    /// Cooldown over; one probe request is let through to decide whether to close again
+    CLXCircuitStateHalfOpen
+};
+
+/// Retries the budget holds when full
+extern const double CLXRetryBudgetDefaultCapacity;
+
+/// Consecutive failed requests to one host that open its circuit
+extern const NSInteger CLXRetryBudgetDefaultFailureThreshold;
+
+/// Seconds an open circuit waits before letting a probe through
+extern const NSTimeInterval CLXRetryBudgetDefaultOpenInterval;
+
+/**
+ * Limits how many retries the bid, init, win/loss and metrics clients send together, so a
+ * backend outage is not met with a wave of retries from every device.
+ *
+ * Retries spend tokens from one bucket that refills slowly over time and by a fraction of a
+ * token for every successful request; with the bucket empty, failed requests are not
+ * retried. Each host has its own circuit: after a run of overloaded answers (429 or 5xx) from
+ * a host its circuit opens and requests to it fail without being sent, for the cooldown or the
+ * server's Retry-After, whichever is longer. A single probe then decides whether the circuit
+ * closes. Connectivity errors and requests cut short by the caller's own deadline say nothing
+ * about the server and are not recorded.
+ *
+ * Hosts are compared case-insensitively; a nil host has a circuit of its own.
+ *
+ * Thread-safe. CLXBaseNetworkService and the metrics bulk uploads (CLXEventTrackerBulkApiImpl)
+ * use the shared instance.
+ */
+@interface CLXRetryBudget : NSObject
+
++ (instancetype)shared;
+
+/// Most tokens the bucket holds; retries cost one each
+@property (atomic, assign) double capacity;
+
+/// Tokens added per second while the bucket is not full
+@property (atomic, assign) double refillPerSecond;
+
+/// Tokens a successful request adds
+@property (atomic, assign) double successDeposit;
+
+/// Consecutive failed requests to one host that open its circuit
+@property (atomic, assign) NSInteger failureThreshold;
+
+/// Seconds an open circuit stays open before a probe
+@property (atomic, assign) NSTimeInterval openInterval;
+
+/// Tokens in the bucket now
+@property (nonatomic, readonly) double availableTokens;
+
+/**
+ * Overrides the clock used for refills and cooldowns. Returns seconds on any monotonic scale.
+ */
+@property (atomic, copy, nullable) NSTimeInterval (^clockForTesting)(void);
+
+/**
+ * Current state of the host's circuit; an open circuit past its cooldown reads as half-open
+ */
+- (CLXCircuitState)circuitStateForHost:(nullable NSString *)host;
+
+/**
+ * Whether a request to the host may be sent now. Claims the probe when its circuit is half-open.
+ */
+- (BOOL)shouldAllowRequestToHost:(nullable NSString *)host;
+
+/**
+ * Takes a token for a retry to the host
+ * @return NO when the bucket is empty or the host's circuit is not closed; the request should fail instead
+ */
+- (BOOL)tryAcquireRetryForHost:(nullable NSString *)host;
+
+/**
+ * Records a request the host answered without overload, including 4xx responses other than 429.
+ * Closes its circuit.
+ */
+- (void)recordSuccessForHost:(nullable NSString *)host;
+
+/**
+ * Records a request the host answered with 429 or 5xx
+ * @param retryAfter Seconds the server asked to wait, 0 if it did not; keeps an opening circuit open at least this long
+ */
+- (void)recordFailureForHost:(nullable NSString *)host retryAfter:(NSTimeInterval)retryAfter;
+
+/**
+ * Fills the bucket and closes every circuit
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -94,6 +94,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy, nullable) NSString *appID;
 @property (nonatomic, strong, nullable) NSArray<NSString *> *tracking;
 @property (nonatomic, copy, nullable) NSString *winLossNotificationURL;
+@property (nonatomic, copy, nullable) NSString *winLossNotificationBatchURL; // Batched win/loss endpoint; nil sends one request per event
 @property (nonatomic, strong, nullable) NSDictionary<NSString *, NSString *> *winLossNotificationPayloadConfig;
 @property (nonatomic, strong, nullable) CLXMetricsConfig *metricsConfig;
 
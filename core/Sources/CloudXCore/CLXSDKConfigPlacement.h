@@ -23,6 +23,12 @@ typedef NS_ENUM(NSInteger, SDKConfigAdType) {
 @property (nonatomic, assign) int64_t bidResponseTimeoutMs;
 @property (nonatomic, assign) int64_t adLoadTimeoutMs;
 @property (nonatomic, assign) int64_t bannerRefreshRateMs;
+/// Adapters loaded in parallel across the top bids; 1 loads the waterfall sequentially
+@property (nonatomic, assign) NSInteger hedgedLoadConcurrency;
+/// Delay before each further parallel load starts; 0 starts them together
+@property (nonatomic, assign) int64_t hedgedLoadDelayMs;
+/// Chance a fullscreen show request should find a cached ad ready, between 0 and 1
+@property (nonatomic, assign) double cacheReadinessTarget;
 @property (nonatomic, assign) SDKConfigAdType type;
 @property (nonatomic, assign) BOOL hasCloseButton;
 @property (nonatomic, copy, nullable) NSString *firstImpressionPlacementSuffix;
@@ -21,6 +21,30 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class CLXLogger;
 
+/**
+ * Connection tuning applied when a database is opened
+ */
+@interface CLXSQLiteDatabaseConfiguration : NSObject <NSCopying>
+
+@property (nonatomic, assign) BOOL walJournalMode;          // PRAGMA journal_mode = WAL
+@property (nonatomic, assign) BOOL synchronousNormal;       // PRAGMA synchronous = NORMAL (no fsync per commit in WAL)
+@property (nonatomic, assign) BOOL tempStoreInMemory;       // PRAGMA temp_store = MEMORY
+@property (nonatomic, assign) int64_t mmapSizeBytes;        // PRAGMA mmap_size, 0 leaves SQLite default
+@property (nonatomic, assign) NSInteger pageCacheSizeKiB;   // PRAGMA cache_size = -N, 0 leaves SQLite default
+
+/**
+ * Tuned for the SDK's small, write-heavy telemetry stores:
+ * WAL, synchronous=NORMAL, in-memory temp store, 4 MB mmap, 512 KiB page cache
+ */
++ (instancetype)defaultConfiguration;
+
+/**
+ * SQLite defaults (rollback journal, synchronous=FULL)
+ */
++ (instancetype)legacyConfiguration;
+
+@end
+
 /**
  * Base SQLite database class providing common functionality
  * Can be subclassed or used directly for different data storage needs
@@ -30,7 +54,24 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readonly) CLXLogger *logger;
 @property (nonatomic, strong, readonly) dispatch_queue_t databaseQueue;
 
+/**
+ * Maximum number of prepared statements kept alive, keyed by SQL text.
+ * Cached statements are reset and have their bindings cleared between uses.
+ * Set to 0 to disable caching (every call prepares and finalizes). Default: 32.
+ */
+@property (nonatomic, assign) NSUInteger statementCacheCapacity;
+
+@property (nonatomic, copy, readonly) CLXSQLiteDatabaseConfiguration *configuration;
+
+/**
+ * Single connection shared by the SDK's internal stores (metrics, win/loss cache).
+ * Each store owns its own tables inside the shared "cloudx_sdk" file.
+ */
++ (instancetype)sharedDatabase;
+
 - (instancetype)initWithDatabaseName:(NSString *)databaseName;
+- (instancetype)initWithDatabaseName:(NSString *)databaseName
+                       configuration:(CLXSQLiteDatabaseConfiguration *)configuration;
 
 /**
  * Database lifecycle
@@ -48,8 +89,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Transaction support
+ * Runs the block inside a single BEGIN/COMMIT. When called while a transaction is already open
+ * the block joins the outer transaction. If a statement in the block fails, the transaction is
+ * rolled back and NO is returned; a joined call returns NO and the outer transaction fails too.
  */
-- (void)executeInTransaction:(void (^)(void))block;
+- (BOOL)executeInTransaction:(void (^)(void))block;
+
+/**
+ * Deletes the rows whose column value is in the list, in one transaction (or the one already open).
+ * Long lists are split into DELETE ... IN (...) statements under SQLite's bound-parameter limit.
+ */
+- (BOOL)deleteFromTable:(NSString *)tableName whereColumn:(NSString *)columnName inValues:(NSArray *)values;
 
 /**
  * Utility methods
@@ -57,6 +107,14 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSString *)databasePath;
 - (BOOL)tableExists:(NSString *)tableName;
 
+/**
+ * Moves rows of a table from a standalone database file (from before stores shared a connection)
+ * into the same table of this database, then deletes the legacy file once it has no tables left to import.
+ * The destination table must already exist. Only the columns both tables have are copied, so columns
+ * added since the legacy file was written take their defaults.
+ */
+- (BOOL)importTable:(NSString *)tableName fromLegacyDatabaseNamed:(NSString *)legacyDatabaseName;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXTrackingAuctionStore.h
+ * @brief Bounded, auction-scoped storage backing CLXTrackingFieldResolver
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Tracking data retained for one auction.
+ * Entries are immutable once published; each write replaces the auction's entry.
+ */
+@interface CLXTrackingAuctionEntry : NSObject
+@property (nonatomic, copy, readonly) NSString *auctionId;
+@property (nonatomic, strong, readonly, nullable) NSDictionary *requestData;
+/**
+ * Bid response JSON. When the response was stored as raw bytes it is parsed on first read;
+ * recently parsed responses are cached by the store and dropped again under memory pressure.
+ */
+@property (nonatomic, strong, readonly, nullable) NSDictionary *responseData;
+/**
+ * Raw bid response bytes, when the response was stored that way
+ */
+@property (nonatomic, strong, readonly, nullable) NSData *responseJSONData;
+@property (nonatomic, copy, readonly, nullable) NSString *loadedBidId;
+@property (nonatomic, strong, readonly, nullable) NSNumber *loopIndex;
+@property (nonatomic, copy, readonly, nullable) NSDictionary<NSString *, NSString *> *sdkValues;
+
+/**
+ * Approximate in-memory size of the retained request and response JSON
+ */
+@property (nonatomic, assign, readonly) NSUInteger estimatedBytes;
+@end
+
+/**
+ * LRU and TTL bounded store of per-auction tracking data.
+ *
+ * Auctions are evicted least-recently-used first once capacity is exceeded, expire after
+ * timeToLive without access, and are retired retirementGracePeriod after the auction ends
+ * so late win/loss and Rill payloads can still resolve their fields. Pinned auctions are exempt
+ * from all three until their last pin is released, which covers ads that sit in a cache for
+ * longer than timeToLive and resolve their win or loss when they are shown or expire.
+ *
+ * Safe to use from any thread. The lock only guards the auction map, so payloads built from
+ * a returned entry proceed in parallel with writes to the same or other auctions.
+ */
+@interface CLXTrackingAuctionStore : NSObject
+
+/**
+ * Maximum number of live auctions. Default: 32
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
+/**
+ * Seconds an auction is kept without being read or written. Default: 600
+ */
+@property (nonatomic, assign) NSTimeInterval timeToLive;
+
+/**
+ * Seconds a retired auction stays readable. Default: 30
+ */
+@property (nonatomic, assign) NSTimeInterval retirementGracePeriod;
+
+/**
+ * Responses stored as raw bytes that are kept parsed at once. Default: 4
+ */
+@property (nonatomic, assign) NSUInteger parsedResponseCacheLimit;
+
+@property (nonatomic, assign, readonly) NSUInteger liveAuctionCount;
+@property (nonatomic, assign, readonly) NSUInteger retainedBytes;
+@property (nonatomic, assign, readonly) NSUInteger evictedAuctionCount;
+
+/**
+ * Returns the auction's entry and marks it recently used, or nil if absent or expired
+ */
+- (nullable CLXTrackingAuctionEntry *)entryForAuction:(NSString *)auctionId;
+
+- (void)setRequestData:(nullable NSDictionary *)requestData forAuction:(NSString *)auctionId;
+- (void)setResponseData:(nullable NSDictionary *)responseData forAuction:(NSString *)auctionId;
+
+/**
+ * Stores the bid response as its raw JSON bytes, which take a fraction of the memory of the
+ * parsed object graph. Replaces any response stored with setResponseData:forAuction:.
+ */
+- (void)setResponseJSONData:(nullable NSData *)responseJSONData forAuction:(NSString *)auctionId;
+- (void)setLoadedBidId:(nullable NSString *)bidId forAuction:(NSString *)auctionId;
+- (void)setLoopIndex:(NSInteger)loopIndex forAuction:(NSString *)auctionId;
+- (void)setSdkValue:(nullable NSString *)value forKey:(NSString *)key auction:(NSString *)auctionId;
+
+/**
+ * Schedules the auction for removal after retirementGracePeriod
+ */
+- (void)retireAuction:(NSString *)auctionId;
+
+/**
+ * Keeps the auction from being evicted, expiring or being retired until a matching
+ * unpinAuction:. Pins are counted, so several holders of one auction can pin it independently.
+ * The auction may be pinned before its data is stored.
+ */
+- (void)pinAuction:(NSString *)auctionId;
+
+/**
+ * Releases one pin. Once the last pin is gone the auction counts as just used, and a pending
+ * retirement is pushed back to a full retirementGracePeriod from now.
+ */
+- (void)unpinAuction:(NSString *)auctionId;
+
+- (BOOL)isAuctionPinned:(NSString *)auctionId;
+
+/**
+ * Removes the auction immediately, pinned or not
+ */
+- (void)removeAuction:(NSString *)auctionId;
+
+- (void)removeAllAuctions;
+
+/**
+ * Approximate in-memory size of a JSON object graph
+ */
++ (NSUInteger)estimatedBytesForJSONObject:(nullable id)object;
+
+#pragma mark - Testing Support
+
+/**
+ * Overrides the clock used for TTL and retirement. Returns seconds on any monotonic scale.
+ */
+@property (nonatomic, copy, nullable) NSTimeInterval (^clockForTesting)(void);
+
+@end
+
+NS_ASSUME_NONNULL_END
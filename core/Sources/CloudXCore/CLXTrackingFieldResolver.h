@@ -4,10 +4,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class CLXSDKConfigResponse;
 @class CLXBidAdSourceResponse;
+@class CLXTrackingAuctionStore;
 
 /**
  * iOS equivalent of Android's TrackingFieldResolver
  * Provides server-driven, dynamic field resolution for Rill tracking payloads
+ *
+ * Thread-safe: config and session state are published as immutable snapshots and auction data
+ * as immutable per-auction entries, so payload building never blocks on concurrent writes.
  */
 @interface CLXTrackingFieldResolver : NSObject
 
@@ -36,6 +40,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)setResponseData:(NSString *)auctionId bidResponseJSON:(NSDictionary *)bidResponseJSON;
 
+/**
+ * Stores the bid response as its raw JSON bytes; fields are resolved by parsing it on demand
+ * @param auctionId The auction identifier
+ * @param bidResponseData The bid response body as received
+ */
+- (void)setResponseData:(NSString *)auctionId bidResponseData:(NSData *)bidResponseData;
+
 /**
  * Sets the winning bid ID for an auction
  * @param auctionId The auction identifier
@@ -94,6 +105,41 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)clear;
 
+/**
+ * Retires an auction once it has ended (impression, expiry or win/loss cleanup).
+ * Its data stays resolvable for the store's grace period so late payloads still build.
+ * @param auctionId The auction identifier
+ */
+- (void)clearAuction:(NSString *)auctionId;
+
+/**
+ * Keeps an auction resolvable while something that will report on it later, such as a cached
+ * ad, is alive. Balance every call with releaseAuction:.
+ * @param auctionId The auction identifier
+ */
+- (void)holdAuction:(NSString *)auctionId;
+
+/**
+ * Releases a hold taken with holdAuction:
+ * @param auctionId The auction identifier
+ */
+- (void)releaseAuction:(NSString *)auctionId;
+
+/**
+ * Bounded per-auction storage; exposed for tuning and metrics
+ */
+@property (nonatomic, strong, readonly) CLXTrackingAuctionStore *auctionStore;
+
+/**
+ * Number of auctions currently retained
+ */
+@property (nonatomic, assign, readonly) NSUInteger liveAuctionCount;
+
+/**
+ * Approximate bytes of bid request/response JSON currently retained
+ */
+@property (nonatomic, assign, readonly) NSUInteger retainedBytes;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXURLSessionProvider.h
+ * @brief SDK-owned URL sessions, one per kind of traffic
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol CLXMetricsTrackerProtocol;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Kinds of SDK traffic, each served by its own long-lived session
+ */
+typedef NS_ENUM(NSInteger, CLXURLSessionPurpose) {
+    /// Bid requests: fail fast instead of waiting for connectivity, no response cache
+    CLXURLSessionPurposeAuction = 0,
+    /// SDK init and config
+    CLXURLSessionPurposeInit,
+    /// Win/loss, impression, metrics and other tracking traffic
+    CLXURLSessionPurposeTracking
+};
+
+/**
+ * Hands out one session per purpose for the lifetime of the SDK, so connections
+ * (and HTTP/2 streams, which NSURLSession negotiates over TLS by itself) are reused
+ * across requests instead of being thrown away with short-lived sessions.
+ *
+ * Every session reports its task metrics here. Each finished network load is counted
+ * as a new or a reused connection and, when a metrics tracker is available, reported
+ * as CLXMetricsTypeNetworkConnectionNew (with the connect and TLS time) or
+ * CLXMetricsTypeNetworkConnectionReused.
+ */
+@interface CLXURLSessionProvider : NSObject
+
++ (instancetype)shared;
+
+/**
+ * Tracker that connection metrics go to; nil resolves the SDK metrics tracker
+ */
+@property (nonatomic, strong, nullable) id<CLXMetricsTrackerProtocol> metricsTracker;
+
+/// Network loads that opened a new connection
+@property (nonatomic, assign, readonly) NSInteger openedConnectionCount;
+
+/// Network loads that reused an open connection
+@property (nonatomic, assign, readonly) NSInteger reusedConnectionCount;
+
+/**
+ * Returns the session for a purpose, creating it on first use
+ */
+- (NSURLSession *)sessionForPurpose:(CLXURLSessionPurpose)purpose;
+
+/**
+ * The configuration sessions for a purpose are created with
+ */
++ (NSURLSessionConfiguration *)configurationForPurpose:(CLXURLSessionPurpose)purpose;
+
+/**
+ * Lets outstanding tasks finish and drops every session; the next request creates fresh ones
+ */
+- (void)invalidateSessions;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -16,6 +16,18 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class CLXBaseNetworkService;
 
+/**
+ * Outcome of a batched win/loss send
+ */
+typedef NS_ENUM(NSInteger, CLXWinLossBatchResult) {
+    /// The server answered; acceptedIndexes says which events it took
+    CLXWinLossBatchResultSent = 0,
+    /// Nothing was accepted; the batch should be retried as a unit
+    CLXWinLossBatchResultFailed,
+    /// The endpoint does not take batches; the events should be sent one by one
+    CLXWinLossBatchResultUnsupported
+};
+
 /**
  * Protocol for win/loss network operations - enables easy testing
  */
@@ -56,6 +68,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)initWithBaseNetworkService:(CLXBaseNetworkService *)baseNetworkService;
 
+/**
+ * Sends several win/loss notifications in one request body: {"events": [payload, ...]}
+ *
+ * A 2xx answer may list the indexes of events the server did not take as
+ * {"rejected": [1, 4]}; those are refused and not worth resending, every other event
+ * counts as accepted. 404, 405 and 501 mean
+ * the endpoint has no batch support.
+ * @param appKey The app key for authorization
+ * @param endpointUrl The batch endpoint URL
+ * @param payloads Payloads in the order they should be reported
+ * @param completion Called with the result and the indexes of accepted payloads
+ */
+- (void)sendBatchWithAppKey:(NSString *)appKey
+                endpointUrl:(NSString *)endpointUrl
+                   payloads:(NSArray<NSDictionary<NSString *, id> *> *)payloads
+                 completion:(void (^)(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error))completion;
+
 @end
 
 NS_ASSUME_NONNULL_END
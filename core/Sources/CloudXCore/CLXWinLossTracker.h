@@ -117,6 +117,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)shared;
 
+/**
+ * Switches to batched sending: events within a short window, such as an auction's win and
+ * losses, go out in one request and are stored and retried as one batch. Set from the SDK
+ * config's winLossNotificationBatchURL; nil, or a server answering 404/405/501, keeps
+ * the one-request-per-event path.
+ * @param batchEndpointUrl The batch endpoint URL, or nil
+ */
+- (void)setBatchEndpoint:(nullable NSString *)batchEndpointUrl;
+
 #pragma mark - Testing Support
 
 /**
@@ -136,7 +145,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)deleteAllEvents;
 - (void)insertEventWithId:(NSString *)eventId endpointUrl:(NSString *)endpointUrl payload:(NSString *)payload;
 - (void)deleteEventWithId:(NSString *)eventId;
+- (void)deleteEventsWithIds:(NSArray<NSString *> *)eventIds;
 - (NSArray *)getAllCachedEvents;
+- (NSArray *)getAllCachedBatches;
 
 @end
 
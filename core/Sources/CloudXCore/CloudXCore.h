@@ -18,6 +18,7 @@
 #import <CloudXCore/CLXAppSessionService.h>
 #import <CloudXCore/CLXAppSessionServiceImplementation.h>
 #import <CloudXCore/CLXBidNetworkService.h>
+#import <CloudXCore/CLXBidRequestTemplate.h>
 #import <CloudXCore/CLXAdTrackingService.h>
 #import <CloudXCore/CLXSettings.h>
 #import <CloudXCore/CLXPrivacyService.h>
@@ -34,6 +35,8 @@
 #import <CloudXCore/CLXMetricsType.h>
 #import <CloudXCore/CLXMetricsConfig.h>
 #import <CloudXCore/CLXMetricsEvent.h>
+#import <CloudXCore/CLXCounterRegistry.h>
+#import <CloudXCore/CLXLatencyHistogram.h>
 #import <CloudXCore/CLXMetricsEventDao.h>
 #import <CloudXCore/CLXEventAM.h>
 #import <CloudXCore/CLXEventTrackerBulkApi.h>
@@ -85,6 +88,7 @@
 #import <CloudXCore/CLXAdNetworkInitializer.h>
 #import <CloudXCore/CLXAdNetworkFactories.h>
 #import <CloudXCore/CLXBidTokenSource.h>
+#import <CloudXCore/CLXBidTokenCache.h>
 
 // Publisher Ads
 #import <CloudXCore/CLXAd.h>
@@ -110,6 +114,7 @@
 
 // Utils
 #import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXPayloadCapture.h>
 #import <CloudXCore/CLXSystemInformation.h>
 #import <CloudXCore/CLXRetryHelper.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
@@ -124,10 +129,13 @@
 #import <CloudXCore/CLXSDKInitNetworkService.h>
 #import <CloudXCore/CLXReachabilityService.h>
 #import <CloudXCore/CLXBackgroundTimer.h>
+#import <CloudXCore/CLXFlushScheduler.h>
 #import <CloudXCore/CLXBannerTimerService.h>
 #import <CloudXCore/CLXCacheAdService.h>
 #import <CloudXCore/CLXCacheAdQueue.h>
+#import <CloudXCore/CLXCacheRefillController.h>
 #import <CloudXCore/CLXExponentialBackoffStrategy.h>
+#import <CloudXCore/CLXRetryBudget.h>
 #import <CloudXCore/CLXXorEncryption.h>
 
 // Additional Models
@@ -153,12 +161,17 @@
 // Additional Utils
 #import <CloudXCore/CLXURLProvider.h>
 #import <CloudXCore/URLSession+CLX.h>
+#import <CloudXCore/CLXURLSessionProvider.h>
+#import <CloudXCore/CLXRequestCompressor.h>
 #import <CloudXCore/UIDevice+CLXIdentifier.h>
 
 // Additional Ad Reporting
 #import <CloudXCore/CLXAdEventReporting.h>
 #import <CloudXCore/CLXBidAdSource.h>
+#import <CloudXCore/CLXAuctionDeadline.h>
+#import <CloudXCore/CLXHedgedWaterfall.h>
 #import <CloudXCore/CLXTrackingFieldResolver.h>
+#import <CloudXCore/CLXTrackingAuctionStore.h>
 #import <CloudXCore/CLXRillTrackingService.h>
 
 NS_ASSUME_NONNULL_BEGIN
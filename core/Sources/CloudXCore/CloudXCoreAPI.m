@@ -24,6 +24,8 @@
 #import <CloudXCore/CLXXorEncryption.h>
 #import <CloudXCore/CLXTrackingFieldResolver.h>
 #import <CloudXCore/CLXWinLossTracker.h>
+#import <CloudXCore/CLXRequestCompressor.h>
+#import <CloudXCore/CLXCounterRegistry.h>
 
 // Adapter Protocols
 #import <CloudXCore/CLXAdapterNative.h>
@@ -37,6 +39,7 @@
 #import <CloudXCore/CLXAdNetworkInitializer.h>
 #import <CloudXCore/CLXAdNetworkFactories.h>
 #import <CloudXCore/CLXBidTokenSource.h>
+#import <CloudXCore/CLXBidTokenCache.h>
 
 // Publisher Ads
 #import <CloudXCore/CLXAd.h>
@@ -59,6 +62,7 @@
 #import <CloudXCore/CLXPublisherBanner.h>
 #import <CloudXCore/CLXPublisherNative.h>
 #import <CloudXCore/CLXPublisherFullscreenAd.h>
+#import <CloudXCore/CLXBidRequestTemplate.h>
 
 @interface CloudXCore ()
 @property (nonatomic, strong) id<CLXInitService> initService;
@@ -182,8 +186,7 @@ static CloudXCore *_sharedInstance = nil;
         }
         
         // Reset metrics dictionary at start of initialization
-        NSDictionary *dict = @{};
-        [[NSUserDefaults standardUserDefaults] setObject:dict forKey:kCLXCoreMetricsDictKey];
+        [[CLXCounterRegistry coreMetrics] reset];
     }
     
     [self.logger debug:@"🔧 [CloudXCore] Starting SDK initialization process"];
@@ -239,21 +242,14 @@ static CloudXCore *_sharedInstance = nil;
         NSString *sessionID = [[NSUUID UUID] UUIDString];
         [[NSUserDefaults standardUserDefaults] setObject:sessionID forKey:kCLXCoreSessionIDKey];
         
-        NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-        NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-        if ([metricsDict.allKeys containsObject:@"method_sdk_init"]) {
-            NSString *value = metricsDict[@"method_sdk_init"];
-            int number = [value intValue];
-            int new = number + 1;
-            metricsDict[@"method_sdk_init"] = [NSString stringWithFormat:@"%d", new];
-        } else {
-            metricsDict[@"method_sdk_init"] = @"1";
-        }
-        [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+        [[CLXCounterRegistry coreMetrics] incrementCounter:@"method_sdk_init"];
 
         // Initialize reporting service (no longer uses legacy eventTrackingURL)
         _reportingService = [[CLXAdEventReporter alloc] initWithEndpoint:nil];
         
+        // Bulk metrics and win/loss bodies are compressed only when the server opts in
+        [[CLXRequestCompressor shared] applyMetricsConfig:config.metricsConfig];
+        
         // Initialize win/loss tracking with server configuration
         [[CLXWinLossTracker shared] setAppKey:_appKey];
         [[CLXWinLossTracker shared] setEndpoint:config.winLossNotificationURL];
@@ -266,6 +262,7 @@ static CloudXCore *_sharedInstance = nil;
             }
             [self.logger debug:[NSString stringWithFormat:@"📊 [CloudXCore] geoHeaders Dictionary: %@", geoHeaders]];
             [[NSUserDefaults standardUserDefaults] setObject:geoHeaders forKey:kCLXCoreGeoHeadersKey];
+            [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
         }
         
         // Generate unique auction ID for this impression
@@ -276,17 +273,7 @@ static CloudXCore *_sharedInstance = nil;
         
         if (config.geoDataEndpointURL) { // @"https://geoip.cloudx.io"
             [self.reportingService geoTrackingWithURLString:config.geoDataEndpointURL extras:geoHeaders];
-            NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-            NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-            if ([metricsDict.allKeys containsObject:@"network_call_geo_req"]) {
-                NSString *value = metricsDict[@"network_call_geo_req"];
-                int number = [value intValue];
-                int new = number + 1;
-                metricsDict[@"network_call_geo_req"] = [NSString stringWithFormat:@"%d", new];
-            } else {
-                metricsDict[@"network_call_geo_req"] = @"1";
-            }
-            [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+            [[CLXCounterRegistry coreMetrics] incrementCounter:@"network_call_geo_req"];
         }
         
         CLXRillImpressionModel *model = [[CLXRillImpressionModel alloc] initWithLastBidResponse:nil impModel:impModel adapterName:@"" loadBannerTimesCount:0 placementID:@""];
@@ -359,6 +346,11 @@ static CloudXCore *_sharedInstance = nil;
             [initializer initializeWithConfig:bidderConfig completion:^(BOOL success, NSError * _Nullable error) {
                 if (success) {
                     [self.logger info:[NSString stringWithFormat:@"✅ [CloudXCore] Successfully initialized network: %@", mappedNetworkName]];
+                    // Warm the bid token so the first auction does not wait on the adapter SDK
+                    id<CLXBidTokenSource> tokenSource = self->_adNetworkFactories.bidTokenSources[mappedNetworkName];
+                    if (tokenSource) {
+                        [[CLXBidTokenCache shared] prefetchTokenForAdapter:mappedNetworkName source:tokenSource];
+                    }
                 } else {
                     [self.logger error:[NSString stringWithFormat:@"❌ [CloudXCore] Failed to initialize network: %@ - %@", mappedNetworkName, error.localizedDescription]];
                 }
@@ -371,6 +363,7 @@ static CloudXCore *_sharedInstance = nil;
     // Store app key, account ID, and URLs from SDK response
     [[NSUserDefaults standardUserDefaults] setValue:_appKey forKey:kCLXCoreAppKeyKey];
     [[NSUserDefaults standardUserDefaults] setValue:config.accountID forKey:kCLXCoreAccountIDKey];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
     [[NSUserDefaults standardUserDefaults] setValue:config.metricsEndpointURL forKey:kCLXCoreMetricsUrlKey];
     
     // Store impression tracker URL for Rill tracking
@@ -445,17 +438,7 @@ static CloudXCore *_sharedInstance = nil;
     _isInitialised = YES;
     [self.logger info:@"✅ [CloudXCore] SDK initialization completed successfully"];
     
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-    NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-    if ([metricsDict.allKeys containsObject:@"network_call_sdk_init_req"]) {
-        NSString *value = metricsDict[@"network_call_sdk_init_req"];
-        int number = [value intValue];
-        int new = number + 1;
-        metricsDict[@"network_call_sdk_init_req"] = [NSString stringWithFormat:@"%d", new];
-    } else {
-        metricsDict[@"network_call_sdk_init_req"] = @"1";
-    }
-    [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+    [[CLXCounterRegistry coreMetrics] incrementCounter:@"network_call_sdk_init_req"];
     
     
     [self startTimer];
@@ -496,18 +479,9 @@ static CloudXCore *_sharedInstance = nil;
     // Track hashed user ID method call
     id<CLXMetricsTrackerProtocol> metricsTracker = [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
     [metricsTracker trackMethodCall:CLXMetricsTypeMethodSetHashedUserId];
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-    NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-    if ([metricsDict.allKeys containsObject:@"method_set_hashed_user_id"]) {
-        NSString *value = metricsDict[@"method_set_hashed_user_id"];
-        int number = [value intValue];
-        int new = number + 1;
-        metricsDict[@"method_set_hashed_user_id"] = [NSString stringWithFormat:@"%d", new];
-    } else {
-        metricsDict[@"method_set_hashed_user_id"] = @"1";
-    }
-    [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+    [[CLXCounterRegistry coreMetrics] incrementCounter:@"method_set_hashed_user_id"];
     [[NSUserDefaults standardUserDefaults] setValue:hashedUserID forKey:kCLXCoreHashedUserIDKey];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
     [self.logger info:@"✅ [CloudXCore] Hashed user ID stored successfully"];
 }
 
@@ -524,18 +498,9 @@ static CloudXCore *_sharedInstance = nil;
     // Track user key-values method call
     id<CLXMetricsTrackerProtocol> metricsTracker = [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
     [metricsTracker trackMethodCall:CLXMetricsTypeMethodSetUserKeyValues];
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreMetricsDictKey];
-    NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-    if ([metricsDict.allKeys containsObject:@"method_set_user_key_values"]) {
-        NSString *value = metricsDict[@"method_set_user_key_values"];
-        int number = [value intValue];
-        int new = number + 1;
-        metricsDict[@"method_set_user_key_values"] = [NSString stringWithFormat:@"%d", new];
-    } else {
-        metricsDict[@"method_set_user_key_values"] = @"1";
-    }
-    [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreMetricsDictKey];
+    [[CLXCounterRegistry coreMetrics] incrementCounter:@"method_set_user_key_values"];
     [[NSUserDefaults standardUserDefaults] setObject:userDictionary forKey:kCLXCoreUserKeyValueKey];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
     [self.logger info:@"✅ [CloudXCore] User dictionary stored successfully"];
 }
 
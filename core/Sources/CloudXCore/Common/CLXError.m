@@ -8,6 +8,7 @@
 #import <CloudXCore/CLXError.h>
 
 NSString * const CLXErrorDomain = @"CLXErrorDomain";
+NSString * const CLXErrorHTTPStatusCodeKey = @"CLXErrorHTTPStatusCode";
 
 @implementation CLXError
 
@@ -52,7 +53,8 @@ NSString * const CLXErrorDomain = @"CLXErrorDomain";
             break;
     }
     
-    return [self errorWithCode:errorCode description:description];
+    return [self errorWithCode:errorCode userInfo:@{NSLocalizedDescriptionKey: description,
+                                                    CLXErrorHTTPStatusCodeKey: @(httpStatusCode)}];
 }
 
 + (instancetype)errorWithCode:(CLXErrorCode)code userInfo:(nullable NSDictionary *)userInfo {
@@ -122,6 +124,8 @@ NSString * const CLXErrorDomain = @"CLXErrorDomain";
             return @"Invalid response received from server.";
         case CLXErrorCodeServerError:
             return @"Server error occurred.";
+        case CLXErrorCodeServiceUnavailable:
+            return @"Server temporarily unavailable; request not sent.";
             
         // AD REQUEST/LOADING ERRORS (300-399)
         case CLXErrorCodeNoFill:
@@ -5,26 +5,90 @@
 #import "CLXSQLiteDatabase.h"
 #import <CloudXCore/CLXLogger.h>
 
+static const NSUInteger kCLXDefaultStatementCacheCapacity = 32;
+static NSString *const kCLXSharedDatabaseName = @"cloudx_sdk";
+
+// Rows per DELETE ... IN (...) statement; stays well under SQLITE_MAX_VARIABLE_NUMBER (999 on older system SQLite)
+static const NSUInteger kCLXDeleteChunkSize = 200;
+
+@implementation CLXSQLiteDatabaseConfiguration
+
++ (instancetype)defaultConfiguration {
+    CLXSQLiteDatabaseConfiguration *configuration = [[self alloc] init];
+    configuration.walJournalMode = YES;
+    configuration.synchronousNormal = YES;
+    configuration.tempStoreInMemory = YES;
+    configuration.mmapSizeBytes = 4 * 1024 * 1024;
+    configuration.pageCacheSizeKiB = 512;
+    return configuration;
+}
+
++ (instancetype)legacyConfiguration {
+    return [[self alloc] init];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    CLXSQLiteDatabaseConfiguration *copy = [[[self class] allocWithZone:zone] init];
+    copy.walJournalMode = self.walJournalMode;
+    copy.synchronousNormal = self.synchronousNormal;
+    copy.tempStoreInMemory = self.tempStoreInMemory;
+    copy.mmapSizeBytes = self.mmapSizeBytes;
+    copy.pageCacheSizeKiB = self.pageCacheSizeKiB;
+    return copy;
+}
+
+@end
+
 @interface CLXSQLiteDatabase ()
 @property (nonatomic, assign) sqlite3 *database;
 @property (nonatomic, copy) NSString *databaseName;
 @property (nonatomic, strong, readwrite) CLXLogger *logger;
 @property (nonatomic, strong, readwrite) dispatch_queue_t databaseQueue;
+@property (nonatomic, copy, readwrite) CLXSQLiteDatabaseConfiguration *configuration;
+
+// Prepared statement cache (accessed only on databaseQueue)
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSValue *> *statementCache;
+@property (nonatomic, strong) NSMutableArray<NSString *> *statementCacheOrder;
+
+// Set when a statement fails inside the open transaction (accessed only on databaseQueue)
+@property (nonatomic, assign) BOOL transactionFailed;
 
 // Private methods that run on the database queue
 - (BOOL)_openDatabase;
 - (BOOL)_executeSQL:(NSString *)sql withParameters:(nullable NSArray *)parameters;
+- (BOOL)_executeSQL:(NSString *)sql withParameters:(nullable NSArray *)parameters cacheable:(BOOL)cacheable;
 - (NSArray<NSDictionary *> *)_executeQuery:(NSString *)sql withParameters:(nullable NSArray *)parameters;
-- (void)_executeInTransaction:(void (^)(void))block;
+- (BOOL)_executeInTransaction:(void (^)(void))block;
 - (id)_dispatchSyncIfNeeded:(id (^)(void))block;
+- (nullable sqlite3_stmt *)_preparedStatementForSQL:(NSString *)sql;
+- (void)_releaseStatement:(sqlite3_stmt *)statement forSQL:(NSString *)sql;
+- (void)_finalizeAllCachedStatements;
 @end
 
 @implementation CLXSQLiteDatabase
 
++ (instancetype)sharedDatabase {
+    static CLXSQLiteDatabase *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[CLXSQLiteDatabase alloc] initWithDatabaseName:kCLXSharedDatabaseName];
+    });
+    return sharedInstance;
+}
+
 - (instancetype)initWithDatabaseName:(NSString *)databaseName {
+    return [self initWithDatabaseName:databaseName configuration:[CLXSQLiteDatabaseConfiguration defaultConfiguration]];
+}
+
+- (instancetype)initWithDatabaseName:(NSString *)databaseName
+                       configuration:(CLXSQLiteDatabaseConfiguration *)configuration {
     self = [super init];
     if (self) {
         _databaseName = [databaseName copy];
+        _configuration = [configuration copy] ?: [CLXSQLiteDatabaseConfiguration defaultConfiguration];
+        _statementCacheCapacity = kCLXDefaultStatementCacheCapacity;
+        _statementCache = [NSMutableDictionary dictionary];
+        _statementCacheOrder = [NSMutableArray array];
         _logger = [[CLXLogger alloc] initWithCategory:@"SQLiteDatabase"];
         _databaseQueue = dispatch_queue_create([[NSString stringWithFormat:@"com.cloudx.database.%@", databaseName] UTF8String], DISPATCH_QUEUE_SERIAL);
         
@@ -60,14 +124,51 @@
     
     // Enable foreign key constraints
     [self _executeSQL:@"PRAGMA foreign_keys = ON;" withParameters:@[]];
+    [self _applyConfiguration:self.configuration];
     
     [self.logger debug:[NSString stringWithFormat:@"Database opened successfully at %@", path]];
     return YES;
 }
 
+/**
+ * Applies connection pragmas. Failures are logged and leave SQLite defaults in place.
+ */
+- (void)_applyConfiguration:(CLXSQLiteDatabaseConfiguration *)configuration {
+    NSMutableArray<NSString *> *pragmas = [NSMutableArray array];
+    if (configuration.walJournalMode) {
+        [pragmas addObject:@"PRAGMA journal_mode = WAL;"];
+    }
+    if (configuration.synchronousNormal) {
+        [pragmas addObject:@"PRAGMA synchronous = NORMAL;"];
+    }
+    if (configuration.tempStoreInMemory) {
+        [pragmas addObject:@"PRAGMA temp_store = MEMORY;"];
+    }
+    if (configuration.mmapSizeBytes > 0) {
+        [pragmas addObject:[NSString stringWithFormat:@"PRAGMA mmap_size = %lld;", configuration.mmapSizeBytes]];
+    }
+    if (configuration.pageCacheSizeKiB > 0) {
+        [pragmas addObject:[NSString stringWithFormat:@"PRAGMA cache_size = -%ld;", (long)configuration.pageCacheSizeKiB]];
+    }
+    
+    for (NSString *pragma in pragmas) {
+        // One-shot statements; run them uncached so they don't occupy cache slots
+        sqlite3_exec(self->_database, [pragma UTF8String], NULL, NULL, NULL);
+    }
+    
+    if (configuration.walJournalMode) {
+        NSArray<NSDictionary *> *rows = [self _executeQuery:@"PRAGMA journal_mode;" withParameters:@[]];
+        NSString *mode = [rows.firstObject[@"journal_mode"] description];
+        if (![mode.lowercaseString isEqualToString:@"wal"]) {
+            [self.logger error:[NSString stringWithFormat:@"WAL journal mode unavailable, using %@", mode ?: @"(unknown)"]];
+        }
+    }
+}
+
 - (void)closeDatabase {
     [self _dispatchSyncIfNeeded:^id {
         if (self->_database) {
+            [self _finalizeAllCachedStatements];
             sqlite3_close(self->_database);
             self->_database = NULL;
             [self.logger debug:@"Database closed"];
@@ -93,27 +194,44 @@
 }
 
 - (BOOL)_executeSQL:(NSString *)sql withParameters:(nullable NSArray *)parameters {
+    return [self _executeSQL:sql withParameters:parameters cacheable:YES];
+}
+
+/**
+ * @param cacheable NO for SQL text that is unlikely to repeat, so it does not push reusable statements out of the cache
+ */
+- (BOOL)_executeSQL:(NSString *)sql withParameters:(nullable NSArray *)parameters cacheable:(BOOL)cacheable {
     if (![self _validateDatabaseState] || ![self _validateSQL:sql]) {
         return NO;
     }
     
-    sqlite3_stmt *statement;
-    int result = sqlite3_prepare_v2(self->_database, [sql UTF8String], -1, &statement, NULL);
-    
-    if (result != SQLITE_OK) {
+    sqlite3_stmt *statement = NULL;
+    if (cacheable) {
+        statement = [self _preparedStatementForSQL:sql];
+    } else if (sqlite3_prepare_v2(self->_database, [sql UTF8String], -1, &statement, NULL) != SQLITE_OK) {
+        sqlite3_finalize(statement);
+        statement = NULL;
+    }
+    if (!statement) {
         [self.logger error:[NSString stringWithFormat:@"Failed to prepare statement: %s", sqlite3_errmsg(self->_database)]];
+        [self _noteStatementFailure];
         return NO;
     }
     
     [self _bindParameters:parameters toStatement:statement];
     
-    result = sqlite3_step(statement);
-    sqlite3_finalize(statement);
+    int result = sqlite3_step(statement);
+    if (cacheable) {
+        [self _releaseStatement:statement forSQL:sql];
+    } else {
+        sqlite3_finalize(statement);
+    }
     
     if (result == SQLITE_DONE || result == SQLITE_ROW) {
         return YES;
     } else {
         [self.logger error:[NSString stringWithFormat:@"Failed to execute statement: %s", sqlite3_errmsg(self->_database)]];
+        [self _noteStatementFailure];
         return NO;
     }
 }
@@ -140,11 +258,10 @@
         return [results copy];
     }
     
-    sqlite3_stmt *statement;
-    int result = sqlite3_prepare_v2(self->_database, [sql UTF8String], -1, &statement, NULL);
-    
-    if (result != SQLITE_OK) {
+    sqlite3_stmt *statement = [self _preparedStatementForSQL:sql];
+    if (!statement) {
         [self.logger error:[NSString stringWithFormat:@"Failed to prepare query: %s", sqlite3_errmsg(self->_database)]];
+        [self _noteStatementFailure];
         return [results copy];
     }
     
@@ -164,32 +281,173 @@
         [results addObject:[row copy]];
     }
     
-    sqlite3_finalize(statement);
+    [self _releaseStatement:statement forSQL:sql];
     return [results copy];
 }
 
 #pragma mark - Transaction Support
 
-- (void)executeInTransaction:(void (^)(void))block {
-    [self _dispatchSyncIfNeeded:^id {
-        [self _executeInTransaction:block];
-        return nil;
+- (BOOL)executeInTransaction:(void (^)(void))block {
+    NSNumber *result = [self _dispatchSyncIfNeeded:^id {
+        return @([self _executeInTransaction:block]);
     }];
+    return result.boolValue;
 }
 
-- (void)_executeInTransaction:(void (^)(void))block {
-    [self _executeSQL:@"BEGIN TRANSACTION;" withParameters:@[]];
+- (BOOL)_executeInTransaction:(void (^)(void))block {
+    if (![self _validateDatabaseState]) {
+        return NO;
+    }
+    
+    // Already inside a transaction: join it instead of issuing a nested BEGIN.
+    // A failure in the joined block is reported here and also fails the outer transaction.
+    if (sqlite3_get_autocommit(self->_database) == 0) {
+        BOOL failedBefore = self.transactionFailed;
+        self.transactionFailed = NO;
+        block();
+        BOOL failed = self.transactionFailed;
+        self.transactionFailed = failedBefore || failed;
+        return !failed;
+    }
+    
+    if (![self _executeSQL:@"BEGIN TRANSACTION;" withParameters:@[]]) {
+        [self.logger error:[NSString stringWithFormat:@"Failed to begin transaction: %s", sqlite3_errmsg(self->_database)]];
+        return NO;
+    }
+    self.transactionFailed = NO;
     
     @try {
         block();
-        [self _executeSQL:@"COMMIT;" withParameters:@[]];
+        if (self.transactionFailed) {
+            [self _rollbackIfNeeded];
+            [self.logger error:@"Transaction rolled back after a failed statement"];
+            return NO;
+        }
+        if (![self _executeSQL:@"COMMIT;" withParameters:@[]]) {
+            [self _rollbackIfNeeded];
+            return NO;
+        }
+        return YES;
     } @catch (NSException *exception) {
-        [self _executeSQL:@"ROLLBACK;" withParameters:@[]];
+        [self _rollbackIfNeeded];
         [self.logger error:[NSString stringWithFormat:@"Transaction rolled back due to exception: %@", exception]];
         @throw exception;
+    } @finally {
+        self.transactionFailed = NO;
+    }
+}
+
+- (void)_rollbackIfNeeded {
+    // The block may already have ended the transaction itself
+    if (sqlite3_get_autocommit(self->_database) == 0) {
+        sqlite3_exec(self->_database, "ROLLBACK;", NULL, NULL, NULL);
     }
 }
 
+- (void)_noteStatementFailure {
+    if (self->_database && sqlite3_get_autocommit(self->_database) == 0) {
+        self.transactionFailed = YES;
+    }
+}
+
+#pragma mark - Batched Deletes
+
+- (BOOL)deleteFromTable:(NSString *)tableName whereColumn:(NSString *)columnName inValues:(NSArray *)values {
+    if (values.count == 0) {
+        return YES;
+    }
+    if (tableName.length == 0 || columnName.length == 0) {
+        return NO;
+    }
+    
+    NSString *quotedTable = [tableName stringByReplacingOccurrencesOfString:@"\"" withString:@"\"\""];
+    NSString *quotedColumn = [columnName stringByReplacingOccurrencesOfString:@"\"" withString:@"\"\""];
+    return [self executeInTransaction:^{
+        for (NSUInteger start = 0; start < values.count; start += kCLXDeleteChunkSize) {
+            NSUInteger length = MIN(kCLXDeleteChunkSize, values.count - start);
+            NSMutableString *placeholders = [NSMutableString stringWithCapacity:length * 2];
+            for (NSUInteger i = 0; i < length; i++) {
+                [placeholders appendString:(i == 0 ? @"?" : @",?")];
+            }
+            NSString *deleteSQL = [NSString stringWithFormat:@"DELETE FROM \"%@\" WHERE \"%@\" IN (%@);", quotedTable, quotedColumn, placeholders];
+            // Only full chunks share SQL text; the shorter tail would churn the statement cache
+            [self _executeSQL:deleteSQL
+               withParameters:[values subarrayWithRange:NSMakeRange(start, length)]
+                    cacheable:length == kCLXDeleteChunkSize];
+        }
+    }];
+}
+
+#pragma mark - Statement Cache
+
+- (void)setStatementCacheCapacity:(NSUInteger)statementCacheCapacity {
+    [self _dispatchSyncIfNeeded:^id {
+        self->_statementCacheCapacity = statementCacheCapacity;
+        while (self.statementCacheOrder.count > statementCacheCapacity) {
+            [self _evictLeastRecentlyUsedStatement];
+        }
+        return nil;
+    }];
+}
+
+/**
+ * Returns a ready-to-bind statement for the given SQL, reusing a cached one when available.
+ * Cached statements are removed from the cache while in use and returned by _releaseStatement:forSQL:.
+ */
+- (nullable sqlite3_stmt *)_preparedStatementForSQL:(NSString *)sql {
+    NSValue *cached = self.statementCache[sql];
+    if (cached) {
+        [self.statementCache removeObjectForKey:sql];
+        [self.statementCacheOrder removeObject:sql];
+        return (sqlite3_stmt *)cached.pointerValue;
+    }
+    
+    sqlite3_stmt *statement = NULL;
+    if (sqlite3_prepare_v2(self->_database, [sql UTF8String], -1, &statement, NULL) != SQLITE_OK) {
+        sqlite3_finalize(statement);
+        return NULL;
+    }
+    return statement;
+}
+
+/**
+ * Resets a statement after use and puts it back in the cache, or finalizes it when caching is disabled
+ */
+- (void)_releaseStatement:(sqlite3_stmt *)statement forSQL:(NSString *)sql {
+    if (self.statementCacheCapacity == 0 || self.statementCache[sql] != nil) {
+        sqlite3_finalize(statement);
+        return;
+    }
+    
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    
+    while (self.statementCacheOrder.count >= self.statementCacheCapacity) {
+        [self _evictLeastRecentlyUsedStatement];
+    }
+    NSString *key = [sql copy];
+    self.statementCache[key] = [NSValue valueWithPointer:statement];
+    [self.statementCacheOrder addObject:key];
+}
+
+- (void)_evictLeastRecentlyUsedStatement {
+    NSString *oldestSQL = self.statementCacheOrder.firstObject;
+    if (!oldestSQL) {
+        return;
+    }
+    [self.statementCacheOrder removeObjectAtIndex:0];
+    sqlite3_finalize((sqlite3_stmt *)self.statementCache[oldestSQL].pointerValue);
+    [self.statementCache removeObjectForKey:oldestSQL];
+}
+
+- (void)_finalizeAllCachedStatements {
+    for (NSValue *value in self.statementCache.allValues) {
+        sqlite3_finalize((sqlite3_stmt *)value.pointerValue);
+    }
+    [self.statementCache removeAllObjects];
+    [self.statementCacheOrder removeAllObjects];
+}
+
 #pragma mark - Utility Methods
 
 - (NSString *)databasePath {
@@ -209,6 +467,91 @@
     return results.count > 0;
 }
 
+- (BOOL)importTable:(NSString *)tableName fromLegacyDatabaseNamed:(NSString *)legacyDatabaseName {
+    if (tableName.length == 0 || legacyDatabaseName.length == 0 || [legacyDatabaseName isEqualToString:self.databaseName]) {
+        return NO;
+    }
+    
+    NSString *documentsDirectory = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *legacyPath = [documentsDirectory stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.sqlite", legacyDatabaseName]];
+    if (![[NSFileManager defaultManager] fileExistsAtPath:legacyPath]) {
+        return NO;
+    }
+    
+    NSNumber *result = [self _dispatchSyncIfNeeded:^id {
+        if (![self _validateDatabaseState]) {
+            return @NO;
+        }
+        
+        // ATTACH/DETACH are connection-level and not worth caching
+        NSString *attachSQL = [NSString stringWithFormat:@"ATTACH DATABASE '%@' AS legacy;",
+                               [legacyPath stringByReplacingOccurrencesOfString:@"'" withString:@"''"]];
+        if (sqlite3_exec(self->_database, [attachSQL UTF8String], NULL, NULL, NULL) != SQLITE_OK) {
+            [self.logger error:[NSString stringWithFormat:@"Failed to attach legacy database %@: %s", legacyDatabaseName, sqlite3_errmsg(self->_database)]];
+            return @NO;
+        }
+        
+        NSString *quotedTable = [tableName stringByReplacingOccurrencesOfString:@"\"" withString:@"\"\""];
+        BOOL imported = YES;
+        NSArray *legacyTable = [self _executeQuery:@"SELECT name FROM legacy.sqlite_master WHERE type='table' AND name = ?;" withParameters:@[tableName]];
+        if (legacyTable.count > 0) {
+            // The schemas may have drifted (columns added since); copy only the columns both tables have
+            NSString *columns = [self _sharedColumnListForTable:quotedTable];
+            if (columns.length > 0) {
+                NSString *copySQL = [NSString stringWithFormat:@"INSERT OR IGNORE INTO main.\"%@\" (%@) SELECT %@ FROM legacy.\"%@\";",
+                                     quotedTable, columns, columns, quotedTable];
+                imported = sqlite3_exec(self->_database, [copySQL UTF8String], NULL, NULL, NULL) == SQLITE_OK;
+            }
+            if (imported) {
+                NSString *dropSQL = [NSString stringWithFormat:@"DROP TABLE legacy.\"%@\";", quotedTable];
+                imported = sqlite3_exec(self->_database, [dropSQL UTF8String], NULL, NULL, NULL) == SQLITE_OK;
+            }
+        }
+        NSArray *remainingTables = [self _executeQuery:@"SELECT name FROM legacy.sqlite_master WHERE type='table';" withParameters:@[]];
+        
+        [self _finalizeAllCachedStatements]; // Statements referencing "legacy" must not outlive the attachment
+        sqlite3_exec(self->_database, "DETACH DATABASE legacy;", NULL, NULL, NULL);
+        
+        if (!imported) {
+            [self.logger error:[NSString stringWithFormat:@"Failed to import %@ from %@: %s", tableName, legacyDatabaseName, sqlite3_errmsg(self->_database)]];
+            return @NO;
+        }
+        
+        if (remainingTables.count == 0) {
+            for (NSString *suffix in @[@"", @"-wal", @"-shm", @"-journal"]) {
+                [[NSFileManager defaultManager] removeItemAtPath:[legacyPath stringByAppendingString:suffix] error:nil];
+            }
+        }
+        [self.logger debug:[NSString stringWithFormat:@"Imported %@ from legacy database %@", tableName, legacyDatabaseName]];
+        return @YES;
+    }];
+    return result.boolValue;
+}
+
+/**
+ * Quoted, comma-separated names of the columns present in both main and legacy copies of a table,
+ * in the main table's order. Empty when they share none. Runs on the database queue with "legacy" attached.
+ */
+- (NSString *)_sharedColumnListForTable:(NSString *)quotedTable {
+    NSMutableSet<NSString *> *legacyColumns = [NSMutableSet set];
+    NSString *legacyInfoSQL = [NSString stringWithFormat:@"PRAGMA legacy.table_info(\"%@\");", quotedTable];
+    for (NSDictionary *column in [self _executeQuery:legacyInfoSQL withParameters:@[]]) {
+        if ([column[@"name"] isKindOfClass:[NSString class]]) {
+            [legacyColumns addObject:column[@"name"]];
+        }
+    }
+    
+    NSMutableArray<NSString *> *shared = [NSMutableArray array];
+    NSString *mainInfoSQL = [NSString stringWithFormat:@"PRAGMA main.table_info(\"%@\");", quotedTable];
+    for (NSDictionary *column in [self _executeQuery:mainInfoSQL withParameters:@[]]) {
+        NSString *name = column[@"name"];
+        if ([name isKindOfClass:[NSString class]] && [legacyColumns containsObject:name]) {
+            [shared addObject:[NSString stringWithFormat:@"\"%@\"", [name stringByReplacingOccurrencesOfString:@"\"" withString:@"\"\""]]];
+        }
+    }
+    return [shared componentsJoinedByString:@", "];
+}
+
 #pragma mark - Private Helper Methods
 
 /**
@@ -9,6 +9,7 @@
 
 #import <CloudXCore/CLXBidResponse.h>
 #import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXError.h>
 
 static CLXLogger *logger;
 
@@ -53,50 +54,115 @@ static void initializeLogger() {
 @implementation CLXBidResponseResponseExt
 @end
 
+// MARK: - Bid Index
+
+/**
+ * Immutable lookup tables over one seatbid array
+ */
+@interface CLXBidResponseIndex : NSObject
+@property (nonatomic, copy, readonly) NSArray<CLXBidResponseBid *> *bids;
+@property (nonatomic, copy, readonly) NSArray<CLXBidResponseBid *> *bidsByRank;
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, CLXBidResponseBid *> *bidsByID;
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSArray<CLXBidResponseBid *> *> *bidsByImpID;
+- (instancetype)initWithSeatBids:(nullable NSArray<CLXBidResponseSeatBid *> *)seatBids;
+@end
+
+@implementation CLXBidResponseIndex
+
+- (instancetype)initWithSeatBids:(nullable NSArray<CLXBidResponseSeatBid *> *)seatBids {
+    self = [super init];
+    if (self) {
+        NSMutableArray<CLXBidResponseBid *> *bids = [NSMutableArray array];
+        NSMutableDictionary<NSString *, CLXBidResponseBid *> *bidsByID = [NSMutableDictionary dictionary];
+        NSMutableDictionary<NSString *, NSMutableArray<CLXBidResponseBid *> *> *bidsByImpID = [NSMutableDictionary dictionary];
+        for (CLXBidResponseSeatBid *seatBid in seatBids) {
+            for (CLXBidResponseBid *bid in seatBid.bid) {
+                [bids addObject:bid];
+                // The first bid with a given id wins, as with the former linear scan
+                if (bid.id && !bidsByID[bid.id]) {
+                    bidsByID[bid.id] = bid;
+                }
+                if (bid.impid) {
+                    NSMutableArray<CLXBidResponseBid *> *impBids = bidsByImpID[bid.impid];
+                    if (!impBids) {
+                        impBids = [NSMutableArray array];
+                        bidsByImpID[bid.impid] = impBids;
+                    }
+                    [impBids addObject:bid];
+                }
+            }
+        }
+        
+        // Sort bids by rank (ascending) for waterfall loading; equal ranks keep response order
+        _bidsByRank = [bids sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(CLXBidResponseBid *bid1, CLXBidResponseBid *bid2) {
+            NSInteger rank1 = bid1.ext.cloudx.rank;
+            NSInteger rank2 = bid2.ext.cloudx.rank;
+            
+            if (rank1 < rank2) {
+                return NSOrderedAscending;
+            } else if (rank1 > rank2) {
+                return NSOrderedDescending;
+            } else {
+                return NSOrderedSame;
+            }
+        }];
+        _bids = [bids copy];
+        _bidsByID = [bidsByID copy];
+        NSMutableDictionary<NSString *, NSArray<CLXBidResponseBid *> *> *frozenImpBids = [NSMutableDictionary dictionaryWithCapacity:bidsByImpID.count];
+        [bidsByImpID enumerateKeysAndObjectsUsingBlock:^(NSString *impID, NSMutableArray<CLXBidResponseBid *> *impBids, BOOL *stop) {
+            frozenImpBids[impID] = [impBids copy];
+        }];
+        _bidsByImpID = [frozenImpBids copy];
+    }
+    return self;
+}
+
+@end
+
 // MARK: - Main Bid Response Implementation
+@interface CLXBidResponse ()
+@property (nonatomic, strong) CLXBidResponseIndex *bidIndex;
+@property (nonatomic, copy, readwrite, nullable) NSData *rawData;
+@end
+
 @implementation CLXBidResponse
 
-- (NSArray<CLXBidResponseBid *> *)allBids {
-    NSMutableArray<CLXBidResponseBid *> *allBids = [NSMutableArray array];
-    for (CLXBidResponseSeatBid *seatBid in self.seatbid) {
-        [allBids addObjectsFromArray:seatBid.bid];
+- (void)setSeatbid:(NSArray<CLXBidResponseSeatBid *> *)seatbid {
+    @synchronized (self) {
+        _seatbid = seatbid;
+        _bidIndex = nil;
+    }
+}
+
+- (CLXBidResponseIndex *)bidIndex {
+    @synchronized (self) {
+        if (!_bidIndex) {
+            _bidIndex = [[CLXBidResponseIndex alloc] initWithSeatBids:_seatbid];
+        }
+        return _bidIndex;
     }
-    return [allBids copy];
+}
+
+- (NSArray<CLXBidResponseBid *> *)allBids {
+    return self.bidIndex.bids;
 }
 
 - (nullable CLXBidResponseBid *)findBidWithID:(NSString *)bidID {
     if (!bidID) {
         return nil;
     }
-    
-    NSArray<CLXBidResponseBid *> *allBids = [self allBids];
-    for (CLXBidResponseBid *bid in allBids) {
-        if ([bid.id isEqualToString:bidID]) {
-            return bid;
-        }
+    return self.bidIndex.bidsByID[bidID];
+}
+
+- (NSArray<CLXBidResponseBid *> *)bidsForImpID:(NSString *)impID {
+    if (!impID) {
+        return @[];
     }
-    
-    return nil;
+    return self.bidIndex.bidsByImpID[impID] ?: @[];
 }
 
 - (NSArray<CLXBidResponseBid *> *)getAllBidsForWaterfall {
-    NSArray<CLXBidResponseBid *> *allBids = [self allBids];
-    
-    // Sort bids by rank (ascending) for waterfall loading
-    NSArray<CLXBidResponseBid *> *sortedBids = [allBids sortedArrayUsingComparator:^NSComparisonResult(CLXBidResponseBid *bid1, CLXBidResponseBid *bid2) {
-        NSInteger rank1 = bid1.ext.cloudx.rank;
-        NSInteger rank2 = bid2.ext.cloudx.rank;
-        
-        if (rank1 < rank2) {
-            return NSOrderedAscending;
-        } else if (rank1 > rank2) {
-            return NSOrderedDescending;
-        } else {
-            return NSOrderedSame;
-        }
-    }];
-    
-    return sortedBids;
+    return self.bidIndex.bidsByRank;
 }
 
 #pragma mark - Marshaling Methods
@@ -148,6 +214,9 @@ static void initializeLogger() {
     [self addStringFieldToDict:bidDict key:@"dealid" value:bid.dealid];
     [self addNumericFieldToDict:bidDict key:@"w" value:@(bid.w)];
     [self addNumericFieldToDict:bidDict key:@"h" value:@(bid.h)];
+    if (bid.exp > 0) {
+        [self addNumericFieldToDict:bidDict key:@"exp" value:@(bid.exp)];
+    }
     [self addStringFieldToDict:bidDict key:@"adm" value:bid.adm];
     [self addStringFieldToDict:bidDict key:@"nurl" value:bid.nurl];
     [self addStringFieldToDict:bidDict key:@"lurl" value:bid.lurl];
@@ -232,11 +301,34 @@ static void initializeLogger() {
         }
         response.seatbid = [seatbids copy];
     }
+    // Index once up front; the waterfall, win/loss and LURL code all read from it
+    [response bidIndex];
     
     [logger info:[NSString stringWithFormat:@"✅ [BidResponse] Successfully parsed bid response with %lu seatbids", (unsigned long)response.seatbid.count]];
     return response;
 }
 
++ (nullable instancetype)parseBidResponseFromData:(NSData *)data error:(NSError * _Nullable * _Nullable)error {
+    CLXBidResponse *response = nil;
+    NSError *jsonError = nil;
+    // Drain the JSON objects here rather than in the caller's pool
+    @autoreleasepool {
+        id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonError];
+        if ([json isKindOfClass:[NSDictionary class]]) {
+            response = [self parseBidResponseFromDictionary:json];
+        }
+    }
+    if (!response) {
+        [logger error:[NSString stringWithFormat:@"❌ [BidResponse] Response body is not a JSON object: %@", jsonError.localizedDescription ?: @"unexpected type"]];
+        if (error) {
+            *error = jsonError ?: [CLXError errorWithCode:CLXErrorCodeInvalidResponse description:@"Bid response is not a JSON object"];
+        }
+        return nil;
+    }
+    response.rawData = data;
+    return response;
+}
+
 @end
 
 // MARK: - Parsing Functions
@@ -300,6 +392,9 @@ static void initializeLogger() {
     id hValue = dictionary[@"h"];
     bid.h = (hValue && ![hValue isKindOfClass:[NSNull class]]) ? [hValue integerValue] : 0;
     
+    id expValue = dictionary[@"exp"];
+    bid.exp = (expValue && ![expValue isKindOfClass:[NSNull class]]) ? [expValue integerValue] : 0;
+    
     // Parse optional fields with NSNull safety
     id abTestIdValue = dictionary[@"abTestId"];
     if (abTestIdValue && ![abTestIdValue isKindOfClass:[NSNull class]]) {
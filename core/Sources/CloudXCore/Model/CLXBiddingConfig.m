@@ -410,21 +410,8 @@ static void initializeLogger() {
         json[@"tmax"] = self.tmax;
     }
     
-    // Debug logging
-    [logger debug:[NSString stringWithFormat:@"🔧 [ObjC-BiddingConfig] Final bid request - Keys: %@, Imp count: %lu", [json allKeys], (unsigned long)[json[@"imp"] count]]];
-    
-    // Log the complete JSON structure
-    NSError *error;
-    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:json options:NSJSONWritingPrettyPrinted error:&error];
-    if (error) {
-        [logger error:[NSString stringWithFormat:@"❌ [ObjC-BiddingConfig] JSON serialization error: %@", error]];
-    } else {
-        NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-        [logger info:[NSString stringWithFormat:@"🔧 [ObjC-BiddingConfig] Complete Bid Request JSON:"]];
-        [logger info:[NSString stringWithFormat:@"🔧 [ObjC-BiddingConfig] ========================================"]];
-        [logger info:[NSString stringWithFormat:@"%@", jsonString]];
-        [logger info:[NSString stringWithFormat:@"🔧 [ObjC-BiddingConfig] ========================================"]];
-    }
+    // The encoded body is available from CLXPayloadCapture once the request is sent
+    CLX_LOG_DEBUG(logger, @"🔧 [ObjC-BiddingConfig] Final bid request - Keys: %@, Imp count: %lu", [json allKeys], (unsigned long)[json[@"imp"] count]);
     
     return [json copy];
 }
@@ -15,6 +15,9 @@
         _bidResponseTimeoutMs = 3000;
         _adLoadTimeoutMs = 10000;
         _bannerRefreshRateMs = 30000;
+        _hedgedLoadConcurrency = 1;
+        _hedgedLoadDelayMs = 0;
+        _cacheReadinessTarget = 0.9;
         _type = SDKConfigAdTypeUnknown;
         _hasCloseButton = NO;
         _firstImpressionPlacementSuffix = nil;
@@ -11,6 +11,7 @@
 
 #import <CloudXCore/CLXAdapterBanner.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
+#import <CloudXCore/CLXCounterRegistry.h>
 #import <CloudXCore/CLXAdapterBannerFactory.h>
 #import <CloudXCore/CLXBannerType.h>
 #import <CloudXCore/CLXSDKConfigPlacement.h>
@@ -85,6 +86,9 @@ NS_ASSUME_NONNULL_BEGIN
 // Rill tracking service for analytics events
 @property (nonatomic, strong) CLXRillTrackingService *rillTrackingService;
 @property (nonatomic, strong) id<CLXAppSessionService> appSessionService;
+// Hedged loading: outstanding adapter loads and whether the waterfall already reported losses
+@property (nonatomic, strong) NSMapTable<id<CLXAdapterBanner>, CLXHedgedLoadCompletion> *hedgedLoads;
+@property (nonatomic, assign) BOOL lossesReportedByWaterfall;
 
 
 @end
@@ -136,6 +140,9 @@ NS_ASSUME_NONNULL_BEGIN
         _successWin = NO;
         _autoRefreshEnabled = YES; // Auto-refresh is enabled by default
         _loadBannerTimesCount = 0;
+        _hedgedLoads = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+        _lossesReportedByWaterfall = NO;
         // Initialize Rill tracking service
         _rillTrackingService = [[CLXRillTrackingService alloc] initWithReportingService:reportingService];
         
@@ -185,6 +192,9 @@ NS_ASSUME_NONNULL_BEGIN
                                               hasClosedButton:hasCloseButton
                                                       network:network];
         }];
+        CLXBidAdSource *bidAdSource = (CLXBidAdSource *)_bidAdSource;
+        bidAdSource.maxConcurrentLoads = placement.hedgedLoadConcurrency;
+        bidAdSource.hedgeDelay = placement.hedgedLoadDelayMs / 1000.0;
         
         [_logger debug:[NSString stringWithFormat:@"Initialized PublisherBanner for placement: %@", _placementID]];
     }
@@ -235,6 +245,13 @@ NS_ASSUME_NONNULL_BEGIN
     
     // Use placement ID directly as stored impression ID
     NSString *storedImpressionId = self.placementID;
+    
+    if (self.placement.hedgedLoadConcurrency > 1 &&
+        [self.bidAdSource respondsToSelector:@selector(requestBidWithAdUnitID:storedImpressionId:impModel:successWin:adapterLoader:canceller:completion:)]) {
+        [self requestHedgedBannerUpdateWithStoredImpressionId:storedImpressionId];
+        return;
+    }
+    
     // Request bid from bid ad source
     __weak typeof(self) weakSelf = self;
     [self.bidAdSource requestBidWithAdUnitID:self.placementID
@@ -279,17 +296,7 @@ NS_ASSUME_NONNULL_BEGIN
                                                              placementID:storedImpressionId
                                                                loadCount:0];
         
-        NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreBannerMetricsDictKey];
-        NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-        if ([metricsDict.allKeys containsObject:@"method_banner_refresh"]) {
-            NSString *value = metricsDict[@"method_banner_refresh"];
-            int number = [value intValue];
-            int new = number + 1;
-            metricsDict[@"method_banner_refresh"] = [NSString stringWithFormat:@"%d", new];
-        } else {
-            metricsDict[@"method_banner_refresh"] = @"1";
-        }
-        [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreBannerMetricsDictKey];
+        [strongSelf trackBannerRefresh];
     
         // Increment load counter
         strongSelf.loadBannerTimesCount += 1;
@@ -299,6 +306,77 @@ NS_ASSUME_NONNULL_BEGIN
     }];
 }
 
+/**
+ * Bid request where the top bids' banners load in parallel (placement.hedgedLoadConcurrency > 1).
+ * The bid source picks the winner and reports every bid's win/loss; the winner then takes the
+ * regular didLoadBanner path.
+ */
+- (void)requestHedgedBannerUpdateWithStoredImpressionId:(NSString *)storedImpressionId {
+    [self.logger debug:[NSString stringWithFormat:@"🔧 [PublisherBanner] Hedged bid request - %ld concurrent loads, %lld ms hedge delay", (long)self.placement.hedgedLoadConcurrency, self.placement.hedgedLoadDelayMs]];
+    
+    __weak typeof(self) weakSelf = self;
+    [self.bidAdSource requestBidWithAdUnitID:self.placementID
+                           storedImpressionId:storedImpressionId
+                                    impModel:self.impModel
+                                   successWin:self.successWin
+                                adapterLoader:^(CLXBidAdSourceResponse *candidate, id adapter, CLXHedgedLoadCompletion done) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf.forceStop || ![adapter conformsToProtocol:@protocol(CLXAdapterBanner)]) {
+            done([CLXError errorWithCode:CLXErrorCodeLoadFailed description:@"Banner adapter creation failed"]);
+            return;
+        }
+        id<CLXAdapterBanner> banner = (id<CLXAdapterBanner>)adapter;
+        if (strongSelf.hedgedLoads.count == 0) {
+            strongSelf.adLoadStartTime = [NSDate date];
+        }
+        [strongSelf.logger debug:[NSString stringWithFormat:@"🔧 [PublisherBanner] Hedged load of %@ (bidID: %@)", candidate.networkName, candidate.bidID]];
+        banner.timeout = NO;
+        [strongSelf.hedgedLoads setObject:done forKey:banner];
+        [banner load];
+    }
+                                    canceller:^(id adapter) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        id<CLXAdapterBanner> banner = (id<CLXAdapterBanner>)adapter;
+        [strongSelf.hedgedLoads removeObjectForKey:banner];
+        banner.delegate = nil;
+        [banner destroy];
+    }
+                                   completion:^(CLXBidAdSourceResponse * _Nullable response, id _Nullable adapter, NSError * _Nullable error) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf.forceStop) {
+            [(id<CLXAdapterBanner>)adapter destroy];
+            return;
+        }
+        
+        if (!response || !adapter) {
+            [strongSelf.logger error:[NSString stringWithFormat:@"❌ [PublisherBanner] Hedged waterfall failed - %@", error.localizedDescription]];
+            // Every bid's loss was already reported by the waterfall
+            strongSelf.lastBidResponse = nil;
+            strongSelf.currentBidResponse = nil;
+            [strongSelf failToLoadBanner:nil error:error];
+            return;
+        }
+        
+        [strongSelf.logger info:[NSString stringWithFormat:@"✅ [PublisherBanner] Hedged waterfall winner - Network: %@, BidID: %@, Price: %.2f", response.networkName, response.bidID, response.price]];
+        strongSelf.lastBidResponse = response;
+        strongSelf.currentBidResponse = [strongSelf.bidAdSource getCurrentBidResponse];
+        [strongSelf.rillTrackingService setupTrackingDataFromBidResponse:response
+                                                                impModel:strongSelf.impModel
+                                                             placementID:storedImpressionId
+                                                               loadCount:0];
+        [strongSelf trackBannerRefresh];
+        strongSelf.loadBannerTimesCount += 1;
+        
+        strongSelf.currentLoadingBanner = (id<CLXAdapterBanner>)adapter;
+        strongSelf.lossesReportedByWaterfall = YES;
+        [strongSelf didLoadBanner:(id<CLXAdapterBanner>)adapter];
+    }];
+}
+
+- (void)trackBannerRefresh {
+    [[CLXCounterRegistry bannerMetrics] incrementCounter:@"method_banner_refresh"];
+}
+
 - (void)continueBannerChain {
     [self.logger debug:[NSString stringWithFormat:@"🔧 [PublisherBanner] continueBannerChain() called for placement: %@ (forceStop:%d, loading:%d, hasResponse:%d, hasCreateBidAd:%d)", self.placementID, self.forceStop, self.isLoading, self.lastBidResponse != nil, self.lastBidResponse.createBidAd != nil]];
     
@@ -423,6 +501,14 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)didLoadBanner:(id<CLXAdapterBanner>)banner {
     [self.logger info:[NSString stringWithFormat:@"✅ [PublisherBanner] didLoadBanner called for placement: %@ (class: %@, timeout: %d)", self.placementID, NSStringFromClass([(NSObject *)banner class]), banner.timeout]];
 
+    // Hedged loads report to the waterfall, which decides the winner
+    CLXHedgedLoadCompletion hedgedLoad = banner ? [self.hedgedLoads objectForKey:banner] : nil;
+    if (hedgedLoad) {
+        [self.hedgedLoads removeObjectForKey:banner];
+        hedgedLoad(nil);
+        return;
+    }
+
     if (banner.timeout) {
         [banner destroy];
         return;
@@ -437,19 +523,13 @@ NS_ASSUME_NONNULL_BEGIN
     
     // SECOND PHASE - Winner has successfully loaded, now fire lurls for all losing bids
     // All remaining bids that could create banners but lost to this winner get LostToHigherBid
-    [self fireLosingBidLurls];
-    
-    NSDictionary *metricsDictionary = [[NSUserDefaults standardUserDefaults] dictionaryForKey:kCLXCoreBannerMetricsDictKey];
-    NSMutableDictionary* metricsDict = [metricsDictionary mutableCopy];
-    if ([metricsDict.allKeys containsObject:@"method_create_banner"]) {
-        NSString *value = metricsDict[@"method_create_banner"];
-        int number = [value intValue];
-        int new = number + 1;
-        metricsDict[@"method_create_banner"] = [NSString stringWithFormat:@"%d", new];
+    if (self.lossesReportedByWaterfall) {
+        self.lossesReportedByWaterfall = NO;
     } else {
-        metricsDict[@"method_create_banner"] = @"1";
+        [self fireLosingBidLurls];
     }
-    [[NSUserDefaults standardUserDefaults] setObject:metricsDict forKey:kCLXCoreBannerMetricsDictKey];
+    
+    [[CLXCounterRegistry bannerMetrics] incrementCounter:@"method_create_banner"];
 
     [self.logger debug:@"🔧 [PublisherBanner] Cleaning up previous banner..."];
     if (self.previousBanner) {
@@ -526,6 +606,13 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)failToLoadBanner:(nullable id<CLXAdapterBanner>)banner error:(nullable NSError *)error {
     [self.logger error:[NSString stringWithFormat:@"❌ [PublisherBanner] failToLoadBanner for placement: %@ - %@", self.placementID, error.localizedDescription ?: @"Unknown error"]];
     
+    CLXHedgedLoadCompletion hedgedLoad = banner ? [self.hedgedLoads objectForKey:banner] : nil;
+    if (hedgedLoad) {
+        [self.hedgedLoads removeObjectForKey:banner];
+        hedgedLoad(error ?: [CLXError errorWithCode:CLXErrorCodeLoadFailed description:@"Banner failed to load"]);
+        return;
+    }
+    
     [self.appSessionService adFailedToLoadWithPlacementID:self.placementID];
 
     // Destroy the failed banner
@@ -678,6 +765,13 @@ NS_ASSUME_NONNULL_BEGIN
         self.bannerOnScreen = nil;
     }
     
+    // Clean up hedged loads still in flight
+    for (id<CLXAdapterBanner> banner in [[self.hedgedLoads keyEnumerator] allObjects]) {
+        banner.delegate = nil;
+        [banner destroy];
+    }
+    [self.hedgedLoads removeAllObjects];
+    
     // Clean up loading banner
     if (self.currentLoadingBanner) {
         [self.currentLoadingBanner destroy];
@@ -6,8 +6,10 @@
 #import <CloudXCore/CLXBidResponse.h>
 #import <CloudXCore/CLXTrackingFieldResolver.h>
 #import <CloudXCore/CLXConfigImpressionModel.h>
+#import <CloudXCore/CLXSDKConfig.h>
 #import <CloudXCore/URLSession+CLX.h>
 #import <CloudXCore/CLXBiddingConfig.h>
+#import <CloudXCore/CLXBidRequestTemplate.h>
 #import <CloudXCore/CLXError.h>
 #import <CloudXCore/CLXSettings.h>
 #import <CloudXCore/CLXUserDefaultsKeys.h>
@@ -26,6 +28,7 @@
 @property (nonatomic, strong) CLXLogger *logger;
 @property (nonatomic, copy) NSString *userAgent;
 @property (nonatomic, strong, nullable) CLXErrorReporter *errorReporter;
+@property (nonatomic, strong) CLXBidRequestTemplateCache *templateCache;
 @end
 
 @interface CLXBidNetworkServiceClass (ErrorReporting)
@@ -61,6 +64,8 @@
         _isCDPEndpointEmpty = cdpEndpointUrl.length == 0;
         _logger = [[CLXLogger alloc] initWithCategory:@"BidNetworkService"];
         _errorReporter = errorReporter;
+        _templateCache = [[CLXBidRequestTemplateCache alloc] init];
+        _retainsRawResponse = YES;
         
         // Initialize user agent like Swift SDK
         _userAgent = [self generateUserAgent];
@@ -86,8 +91,63 @@
                             impModel:(nullable CLXConfigImpressionModel *)impModel
                            completion:(void (^)(id _Nullable, NSError * _Nullable))completion {
     
-    [self.logger debug:[NSString stringWithFormat:@"🔧 [BidNetworkService] Creating bid request - AdUnit: %@, Type: %d", adUnitID, (int)adType]];
+    CLX_LOG_DEBUG(self.logger, @"🔧 [BidNetworkService] Creating bid request - AdUnit: %@, Type: %d", adUnitID, (int)adType);
     
+    // Everything except id, imp.id, tmax and adapter tokens is fixed per placement until an input changes
+    NSString *templateKey = [NSString stringWithFormat:@"%d|%@|%@|%@|%@", (int)adType, adUnitID, storedImpressionId, publisherID, impModel.sdkConfig.appID];
+    CLXBidRequestTemplate *requestTemplate = [self.templateCache templateForKey:templateKey];
+    if (requestTemplate && !(requestTemplate.nativeAdRequirements == nativeAdRequirements || [requestTemplate.nativeAdRequirements isEqual:nativeAdRequirements])) {
+        requestTemplate = nil;
+    }
+    if (!requestTemplate) {
+        NSDictionary *fullRequest = [self buildBidRequestJSONWithAdUnitID:adUnitID
+                                                       storedImpressionId:storedImpressionId
+                                                                   adType:adType
+                                                                   dealID:dealID
+                                                                 bidFloor:bidFloor
+                                                              publisherID:publisherID
+                                                              adapterInfo:adapterInfo
+                                                     nativeAdRequirements:nativeAdRequirements
+                                                                     tmax:tmax
+                                                                 impModel:impModel];
+        requestTemplate = [[CLXBidRequestTemplate alloc] initWithBidRequestJSON:fullRequest nativeAdRequirements:nativeAdRequirements];
+        if (!requestTemplate) {
+            [self.logger debug:@"⚠️ [BidNetworkService] Bid request cannot be templated, using full build"];
+            if (completion) {
+                completion(fullRequest, nil);
+            }
+            return;
+        }
+        [self.templateCache setTemplate:requestTemplate forKey:templateKey];
+    }
+    
+    NSData *encodedBody = nil;
+    NSDictionary *bidRequest = [requestTemplate bidRequestWithRequestID:[[NSUUID UUID] UUIDString]
+                                                    impressionID:[[NSUUID UUID] UUIDString]
+                                                     adapterInfo:adapterInfo
+                                                            tmax:tmax
+                                                     encodedBody:&encodedBody];
+    if (encodedBody) {
+        [self.templateCache setEncodedBody:encodedBody forBidRequest:bidRequest];
+    }
+    if (completion) {
+        completion(bidRequest, nil);
+    }
+}
+
+/**
+ * Builds the complete request object graph and converts it to JSON. Used to (re)build templates.
+ */
+- (NSDictionary *)buildBidRequestJSONWithAdUnitID:(NSString *)adUnitID
+                               storedImpressionId:(NSString *)storedImpressionId
+                                           adType:(CLXAdType)adType
+                                           dealID:(nullable NSString *)dealID
+                                         bidFloor:(float)bidFloor
+                                      publisherID:(NSString *)publisherID
+                                      adapterInfo:(NSDictionary *)adapterInfo
+                             nativeAdRequirements:(nullable id)nativeAdRequirements
+                                             tmax:(nullable NSNumber *)tmax
+                                         impModel:(nullable CLXConfigImpressionModel *)impModel {
     CLXBiddingConfigRequest *bidRequest = [[CLXBiddingConfigRequest alloc] initWithAdType:adType
                                                                              adUnitID:adUnitID
                                                                    storedImpressionId:storedImpressionId
@@ -105,33 +165,21 @@
                                                                            impModel:impModel
                                                                            settings:[CLXSettings sharedInstance]
                                                                      privacyService:[CLXPrivacyService sharedInstance]];
-    if (completion) {
-        completion([bidRequest json], nil);
-    }
+    return [bidRequest json];
+}
+
+- (void)startAuctionWithBidRequest:(NSDictionary *)bidRequest
+                            appKey:(NSString *)appKey
+                        completion:(void (^)(CLXBidResponse * _Nullable parsedResponse, NSDictionary * _Nullable rawJSON, NSError * _Nullable error))completion {
+    [self startAuctionWithBidRequest:bidRequest appKey:appKey deadline:nil completion:completion];
 }
 
 - (void)startAuctionWithBidRequest:(NSDictionary *)bidRequest
                             appKey:(NSString *)appKey
+                          deadline:(nullable CLXAuctionDeadline *)deadline
                         completion:(void (^)(CLXBidResponse * _Nullable parsedResponse, NSDictionary * _Nullable rawJSON, NSError * _Nullable error))completion {
     [self.logger info:[NSString stringWithFormat:@"🚀 [BidNetworkService] startAuctionWithBidRequest called - AppKey: %@", appKey]];
     
-    // Log the actual bid request JSON
-    if (bidRequest) {
-        @try {
-            NSError *jsonError;
-            NSData *jsonData = [NSJSONSerialization dataWithJSONObject:bidRequest options:NSJSONWritingPrettyPrinted error:&jsonError];
-            if (jsonData && !jsonError) {
-                NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-                [self.logger debug:[NSString stringWithFormat:@"📊 [BidNetworkService] BidRequest JSON (%lu chars)", (unsigned long)jsonString.length]];
-            }
-        } @catch (NSException *exception) {
-            [self.logger error:[NSString stringWithFormat:@"❌ [BidNetworkService] Exception in bid_request_json_logging: %@ - %@", 
-                               exception.name ?: @"unknown", exception.reason ?: @"no reason"]];
-            [self reportException:exception context:@{@"operation": @"bid_request_json_logging"}];
-            // Continue execution - debug logging failure should not affect bid request
-        }
-    }
-    
     [self.logger debug:[NSString stringWithFormat:@"🔧 [BidNetworkService] Bid request: ID=%@, IMPs=%lu, URL=%@%@", 
                        bidRequest[@"id"], 
                        (unsigned long)[bidRequest[@"imp"] count],
@@ -163,13 +211,18 @@
         return;
     }
     
-    NSError *jsonError;
-    NSData *requestBodyData = [NSJSONSerialization dataWithJSONObject:bidRequest options:0 error:&jsonError];
-    if (jsonError) {
-        [self.logger error:[NSString stringWithFormat:@"❌ [BidNetworkService] JSON serialization failed - %@ (Domain: %@, Code: %ld)", jsonError.localizedDescription, jsonError.domain, (long)jsonError.code]];
-        if (completion) completion(nil, nil, jsonError);
-        return;
+    // Requests built from a template arrive with their body already encoded
+    NSData *requestBodyData = [self.templateCache takeEncodedBodyForBidRequest:bidRequest];
+    if (!requestBodyData) {
+        NSError *jsonError;
+        requestBodyData = [NSJSONSerialization dataWithJSONObject:bidRequest options:0 error:&jsonError];
+        if (jsonError) {
+            [self.logger error:[NSString stringWithFormat:@"❌ [BidNetworkService] JSON serialization failed - %@ (Domain: %@, Code: %ld)", jsonError.localizedDescription, jsonError.domain, (long)jsonError.code]];
+            if (completion) completion(nil, nil, jsonError);
+            return;
+        }
     }
+    CLX_LOG_DEBUG(self.logger, @"📊 [BidNetworkService] BidRequest body: %lu bytes", (unsigned long)requestBodyData.length);
     
     // Use empty endpoint string like Swift version to avoid double URL
     [self.logger debug:@"🔧 [BidNetworkService] Starting auction request with V1 retry policy (maxRetries:1, delay:1.0s)"];
@@ -178,13 +231,7 @@
     // Track bid request network call latency
     NSDate *bidRequestStartTime = [NSDate date];
     
-    [self.baseNetworkService executeRequestWithEndpoint:@""
-                                         urlParameters:nil
-                                          requestBody:requestBodyData
-                                              headers:headers
-                                           maxRetries:1
-                                               delay:1.0
-                                          completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
+    void (^handleResponse)(id _Nullable, NSError * _Nullable, BOOL) = ^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
         // Track bid request latency
         NSTimeInterval bidRequestLatency = [[NSDate date] timeIntervalSinceDate:bidRequestStartTime] * 1000; // Convert to milliseconds
         id<CLXMetricsTrackerProtocol> metricsTracker = [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
@@ -215,7 +262,21 @@
         
         [self.logger info:@"✅ [BidNetworkService] Auction response received successfully"];
         [self.logger debug:[NSString stringWithFormat:@"📊 [BidNetworkService] Response type: %@", NSStringFromClass([response class])]];
-        [self.logger debug:[NSString stringWithFormat:@"📊 [BidNetworkService] Response: %@", response]];
+        
+        if ([response isKindOfClass:[NSData class]]) {
+            // Raw body: typed fields are parsed, the body itself is kept as bytes on the response
+            NSError *parseError = nil;
+            CLXBidResponse *bidResponse = [CLXBidResponse parseBidResponseFromData:response error:&parseError];
+            if (!bidResponse) {
+                [self.logger error:[NSString stringWithFormat:@"❌ [BidNetworkService] Auction response parsing failed - %@", parseError.localizedDescription]];
+            }
+            if (completion) {
+                completion(bidResponse, nil, bidResponse ? nil : parseError);
+            }
+            return;
+        }
+        
+        CLX_LOG_DEBUG(self.logger, @"📊 [BidNetworkService] Response: %@", response);
         // Parse response dictionary into BidResponse object
         CLXBidResponse *bidResponse = [CLXBidResponse parseBidResponseFromDictionary:response];
         
@@ -223,7 +284,27 @@
         if (completion) {
             completion(bidResponse, [response isKindOfClass:[NSDictionary class]] ? (NSDictionary *)response : nil, nil);
         }
-    }];
+    };
+    
+    if (self.retainsRawResponse) {
+        [self.baseNetworkService executeRawRequestWithEndpoint:@""
+                                                urlParameters:nil
+                                                 requestBody:requestBodyData
+                                                     headers:headers
+                                                  maxRetries:1
+                                                       delay:1.0
+                                                    deadline:deadline
+                                                  completion:handleResponse];
+    } else {
+        [self.baseNetworkService executeRequestWithEndpoint:@""
+                                             urlParameters:nil
+                                              requestBody:requestBodyData
+                                                  headers:headers
+                                               maxRetries:1
+                                                   delay:1.0
+                                                 deadline:deadline
+                                              completion:handleResponse];
+    }
 }
 
 - (void)startCDPFlowWithBidRequest:(id)bidRequest
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXBidRequestTemplate.m
+ * @brief Pre-encoded bid request skeletons patched per auction
+ */
+
+#import <CloudXCore/CLXBidRequestTemplate.h>
+#import <CloudXCore/CLXGPPProvider.h>
+#import <CloudXCore/CLXReachabilityService.h>
+#import <CloudXCore/CLXAdTrackingService.h>
+#import <CloudXCore/CLXLogger.h>
+#import <UIKit/UIKit.h>
+
+NSNotificationName const CLXBidRequestInputsDidChangeNotification = @"CLXBidRequestInputsDidChangeNotification";
+
+// Keys spliced in per auction; everything else in the request is part of the template
+static NSString *const kCLXBidRequestIDKey = @"id";
+static NSString *const kCLXBidRequestImpKey = @"imp";
+static NSString *const kCLXBidRequestTmaxKey = @"tmax";
+static NSString *const kCLXBidRequestExtKey = @"ext";
+
+#pragma mark - CLXBidRequestTemplate
+
+@interface CLXBidRequestTemplate ()
+@property (nonatomic, strong, readwrite, nullable) id nativeAdRequirements;
+@property (nonatomic, copy) NSDictionary *staticParts;
+@property (nonatomic, copy) NSDictionary *impression;
+@property (nonatomic, copy, nullable) NSDictionary *prebidExt;
+
+// Pre-encoded fragments
+@property (nonatomic, copy) NSData *encodedPrefix;     // `{"app":…,"device":…,` (open object, trailing comma)
+@property (nonatomic, copy) NSData *encodedImpBody;    // Impression members without braces or id
+@property (nonatomic, copy, nullable) NSData *encodedPrebidExt;
+@end
+
+@implementation CLXBidRequestTemplate
+
+- (nullable instancetype)initWithBidRequestJSON:(NSDictionary *)bidRequestJSON
+                           nativeAdRequirements:(nullable id)nativeAdRequirements {
+    self = [super init];
+    if (self) {
+        // Only the single-impression shape produced by CLXBiddingConfigRequest is templated
+        NSArray *imps = bidRequestJSON[kCLXBidRequestImpKey];
+        if (![imps isKindOfClass:[NSArray class]] || imps.count != 1 || ![imps.firstObject isKindOfClass:[NSDictionary class]]) {
+            return nil;
+        }
+        NSDictionary *ext = bidRequestJSON[kCLXBidRequestExtKey];
+        if (ext && ![ext isKindOfClass:[NSDictionary class]]) {
+            return nil;
+        }
+        for (NSString *key in ext) {
+            if (![key isEqualToString:@"cloudx"] && ![key isEqualToString:@"prebid"]) {
+                return nil;
+            }
+        }
+
+        NSMutableDictionary *staticParts = [bidRequestJSON mutableCopy];
+        [staticParts removeObjectsForKeys:@[kCLXBidRequestIDKey, kCLXBidRequestImpKey, kCLXBidRequestTmaxKey, kCLXBidRequestExtKey]];
+        NSMutableDictionary *impression = [imps.firstObject mutableCopy];
+        [impression removeObjectForKey:kCLXBidRequestIDKey];
+
+        _nativeAdRequirements = nativeAdRequirements;
+        _staticParts = [staticParts copy];
+        _impression = [impression copy];
+        _prebidExt = ext[@"prebid"];
+
+        NSData *encodedStatic = [self _encodeObject:_staticParts];
+        NSData *encodedImpression = [self _encodeObject:_impression];
+        NSData *encodedPrebid = _prebidExt ? [self _encodeObject:_prebidExt] : nil;
+        if (!encodedStatic || !encodedImpression || (_prebidExt && !encodedPrebid)) {
+            return nil;
+        }
+
+        NSMutableData *prefix = [[encodedStatic subdataWithRange:NSMakeRange(0, encodedStatic.length - 1)] mutableCopy];
+        if (_staticParts.count > 0) {
+            [prefix appendBytes:"," length:1];
+        }
+        _encodedPrefix = [prefix copy];
+        _encodedImpBody = [encodedImpression subdataWithRange:NSMakeRange(1, encodedImpression.length - 2)];
+        _encodedPrebidExt = encodedPrebid;
+    }
+    return self;
+}
+
+- (NSDictionary *)bidRequestWithRequestID:(NSString *)requestID
+                             impressionID:(NSString *)impressionID
+                              adapterInfo:(NSDictionary *)adapterInfo
+                                     tmax:(nullable NSNumber *)tmax
+                              encodedBody:(NSData * _Nullable * _Nullable)encodedBody {
+    NSMutableDictionary *impression = [self.impression mutableCopy];
+    impression[kCLXBidRequestIDKey] = impressionID;
+
+    NSMutableDictionary *ext = [NSMutableDictionary dictionaryWithCapacity:2];
+    ext[@"cloudx"] = @{@"adapter_extras": adapterInfo ?: @{}};
+    ext[@"prebid"] = self.prebidExt;
+
+    NSMutableDictionary *json = [self.staticParts mutableCopy];
+    json[kCLXBidRequestIDKey] = requestID;
+    json[kCLXBidRequestImpKey] = @[impression];
+    json[kCLXBidRequestExtKey] = ext;
+    json[kCLXBidRequestTmaxKey] = tmax;
+
+    if (encodedBody) {
+        *encodedBody = [self _encodedBodyWithRequestID:requestID impressionID:impressionID adapterInfo:adapterInfo tmax:tmax];
+    }
+    return [json copy];
+}
+
+#pragma mark - Private Methods
+
+- (nullable NSData *)_encodedBodyWithRequestID:(NSString *)requestID
+                                  impressionID:(NSString *)impressionID
+                                   adapterInfo:(nullable NSDictionary *)adapterInfo
+                                          tmax:(nullable NSNumber *)tmax {
+    NSData *encodedRequestID = [self _encodeObject:requestID];
+    NSData *encodedImpressionID = [self _encodeObject:impressionID];
+    NSData *encodedAdapterInfo = [self _encodeObject:adapterInfo ?: @{}];
+    NSData *encodedTmax = tmax ? [self _encodeObject:tmax] : nil;
+    if (!encodedRequestID || !encodedImpressionID || !encodedAdapterInfo || (tmax && !encodedTmax)) {
+        return nil;
+    }
+
+    NSMutableData *body = [NSMutableData dataWithCapacity:self.encodedPrefix.length + self.encodedImpBody.length +
+                                                          self.encodedPrebidExt.length + encodedAdapterInfo.length + 128];
+    [body appendData:self.encodedPrefix];
+    [self _append:"\"id\":" to:body];
+    [body appendData:encodedRequestID];
+    [self _append:",\"imp\":[{\"id\":" to:body];
+    [body appendData:encodedImpressionID];
+    if (self.encodedImpBody.length > 0) {
+        [self _append:"," to:body];
+        [body appendData:self.encodedImpBody];
+    }
+    [self _append:"}]" to:body];
+    if (encodedTmax) {
+        [self _append:",\"tmax\":" to:body];
+        [body appendData:encodedTmax];
+    }
+    [self _append:",\"ext\":{\"cloudx\":{\"adapter_extras\":" to:body];
+    [body appendData:encodedAdapterInfo];
+    [self _append:"}" to:body];
+    if (self.encodedPrebidExt) {
+        [self _append:",\"prebid\":" to:body];
+        [body appendData:self.encodedPrebidExt];
+    }
+    [self _append:"}}" to:body];
+    return body;
+}
+
+- (void)_append:(const char *)literal to:(NSMutableData *)data {
+    [data appendBytes:literal length:strlen(literal)];
+}
+
+- (nullable NSData *)_encodeObject:(id)object {
+    @try {
+        return [NSJSONSerialization dataWithJSONObject:object options:NSJSONWritingFragmentsAllowed error:nil];
+    } @catch (NSException *exception) {
+        return nil;
+    }
+}
+
+@end
+
+#pragma mark - CLXBidRequestTemplateCache
+
+@interface CLXBidRequestTemplateCache ()
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXBidRequestTemplate *> *templates;
+@property (nonatomic, strong, nullable) id fingerprint;
+@property (nonatomic, strong) NSMapTable<NSDictionary *, NSData *> *encodedBodies;
+@property (nonatomic, assign, readwrite) NSUInteger invalidationCount;
+@property (nonatomic, strong) NSMutableArray<id<NSObject>> *observers;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXBidRequestTemplateCache
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _templates = [NSMutableDictionary dictionary];
+        // Keyed by dictionary identity: only the instance a template produced maps to its body
+        _encodedBodies = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                   valueOptions:NSPointerFunctionsStrongMemory
+                                                       capacity:8];
+        _observers = [NSMutableArray array];
+        _logger = [[CLXLogger alloc] initWithCategory:@"BidRequestTemplate"];
+
+        __weak typeof(self) weakSelf = self;
+        void (^invalidate)(NSNotification *) = ^(NSNotification *note) {
+            [weakSelf invalidate];
+        };
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [_observers addObject:[center addObserverForName:CLXBidRequestInputsDidChangeNotification object:nil queue:nil usingBlock:invalidate]];
+        [_observers addObject:[center addObserverForName:UIApplicationWillEnterForegroundNotification object:nil queue:nil usingBlock:invalidate]];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (id<NSObject> observer in self.observers) {
+        [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    }
+}
+
+- (nullable CLXBidRequestTemplate *)templateForKey:(NSString *)key {
+    id fingerprint = [self _currentFingerprint];
+    @synchronized (self) {
+        if (self.templates.count > 0 && !(fingerprint == self.fingerprint || [fingerprint isEqual:self.fingerprint])) {
+            [self _invalidateLocked];
+        }
+        self.fingerprint = fingerprint;
+        return self.templates[key];
+    }
+}
+
+- (void)setTemplate:(CLXBidRequestTemplate *)bidRequestTemplate forKey:(NSString *)key {
+    @synchronized (self) {
+        self.templates[key] = bidRequestTemplate;
+    }
+}
+
+- (void)invalidate {
+    @synchronized (self) {
+        [self _invalidateLocked];
+    }
+}
+
+- (void)setEncodedBody:(NSData *)body forBidRequest:(NSDictionary *)bidRequest {
+    @synchronized (self) {
+        [self.encodedBodies setObject:body forKey:bidRequest];
+    }
+}
+
+- (nullable NSData *)takeEncodedBodyForBidRequest:(NSDictionary *)bidRequest {
+    @synchronized (self) {
+        NSData *body = [self.encodedBodies objectForKey:bidRequest];
+        if (body) {
+            [self.encodedBodies removeObjectForKey:bidRequest];
+        }
+        return body;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)_invalidateLocked {
+    if (self.templates.count == 0) {
+        return;
+    }
+    [self.templates removeAllObjects];
+    self.invalidationCount += 1;
+    [self.logger debug:@"🔄 [BidRequestTemplate] Bid request templates invalidated"];
+}
+
+/**
+ * Inputs that can change without passing through an SDK setter. Screen bounds follow the
+ * orientation and feed device.w/h and the fullscreen imp sizes; the UTC offset feeds
+ * geo.utcoffset and moves with time zone and DST changes.
+ */
+- (id)_currentFingerprint {
+    if (self.fingerprintProviderForTesting) {
+        return self.fingerprintProviderForTesting() ?: [NSNull null];
+    }
+    CLXGPPProvider *gppProvider = [CLXGPPProvider sharedInstance];
+    CGSize screenSize = [UIScreen mainScreen].bounds.size;
+    return @[
+        @([CLXAdTrackingService isIDFAAccessAllowed]),
+        @([CLXReachabilityService shared].currentReachabilityType),
+        [gppProvider gppString] ?: [NSNull null],
+        [gppProvider gppSid] ?: [NSNull null],
+        @(screenSize.width),
+        @(screenSize.height),
+        @([NSTimeZone localTimeZone].secondsFromGMT)
+    ];
+}
+
+@end
@@ -14,45 +14,178 @@
 #import <CloudXCore/CLXCacheableAd.h>
 #import <CloudXCore/CLXAppSessionService.h>
 #import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXAuctionDeadline.h>
+#import <CloudXCore/CLXMetricsType.h>
+#import <CloudXCore/CLXBidResponse.h>
+#import <CloudXCore/CLXWinLossTracker.h>
+#import <CloudXCore/CLXTrackingFieldResolver.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+const NSTimeInterval CLXCacheAdQueueDefaultTimeToLive = 3600.0;
+
+// Sweeps may run this late; expiry is checked again on pop, so precision is not needed
+static const uint64_t kCLXCacheAdQueueSweepLeewayNanos = 1 * NSEC_PER_SEC;
+
 @interface QueueItem : NSObject
 
 @property (nonatomic, strong) id<CLXCacheableAd> ad;
 @property (nonatomic, assign) double price;
+@property (nonatomic, copy) NSString *bidID;
+// Auction held in the tracking store while the item is queued
+@property (nonatomic, copy, nullable) NSString *auctionID;
+@property (nonatomic, assign) NSTimeInterval expiresAt;
+@property (nonatomic, assign) NSTimeInterval cachedAt;
+@property (nonatomic, assign) uint64_t sequence;
+@property (nonatomic, assign) NSUInteger heapIndex;
 
-- (instancetype)initWithAd:(id<CLXCacheableAd>)ad price:(double)price;
+- (instancetype)initWithAd:(id<CLXCacheableAd>)ad
+                     price:(double)price
+                     bidID:(NSString *)bidID
+                 expiresAt:(NSTimeInterval)expiresAt;
 
 @end
 
 @implementation QueueItem
 
-- (instancetype)initWithAd:(id<CLXCacheableAd>)ad price:(double)price {
+- (instancetype)initWithAd:(id<CLXCacheableAd>)ad
+                     price:(double)price
+                     bidID:(NSString *)bidID
+                 expiresAt:(NSTimeInterval)expiresAt {
     self = [super init];
     if (self) {
         _ad = ad;
         _price = price;
+        _bidID = [bidID copy];
+        _expiresAt = expiresAt;
     }
     return self;
 }
 
-- (NSComparisonResult)compare:(QueueItem *)other {
-    if (self.price < other.price) {
-        return NSOrderedAscending;
-    } else if (self.price > other.price) {
-        return NSOrderedDescending;
-    } else {
-        return NSOrderedSame;
+// Higher price first; equal prices in load order
+- (BOOL)outranks:(QueueItem *)other {
+    if (self.price != other.price) {
+        return self.price > other.price;
     }
+    return self.sequence < other.sequence;
 }
 
-- (BOOL)isEqual:(id)object {
-    if (self == object) return YES;
-    if (![object isKindOfClass:[QueueItem class]]) return NO;
-    
-    QueueItem *other = (QueueItem *)object;
-    return [self.ad.network isEqualToString:other.ad.network];
+- (BOOL)isExpiredAt:(NSTimeInterval)now {
+    if (now >= self.expiresAt) {
+        return YES;
+    }
+    return [self.ad respondsToSelector:@selector(isExpired)] && self.ad.isExpired;
+}
+
+@end
+
+/**
+ * Occupies a slot of the load queue from the start of an adapter load until it completes.
+ * Exactly one of the load block and the cancel block runs: the cancel block when the operation
+ * is cancelled before it starts, which may be while it still waits for a slot.
+ */
+@interface CLXAdLoadOperation : NSOperation
+
+- (instancetype)initWithLoadBlock:(void (^)(CLXAdLoadOperation *operation))loadBlock
+                      cancelBlock:(dispatch_block_t)cancelBlock;
+
+/// Frees the slot; safe to call more than once
+- (void)finish;
+
+@end
+
+@implementation CLXAdLoadOperation {
+    void (^_loadBlock)(CLXAdLoadOperation *operation);
+    dispatch_block_t _cancelBlock;
+    BOOL _claimed;
+    BOOL _executing;
+    BOOL _finished;
+}
+
+- (instancetype)initWithLoadBlock:(void (^)(CLXAdLoadOperation *operation))loadBlock
+                      cancelBlock:(dispatch_block_t)cancelBlock {
+    self = [super init];
+    if (self) {
+        _loadBlock = [loadBlock copy];
+        _cancelBlock = [cancelBlock copy];
+    }
+    return self;
+}
+
+- (BOOL)isAsynchronous {
+    return YES;
+}
+
+- (BOOL)isExecuting {
+    @synchronized (self) {
+        return _executing;
+    }
+}
+
+- (BOOL)isFinished {
+    @synchronized (self) {
+        return _finished;
+    }
+}
+
+// The first caller wins the operation; hands out the cancel block it is now responsible for
+- (BOOL)_claimTakingCancelBlock:(dispatch_block_t _Nullable * _Nonnull)cancelBlock {
+    @synchronized (self) {
+        if (_claimed) {
+            return NO;
+        }
+        _claimed = YES;
+        *cancelBlock = _cancelBlock;
+        _cancelBlock = nil;
+        return YES;
+    }
+}
+
+- (void)start {
+    dispatch_block_t cancelBlock = nil;
+    if (![self _claimTakingCancelBlock:&cancelBlock]) {
+        // cancel already ran the cancel block
+        [self finish];
+        return;
+    }
+    if (self.isCancelled) {
+        cancelBlock();
+        [self finish];
+        return;
+    }
+    [self willChangeValueForKey:@"isExecuting"];
+    @synchronized (self) {
+        _executing = YES;
+    }
+    [self didChangeValueForKey:@"isExecuting"];
+    _loadBlock(self);
+}
+
+// A queue may not start a cancelled operation until a slot frees up, so the cancel block runs
+// here; start still finishes the operation later
+- (void)cancel {
+    [super cancel];
+    dispatch_block_t cancelBlock = nil;
+    if ([self _claimTakingCancelBlock:&cancelBlock]) {
+        cancelBlock();
+    }
+}
+
+- (void)finish {
+    @synchronized (self) {
+        if (_finished) {
+            return;
+        }
+    }
+    [self willChangeValueForKey:@"isExecuting"];
+    [self willChangeValueForKey:@"isFinished"];
+    @synchronized (self) {
+        _executing = NO;
+        _finished = YES;
+    }
+    [self didChangeValueForKey:@"isFinished"];
+    [self didChangeValueForKey:@"isExecuting"];
+    _loadBlock = nil;
 }
 
 @end
@@ -60,8 +193,19 @@ NS_ASSUME_NONNULL_BEGIN
 @interface CLXCacheAdQueue ()
 
 @property (nonatomic, strong) id<CLXAdEventReporting> reportingService;
-@property (nonatomic, strong, nullable) QueueItem *latestFirstElement;
-@property (nonatomic, strong) NSMutableArray<QueueItem *> *sortedQueue;
+// Owns every property below it; methods named *Locked run on it
+@property (nonatomic, strong) dispatch_queue_t stateQueue;
+// Binary max-heap of loaded ads; each item knows its own index for O(log n) removal
+@property (nonatomic, strong) NSMutableArray<QueueItem *> *heap;
+// Loaded ad (by identity) -> its heap item
+@property (nonatomic, strong) NSMapTable<id<CLXCacheableAd>, QueueItem *> *itemsByAd;
+@property (nonatomic, assign) uint64_t nextSequence;
+// Loads accepted but not yet finished; they count against capacity
+@property (nonatomic, assign) NSInteger pendingLoadCount;
+@property (nonatomic, assign) BOOL isDestroyed;
+@property (nonatomic, strong, nullable) dispatch_source_t expiryTimer;
+@property (nonatomic, strong) CLXWinLossTracker *winLossTracker;
+@property (nonatomic, strong) CLXTrackingFieldResolver *trackingFieldResolver;
 @property (nonatomic, strong) NSOperationQueue *adLoadOperationQueue;
 @property (nonatomic, strong) CLXLogger *logger;
 @property (nonatomic, copy) NSString *placementID;
@@ -79,9 +223,16 @@ NS_ASSUME_NONNULL_BEGIN
         _maxCapacity = maxCapacity;
         _reportingService = reportingService;
         _placementID = [placementID copy];
-        _sortedQueue = [NSMutableArray array];
+        _defaultTimeToLive = CLXCacheAdQueueDefaultTimeToLive;
+        _stateQueue = dispatch_queue_create("com.cloudx.cacheadqueue", DISPATCH_QUEUE_SERIAL);
+        _heap = [NSMutableArray array];
+        _itemsByAd = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                           valueOptions:NSPointerFunctionsStrongMemory];
+        _winLossTracker = [CLXWinLossTracker shared];
+        _trackingFieldResolver = [CLXTrackingFieldResolver shared];
         _adLoadOperationQueue = [[NSOperationQueue alloc] init];
         _adLoadOperationQueue.maxConcurrentOperationCount = 2;
+        _adLoadOperationQueue.name = @"com.cloudx.cacheadqueue.load";
         _logger = [[CLXLogger alloc] initWithCategory:@"CacheAdQueue"];
         
         // Get app key from UserDefaults (matching Swift SDK behavior)
@@ -96,27 +247,69 @@ NS_ASSUME_NONNULL_BEGIN
     return self;
 }
 
+- (void)dealloc {
+    [_adLoadOperationQueue cancelAllOperations];
+    if (_expiryTimer) {
+        dispatch_source_cancel(_expiryTimer);
+    }
+}
+
 - (BOOL)isEnoughSpace {
-    return self.sortedQueue.count < self.maxCapacity;
+    __block BOOL enoughSpace = NO;
+    dispatch_sync(self.stateQueue, ^{
+        enoughSpace = (NSInteger)self.heap.count + self.pendingLoadCount < self.maxCapacity;
+    });
+    return enoughSpace;
+}
+
+- (NSInteger)count {
+    __block NSInteger count = 0;
+    dispatch_sync(self.stateQueue, ^{
+        count = (NSInteger)self.heap.count;
+    });
+    return count;
+}
+
+- (NSInteger)loadingCount {
+    __block NSInteger count = 0;
+    dispatch_sync(self.stateQueue, ^{
+        count = self.pendingLoadCount;
+    });
+    return count;
 }
 
 - (BOOL)isEmpty {
-    return self.sortedQueue.count == 0;
+    return !self.hasItems;
 }
 
 - (BOOL)hasItems {
-    return self.sortedQueue.count > 0;
-    
+    return self.first != nil;
 }
 
 - (nullable id<CLXCacheableAd>)first {
-    return self.sortedQueue.firstObject.ad;
+    __block id<CLXCacheableAd> ad = nil;
+    __block NSArray<QueueItem *> *expired = nil;
+    dispatch_sync(self.stateQueue, ^{
+        expired = [self _takeExpiredTopLocked];
+        ad = self.heap.firstObject.ad;
+    });
+    [self _disposeItems:expired reportExpired:YES];
+    return ad;
+}
+
+- (void)enqueueAdWithPrice:(double)price
+                loadTimeout:(NSTimeInterval)loadTimeout
+                      bidID:(NSString *)bidID
+                         ad:(nullable id<CLXCacheableAd>)ad
+                 completion:(void (^)(NSError * _Nullable error))completion {
+    [self enqueueAdWithPrice:price loadTimeout:loadTimeout bidID:bidID ad:ad deadline:nil completion:completion];
 }
 
 - (void)enqueueAdWithPrice:(double)price
                 loadTimeout:(NSTimeInterval)loadTimeout
                       bidID:(NSString *)bidID
                          ad:(nullable id<CLXCacheableAd>)ad
+                   deadline:(nullable CLXAuctionDeadline *)deadline
                  completion:(void (^)(NSError * _Nullable error))completion {
     
     if (!ad) {
@@ -127,79 +320,394 @@ NS_ASSUME_NONNULL_BEGIN
         return;
     }
     
-    [self.logger debug:@"Loading ad adapter"];
+    if (deadline.isExpired) {
+        [self.logger error:[NSString stringWithFormat:@"Auction deadline passed, not loading ad: %@", deadline]];
+        completion([self _deadlineError]);
+        return;
+    }
     
-    NSDate *startTime = [NSDate date];
+    dispatch_sync(self.stateQueue, ^{
+        self.pendingLoadCount += 1;
+    });
     
-    // The ad object itself handles the timeout. We just need to handle the completion.
-    [ad loadWithTimeout:loadTimeout completion:^(NSError * _Nullable error) {
-        if (error) {
-            [self.logger error:[NSString stringWithFormat:@"Failed to load ad: %@", error.localizedDescription]];
-            completion(error);
+    NSTimeInterval enqueuedAt = [self _now];
+    __weak typeof(self) weakSelf = self;
+    CLXAdLoadOperation *operation = [[CLXAdLoadOperation alloc] initWithLoadBlock:^(CLXAdLoadOperation *operation) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) {
+            [operation finish];
             return;
         }
         
-        // Ad loaded successfully
-        NSTimeInterval loadTime = [[NSDate date] timeIntervalSinceDate:startTime];
-        [self addQueueItem:[[QueueItem alloc] initWithAd:ad price:price]];
-        [self.appSessionService adLoadedWithPlacementID:self.placementID latency:loadTime * 1000];
+        // Time spent waiting for a load slot comes out of the auction's budget
+        if (deadline.isExpired) {
+            [strongSelf.logger error:[NSString stringWithFormat:@"Auction deadline passed while waiting to load ad: %@", deadline]];
+            [strongSelf _finishLoadOfAd:ad item:nil];
+            [operation finish];
+            completion([strongSelf _deadlineError]);
+            return;
+        }
+        NSTimeInterval timeout = deadline ? [deadline timeoutBoundedBy:loadTimeout] : loadTimeout;
         
-        // Signal completion
-        completion(nil);
+        // Adapters schedule timers and touch UIKit, so loads start on the main queue
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [strongSelf.logger debug:@"Loading ad adapter"];
+            NSDate *startTime = [NSDate date];
+            [deadline beginStage:CLXMetricsTypeAuctionStageAdapterLoad];
+            
+            // The ad object itself handles the timeout. We just need to handle the completion.
+            [ad loadWithTimeout:timeout completion:^(NSError * _Nullable error) {
+                [deadline endStage:CLXMetricsTypeAuctionStageAdapterLoad];
+                [operation finish];
+                if (error) {
+                    [strongSelf.logger error:[NSString stringWithFormat:@"Failed to load ad: %@", error.localizedDescription]];
+                    [strongSelf _finishLoadOfAd:ad item:nil];
+                    completion(error);
+                    return;
+                }
+                
+                // Ad loaded successfully
+                NSTimeInterval loadTime = [[NSDate date] timeIntervalSinceDate:startTime];
+                NSTimeInterval expiresAt = [strongSelf _expiryForAd:ad bidID:bidID enqueuedAt:enqueuedAt];
+                QueueItem *item = [[QueueItem alloc] initWithAd:ad price:price bidID:bidID expiresAt:expiresAt];
+                item.cachedAt = [strongSelf _now];
+                BOOL cached = [strongSelf _finishLoadOfAd:ad item:item];
+                [strongSelf.appSessionService adLoadedWithPlacementID:strongSelf.placementID latency:loadTime * 1000];
+                if (cached) {
+                    [strongSelf _notifyDelegateOfCachedItem:item];
+                }
+                
+                // Signal completion
+                completion(nil);
+            }];
+        });
+    } cancelBlock:^{
+        // The queue was destroyed before this load got a slot
+        [weakSelf _finishLoadOfAd:ad item:nil];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [ad destroy];
+            completion([NSError errorWithDomain:@"CacheAdQueue"
+                                           code:CacheAdQueueErrorFailToLoad
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Cache destroyed before the ad loaded"}]);
+        });
     }];
+    [self.adLoadOperationQueue addOperation:operation];
+}
+
+// Returns whether the item went into the queue
+- (BOOL)_finishLoadOfAd:(id<CLXCacheableAd>)ad item:(nullable QueueItem *)item {
+    __block BOOL discard = NO;
+    dispatch_sync(self.stateQueue, ^{
+        self.pendingLoadCount = MAX(0, self.pendingLoadCount - 1);
+        if (!item) {
+            return;
+        }
+        if (self.isDestroyed) {
+            discard = YES;
+            return;
+        }
+        [self _addQueueItemLocked:item];
+    });
+    if (discard) {
+        [ad destroy];
+    }
+    return item != nil && !discard;
 }
 
-- (void)addQueueItem:(QueueItem *)item {
-    if (self.sortedQueue.count == 0) {
-        self.latestFirstElement = item;
+- (void)_notifyDelegateOfCachedItem:(QueueItem *)item {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self _notifyDelegateOfCachedItem:item];
+        });
+        return;
     }
-    
+    id<CLXCacheAdQueueDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(cacheAdQueue:didCacheAd:lifetime:)]) {
+        [delegate cacheAdQueue:self didCacheAd:item.ad lifetime:MAX(0, item.expiresAt - item.cachedAt)];
+    }
+}
+
+- (void)_addQueueItemLocked:(QueueItem *)item {
     [self.logger debug:@"Adapter ad loaded. Put it in queue"];
-    [self.sortedQueue addObject:item];
+    item.sequence = self.nextSequence++;
+    [self _heapInsertLocked:item];
+    [self _scheduleExpirySweepLocked];
+    
+    [self.logger debug:[NSString stringWithFormat:@"Queue contains %lu item(s), expires in %.0fs",
+                        (unsigned long)self.heap.count, item.expiresAt - [self _now]]];
+}
+
+- (nullable id<CLXCacheableAd>)popAd {
+    __block QueueItem *item = nil;
+    __block NSArray<QueueItem *> *expired = nil;
+    dispatch_sync(self.stateQueue, ^{
+        expired = [self _takeExpiredTopLocked];
+        item = self.heap.firstObject;
+        if (item) {
+            [self _heapRemoveLocked:item];
+            [self _scheduleExpirySweepLocked];
+            [self.logger debug:[NSString stringWithFormat:@"pop ad from queue - %lu item(s) remaining", (unsigned long)self.heap.count]];
+        }
+    });
+    [self _disposeItems:expired reportExpired:YES];
+    return item.ad;
+}
+
+- (void)removeAd:(id<CLXCacheableAd>)ad {
+    __block QueueItem *item = nil;
+    dispatch_sync(self.stateQueue, ^{
+        item = [self.itemsByAd objectForKey:ad];
+        if (!item) {
+            // A different object for the same impression
+            for (QueueItem *candidate in self.heap) {
+                if ([candidate.ad.impressionID isEqualToString:ad.impressionID]) {
+                    item = candidate;
+                    break;
+                }
+            }
+        }
+        if (item) {
+            [self _heapRemoveLocked:item];
+            [self _scheduleExpirySweepLocked];
+        }
+    });
+    if (item) {
+        [self _disposeItems:@[item] reportExpired:NO];
+    }
+}
+
+- (void)sweepExpiredAds {
+    __block NSArray<QueueItem *> *expired = nil;
+    dispatch_sync(self.stateQueue, ^{
+        expired = [self _takeAllExpiredLocked];
+    });
+    [self _disposeItems:expired reportExpired:YES];
+}
+
+- (void)destroy {
+    [self.adLoadOperationQueue cancelAllOperations];
+    __block NSArray<QueueItem *> *items = nil;
+    dispatch_sync(self.stateQueue, ^{
+        self.isDestroyed = YES;
+        items = [self.heap copy];
+        for (QueueItem *item in items) {
+            [self _releaseAuctionOfItemLocked:item];
+        }
+        [self.heap removeAllObjects];
+        [self.itemsByAd removeAllObjects];
+        if (self.expiryTimer) {
+            dispatch_source_cancel(self.expiryTimer);
+            self.expiryTimer = nil;
+        }
+    });
+    [self _disposeItems:items reportExpired:NO];
+}
+
+#pragma mark - Expiry
+
+- (NSTimeInterval)_now {
+    return self.clockForTesting ? self.clockForTesting() : [NSProcessInfo processInfo].systemUptime;
+}
+
+- (NSError *)_deadlineError {
+    return [NSError errorWithDomain:@"CacheAdQueue"
+                               code:CacheAdQueueErrorTimeout
+                           userInfo:@{NSLocalizedDescriptionKey: @"Auction deadline exceeded"}];
+}
+
+// Earliest of the bid's exp (counted from the auction), the network's lifetime (counted from load)
+// and the default lifetime
+- (NSTimeInterval)_expiryForAd:(id<CLXCacheableAd>)ad bidID:(NSString *)bidID enqueuedAt:(NSTimeInterval)enqueuedAt {
+    NSTimeInterval loadedAt = [self _now];
+    NSTimeInterval expiresAt = loadedAt + self.defaultTimeToLive;
     
-    // Sort by price (descending)
-    [self.sortedQueue sortUsingComparator:^NSComparisonResult(QueueItem *obj1, QueueItem *obj2) {
-        if (obj1.price > obj2.price) {
-            return NSOrderedAscending;
-        } else if (obj1.price < obj2.price) {
-            return NSOrderedDescending;
-        } else {
-            return NSOrderedSame;
+    CLXBidResponseBid *bid = bidID ? [ad.bidResponse findBidWithID:bidID] : nil;
+    if (bid.exp > 0) {
+        expiresAt = MIN(expiresAt, enqueuedAt + bid.exp);
+    }
+    if ([ad respondsToSelector:@selector(expirationInterval)] && ad.expirationInterval > 0) {
+        expiresAt = MIN(expiresAt, loadedAt + ad.expirationInterval);
+    }
+    return expiresAt;
+}
+
+- (NSArray<QueueItem *> *)_takeExpiredTopLocked {
+    NSTimeInterval now = [self _now];
+    NSMutableArray<QueueItem *> *expired = [NSMutableArray array];
+    while (self.heap.count > 0 && [self.heap.firstObject isExpiredAt:now]) {
+        QueueItem *item = self.heap.firstObject;
+        [self _heapRemoveLocked:item];
+        [expired addObject:item];
+    }
+    if (expired.count > 0) {
+        [self _scheduleExpirySweepLocked];
+    }
+    return expired;
+}
+
+- (NSArray<QueueItem *> *)_takeAllExpiredLocked {
+    NSTimeInterval now = [self _now];
+    NSMutableArray<QueueItem *> *expired = [NSMutableArray array];
+    for (QueueItem *item in self.heap) {
+        if ([item isExpiredAt:now]) {
+            [expired addObject:item];
         }
-    }];
+    }
+    for (QueueItem *item in expired) {
+        [self _heapRemoveLocked:item];
+    }
+    [self _scheduleExpirySweepLocked];
+    return expired;
+}
+
+// Destroys ads taken out of the queue. Runs on the main queue, where adapters expect to be torn down;
+// callers already on it (popAd, removeAd from the publisher) see the ads destroyed on return.
+- (void)_disposeItems:(NSArray<QueueItem *> *)items reportExpired:(BOOL)reportExpired {
+    if (items.count == 0) {
+        return;
+    }
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self _disposeItems:items reportExpired:reportExpired];
+        });
+        return;
+    }
+    
+    id<CLXCacheAdQueueDelegate> delegate = self.delegate;
+    for (QueueItem *item in items) {
+        if (reportExpired) {
+            [self _reportExpiredItem:item];
+        }
+        [item.ad destroy];
+        if (reportExpired && [delegate respondsToSelector:@selector(cacheAdQueue:didExpireAd:cachedFor:)]) {
+            [delegate cacheAdQueue:self didExpireAd:item.ad cachedFor:MAX(0, [self _now] - item.cachedAt)];
+        }
+    }
+}
+
+- (void)_reportExpiredItem:(QueueItem *)item {
+    [self.logger debug:[NSString stringWithFormat:@"⏰ [CacheAdQueue] %@ ad expired in cache (bid %@, price %.2f)",
+                        item.ad.network, item.bidID, item.price]];
     
-    [self.logger debug:[NSString stringWithFormat:@"Queue contains %lu item(s)", (unsigned long)self.sortedQueue.count]];
+    NSString *auctionId = item.ad.bidResponse.id;
+    if (auctionId.length > 0 && item.bidID.length > 0) {
+        [self.winLossTracker setBidLoadResult:auctionId bidId:item.bidID success:NO lossReason:@(CLXLossReasonExpired)];
+        [self.winLossTracker sendLoss:auctionId bidId:item.bidID];
+    }
 }
 
-- (nullable id<CLXCacheableAd>)popAd {
-    if (self.sortedQueue.count == 0) {
-        return nil;
+// Arms the sweeper for the earliest expiry. The heap is ordered by price, so this is a scan,
+// which is cheap at cache sizes.
+- (void)_scheduleExpirySweepLocked {
+    if (self.isDestroyed) {
+        return;
+    }
+    if (self.heap.count == 0) {
+        if (self.expiryTimer) {
+            dispatch_source_set_timer(self.expiryTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        }
+        return;
+    }
+    
+    NSTimeInterval earliest = DBL_MAX;
+    for (QueueItem *item in self.heap) {
+        earliest = MIN(earliest, item.expiresAt);
     }
+    NSTimeInterval delay = MAX(0, earliest - [self _now]);
     
-    QueueItem *item = self.sortedQueue.firstObject;
-    [self.sortedQueue removeObjectAtIndex:0];
+    if (!self.expiryTimer) {
+        self.expiryTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.stateQueue);
+        __weak typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(self.expiryTimer, ^{
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            [strongSelf _disposeItems:[strongSelf _takeAllExpiredLocked] reportExpired:YES];
+        });
+        dispatch_source_set_timer(self.expiryTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(self.expiryTimer);
+    }
+    dispatch_source_set_timer(self.expiryTimer,
+                              dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                              DISPATCH_TIME_FOREVER,
+                              kCLXCacheAdQueueSweepLeewayNanos);
+}
+
+#pragma mark - Heap
+
+// Queued ads report their win or loss when shown or expired, possibly long after the auction,
+// so their auction's tracking data is held for as long as they are in the heap
+- (void)_heapInsertLocked:(QueueItem *)item {
+    item.heapIndex = self.heap.count;
+    [self.heap addObject:item];
+    [self.itemsByAd setObject:item forKey:item.ad];
+    item.auctionID = item.ad.bidResponse.id;
+    if (item.auctionID.length > 0) {
+        [self.trackingFieldResolver holdAuction:item.auctionID];
+    }
+    [self _siftUpLocked:item.heapIndex];
+}
+
+- (void)_releaseAuctionOfItemLocked:(QueueItem *)item {
+    if (item.auctionID.length > 0) {
+        [self.trackingFieldResolver releaseAuction:item.auctionID];
+        item.auctionID = nil;
+    }
+}
+
+- (void)_heapRemoveLocked:(QueueItem *)item {
+    NSUInteger index = item.heapIndex;
+    if (index >= self.heap.count || self.heap[index] != item) {
+        return;
+    }
     
-    [self.logger debug:[NSString stringWithFormat:@"pop ad from queue - %lu item(s) remaining", (unsigned long)self.sortedQueue.count]];
+    NSUInteger last = self.heap.count - 1;
+    if (index != last) {
+        [self _swapLocked:index with:last];
+    }
+    [self.heap removeLastObject];
+    [self.itemsByAd removeObjectForKey:item.ad];
+    [self _releaseAuctionOfItemLocked:item];
     
-    return item.ad;
+    if (index < self.heap.count) {
+        [self _siftDownLocked:index];
+        [self _siftUpLocked:index];
+    }
 }
 
-- (void)removeAd:(id<CLXCacheableAd>)ad {
-    for (NSInteger i = 0; i < self.sortedQueue.count; i++) {
-        QueueItem *item = self.sortedQueue[i];
-        if ([item.ad.impressionID isEqualToString:ad.impressionID]) {
-            [item.ad destroy];
-            [self.sortedQueue removeObjectAtIndex:i];
+- (void)_siftUpLocked:(NSUInteger)index {
+    while (index > 0) {
+        NSUInteger parent = (index - 1) / 2;
+        if (![self.heap[index] outranks:self.heap[parent]]) {
             break;
         }
+        [self _swapLocked:index with:parent];
+        index = parent;
     }
 }
 
-- (void)destroy {
-    for (QueueItem *item in self.sortedQueue) {
-        [item.ad destroy];
+- (void)_siftDownLocked:(NSUInteger)index {
+    NSUInteger count = self.heap.count;
+    while (YES) {
+        NSUInteger left = 2 * index + 1;
+        NSUInteger right = left + 1;
+        NSUInteger best = index;
+        if (left < count && [self.heap[left] outranks:self.heap[best]]) {
+            best = left;
+        }
+        if (right < count && [self.heap[right] outranks:self.heap[best]]) {
+            best = right;
+        }
+        if (best == index) {
+            break;
+        }
+        [self _swapLocked:index with:best];
+        index = best;
     }
-    [self.sortedQueue removeAllObjects];
+}
+
+- (void)_swapLocked:(NSUInteger)i with:(NSUInteger)j {
+    [self.heap exchangeObjectAtIndex:i withObjectAtIndex:j];
+    self.heap[i].heapIndex = i;
+    self.heap[j].heapIndex = j;
 }
 
 @end
@@ -15,6 +15,7 @@
 #import <CloudXCore/CLXDestroyable.h>
 #import <CloudXCore/CLXSDKConfigPlacement.h>
 #import <CloudXCore/CLXCacheAdQueue.h>
+#import <CloudXCore/CLXCacheRefillController.h>
 #import <CloudXCore/CLXExponentialBackoffStrategy.h>
 #import <CloudXCore/CLXLogger.h>
 #import <CloudXCore/CLXReachabilityService.h>
@@ -23,7 +24,7 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface CLXCacheAdService ()
+@interface CLXCacheAdService () <CLXCacheAdQueueDelegate>
 
 @property (nonatomic, strong, nullable) id<CLXBidAdSourceProtocol> bidAdSource;
 @property (nonatomic, assign) NSTimeInterval bidLoadTimeout;
@@ -40,6 +41,11 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL isSuspended;
 @property (nonatomic, strong) CLXSettings *settings;
 @property (nonatomic, assign) NSInteger adType;
+// Refill state, touched on the main queue only
+@property (nonatomic, strong) CLXCacheRefillController *refillController;
+@property (nonatomic, assign) NSInteger auctionsInFlight;
+@property (nonatomic, assign) BOOL isBackingOff;
+@property (nonatomic, assign) BOOL isRefillDeferred;
 
 @end
 
@@ -99,6 +105,10 @@ NS_ASSUME_NONNULL_BEGIN
         _cachedQueue = [[CLXCacheAdQueue alloc] initWithMaxCapacity:cacheSize
                                                 reportingService:reportingService
                                                      placementID:placement.id];
+        _cachedQueue.delegate = self;
+        _refillController = [[CLXCacheRefillController alloc] initWithPlacementID:placement.id
+                                                                  readinessTarget:placement.cacheReadinessTarget
+                                                                         maxDepth:cacheSize];
         _logger = [[CLXLogger alloc] initWithCategory:@"CacheAdService"];
         _winSuccess = NO;
         _isSuspended = NO;
@@ -149,8 +159,70 @@ NS_ASSUME_NONNULL_BEGIN
     // Implement async loading logic following Swift SDK pattern
     [self.logger debug:@"Start filling fullscreen ad queue"];
     
-    // Start loading queue items
-    [self loadQueueItem];
+    [self _refill];
+}
+
+// Asks the refill controller how many auctions the cache needs now and starts them
+- (void)_refill {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self _refill];
+        });
+        return;
+    }
+    if (!self.bidAdSource || self.isSuspended || self.isBackingOff) {
+        return;
+    }
+    
+    CLXCacheRefillDecision *decision = [self.refillController decisionWithCachedCount:self.cachedQueue.count
+                                                                         loadingCount:self.cachedQueue.loadingCount
+                                                                     auctionsInFlight:self.auctionsInFlight];
+    if (decision.deferral > 0) {
+        if (!self.isRefillDeferred) {
+            self.isRefillDeferred = YES;
+            __weak typeof(self) weakSelf = self;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(decision.deferral * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+                __strong typeof(weakSelf) strongSelf = weakSelf;
+                if (!strongSelf) return;
+                strongSelf.isRefillDeferred = NO;
+                [strongSelf _refill];
+            });
+        }
+        return;
+    }
+    for (NSInteger i = 0; i < decision.auctionsToStart; i++) {
+        [self loadQueueItem];
+    }
+}
+
+// Retries after the waterfall backoff; refills asked for meanwhile wait for it
+- (void)_refillAfterBackoff {
+    // Check if retries are enabled for this ad type
+    if (![self shouldEnableRetries]) {
+        [self.logger info:@"🚫 [CacheAdService] Retries disabled for this ad type - failing immediately"];
+        return; // Exit without retrying
+    }
+    
+    // Log retry attempt
+    [self.logger debug:@"🔄 [CacheAdService] Retries enabled - will retry after backoff delay"];
+    
+    // Implement waterfall backoff delay logic
+    NSError *backoffError;
+    NSTimeInterval delay = [self.waterfallBackoffAlgorithm nextDelayWithError:&backoffError];
+    if (backoffError) {
+        delay = 1.0; // Default delay if backoff fails
+    }
+    
+    [self.logger debug:[NSString stringWithFormat:@"Sleep for %f seconds", delay]];
+    
+    self.isBackingOff = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        strongSelf.isBackingOff = NO;
+        [strongSelf _refill];
+    });
 }
 
 - (void)loadQueueItem {
@@ -160,6 +232,8 @@ NS_ASSUME_NONNULL_BEGIN
         return;
     }
     
+    self.auctionsInFlight += 1;
+    NSTimeInterval startedAt = [NSProcessInfo processInfo].systemUptime;
     __weak typeof(self) weakSelf = self;
     [self.bidAdSource requestBidWithAdUnitID:self.placement.id
                            storedImpressionId:self.placement.id
@@ -169,83 +243,96 @@ NS_ASSUME_NONNULL_BEGIN
         __strong typeof(weakSelf) strongSelf = weakSelf;
         if (!strongSelf) return;
         
-        if (error) {
-            [strongSelf.logger error:[NSString stringWithFormat:@"❌ [CacheAdService] Bid failed: %@ (domain:%@, code:%ld)", error.localizedDescription, error.domain, (long)error.code]];
-            
-            // Check if retries are enabled for this ad type
-            if (![strongSelf shouldEnableRetries]) {
-                [strongSelf.logger info:@"🚫 [CacheAdService] Retries disabled for this ad type - failing immediately"];
-                return; // Exit without retrying
-            }
-            
-            // Log retry attempt
-            [strongSelf.logger debug:@"🔄 [CacheAdService] Retries enabled - will retry after backoff delay"];
-            
-            // Implement waterfall backoff delay logic
-            NSError *backoffError;
-            NSTimeInterval delay = [strongSelf.waterfallBackoffAlgorithm nextDelayWithError:&backoffError];
-            if (backoffError) {
-                delay = 1.0; // Default delay if backoff fails
+        // Taken before hopping queues; the source keeps only the latest auction's response
+        CLXBidResponse *bidResponse = error ? nil : [strongSelf.bidAdSource getCurrentBidResponse];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [strongSelf _finishAuctionStartedAt:startedAt response:response bidResponse:bidResponse error:error];
+        });
+    }];
+}
+
+- (void)_finishAuctionStartedAt:(NSTimeInterval)startedAt
+                       response:(nullable CLXBidAdSourceResponse *)response
+                    bidResponse:(nullable CLXBidResponse *)bidResponse
+                          error:(nullable NSError *)error {
+    self.auctionsInFlight = MAX(self.auctionsInFlight - 1, 0);
+    
+    if (error) {
+        [self.logger error:[NSString stringWithFormat:@"❌ [CacheAdService] Bid failed: %@ (domain:%@, code:%ld)", error.localizedDescription, error.domain, (long)error.code]];
+        [self.refillController noteRefillFinishedAfter:[NSProcessInfo processInfo].systemUptime - startedAt filled:NO];
+        [self _refillAfterBackoff];
+        return;
+    }
+    
+    self.winSuccess = YES;
+    
+    // Reset waterfall backoff algorithm
+    [self.waterfallBackoffAlgorithm reset];
+    
+    // Create cacheable ad from response
+    id<CLXCacheableAd> cacheableAd = nil;
+    if (self.createCacheableAd && response) {
+        [self.logger debug:[NSString stringWithFormat:@"🔧 [CacheAdService] Creating cacheable ad - Network: %@, BidID: %@", response.networkName, response.bidID]];
+        
+        // Call createBidAd block without parameters (it captures parameters internally)
+        id destroyable = response.createBidAd();
+        
+        if (destroyable) {
+            cacheableAd = self.createCacheableAd(destroyable);
+            [self.logger debug:[NSString stringWithFormat:@"📊 [CacheAdService] Cacheable ad created: %@", cacheableAd]];
+            if (!cacheableAd) {
+                [self.logger error:@"❌ [CacheAdService] Failed to create cacheable ad from destroyable"];
             }
-            
-            [strongSelf.logger debug:[NSString stringWithFormat:@"Sleep for %f seconds", delay]];
-            
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                if (strongSelf.cachedQueue.isEnoughSpace && !strongSelf.isSuspended) {
-                    [strongSelf loadQueueItem];
-                }
-            });
         } else {
-            strongSelf.winSuccess = YES;
-            
-            // Reset waterfall backoff algorithm
-            NSTimeInterval delay = [strongSelf.waterfallBackoffAlgorithm reset];
-            
-            // Create cacheable ad from response
-            if (strongSelf.createCacheableAd && response) {
-                [strongSelf.logger debug:[NSString stringWithFormat:@"🔧 [CacheAdService] Creating cacheable ad - Network: %@, BidID: %@", response.networkName, response.bidID]];
-                
-                // Call createBidAd block without parameters (it captures parameters internally)
-                id destroyable = response.createBidAd();
-                
-                if (destroyable) {
-                    id<CLXCacheableAd> cacheableAd = strongSelf.createCacheableAd(destroyable);
-                    [strongSelf.logger debug:[NSString stringWithFormat:@"📊 [CacheAdService] Cacheable ad created: %@", cacheableAd]];
-                    
-                    if (cacheableAd) {
-                        // Set the bid response on the cacheable ad for NURL firing
-                        CLXBidResponse *bidResponse = [strongSelf.bidAdSource getCurrentBidResponse];
-                        cacheableAd.bidResponse = bidResponse;
-                        [strongSelf.logger debug:@"🔧 [CacheAdService] Set bidResponse on cacheable ad and enqueueing"];
-                        [strongSelf.cachedQueue enqueueAdWithPrice:response.price
-                                                       loadTimeout:strongSelf.bidLoadTimeout
-                                                             bidID:response.bidID
-                                                                ad:cacheableAd
-                                                        completion:^(NSError * _Nullable error) {
-                            if (error) {
-                                [strongSelf.logger error:[NSString stringWithFormat:@"Failed to enqueue ad: %@", error.localizedDescription]];
-                            } else {
-                                [strongSelf.logger info:[NSString stringWithFormat:@"✅ [CacheAdService] Ad successfully enqueued to service: %@", strongSelf]];
-                            }
-                        }];
-                    } else {
-                        [strongSelf.logger error:@"❌ [CacheAdService] Failed to create cacheable ad from destroyable"];
-                    }
-                } else {
-                    [strongSelf.logger error:@"❌ [CacheAdService] Failed to create destroyable from bid response"];
-                }
+            [self.logger error:@"❌ [CacheAdService] Failed to create destroyable from bid response"];
+        }
+    } else {
+        [self.logger error:[NSString stringWithFormat:@"❌ [CacheAdService] Missing createCacheableAd block (%d) or response (%d)", self.createCacheableAd != nil, response != nil]];
+    }
+    
+    if (!cacheableAd) {
+        [self.refillController noteRefillFinishedAfter:[NSProcessInfo processInfo].systemUptime - startedAt filled:NO];
+        [self _refill];
+        return;
+    }
+    
+    // Set the bid response on the cacheable ad for NURL firing
+    cacheableAd.bidResponse = bidResponse;
+    [self.logger debug:@"🔧 [CacheAdService] Set bidResponse on cacheable ad and enqueueing"];
+    __weak typeof(self) weakSelf = self;
+    [self.cachedQueue enqueueAdWithPrice:response.price
+                             loadTimeout:self.bidLoadTimeout
+                                   bidID:response.bidID
+                                      ad:cacheableAd
+                                deadline:response.deadline
+                              completion:^(NSError * _Nullable error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (!strongSelf) return;
+            [strongSelf.refillController noteRefillFinishedAfter:[NSProcessInfo processInfo].systemUptime - startedAt filled:error == nil];
+            if (error) {
+                [strongSelf.logger error:[NSString stringWithFormat:@"Failed to enqueue ad: %@", error.localizedDescription]];
+                [strongSelf _refillAfterBackoff];
             } else {
-                [strongSelf.logger error:[NSString stringWithFormat:@"❌ [CacheAdService] Missing createCacheableAd block (%d) or response (%d)", strongSelf.createCacheableAd != nil, response != nil]];
+                [strongSelf.logger info:[NSString stringWithFormat:@"✅ [CacheAdService] Ad successfully enqueued to service: %@", strongSelf]];
+                [strongSelf _refill];
             }
-            
-            // Schedule next load
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                if (strongSelf.cachedQueue.isEnoughSpace && !strongSelf.isSuspended) {
-                    [strongSelf loadQueueItem];
-                }
-            });
-        }
+        });
     }];
+    
+    // The won ad now counts as loading in the queue; the next auction may start alongside it
+    [self _refill];
+}
+
+#pragma mark - CLXCacheAdQueueDelegate
+
+- (void)cacheAdQueue:(CLXCacheAdQueue *)queue didCacheAd:(id<CLXCacheableAd>)ad lifetime:(NSTimeInterval)lifetime {
+    [self.refillController noteAdCachedFromNetwork:ad.network lifetime:lifetime];
+}
+
+- (void)cacheAdQueue:(CLXCacheAdQueue *)queue didExpireAd:(id<CLXCacheableAd>)ad cachedFor:(NSTimeInterval)cachedFor {
+    [self.refillController noteAdExpiredFromNetwork:ad.network cachedFor:cachedFor];
+    [self _refill];
 }
 
 - (void)suspendLoading {
@@ -268,13 +355,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable id<CLXCacheableAd>)popAd {
     id<CLXCacheableAd> ad = [self.cachedQueue popAd];
-    [self startLoading];
+    [self.refillController noteShowWithAdReady:ad != nil];
+    [self _refill];
     return ad;
 }
 
 - (void)adError:(id)ad {
     [self.cachedQueue removeAd:ad];
-    [self startLoading];
+    [self _refill];
 }
 
 @end
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXCacheRefillController.m
+ * @brief Decides how many fullscreen ads to keep cached and when to refill
+ */
+
+#import <CloudXCore/CLXCacheRefillController.h>
+#import <CloudXCore/CLXCacheAdQueue.h>
+#import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXDIContainer.h>
+#import <CloudXCore/CLXMetricsTrackerProtocol.h>
+#import <CloudXCore/CLXMetricsTrackerImpl.h>
+#import <CloudXCore/CLXMetricsType.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+const double CLXCacheRefillDefaultReadinessTarget = 0.9;
+
+// Weight of the newest sample in every moving average
+static const double kCLXRefillEwmaAlpha = 0.3;
+
+// Priors until the first samples arrive
+static const NSTimeInterval kCLXRefillPriorShowInterval = 120.0;
+static const NSTimeInterval kCLXRefillPriorDuration = 3.0;
+static const double kCLXRefillPriorFillRate = 0.8;
+
+// A refill that rarely fills still gets tried; this bounds the effective refill time
+static const double kCLXRefillMinFillRate = 0.1;
+
+// Longest a replacement for an expired ad is put off
+static const NSTimeInterval kCLXRefillMaxDeferral = 1800.0;
+
+@interface CLXCacheRefillDecision ()
+@property (nonatomic, assign, readwrite) NSInteger targetDepth;
+@property (nonatomic, assign, readwrite) NSInteger auctionsToStart;
+@property (nonatomic, assign, readwrite) NSTimeInterval deferral;
+@property (nonatomic, assign, readwrite) double showRate;
+@property (nonatomic, assign, readwrite) double readiness;
+@end
+
+@implementation CLXCacheRefillDecision
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"CLXCacheRefillDecision{target=%ld, start=%ld, defer=%.1fs, rate=%.4f/s, readiness=%.2f}",
+            (long)self.targetDepth, (long)self.auctionsToStart, self.deferral, self.showRate, self.readiness];
+}
+
+@end
+
+@interface CLXCacheRefillController ()
+
+@property (nonatomic, copy) NSString *placementID;
+@property (nonatomic, assign) double readinessTarget;
+@property (nonatomic, assign) NSTimeInterval showInterval;
+@property (nonatomic, assign) NSTimeInterval lastShowAt;
+@property (nonatomic, assign) BOOL hasShown;
+@property (nonatomic, assign) NSTimeInterval refillDuration;
+@property (nonatomic, assign) double fillRate;
+// Ads that expired since the last show, and when the deferred replacement may start
+@property (nonatomic, assign) NSInteger expiredSinceShow;
+@property (nonatomic, assign) NSTimeInterval deferredUntil;
+// Network -> EWMA lifetime, and -> ads cached, for the fill-weighted lifetime
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *lifetimeByNetwork;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *fillsByNetwork;
+@property (nonatomic, strong) CLXLogger *logger;
+
+@end
+
+@implementation CLXCacheRefillController
+
+- (instancetype)initWithPlacementID:(NSString *)placementID
+                    readinessTarget:(double)readinessTarget
+                           maxDepth:(NSInteger)maxDepth {
+    self = [super init];
+    if (self) {
+        _placementID = [placementID copy];
+        _readinessTarget = (readinessTarget > 0 && readinessTarget < 1) ? readinessTarget : CLXCacheRefillDefaultReadinessTarget;
+        _maxDepth = MAX(maxDepth, 1);
+        _maxConcurrentAuctions = 2;
+        _showInterval = kCLXRefillPriorShowInterval;
+        _refillDuration = kCLXRefillPriorDuration;
+        _fillRate = kCLXRefillPriorFillRate;
+        _lifetimeByNetwork = [NSMutableDictionary dictionary];
+        _fillsByNetwork = [NSMutableDictionary dictionary];
+        _logger = [[CLXLogger alloc] initWithCategory:@"CacheRefillController"];
+    }
+    return self;
+}
+
+#pragma mark - Observations
+
+- (void)noteShowWithAdReady:(BOOL)ready {
+    NSTimeInterval now = [self _now];
+    if (self.hasShown) {
+        self.showInterval = [self _ewma:self.showInterval sample:MAX(now - self.lastShowAt, 0.001)];
+    }
+    self.hasShown = YES;
+    self.lastShowAt = now;
+    self.expiredSinceShow = 0;
+    self.deferredUntil = 0;
+    [self _track:ready ? CLXMetricsTypeCacheShowReady : CLXMetricsTypeCacheShowMiss latency:0];
+}
+
+- (void)noteRefillFinishedAfter:(NSTimeInterval)duration filled:(BOOL)filled {
+    self.refillDuration = [self _ewma:self.refillDuration sample:MAX(duration, 0)];
+    self.fillRate = [self _ewma:self.fillRate sample:filled ? 1.0 : 0.0];
+}
+
+- (void)noteAdCachedFromNetwork:(NSString *)network lifetime:(NSTimeInterval)lifetime {
+    NSNumber *known = self.lifetimeByNetwork[network];
+    self.lifetimeByNetwork[network] = @(known ? [self _ewma:known.doubleValue sample:lifetime] : lifetime);
+    self.fillsByNetwork[network] = @(self.fillsByNetwork[network].integerValue + 1);
+}
+
+- (void)noteAdExpiredFromNetwork:(NSString *)network cachedFor:(NSTimeInterval)cachedFor {
+    // An ad can expire before its advertised lifetime (the network says so); trust what was seen
+    NSNumber *known = self.lifetimeByNetwork[network];
+    if (!known || cachedFor < known.doubleValue) {
+        self.lifetimeByNetwork[network] = @(known ? [self _ewma:known.doubleValue sample:cachedFor] : cachedFor);
+    }
+    self.expiredSinceShow += 1;
+    [self _track:CLXMetricsTypeCacheAdExpired latency:(NSInteger)(cachedFor * 1000)];
+    [self.logger debug:[NSString stringWithFormat:@"⏰ [CacheRefillController] %@ ad expired unused after %.0fs on %@",
+                        network, cachedFor, self.placementID]];
+}
+
+#pragma mark - Estimates
+
+- (double)showRate {
+    NSTimeInterval interval = self.showInterval;
+    if (self.hasShown) {
+        // A session that has gone quiet is showing less often than its history says
+        interval = MAX(interval, [self _now] - self.lastShowAt);
+    }
+    return 1.0 / MAX(interval, 0.001);
+}
+
+- (NSTimeInterval)expectedLifetimeForNetwork:(NSString *)network {
+    NSNumber *lifetime = self.lifetimeByNetwork[network];
+    return lifetime ? lifetime.doubleValue : CLXCacheAdQueueDefaultTimeToLive;
+}
+
+- (NSTimeInterval)_expectedLifetime {
+    double weighted = 0;
+    NSInteger fills = 0;
+    for (NSString *network in self.lifetimeByNetwork) {
+        NSInteger count = MAX(self.fillsByNetwork[network].integerValue, 1);
+        weighted += self.lifetimeByNetwork[network].doubleValue * count;
+        fills += count;
+    }
+    return fills > 0 ? weighted / fills : CLXCacheAdQueueDefaultTimeToLive;
+}
+
+#pragma mark - Decision
+
+- (CLXCacheRefillDecision *)decisionWithCachedCount:(NSInteger)cachedCount
+                                       loadingCount:(NSInteger)loadingCount
+                                   auctionsInFlight:(NSInteger)auctionsInFlight {
+    double rate = [self showRate];
+    NSTimeInterval refillTime = self.refillDuration / MAX(self.fillRate, kCLXRefillMinFillRate);
+    double showsPerRefill = rate * refillTime;
+    NSTimeInterval lifetime = [self _expectedLifetime];
+
+    // Smallest supply that covers the shows of one refill with the target probability
+    NSInteger target = [[self class] _poissonQuantile:self.readinessTarget mean:showsPerRefill limit:self.maxDepth] + 1;
+    // More than the shows expected within an ad's lifetime would expire unused
+    NSInteger useful = MAX((NSInteger)floor(rate * lifetime), 1);
+    target = MAX(MIN(MIN(target, useful), self.maxDepth), 1);
+
+    NSInteger supply = cachedCount + loadingCount + auctionsInFlight;
+    NSInteger deficit = MAX(target - supply, 0);
+
+    CLXCacheRefillDecision *decision = [[CLXCacheRefillDecision alloc] init];
+    decision.targetDepth = target;
+    decision.showRate = rate;
+    decision.readiness = supply > 0 ? [[self class] _poissonCDF:supply - 1 mean:showsPerRefill] : 0;
+
+    // The last ad expired without a show: replace it only as late as the readiness target allows.
+    // With shows at rate r, starting d seconds late still finds an ad ready with probability
+    // exp(-r * (d + refill time)), so d = -ln(p) / r - refill time.
+    if (deficit > 0 && cachedCount == 0 && self.expiredSinceShow > 0) {
+        NSTimeInterval now = [self _now];
+        // Reported once per deferral; callers ask again on every cache change while it runs
+        if (self.deferredUntil == 0) {
+            NSTimeInterval deferral = MIN(-log(self.readinessTarget) / rate - refillTime, kCLXRefillMaxDeferral);
+            self.deferredUntil = deferral > 1.0 ? now + deferral : now;
+            if (deferral > 1.0) {
+                [self _track:CLXMetricsTypeCacheRefillDefer latency:(NSInteger)(deferral * 1000)];
+            }
+        }
+        if (now < self.deferredUntil) {
+            decision.deferral = self.deferredUntil - now;
+            [self.logger debug:[NSString stringWithFormat:@"📊 [CacheRefillController] %@ %@", self.placementID, decision]];
+            return decision;
+        }
+        self.expiredSinceShow = 0;
+        self.deferredUntil = 0;
+    }
+
+    NSInteger concurrency = showsPerRefill >= 1.0 ? self.maxConcurrentAuctions : 1;
+    decision.auctionsToStart = MAX(MIN(deficit, concurrency - auctionsInFlight), 0);
+    for (NSInteger i = 0; i < decision.auctionsToStart; i++) {
+        [self _track:CLXMetricsTypeCacheRefillStart latency:0];
+    }
+    if (decision.auctionsToStart > 0) {
+        [self.logger debug:[NSString stringWithFormat:@"📊 [CacheRefillController] %@ %@", self.placementID, decision]];
+    }
+    return decision;
+}
+
+// P(N <= k) for N ~ Poisson(mean)
++ (double)_poissonCDF:(NSInteger)k mean:(double)mean {
+    double term = exp(-mean);
+    double cdf = term;
+    for (NSInteger j = 1; j <= k; j++) {
+        term *= mean / j;
+        cdf += term;
+    }
+    return MIN(cdf, 1.0);
+}
+
+// Smallest k with P(N <= k) >= probability, stopping at limit
++ (NSInteger)_poissonQuantile:(double)probability mean:(double)mean limit:(NSInteger)limit {
+    double term = exp(-mean);
+    double cdf = term;
+    NSInteger k = 0;
+    while (cdf < probability && k < limit) {
+        k += 1;
+        term *= mean / k;
+        cdf += term;
+    }
+    return k;
+}
+
+#pragma mark - Helpers
+
+- (double)_ewma:(double)average sample:(double)sample {
+    return average + kCLXRefillEwmaAlpha * (sample - average);
+}
+
+- (NSTimeInterval)_now {
+    return self.clockForTesting ? self.clockForTesting() : [NSProcessInfo processInfo].systemUptime;
+}
+
+- (void)_track:(NSString *)metricType latency:(NSInteger)latencyMs {
+    id<CLXMetricsTrackerProtocol> metricsTracker = self.metricsTracker ?: [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
+    [metricsTracker trackPerformanceMetric:metricType value:latencyMs];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -18,6 +18,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) NSInteger attempt;
 @property (nonatomic, assign) NSTimeInterval initialDelay;
 @property (nonatomic, assign) NSTimeInterval maxDelay;
+@property (nonatomic, assign) NSTimeInterval previousDelay;
 
 @end
 
@@ -32,6 +33,7 @@ NS_ASSUME_NONNULL_BEGIN
         _attempt = 0;
         _initialDelay = initialDelay;
         _maxDelay = maxDelay;
+        _previousDelay = initialDelay;
     }
     return self;
 }
@@ -59,16 +61,35 @@ NS_ASSUME_NONNULL_BEGIN
         return 0;
     }
     
-    NSTimeInterval delay = MIN(self.initialDelay * pow(2.0, (double)self.attempt), self.maxDelay);
+    double unit = self.randomSourceForTesting ? self.randomSourceForTesting() : [[self class] randomUnit];
+    NSTimeInterval delay = [[self class] decorrelatedDelayAfter:self.previousDelay
+                                                      baseDelay:self.initialDelay
+                                                       maxDelay:self.maxDelay
+                                                           unit:unit];
+    self.previousDelay = delay;
     self.attempt += 1;
     return delay;
 }
 
 - (NSTimeInterval)reset {
     self.attempt = 0;
+    self.previousDelay = self.initialDelay;
     return 0;
 }
 
++ (NSTimeInterval)decorrelatedDelayAfter:(NSTimeInterval)previousDelay
+                               baseDelay:(NSTimeInterval)baseDelay
+                                maxDelay:(NSTimeInterval)maxDelay
+                                    unit:(double)unit {
+    NSTimeInterval upper = MAX(previousDelay * 3.0, baseDelay);
+    NSTimeInterval delay = baseDelay + (upper - baseDelay) * MIN(MAX(unit, 0.0), 1.0);
+    return MIN(delay, maxDelay);
+}
+
++ (double)randomUnit {
+    return (double)arc4random() / ((double)UINT32_MAX + 1.0);
+}
+
 @end
 
 NS_ASSUME_NONNULL_END 
\ No newline at end of file
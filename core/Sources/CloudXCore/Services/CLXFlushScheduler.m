@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXFlushScheduler.m
+ * @brief Dispatch-source based flush scheduler shared by the telemetry pipelines
+ */
+
+#import <CloudXCore/CLXFlushScheduler.h>
+#import <CloudXCore/CLXLogger.h>
+#import <UIKit/UIKit.h>
+
+@interface CLXFlushScheduler ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, copy) CLXFlushBlock flushBlock;
+@property (nonatomic, strong) CLXLogger *logger;
+
+// State below is accessed only on queue
+@property (nonatomic, assign, readwrite) BOOL isRunning;
+@property (nonatomic, assign, readwrite) BOOL isPaused;
+@property (nonatomic, assign) BOOL flushInFlight;
+@property (nonatomic, assign) BOOL flushRequestedDuringFlight;
+@property (nonatomic, assign) BOOL flushDeferredWhilePaused;
+@property (nonatomic, assign) NSUInteger pendingEvents;
+@property (nonatomic, assign) NSUInteger pendingBytes;
+@property (nonatomic, strong, nullable) dispatch_source_t timer;
+
+@property (nonatomic, assign) BOOL usesVirtualClock;
+@property (nonatomic, assign) NSTimeInterval virtualNow;
+@property (nonatomic, assign, readwrite) NSTimeInterval nextFireTimeForTesting;
+
+@property (nonatomic, strong, nullable) id didEnterBackgroundObserver;
+@property (nonatomic, strong, nullable) id willEnterForegroundObserver;
+@end
+
+@implementation CLXFlushScheduler
+
+- (instancetype)initWithName:(NSString *)name
+                    interval:(NSTimeInterval)interval
+                       queue:(dispatch_queue_t)queue
+                  flushBlock:(CLXFlushBlock)flushBlock {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _interval = interval;
+        _queue = queue;
+        _flushBlock = [flushBlock copy];
+        _logger = [[CLXLogger alloc] initWithCategory:@"FlushScheduler"];
+        _jitterFraction = 0.1;
+        _pausesInBackground = YES;
+        _nextFireTimeForTesting = -1;
+
+        // Lets callers already running on queue act inline instead of re-dispatching
+        dispatch_queue_set_specific(queue, (__bridge const void *)self, (__bridge void *)self, NULL);
+
+        __weak typeof(self) weakSelf = self;
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        _didEnterBackgroundObserver = [center addObserverForName:UIApplicationDidEnterBackgroundNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification * _Nonnull note) {
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf.pausesInBackground) {
+                [strongSelf pause];
+            }
+        }];
+        _willEnterForegroundObserver = [center addObserverForName:UIApplicationWillEnterForegroundNotification
+                                                           object:nil
+                                                            queue:nil
+                                                       usingBlock:^(NSNotification * _Nonnull note) {
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf.pausesInBackground) {
+                [strongSelf resume];
+            }
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_didEnterBackgroundObserver) {
+        [[NSNotificationCenter defaultCenter] removeObserver:_didEnterBackgroundObserver];
+    }
+    if (_willEnterForegroundObserver) {
+        [[NSNotificationCenter defaultCenter] removeObserver:_willEnterForegroundObserver];
+    }
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+        _timer = nil;
+    }
+    dispatch_queue_set_specific(_queue, (__bridge const void *)self, NULL, NULL);
+}
+
+#pragma mark - Public Methods
+
+- (void)start {
+    [self _performOnQueue:^{
+        self.isRunning = YES;
+        if (!self.isPaused) {
+            [self _armTimer];
+        }
+        [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Started with interval %.1fs", self.name, self.interval]];
+    }];
+}
+
+- (void)stop {
+    [self _performOnQueue:^{
+        if (!self.isRunning) {
+            return;
+        }
+        self.isRunning = NO;
+        self.flushRequestedDuringFlight = NO;
+        self.flushDeferredWhilePaused = NO;
+        self.pendingEvents = 0;
+        self.pendingBytes = 0;
+        [self _cancelTimer];
+        [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Stopped", self.name]];
+    }];
+}
+
+- (void)requestFlush {
+    [self _performOnQueue:^{
+        [self _triggerFlush];
+    }];
+}
+
+- (void)noteEnqueuedEvents:(NSUInteger)count bytes:(NSUInteger)bytes {
+    [self _performOnQueue:^{
+        self.pendingEvents += count;
+        self.pendingBytes += bytes;
+
+        BOOL eventThresholdReached = self.pendingEventThreshold > 0 && self.pendingEvents >= self.pendingEventThreshold;
+        BOOL bytesThresholdReached = self.pendingBytesThreshold > 0 && self.pendingBytes >= self.pendingBytesThreshold;
+        if (eventThresholdReached || bytesThresholdReached) {
+            [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Threshold reached (%lu events, %lu bytes)",
+                                self.name, (unsigned long)self.pendingEvents, (unsigned long)self.pendingBytes]];
+            [self _triggerFlush];
+        }
+    }];
+}
+
+- (void)pause {
+    [self _performOnQueue:^{
+        if (self.isPaused) {
+            return;
+        }
+        self.isPaused = YES;
+        [self _cancelTimer];
+        [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Paused", self.name]];
+    }];
+}
+
+- (void)resume {
+    [self _performOnQueue:^{
+        if (!self.isPaused) {
+            return;
+        }
+        self.isPaused = NO;
+        if (!self.isRunning) {
+            return;
+        }
+
+        if (self.flushDeferredWhilePaused) {
+            self.flushDeferredWhilePaused = NO;
+            [self _triggerFlush];
+        } else {
+            [self _armTimer];
+        }
+        [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Resumed", self.name]];
+    }];
+}
+
+#pragma mark - Testing Support
+
+- (void)enableVirtualClockForTesting {
+    [self _performOnQueueSync:^{
+        [self _cancelTimer];
+        self.usesVirtualClock = YES;
+        self.virtualNow = 0;
+    }];
+}
+
+- (void)advanceVirtualClockBy:(NSTimeInterval)seconds {
+    [self _performOnQueueSync:^{
+        if (!self.usesVirtualClock) {
+            return;
+        }
+
+        NSTimeInterval target = self.virtualNow + seconds;
+        while (self.nextFireTimeForTesting >= 0 && self.nextFireTimeForTesting <= target) {
+            self.virtualNow = self.nextFireTimeForTesting;
+            [self _timerFired];
+        }
+        self.virtualNow = target;
+    }];
+}
+
+#pragma mark - Private Methods
+
+- (void)_performOnQueue:(dispatch_block_t)block {
+    if (dispatch_get_specific((__bridge const void *)self)) {
+        block();
+    } else {
+        dispatch_async(self.queue, block);
+    }
+}
+
+- (void)_performOnQueueSync:(dispatch_block_t)block {
+    if (dispatch_get_specific((__bridge const void *)self)) {
+        block();
+    } else {
+        dispatch_sync(self.queue, block);
+    }
+}
+
+- (NSTimeInterval)_jitteredInterval {
+    double random = self.randomSourceForTesting ? self.randomSourceForTesting() : (double)arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+    double jitter = MIN(MAX(self.jitterFraction, 0.0), 1.0);
+    return self.interval * (1.0 + jitter * (2.0 * random - 1.0));
+}
+
+/**
+ * Arms a one-shot timer for the next jittered deadline. Re-arming after each fire
+ * gives every cycle fresh jitter and restarts the cadence after threshold flushes.
+ */
+- (void)_armTimer {
+    [self _cancelTimer];
+
+    if (!self.isRunning || self.isPaused || self.interval <= 0) {
+        return;
+    }
+
+    NSTimeInterval delay = [self _jitteredInterval];
+    if (self.usesVirtualClock) {
+        self.nextFireTimeForTesting = self.virtualNow + delay;
+        return;
+    }
+
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    uint64_t delayNanos = (uint64_t)(delay * NSEC_PER_SEC);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)delayNanos), DISPATCH_TIME_FOREVER, delayNanos / 10);
+
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(timer, ^{
+        [weakSelf _timerFired];
+    });
+    dispatch_resume(timer);
+    self.timer = timer;
+}
+
+- (void)_cancelTimer {
+    if (self.timer) {
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+    }
+    self.nextFireTimeForTesting = -1;
+}
+
+- (void)_timerFired {
+    if (!self.isRunning || self.isPaused) {
+        return;
+    }
+
+    if (self.flushInFlight) {
+        // The completion of the current flush runs the follow-up; keep the cadence going
+        self.flushRequestedDuringFlight = YES;
+        [self _armTimer];
+        return;
+    }
+
+    [self _beginFlush];
+}
+
+- (void)_triggerFlush {
+    if (!self.isRunning) {
+        return;
+    }
+
+    if (self.isPaused) {
+        self.flushDeferredWhilePaused = YES;
+        return;
+    }
+
+    if (self.flushInFlight) {
+        self.flushRequestedDuringFlight = YES;
+        return;
+    }
+
+    [self _beginFlush];
+}
+
+- (void)_beginFlush {
+    self.flushInFlight = YES;
+    self.flushRequestedDuringFlight = NO;
+    self.pendingEvents = 0;
+    self.pendingBytes = 0;
+    [self _armTimer];
+
+    [self.logger debug:[NSString stringWithFormat:@"⏱️ [FlushScheduler:%@] Flushing", self.name]];
+
+    __block BOOL completed = NO;
+    __weak typeof(self) weakSelf = self;
+    self.flushBlock(^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        [strongSelf _performOnQueue:^{
+            if (completed) {
+                return;
+            }
+            completed = YES;
+            [strongSelf _flushDidComplete];
+        }];
+    });
+}
+
+- (void)_flushDidComplete {
+    self.flushInFlight = NO;
+
+    if (self.flushRequestedDuringFlight) {
+        self.flushRequestedDuringFlight = NO;
+        [self _triggerFlush];
+    }
+}
+
+@end
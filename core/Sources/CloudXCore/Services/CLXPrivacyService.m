@@ -14,6 +14,7 @@
 #import <CloudXCore/CLXUserDefaultsKeys.h>
 #import <CloudXCore/CLXGPPProvider.h>
 #import <CloudXCore/CLXGeoLocationService.h>
+#import <CloudXCore/CLXBidRequestTemplate.h>
 
 // Private category for internal methods (not exposed in public header)
 // These methods are temporarily private because server-side support for GDPR/CCPA is not implemented
@@ -177,6 +178,7 @@
         [[NSUserDefaults standardUserDefaults] removeObjectForKey:kCLXPrivacyHashedUserIdKey];
     }
     [[NSUserDefaults standardUserDefaults] synchronize];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
 }
 
 - (nullable NSString *)hashedGeoIp {
@@ -193,6 +195,7 @@
         [[NSUserDefaults standardUserDefaults] removeObjectForKey:kCLXPrivacyHashedGeoIpKey];
     }
     [[NSUserDefaults standardUserDefaults] synchronize];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
 }
 
 #pragma mark - Public Privacy Setters
@@ -205,6 +208,7 @@
         [[NSUserDefaults standardUserDefaults] removeObjectForKey:kCLXPrivacyCCPAPrivacyKey];
     }
     [[NSUserDefaults standardUserDefaults] synchronize];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
 }
 
 - (void)setHasUserConsent:(nullable NSNumber *)hasUserConsent {
@@ -215,6 +219,7 @@
         [[NSUserDefaults standardUserDefaults] removeObjectForKey:kCLXPrivacyGDPRAppliesKey];
     }
     [[NSUserDefaults standardUserDefaults] synchronize];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
 }
 
 - (void)setIsAgeRestrictedUser:(nullable NSNumber *)isAgeRestrictedUser {
@@ -225,6 +230,7 @@
         [[NSUserDefaults standardUserDefaults] removeObjectForKey:kCLXPrivacyCOPPAAppliesKey];
     }
     [[NSUserDefaults standardUserDefaults] synchronize];
+    [[NSNotificationCenter defaultCenter] postNotificationName:CLXBidRequestInputsDidChangeNotification object:self];
 }
 
 - (void)setDoNotSell:(nullable NSNumber *)doNotSell {
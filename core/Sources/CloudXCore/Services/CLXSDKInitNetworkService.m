@@ -118,7 +118,7 @@ static NSString *const kAPIRequestKeyIfa = @"ifa";
     
     // Serialize the JSON dictionary to NSData
     NSError *jsonError;
-    NSData *requestBodyData = [NSJSONSerialization dataWithJSONObject:request.json options:NSJSONWritingPrettyPrinted error:&jsonError];
+    NSData *requestBodyData = [NSJSONSerialization dataWithJSONObject:request.json options:0 error:&jsonError];
     if (jsonError) {
         [self.logger error:[NSString stringWithFormat:@"❌ [SDKInitNetworkService] JSON serialization failed: %@", jsonError]];
         if (completion) {
@@ -127,9 +127,7 @@ static NSString *const kAPIRequestKeyIfa = @"ifa";
         return;
     }
     
-    // Debug: Print the request payload
-    NSString *requestPayloadString = [[NSString alloc] initWithData:requestBodyData encoding:NSUTF8StringEncoding];
-    [self.logger debug:[NSString stringWithFormat:@"📋 [SDKInitNetworkService] Request Payload:\n%@", requestPayloadString]];
+    CLX_LOG_DEBUG(self.logger, @"📋 [SDKInitNetworkService] Request payload: %lu bytes", (unsigned long)requestBodyData.length);
     
     // Track SDK init network call latency
     NSDate *sdkInitStartTime = [NSDate date];
@@ -290,6 +288,7 @@ static NSString *const kAPIRequestKeyIfa = @"ifa";
     config.impressionTrackerURL = response[@"impressionTrackerURL"];
     config.metricsEndpointURL = response[@"metricsEndpointURL"];
     config.winLossNotificationURL = response[@"winLossNotificationURL"];
+    config.winLossNotificationBatchURL = response[@"winLossNotificationBatchURL"];
     
     // Parse metrics configuration from server response
     NSDictionary *metricsConfigDict = response[@"metricsConfig"];
@@ -359,6 +358,16 @@ static NSString *const kAPIRequestKeyIfa = @"ifa";
             placement.bidResponseTimeoutMs = [placementDict[@"bidResponseTimeoutMs"] integerValue];
             placement.adLoadTimeoutMs = [placementDict[@"adLoadTimeoutMs"] integerValue];
             placement.bannerRefreshRateMs = [placementDict[@"bannerRefreshRateMs"] integerValue];
+            if (placementDict[@"hedgedLoadConcurrency"]) {
+                placement.hedgedLoadConcurrency = MAX([placementDict[@"hedgedLoadConcurrency"] integerValue], 1);
+            }
+            if (placementDict[@"hedgedLoadDelayMs"]) {
+                placement.hedgedLoadDelayMs = MAX([placementDict[@"hedgedLoadDelayMs"] integerValue], 0);
+            }
+            if (placementDict[@"cacheReadinessTarget"]) {
+                double target = [placementDict[@"cacheReadinessTarget"] doubleValue];
+                placement.cacheReadinessTarget = MIN(MAX(target, 0.5), 0.99);
+            }
             [placements addObject:placement];
         }
         config.placements = [placements copy];
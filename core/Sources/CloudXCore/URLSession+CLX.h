@@ -4,6 +4,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface NSURLSession (CloudX)
 
+/**
+ * Returns the shared SDK session for an identifier: "auction" and "init" get their own
+ * sessions, anything else shares the tracking session. See CLXURLSessionProvider.
+ */
 + (NSURLSession *)cloudxSessionWithIdentifier:(NSString *)identifier;
 
 @end
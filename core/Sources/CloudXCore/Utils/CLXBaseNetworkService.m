@@ -8,8 +8,15 @@
  */
 
 #import <CloudXCore/CLXBaseNetworkService.h>
+#import <CloudXCore/CLXAuctionDeadline.h>
 #import <CloudXCore/CLXError.h>
 #import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXPayloadCapture.h>
+#import <CloudXCore/CLXRetryBudget.h>
+#import <CloudXCore/CLXExponentialBackoffStrategy.h>
+
+// Retry delay when the caller gives none (V1 spec)
+static const NSTimeInterval kCLXDefaultRetryDelay = 1.0;
 
 @interface CLXBaseNetworkService ()
 @property (nonatomic, strong) CLXLogger *logger;
@@ -28,6 +35,8 @@
     if (self) {
         _baseURL = [baseURL copy];
         _urlSession = urlSession;
+        _retryBudget = [CLXRetryBudget shared];
+        _maxRetryDelay = 30.0;
         _logger = [[CLXLogger alloc] initWithCategory:@"BaseNetworkService"];
     }
     return self;
@@ -66,7 +75,53 @@
                             headers:headers
                          maxRetries:maxRetries
                              delay:delay
+                           deadline:nil
+                         completion:completion];
+}
+
+/**
+ * @brief Executes a network request within an auction's time budget
+ * @param deadline Auction deadline bounding every attempt and retry; may be nil
+ */
+- (void)executeRequestWithEndpoint:(NSString *)endpoint
+                    urlParameters:(nullable NSDictionary *)urlParameters
+                     requestBody:(nullable NSData *)requestBody
+                         headers:(nullable NSDictionary *)headers
+                      maxRetries:(NSInteger)maxRetries
+                          delay:(NSTimeInterval)delay
+                        deadline:(nullable CLXAuctionDeadline *)deadline
+                     completion:(void (^)(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion {
+    [self executeRequestWithEndpoint:endpoint
+                      urlParameters:urlParameters
+                        requestBody:requestBody
+                            headers:headers
+                         maxRetries:maxRetries
+                             delay:delay
+                           deadline:deadline
+                        rawResponse:NO
+                      currentAttempt:0
+                       previousDelay:0
+                         completion:completion];
+}
+
+- (void)executeRawRequestWithEndpoint:(NSString *)endpoint
+                       urlParameters:(nullable NSDictionary *)urlParameters
+                        requestBody:(nullable NSData *)requestBody
+                            headers:(nullable NSDictionary *)headers
+                         maxRetries:(NSInteger)maxRetries
+                              delay:(NSTimeInterval)delay
+                           deadline:(nullable CLXAuctionDeadline *)deadline
+                         completion:(void (^)(NSData * _Nullable data, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion {
+    [self executeRequestWithEndpoint:endpoint
+                      urlParameters:urlParameters
+                        requestBody:requestBody
+                            headers:headers
+                         maxRetries:maxRetries
+                             delay:delay
+                           deadline:deadline
+                        rawResponse:YES
                       currentAttempt:0
+                       previousDelay:0
                          completion:completion];
 }
 
@@ -86,7 +141,10 @@
  * @param headers Dictionary of request headers
  * @param maxRetries Maximum number of retry attempts
  * @param delay Delay between retry attempts in seconds
+ * @param deadline Auction deadline bounding every attempt and retry; may be nil
+ * @param rawResponse Return the response body as NSData instead of parsing it as JSON
  * @param currentAttempt Current attempt number (0 = initial request)
+ * @param previousDelay Delay before this attempt, which the next jittered delay grows from; 0 for the initial request
  * @param completion Completion handler called with the response or error
  */
 - (void)executeRequestWithEndpoint:(NSString *)endpoint
@@ -95,13 +153,35 @@
                          headers:(nullable NSDictionary *)headers
                       maxRetries:(NSInteger)maxRetries
                           delay:(NSTimeInterval)delay
+                        deadline:(nullable CLXAuctionDeadline *)deadline
+                     rawResponse:(BOOL)rawResponse
                     currentAttempt:(NSInteger)currentAttempt
+                     previousDelay:(NSTimeInterval)previousDelay
                      completion:(void (^)(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled))completion {
     
-    [self.logger debug:[NSString stringWithFormat:@"🔧 [BaseNetworkService] executeRequestWithEndpoint - Endpoint: %@, Retries: %ld", endpoint, (long)maxRetries]];
+    CLX_LOG_DEBUG(self.logger, @"🔧 [BaseNetworkService] executeRequestWithEndpoint - Endpoint: %@, Retries: %ld", endpoint, (long)maxRetries);
+    
+    // Nothing sent after the auction deadline could be used
+    if (deadline.isExpired) {
+        CLX_LOG_ERROR(self.logger, @"⏱️ [BaseNetworkService] Auction deadline passed before attempt %ld, not sending", (long)(currentAttempt + 1));
+        if (completion) {
+            completion(nil, [CLXError errorWithCode:CLXErrorCodeNetworkTimeout description:@"Auction deadline exceeded"], NO);
+        }
+        return;
+    }
     
     // Build complete URL with query parameters
     NSURLComponents *components = [[NSURLComponents alloc] initWithString:[self.baseURL stringByAppendingString:endpoint]];
+    NSString *host = components.host;
+    
+    // The host is overloaded; let its cooldown run instead of adding load
+    if (currentAttempt == 0 && ![self.retryBudget shouldAllowRequestToHost:host]) {
+        CLX_LOG_ERROR(self.logger, @"🔌 [BaseNetworkService] Circuit for %@ open, not sending %@", host, endpoint);
+        if (completion) {
+            completion(nil, [CLXError errorWithCode:CLXErrorCodeServiceUnavailable description:@"Server overloaded, circuit open"], NO);
+        }
+        return;
+    }
     
     // Preserve existing query items from base URL
     NSMutableArray *queryItems = [NSMutableArray array];
@@ -121,24 +201,34 @@
         components.queryItems = queryItems;
     }
     
-    [self.logger debug:[NSString stringWithFormat:@"📊 [BaseNetworkService] Final URL: %@", components.URL]];
+    CLX_LOG_DEBUG(self.logger, @"📊 [BaseNetworkService] Final URL: %@", components.URL);
     
     // Configure HTTP request with method, body, and headers
     NSMutableURLRequest *request = [[NSMutableURLRequest alloc] initWithURL:components.URL];
     request.HTTPMethod = requestBody ? @"POST" : @"GET";
     request.HTTPBody = requestBody;
+    if (deadline) {
+        request.timeoutInterval = [deadline timeoutBoundedBy:request.timeoutInterval];
+    }
     
     NSMutableDictionary *requestHeaders = [[self headers] mutableCopy];
     [requestHeaders addEntriesFromDictionary:headers ?: @{}];
     request.allHTTPHeaderFields = requestHeaders;
     
-    [self.logger debug:[NSString stringWithFormat:@"📊 [BaseNetworkService] HTTP %@ request prepared", request.HTTPMethod]];
+    CLX_LOG_DEBUG(self.logger, @"📊 [BaseNetworkService] HTTP %@ request prepared", request.HTTPMethod);
+    
+    // Debug capture keeps the encoded body as-is; nothing is re-serialized for logging
+    CLXPayloadCapture *payloadCapture = [CLXPayloadCapture shared];
+    if (requestBody && payloadCapture.enabled) {
+        [payloadCapture recordRequestBody:requestBody url:request.URL];
+    }
     
     // Execute network request with completion handling
     [self.logger debug:@"🔧 [BaseNetworkService] Creating URLSessionDataTask..."];
+    NSTimeInterval attemptStart = [NSProcessInfo processInfo].systemUptime;
     NSURLSessionDataTask *task = [self.urlSession dataTaskWithRequest:request
                                                   completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        [self.logger debug:[NSString stringWithFormat:@"🔧 [BaseNetworkService] Request completed - Data: %@, Error: %@", data ? @"YES" : @"NO", error ? error.localizedDescription : @"None"]];
+        CLX_LOG_DEBUG(self.logger, @"🔧 [BaseNetworkService] Request completed - Data: %@, Error: %@", data ? @"YES" : @"NO", error ? error.localizedDescription : @"None");
         
         // Initialize kill switch detection flag
         BOOL isKillSwitchEnabled = NO;
@@ -147,40 +237,69 @@
         
         // Log response status for debugging
         if (httpResponse) {
-            [self.logger debug:[NSString stringWithFormat:@"📊 [BaseNetworkService] HTTP response - Status: %ld", (long)httpResponse.statusCode]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [BaseNetworkService] HTTP response - Status: %ld", (long)httpResponse.statusCode);
         } else {
             [self.logger debug:@"📊 [BaseNetworkService] No HTTP response (network/timeout error)"];
         }
         
         // Determine if request should be retried based on error type
         BOOL shouldRetry = NO;
-        NSTimeInterval retryDelay = delay;
+        BOOL serverOverloaded = NO;
+        NSTimeInterval retryAfter = 0;
         
         // Check for network/timeout errors that warrant retry
         BOOL isNetworkOrTimeoutError = (error != nil && (!httpResponse || [self isNetworkTimeoutError:error]));
         if (isNetworkOrTimeoutError) {
-            [self.logger error:[NSString stringWithFormat:@"❌ [BaseNetworkService] Network/timeout error - Error: %@, Attempt: %ld/%ld", error.localizedDescription, (long)(currentAttempt + 1), (long)(maxRetries + 1)]];
+            CLX_LOG_ERROR(self.logger, @"❌ [BaseNetworkService] Network/timeout error - Error: %@, Attempt: %ld/%ld", error.localizedDescription, (long)(currentAttempt + 1), (long)(maxRetries + 1));
             shouldRetry = YES;
-            retryDelay = 1.0; // V1 spec: 1-second delay for network errors
         } else if (httpResponse && ((httpResponse.statusCode >= 500 && httpResponse.statusCode < 600) || httpResponse.statusCode == 429)) {
             // Check for server errors (5xx) or rate limiting (429) that warrant retry
-            [self.logger error:[NSString stringWithFormat:@"❌ [BaseNetworkService] Server error %ld - Attempt: %ld/%ld", (long)httpResponse.statusCode, (long)(currentAttempt + 1), (long)(maxRetries + 1)]];
+            CLX_LOG_ERROR(self.logger, @"❌ [BaseNetworkService] Server error %ld - Attempt: %ld/%ld", (long)httpResponse.statusCode, (long)(currentAttempt + 1), (long)(maxRetries + 1));
             shouldRetry = YES;
+            serverOverloaded = YES;
             
-            if (httpResponse.statusCode == 429) {
-                // Parse Retry-After header for rate limiting
-                NSString *retryAfterHeader = httpResponse.allHeaderFields[@"Retry-After"];
-                NSTimeInterval parsedDelay = [self parseRetryAfterHeader:retryAfterHeader];
-                retryDelay = parsedDelay > 0 ? parsedDelay : 1.0; // V1 spec: default 1s if missing
-            } else {
-                retryDelay = 1.0; // V1 spec: 1-second delay for 5xx errors
+            // 503 and other overload answers carry Retry-After as well as 429
+            retryAfter = [self parseRetryAfterHeader:httpResponse.allHeaderFields[@"Retry-After"]];
+        }
+        
+        // Only the server's own answers move the host's circuit; connectivity errors and
+        // timeouts from the caller's deadline say nothing about its health
+        if (serverOverloaded) {
+            [self.retryBudget recordFailureForHost:host retryAfter:retryAfter];
+        } else if (httpResponse && !isNetworkOrTimeoutError) {
+            [self.retryBudget recordSuccessForHost:host];
+        }
+        
+        // The server's wait wins; otherwise spread retries with decorrelated jitter
+        NSTimeInterval baseDelay = delay > 0 ? delay : kCLXDefaultRetryDelay;
+        NSTimeInterval retryDelay = retryAfter;
+        if (retryDelay <= 0) {
+            double unit = self.randomSourceForTesting ? self.randomSourceForTesting() : [CLXExponentialBackoffStrategy randomUnit];
+            retryDelay = [CLXExponentialBackoffStrategy decorrelatedDelayAfter:MAX(previousDelay, baseDelay)
+                                                                     baseDelay:baseDelay
+                                                                      maxDelay:MAX(self.maxRetryDelay, baseDelay)
+                                                                          unit:unit];
+        }
+        
+        // A retry that cannot complete before the auction deadline only wastes the budget
+        if (shouldRetry && currentAttempt < maxRetries && deadline) {
+            NSTimeInterval attemptDuration = [NSProcessInfo processInfo].systemUptime - attemptStart;
+            if (![deadline canFinishWithin:retryDelay + attemptDuration]) {
+                CLX_LOG_ERROR(self.logger, @"⏱️ [BaseNetworkService] Skipping retry, %.0fms left of auction budget", deadline.remaining * 1000);
+                shouldRetry = NO;
             }
         }
         
+        // Retries across all clients share one budget
+        if (shouldRetry && currentAttempt < maxRetries && ![self.retryBudget tryAcquireRetryForHost:host]) {
+            CLX_LOG_ERROR(self.logger, @"🚫 [BaseNetworkService] Retry budget spent or circuit open, not retrying");
+            shouldRetry = NO;
+        }
+        
         // Execute retry if conditions are met and attempts remain
         if (shouldRetry && currentAttempt < maxRetries) {
             NSInteger nextAttempt = currentAttempt + 1;
-            [self.logger debug:[NSString stringWithFormat:@"🔄 [BaseNetworkService] Retrying request (attempt %ld) after %.1fs delay", (long)(nextAttempt + 1), retryDelay]];
+            CLX_LOG_DEBUG(self.logger, @"🔄 [BaseNetworkService] Retrying request (attempt %ld) after %.1fs delay", (long)(nextAttempt + 1), retryDelay);
             dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(retryDelay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
                 [self executeRequestWithEndpoint:endpoint
                                    urlParameters:urlParameters
@@ -188,7 +307,10 @@
                                          headers:headers
                                       maxRetries:maxRetries
                                            delay:delay
+                                        deadline:deadline
+                                     rawResponse:rawResponse
                                    currentAttempt:nextAttempt
+                                    previousDelay:retryDelay
                                       completion:completion];
             });
             return;
@@ -208,9 +330,11 @@
         }
         
         // Log response data for debugging
+        if (data && payloadCapture.enabled) {
+            [payloadCapture recordResponseBody:data url:request.URL statusCode:httpResponse.statusCode];
+        }
         if (data) {
-            NSString *responseBody = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-            [self.logger debug:[NSString stringWithFormat:@"📊 [BaseNetworkService] Response body length: %lu", (unsigned long)responseBody.length]];
+            CLX_LOG_DEBUG(self.logger, @"📊 [BaseNetworkService] Response body length: %lu", (unsigned long)data.length);
         } else {
             [self.logger debug:@"📊 [BaseNetworkService] No response data received"];
         }
@@ -228,17 +352,21 @@
             
             
             
-            [self.logger debug:[NSString stringWithFormat:@"[BaseNetworkService] httpResponse.statusCode: %lu", httpResponse.statusCode]];
+            CLX_LOG_DEBUG(self.logger, @"[BaseNetworkService] httpResponse.statusCode: %lu", httpResponse.statusCode);
             
             
             
             [self.logger info:@"✅ [BaseNetworkService] HTTP status code indicates success"];
             // Parse JSON response data if present and non-empty
-            if (data && data.length > 0) {
+            if (rawResponse) {
+                if (completion) {
+                    completion(data.length > 0 ? data : nil, nil, isKillSwitchEnabled);
+                }
+            } else if (data && data.length > 0) {
                 NSError *jsonError;
                 id jsonResponse = [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonError];
                 if (jsonError) {
-                    [self.logger error:[NSString stringWithFormat:@"❌ [BaseNetworkService] JSON parsing failed: %@", jsonError]];
+                    CLX_LOG_ERROR(self.logger, @"❌ [BaseNetworkService] JSON parsing failed: %@", jsonError);
                     if (completion) {
                         completion(nil, jsonError, isKillSwitchEnabled);
                     }
@@ -257,7 +385,7 @@
             }
         } else {
             // Handle HTTP error status codes (non-2xx)
-            [self.logger error:[NSString stringWithFormat:@"❌ [BaseNetworkService] HTTP status code indicates error: %ld", (long)httpResponse.statusCode]];
+            CLX_LOG_ERROR(self.logger, @"❌ [BaseNetworkService] HTTP status code indicates error: %ld", (long)httpResponse.statusCode);
             if (completion) {
                 completion(nil, [CLXError errorWithHTTPStatusCode:httpResponse.statusCode], false);
             }
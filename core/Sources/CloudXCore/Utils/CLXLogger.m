@@ -6,6 +6,24 @@
 #import <CloudXCore/CLXLogger.h>
 #import <os/log.h>
 
+// Verbose flags come from the launch environment, which cannot change while the process runs
+static BOOL CLXLoggerVerbose = NO;
+static BOOL CLXLoggerFlutterVerbose = NO;
+
+static void CLXLoggerLoadFlags(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSDictionary<NSString *, NSString *> *environment = [[NSProcessInfo processInfo] environment];
+        CLXLoggerVerbose = [environment[@"CLOUDX_VERBOSE_LOG"] isEqualToString:@"1"];
+        CLXLoggerFlutterVerbose = [environment[@"CLOUDX_FLUTTER_VERBOSE_LOG"] isEqualToString:@"1"];
+    });
+}
+
+BOOL CLXLoggerIsEnabled(void) {
+    CLXLoggerLoadFlags();
+    return CLXLoggerVerbose || CLXLoggerFlutterVerbose;
+}
+
 @interface CLXLogger ()
 @property (nonatomic, copy) NSString *category;
 @property (nonatomic, strong) os_log_t osLog;
@@ -29,13 +47,10 @@
     if (self) {
         _category = [category copy];
         
-        // Check environment variables for logging control
-        NSString *verboseLog = [[NSProcessInfo processInfo] environment][@"CLOUDX_VERBOSE_LOG"];
-        NSString *flutterVerboseLog = [[NSProcessInfo processInfo] environment][@"CLOUDX_FLUTTER_VERBOSE_LOG"];
-        
-        // Set up logging based on environment variables
-        _verbose = [verboseLog isEqualToString:@"1"];
-        _flutterVerbose = [flutterVerboseLog isEqualToString:@"1"];
+        // Set up logging based on the process-wide environment flags
+        CLXLoggerLoadFlags();
+        _verbose = CLXLoggerVerbose;
+        _flutterVerbose = CLXLoggerFlutterVerbose;
         
         // Create os_log if we need system logging (either verbose flag)
         // Note: os_log entries won't appear in Flutter console, but will be visible in:
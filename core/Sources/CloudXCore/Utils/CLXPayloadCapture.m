@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXPayloadCapture.m
+ * @brief Opt-in ring buffer of recent network request and response bodies for debugging
+ */
+
+#import <CloudXCore/CLXPayloadCapture.h>
+#import <CloudXCore/CLXLogger.h>
+
+static const NSUInteger kCLXDefaultPayloadCaptureCapacity = 32;
+
+@interface CLXCapturedPayload ()
+@property (nonatomic, copy, readwrite) NSString *url;
+@property (nonatomic, assign, readwrite) CLXCapturedPayloadDirection direction;
+@property (nonatomic, strong, readwrite) NSData *body;
+@property (nonatomic, strong, readwrite) NSDate *timestamp;
+@property (nonatomic, assign, readwrite) NSInteger statusCode;
+@end
+
+@implementation CLXCapturedPayload
+
+- (nullable NSString *)bodyString {
+    return [[NSString alloc] initWithData:self.body encoding:NSUTF8StringEncoding];
+}
+
+- (NSString *)description {
+    if (self.direction == CLXCapturedPayloadDirectionRequest) {
+        return [NSString stringWithFormat:@"<request %@ (%lu bytes)>", self.url, (unsigned long)self.body.length];
+    }
+    return [NSString stringWithFormat:@"<response %ld %@ (%lu bytes)>", (long)self.statusCode, self.url, (unsigned long)self.body.length];
+}
+
+@end
+
+@interface CLXPayloadCapture ()
+@property (nonatomic, strong) NSMutableArray<CLXCapturedPayload *> *buffer;
+@property (nonatomic, assign) NSUInteger head; // Index of the oldest payload once the buffer is full
+@end
+
+@implementation CLXPayloadCapture
+
++ (instancetype)shared {
+    static CLXPayloadCapture *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _enabled = CLXLoggerIsEnabled();
+        _capacity = kCLXDefaultPayloadCaptureCapacity;
+        _buffer = [NSMutableArray arrayWithCapacity:_capacity];
+    }
+    return self;
+}
+
+- (void)setCapacity:(NSUInteger)capacity {
+    @synchronized (self) {
+        NSArray<CLXCapturedPayload *> *payloads = [self _orderedPayloadsLocked];
+        NSUInteger kept = MIN(payloads.count, capacity);
+        _capacity = capacity;
+        self.buffer = [[payloads subarrayWithRange:NSMakeRange(payloads.count - kept, kept)] mutableCopy];
+        self.head = 0;
+    }
+}
+
+- (NSArray<CLXCapturedPayload *> *)recentPayloads {
+    @synchronized (self) {
+        return [self _orderedPayloadsLocked];
+    }
+}
+
+- (void)recordRequestBody:(nullable NSData *)body url:(nullable NSURL *)url {
+    [self _recordBody:body url:url direction:CLXCapturedPayloadDirectionRequest statusCode:0];
+}
+
+- (void)recordResponseBody:(nullable NSData *)body url:(nullable NSURL *)url statusCode:(NSInteger)statusCode {
+    [self _recordBody:body url:url direction:CLXCapturedPayloadDirectionResponse statusCode:statusCode];
+}
+
+- (void)removeAllPayloads {
+    @synchronized (self) {
+        [self.buffer removeAllObjects];
+        self.head = 0;
+    }
+}
+
+#pragma mark - Private Methods
+
+- (void)_recordBody:(nullable NSData *)body
+                url:(nullable NSURL *)url
+          direction:(CLXCapturedPayloadDirection)direction
+         statusCode:(NSInteger)statusCode {
+    if (!self.enabled) {
+        return;
+    }
+
+    CLXCapturedPayload *payload = [[CLXCapturedPayload alloc] init];
+    payload.url = url.absoluteString ?: @"";
+    payload.direction = direction;
+    payload.body = [body copy] ?: [NSData data]; // NSData from the network stack is immutable, so this does not copy bytes
+    payload.timestamp = [NSDate date];
+    payload.statusCode = statusCode;
+
+    @synchronized (self) {
+        if (self.capacity == 0) {
+            return;
+        }
+        if (self.buffer.count < self.capacity) {
+            [self.buffer addObject:payload];
+        } else {
+            self.buffer[self.head] = payload;
+            self.head = (self.head + 1) % self.capacity;
+        }
+    }
+}
+
+- (NSArray<CLXCapturedPayload *> *)_orderedPayloadsLocked {
+    if (self.head == 0) {
+        return [self.buffer copy];
+    }
+    NSMutableArray<CLXCapturedPayload *> *ordered = [NSMutableArray arrayWithCapacity:self.buffer.count];
+    [ordered addObjectsFromArray:[self.buffer subarrayWithRange:NSMakeRange(self.head, self.buffer.count - self.head)]];
+    [ordered addObjectsFromArray:[self.buffer subarrayWithRange:NSMakeRange(0, self.head)]];
+    return ordered;
+}
+
+@end
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXRequestCompressor.m
+ * @brief Content-Encoding for bulk metrics and win/loss upload bodies
+ */
+
+#import <CloudXCore/CLXRequestCompressor.h>
+#import <CloudXCore/CLXMetricsConfig.h>
+#import <CloudXCore/CLXLogger.h>
+#import <zlib.h>
+
+const NSUInteger CLXRequestCompressorDefaultMinimumBodyBytes = 1024;
+
+@interface CLXRequestCompressor ()
+@property (nonatomic, strong) NSMutableSet<NSString *> *rejectingHosts;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXRequestCompressor
+
++ (instancetype)shared {
+    static CLXRequestCompressor *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _encoding = CLXContentEncodingIdentity;
+        _minimumBodyBytes = CLXRequestCompressorDefaultMinimumBodyBytes;
+        _rejectingHosts = [NSMutableSet set];
+        _logger = [[CLXLogger alloc] initWithCategory:@"RequestCompressor"];
+    }
+    return self;
+}
+
+- (void)applyMetricsConfig:(nullable CLXMetricsConfig *)config {
+    NSString *encoding = [config bulkContentEncoding];
+    if ([encoding isEqualToString:@"gzip"]) {
+        self.encoding = CLXContentEncodingGzip;
+    } else if ([encoding isEqualToString:@"deflate"]) {
+        self.encoding = CLXContentEncodingDeflate;
+    } else {
+        self.encoding = CLXContentEncodingIdentity;
+    }
+
+    NSNumber *minBytes = config.bulkCompressionMinBytes;
+    self.minimumBodyBytes = minBytes.integerValue > 0 ? minBytes.unsignedIntegerValue : CLXRequestCompressorDefaultMinimumBodyBytes;
+
+    CLX_LOG_DEBUG(self.logger, @"🔧 [RequestCompressor] Bulk bodies: %@ from %lu bytes",
+                  [[self class] headerValueForEncoding:self.encoding] ?: @"identity", (unsigned long)self.minimumBodyBytes);
+}
+
+- (nullable NSData *)compressedBody:(NSData *)body
+                             forURL:(nullable NSURL *)url
+                           encoding:(CLXContentEncoding *)encoding {
+    *encoding = CLXContentEncodingIdentity;
+    CLXContentEncoding configured = self.encoding;
+    if (configured == CLXContentEncodingIdentity || body.length < self.minimumBodyBytes) {
+        return nil;
+    }
+    if ([self hasHostRejectedCompression:url.host]) {
+        return nil;
+    }
+
+    NSData *compressed = [[self class] compressData:body encoding:configured];
+    if (!compressed || compressed.length >= body.length) {
+        return nil;
+    }
+
+    CLX_LOG_DEBUG(self.logger, @"📊 [RequestCompressor] %@ body %lu -> %lu bytes for %@",
+                  [[self class] headerValueForEncoding:configured], (unsigned long)body.length,
+                  (unsigned long)compressed.length, url.host);
+    *encoding = configured;
+    return compressed;
+}
+
+- (CLXContentEncoding)compressBodyOfRequest:(NSMutableURLRequest *)request {
+    CLXContentEncoding encoding = CLXContentEncodingIdentity;
+    NSData *compressed = request.HTTPBody ? [self compressedBody:request.HTTPBody forURL:request.URL encoding:&encoding] : nil;
+    if (compressed) {
+        request.HTTPBody = compressed;
+        [request setValue:[[self class] headerValueForEncoding:encoding] forHTTPHeaderField:@"Content-Encoding"];
+    }
+    return encoding;
+}
+
+- (BOOL)shouldRetryUncompressedAfterEncoding:(CLXContentEncoding)encoding
+                                  statusCode:(NSInteger)statusCode
+                                         url:(nullable NSURL *)url {
+    if (encoding == CLXContentEncodingIdentity) {
+        return NO;
+    }
+    // 415 is the RFC 7694 answer to an unsupported Content-Encoding; some servers send 400
+    if (statusCode != 415 && statusCode != 400) {
+        return NO;
+    }
+
+    NSString *host = url.host;
+    if (host) {
+        @synchronized (self.rejectingHosts) {
+            [self.rejectingHosts addObject:host];
+        }
+    }
+    CLX_LOG_ERROR(self.logger, @"⚠️ [RequestCompressor] %@ rejected %@ body (HTTP %ld), sending it uncompressed from now on",
+                  host ?: @"(unknown host)", [[self class] headerValueForEncoding:encoding], (long)statusCode);
+    return YES;
+}
+
+- (BOOL)hasHostRejectedCompression:(nullable NSString *)host {
+    if (!host) {
+        return NO;
+    }
+    @synchronized (self.rejectingHosts) {
+        return [self.rejectingHosts containsObject:host];
+    }
+}
+
+- (void)resetRejectedHosts {
+    @synchronized (self.rejectingHosts) {
+        [self.rejectingHosts removeAllObjects];
+    }
+}
+
++ (nullable NSData *)compressData:(NSData *)data encoding:(CLXContentEncoding)encoding {
+    if (encoding == CLXContentEncodingIdentity) {
+        return data;
+    }
+    if (data.length > UINT_MAX) {
+        return nil;
+    }
+
+    // 15 window bits give a zlib stream; adding 16 wraps it in a gzip header and trailer
+    int windowBits = (encoding == CLXContentEncodingGzip) ? 15 + 16 : 15;
+    z_stream stream = {0};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nil;
+    }
+
+    // deflateBound covers the whole output, so one Z_FINISH call is enough
+    uLong bound = deflateBound(&stream, (uLong)data.length);
+    NSMutableData *output = [NSMutableData dataWithLength:bound];
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    stream.next_out = (Bytef *)output.mutableBytes;
+    stream.avail_out = (uInt)bound;
+
+    int status = deflate(&stream, Z_FINISH);
+    uLong written = stream.total_out;
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) {
+        return nil;
+    }
+
+    output.length = written;
+    return output;
+}
+
++ (nullable NSString *)headerValueForEncoding:(CLXContentEncoding)encoding {
+    switch (encoding) {
+        case CLXContentEncodingGzip:
+            return @"gzip";
+        case CLXContentEncodingDeflate:
+            return @"deflate";
+        case CLXContentEncodingIdentity:
+            return nil;
+    }
+    return nil;
+}
+
+@end
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXRetryBudget.m
+ * @brief Retry budget shared by the SDK's network clients and their per-host circuit breakers
+ */
+
+#import <CloudXCore/CLXRetryBudget.h>
+#import <CloudXCore/CLXLogger.h>
+
+const double CLXRetryBudgetDefaultCapacity = 10.0;
+const NSInteger CLXRetryBudgetDefaultFailureThreshold = 5;
+const NSTimeInterval CLXRetryBudgetDefaultOpenInterval = 30.0;
+
+// Breaker state for one host; only touched while holding the budget's lock
+@interface CLXHostCircuit : NSObject
+@property (nonatomic, assign) NSInteger consecutiveFailures;
+@property (nonatomic, assign) BOOL open;
+@property (nonatomic, assign) NSTimeInterval openUntil;
+// Start of the half-open probe in flight, 0 when none
+@property (nonatomic, assign) NSTimeInterval probeStartedAt;
+@end
+
+@implementation CLXHostCircuit
+@end
+
+@interface CLXRetryBudget ()
+@property (nonatomic, assign) double tokens;
+@property (nonatomic, assign) NSTimeInterval lastRefillAt;
+// Lowercased host -> its breaker; requests without a host share the "" entry
+@property (nonatomic, strong) NSMutableDictionary<NSString *, CLXHostCircuit *> *circuits;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXRetryBudget
+
++ (instancetype)shared {
+    static CLXRetryBudget *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _capacity = CLXRetryBudgetDefaultCapacity;
+        _refillPerSecond = 0.1;
+        _successDeposit = 0.1;
+        _failureThreshold = CLXRetryBudgetDefaultFailureThreshold;
+        _openInterval = CLXRetryBudgetDefaultOpenInterval;
+        _tokens = CLXRetryBudgetDefaultCapacity;
+        _lastRefillAt = -1;
+        _circuits = [NSMutableDictionary dictionary];
+        _logger = [[CLXLogger alloc] initWithCategory:@"RetryBudget"];
+    }
+    return self;
+}
+
+#pragma mark - State
+
+- (CLXCircuitState)circuitStateForHost:(nullable NSString *)host {
+    @synchronized (self) {
+        return [self _stateOfCircuit:self.circuits[[self _keyForHost:host]] at:[self _now]];
+    }
+}
+
+- (double)availableTokens {
+    @synchronized (self) {
+        [self _refillAt:[self _now]];
+        return self.tokens;
+    }
+}
+
+- (CLXCircuitState)_stateOfCircuit:(nullable CLXHostCircuit *)circuit at:(NSTimeInterval)now {
+    if (!circuit.open) {
+        return CLXCircuitStateClosed;
+    }
+    return now < circuit.openUntil ? CLXCircuitStateOpen : CLXCircuitStateHalfOpen;
+}
+
+#pragma mark - Requests
+
+- (BOOL)shouldAllowRequestToHost:(nullable NSString *)host {
+    @synchronized (self) {
+        NSTimeInterval now = [self _now];
+        CLXHostCircuit *circuit = self.circuits[[self _keyForHost:host]];
+        switch ([self _stateOfCircuit:circuit at:now]) {
+            case CLXCircuitStateClosed:
+                return YES;
+            case CLXCircuitStateOpen:
+                return NO;
+            case CLXCircuitStateHalfOpen:
+                // A probe that never reported back frees its slot after one cooldown
+                if (circuit.probeStartedAt > 0 && now - circuit.probeStartedAt < self.openInterval) {
+                    return NO;
+                }
+                circuit.probeStartedAt = now;
+                CLX_LOG_DEBUG(self.logger, @"🔌 [RetryBudget] Circuit for %@ half-open, letting a probe through", host);
+                return YES;
+        }
+    }
+}
+
+- (BOOL)tryAcquireRetryForHost:(nullable NSString *)host {
+    @synchronized (self) {
+        NSTimeInterval now = [self _now];
+        if ([self _stateOfCircuit:self.circuits[[self _keyForHost:host]] at:now] != CLXCircuitStateClosed) {
+            return NO;
+        }
+        [self _refillAt:now];
+        if (self.tokens < 1.0) {
+            CLX_LOG_DEBUG(self.logger, @"🚫 [RetryBudget] Budget exhausted (%.2f tokens), not retrying", self.tokens);
+            return NO;
+        }
+        self.tokens -= 1.0;
+        return YES;
+    }
+}
+
+- (void)recordSuccessForHost:(nullable NSString *)host {
+    @synchronized (self) {
+        NSTimeInterval now = [self _now];
+        [self _refillAt:now];
+        self.tokens = MIN(self.tokens + self.successDeposit, self.capacity);
+        NSString *key = [self _keyForHost:host];
+        if (self.circuits[key].open) {
+            CLX_LOG_DEBUG(self.logger, @"🔌 [RetryBudget] %@ answered, circuit closed", host);
+        }
+        [self.circuits removeObjectForKey:key];
+    }
+}
+
+- (void)recordFailureForHost:(nullable NSString *)host retryAfter:(NSTimeInterval)retryAfter {
+    @synchronized (self) {
+        NSTimeInterval now = [self _now];
+        NSString *key = [self _keyForHost:host];
+        CLXHostCircuit *circuit = self.circuits[key];
+        if (!circuit) {
+            circuit = [[CLXHostCircuit alloc] init];
+            self.circuits[key] = circuit;
+        }
+        circuit.consecutiveFailures += 1;
+        BOOL probeFailed = circuit.open && circuit.probeStartedAt > 0;
+        if (probeFailed || (!circuit.open && circuit.consecutiveFailures >= self.failureThreshold)) {
+            circuit.open = YES;
+            circuit.openUntil = now + MAX(self.openInterval, retryAfter);
+            circuit.probeStartedAt = 0;
+            CLX_LOG_ERROR(self.logger, @"🔌 [RetryBudget] Circuit for %@ open for %.0fs after %ld failed requests",
+                          host, circuit.openUntil - now, (long)circuit.consecutiveFailures);
+        } else if (circuit.open) {
+            // Requests sent before the circuit opened may still report; the server's wait wins
+            circuit.openUntil = MAX(circuit.openUntil, now + retryAfter);
+        }
+    }
+}
+
+- (void)reset {
+    @synchronized (self) {
+        self.tokens = self.capacity;
+        self.lastRefillAt = -1;
+        [self.circuits removeAllObjects];
+    }
+}
+
+#pragma mark - Helpers
+
+- (NSString *)_keyForHost:(nullable NSString *)host {
+    return host.lowercaseString ?: @"";
+}
+
+- (void)_refillAt:(NSTimeInterval)now {
+    if (self.lastRefillAt >= 0 && now > self.lastRefillAt) {
+        self.tokens = MIN(self.tokens + (now - self.lastRefillAt) * self.refillPerSecond, self.capacity);
+    }
+    self.lastRefillAt = now;
+}
+
+- (NSTimeInterval)_now {
+    NSTimeInterval (^clock)(void) = self.clockForTesting;
+    return clock ? clock() : [NSProcessInfo processInfo].systemUptime;
+}
+
+@end
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 CloudX. All rights reserved.
+ */
+
+/**
+ * @file CLXURLSessionProvider.m
+ * @brief SDK-owned URL sessions, one per kind of traffic
+ */
+
+#import <CloudXCore/CLXURLSessionProvider.h>
+#import <CloudXCore/CLXLogger.h>
+#import <CloudXCore/CLXDIContainer.h>
+#import <CloudXCore/CLXMetricsTrackerProtocol.h>
+#import <CloudXCore/CLXMetricsTrackerImpl.h>
+#import <CloudXCore/CLXMetricsType.h>
+
+@interface CLXURLSessionProvider () <NSURLSessionTaskDelegate>
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSURLSession *> *sessions;
+@property (nonatomic, strong) CLXLogger *logger;
+@end
+
+@implementation CLXURLSessionProvider {
+    NSInteger _openedConnectionCount;
+    NSInteger _reusedConnectionCount;
+}
+
++ (instancetype)shared {
+    static CLXURLSessionProvider *sharedInstance = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[self alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _sessions = [NSMutableDictionary dictionary];
+        _logger = [[CLXLogger alloc] initWithCategory:@"URLSessionProvider"];
+    }
+    return self;
+}
+
+- (NSURLSession *)sessionForPurpose:(CLXURLSessionPurpose)purpose {
+    @synchronized (self) {
+        NSURLSession *session = self.sessions[@(purpose)];
+        if (!session) {
+            // The session retains its delegate until it is invalidated
+            session = [NSURLSession sessionWithConfiguration:[[self class] configurationForPurpose:purpose]
+                                                    delegate:self
+                                               delegateQueue:nil];
+            session.sessionDescription = [NSString stringWithFormat:@"cloudx.sdk.%@", [[self class] _nameForPurpose:purpose]];
+            self.sessions[@(purpose)] = session;
+            CLX_LOG_DEBUG(self.logger, @"🔧 [URLSessionProvider] Created %@ session", session.sessionDescription);
+        }
+        return session;
+    }
+}
+
++ (NSURLSessionConfiguration *)configurationForPurpose:(CLXURLSessionPurpose)purpose {
+    NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
+    switch (purpose) {
+        case CLXURLSessionPurposeAuction:
+            // An auction has its own deadline; waiting for connectivity would only outlive it
+            config.waitsForConnectivity = NO;
+            config.timeoutIntervalForRequest = 10;
+            config.timeoutIntervalForResource = 15;
+            config.HTTPMaximumConnectionsPerHost = 4;
+            config.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+            config.URLCache = nil;
+            break;
+        case CLXURLSessionPurposeInit:
+            config.waitsForConnectivity = YES;
+            config.timeoutIntervalForRequest = 30;
+            config.timeoutIntervalForResource = 60;
+            config.HTTPMaximumConnectionsPerHost = 2;
+            break;
+        case CLXURLSessionPurposeTracking:
+            // Tracking tolerates queueing, so few connections kept warm beat many cold ones
+            config.waitsForConnectivity = YES;
+            config.timeoutIntervalForRequest = 30;
+            config.timeoutIntervalForResource = 120;
+            config.HTTPMaximumConnectionsPerHost = 2;
+            config.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+            config.URLCache = nil;
+            break;
+    }
+    return config;
+}
+
+- (void)invalidateSessions {
+    NSArray<NSURLSession *> *sessions;
+    @synchronized (self) {
+        sessions = self.sessions.allValues;
+        [self.sessions removeAllObjects];
+    }
+    for (NSURLSession *session in sessions) {
+        [session finishTasksAndInvalidate];
+    }
+}
+
+- (NSInteger)openedConnectionCount {
+    @synchronized (self) {
+        return _openedConnectionCount;
+    }
+}
+
+- (NSInteger)reusedConnectionCount {
+    @synchronized (self) {
+        return _reusedConnectionCount;
+    }
+}
+
+#pragma mark - NSURLSessionTaskDelegate
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+    id<CLXMetricsTrackerProtocol> metricsTracker = self.metricsTracker ?: [[CLXDIContainer shared] resolveType:ServiceTypeSingleton class:[CLXMetricsTrackerImpl class]];
+
+    for (NSURLSessionTaskTransactionMetrics *transaction in metrics.transactionMetrics) {
+        if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad) {
+            continue;
+        }
+        if (transaction.isReusedConnection) {
+            @synchronized (self) {
+                _reusedConnectionCount += 1;
+            }
+            NSTimeInterval latency = [transaction.responseEndDate timeIntervalSinceDate:transaction.fetchStartDate];
+            [metricsTracker trackPerformanceMetric:CLXMetricsTypeNetworkConnectionReused value:(NSInteger)(MAX(latency, 0) * 1000)];
+        } else {
+            @synchronized (self) {
+                _openedConnectionCount += 1;
+            }
+            // connectEnd covers the TLS handshake as well
+            NSTimeInterval connectTime = [transaction.connectEndDate timeIntervalSinceDate:transaction.connectStartDate];
+            [metricsTracker trackPerformanceMetric:CLXMetricsTypeNetworkConnectionNew value:(NSInteger)(MAX(connectTime, 0) * 1000)];
+        }
+        CLX_LOG_DEBUG(self.logger, @"📊 [URLSessionProvider] %@ %@ over %@ on a %@ connection",
+                      session.sessionDescription, task.originalRequest.URL.host, transaction.networkProtocolName ?: @"unknown protocol",
+                      transaction.isReusedConnection ? @"reused" : @"new");
+    }
+}
+
+#pragma mark - Private Methods
+
++ (NSString *)_nameForPurpose:(CLXURLSessionPurpose)purpose {
+    switch (purpose) {
+        case CLXURLSessionPurposeAuction:
+            return @"auction";
+        case CLXURLSessionPurposeInit:
+            return @"init";
+        case CLXURLSessionPurposeTracking:
+            return @"tracking";
+    }
+    return @"unknown";
+}
+
+@end
@@ -1,13 +1,16 @@
 #import <CloudXCore/URLSession+CLX.h>
+#import <CloudXCore/CLXURLSessionProvider.h>
 
 @implementation NSURLSession (CloudX)
 
 + (NSURLSession *)cloudxSessionWithIdentifier:(NSString *)identifier {
-    NSURLSessionConfiguration *config = [NSURLSessionConfiguration defaultSessionConfiguration];
-    config.waitsForConnectivity = YES;    
-    NSURLSession *urlSession = [NSURLSession sessionWithConfiguration:config];
-    urlSession.sessionDescription = [NSString stringWithFormat:@"cloudx.sdk.%@", identifier];
-    return urlSession;
+    CLXURLSessionPurpose purpose = CLXURLSessionPurposeTracking;
+    if ([identifier isEqualToString:@"auction"]) {
+        purpose = CLXURLSessionPurposeAuction;
+    } else if ([identifier isEqualToString:@"init"]) {
+        purpose = CLXURLSessionPurposeInit;
+    }
+    return [[CLXURLSessionProvider shared] sessionForPurpose:purpose];
 }
 
 @end 
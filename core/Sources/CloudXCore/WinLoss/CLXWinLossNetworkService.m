@@ -11,6 +11,7 @@
 #import <CloudXCore/CLXBaseNetworkService.h>
 #import <CloudXCore/CLXLogger.h>
 #import <CloudXCore/CLXError.h>
+#import <CloudXCore/CLXRequestCompressor.h>
 
 @interface CLXWinLossNetworkService ()
 @property (nonatomic, strong) CLXBaseNetworkService *baseNetworkService;
@@ -112,20 +113,11 @@
                        notificationType, (unsigned long)jsonBody.length, endpointUrl]];
     [self.logger debug:[NSString stringWithFormat:@"📊 [WinLossNetworkService] Win/Loss API Request Body: %@", jsonBody]];
     
-    // Prepare headers matching Android's implementation
-    NSMutableDictionary *headers = [[NSMutableDictionary alloc] init];
-    headers[@"Authorization"] = [NSString stringWithFormat:@"Bearer %@", appKey];
-    headers[@"Content-Type"] = @"application/json";
-    
-    // Execute POST request using base class method signature
-    [self.baseNetworkService executeRequestWithEndpoint:@"" // Full URL provided in endpointUrl
-                                           urlParameters:nil
-                                             requestBody:jsonData
-                                                 headers:headers
-                                              maxRetries:1
-                                                   delay:1.0
-                                              completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
-        
+    [self _postBody:jsonData
+             appKey:appKey
+        endpointUrl:endpointUrl
+   allowCompression:YES
+         completion:^(id _Nullable response, NSError * _Nullable error) {
         if (error) {
             [self.logger error:[NSString stringWithFormat:@"❌ [WinLossNetworkService] Win/loss notification failed: %@", error.localizedDescription]];
             
@@ -136,12 +128,7 @@
         }
         
         // Check HTTP status code (matches Android's response.status.value check)
-        NSHTTPURLResponse *httpResponse = nil;
-        if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-            httpResponse = (NSHTTPURLResponse *)response;
-        }
-        
-        NSInteger statusCode = httpResponse ? httpResponse.statusCode : 200; // Default to success if no HTTP response
+        NSInteger statusCode = [self _statusCodeForResponse:response error:nil];
         
         // Match Android's success condition: code in 200..299
         if (statusCode >= 200 && statusCode < 300) {
@@ -152,8 +139,9 @@
         } else {
             [self.logger error:[NSString stringWithFormat:@"❌ [WinLossNetworkService] HTTP %ld", (long)statusCode]];
             
-            NSError *statusError = [CLXError errorWithCode:CLXErrorCodeServerError 
-                                               description:[NSString stringWithFormat:@"HTTP %ld", (long)statusCode]];
+            NSError *statusError = [CLXError errorWithCode:CLXErrorCodeServerError
+                                                  userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"HTTP %ld", (long)statusCode],
+                                                             CLXErrorHTTPStatusCodeKey: @(statusCode)}];
             if (completion) {
                 completion(NO, statusError);
             }
@@ -161,4 +149,144 @@
     }];
 }
 
+- (void)sendBatchWithAppKey:(NSString *)appKey
+                endpointUrl:(NSString *)endpointUrl
+                   payloads:(NSArray<NSDictionary<NSString *, id> *> *)payloads
+                 completion:(void (^)(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error))completion {
+    if (payloads.count == 0) {
+        if (completion) {
+            completion(CLXWinLossBatchResultSent, [NSIndexSet indexSet], nil);
+        }
+        return;
+    }
+    
+    NSError *jsonError;
+    NSData *jsonData = nil;
+    @try {
+        jsonData = [NSJSONSerialization dataWithJSONObject:@{@"events": payloads} options:0 error:&jsonError];
+    } @catch (NSException *exception) {
+        jsonError = [NSError errorWithDomain:@"CLXWinLossNetworkService"
+                                        code:1001
+                                    userInfo:@{
+                                        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"JSON serialization exception: %@", exception.reason],
+                                        @"exception": exception
+                                    }];
+    }
+    
+    if (jsonError || !jsonData) {
+        [self.logger error:[NSString stringWithFormat:@"❌ [WinLossNetworkService] Batch JSON serialization failed: %@", jsonError.localizedDescription]];
+        if (completion) {
+            completion(CLXWinLossBatchResultFailed, [NSIndexSet indexSet], jsonError);
+        }
+        return;
+    }
+    
+    CLX_LOG_DEBUG(self.logger, @"🔧 [WinLossNetworkService] Sending batch of %lu notifications (%lu bytes) to: %@",
+                  (unsigned long)payloads.count, (unsigned long)jsonData.length, endpointUrl);
+    
+    [self _postBody:jsonData
+             appKey:appKey
+        endpointUrl:endpointUrl
+   allowCompression:YES
+         completion:^(id _Nullable response, NSError * _Nullable error) {
+        NSInteger statusCode = [self _statusCodeForResponse:response error:error];
+        
+        if (statusCode == 404 || statusCode == 405 || statusCode == 501) {
+            [self.logger error:[NSString stringWithFormat:@"⚠️ [WinLossNetworkService] Batch endpoint not supported (HTTP %ld)", (long)statusCode]];
+            if (completion) {
+                completion(CLXWinLossBatchResultUnsupported, [NSIndexSet indexSet], error);
+            }
+            return;
+        }
+        
+        if (error || statusCode < 200 || statusCode >= 300) {
+            NSError *batchError = error ?: [CLXError errorWithHTTPStatusCode:statusCode];
+            [self.logger error:[NSString stringWithFormat:@"❌ [WinLossNetworkService] Batch of %lu failed: %@",
+                               (unsigned long)payloads.count, batchError.localizedDescription]];
+            if (completion) {
+                completion(CLXWinLossBatchResultFailed, [NSIndexSet indexSet], batchError);
+            }
+            return;
+        }
+        
+        NSMutableIndexSet *accepted = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, payloads.count)];
+        if ([response isKindOfClass:[NSDictionary class]]) {
+            id rejected = ((NSDictionary *)response)[@"rejected"];
+            if ([rejected isKindOfClass:[NSArray class]]) {
+                for (id index in (NSArray *)rejected) {
+                    if ([index isKindOfClass:[NSNumber class]] && [index integerValue] >= 0) {
+                        [accepted removeIndex:[index unsignedIntegerValue]];
+                    }
+                }
+            }
+        }
+        
+        CLX_LOG_DEBUG(self.logger, @"✅ [WinLossNetworkService] Batch accepted %lu of %lu notifications",
+                      (unsigned long)accepted.count, (unsigned long)payloads.count);
+        if (completion) {
+            completion(CLXWinLossBatchResultSent, accepted, nil);
+        }
+    }];
+}
+
+/**
+ * Posts the JSON body, compressed when the shared compressor says so. A server that
+ * rejects the compressed body gets it once more uncompressed.
+ */
+- (void)_postBody:(NSData *)jsonData
+           appKey:(NSString *)appKey
+      endpointUrl:(NSString *)endpointUrl
+ allowCompression:(BOOL)allowCompression
+       completion:(void (^)(id _Nullable response, NSError * _Nullable error))completion {
+    // Prepare headers matching Android's implementation
+    NSMutableDictionary *headers = [[NSMutableDictionary alloc] init];
+    headers[@"Authorization"] = [NSString stringWithFormat:@"Bearer %@", appKey];
+    headers[@"Content-Type"] = @"application/json";
+    
+    CLXRequestCompressor *compressor = [CLXRequestCompressor shared];
+    NSURL *url = [NSURL URLWithString:endpointUrl];
+    CLXContentEncoding encoding = CLXContentEncodingIdentity;
+    NSData *requestBody = jsonData;
+    if (allowCompression) {
+        NSData *compressed = [compressor compressedBody:jsonData forURL:url encoding:&encoding];
+        if (compressed) {
+            requestBody = compressed;
+            headers[@"Content-Encoding"] = [CLXRequestCompressor headerValueForEncoding:encoding];
+        }
+    }
+    
+    // Execute POST request using base class method signature
+    [self.baseNetworkService executeRequestWithEndpoint:@"" // Full URL provided in endpointUrl
+                                           urlParameters:nil
+                                             requestBody:requestBody
+                                                 headers:headers
+                                              maxRetries:1
+                                                   delay:1.0
+                                              completion:^(id _Nullable response, NSError * _Nullable error, BOOL isKillSwitchEnabled) {
+        NSInteger statusCode = [self _statusCodeForResponse:response error:error];
+        if ([compressor shouldRetryUncompressedAfterEncoding:encoding statusCode:statusCode url:url]) {
+            [self _postBody:jsonData appKey:appKey endpointUrl:endpointUrl allowCompression:NO completion:completion];
+            return;
+        }
+        if (completion) {
+            completion(response, error);
+        }
+    }];
+}
+
+/**
+ * HTTP status of a base service answer: carried by the error for non-2xx responses,
+ * by the response object when it is an NSHTTPURLResponse, otherwise a 2xx
+ */
+- (NSInteger)_statusCodeForResponse:(nullable id)response error:(nullable NSError *)error {
+    NSNumber *errorStatus = error.userInfo[CLXErrorHTTPStatusCodeKey];
+    if (errorStatus) {
+        return errorStatus.integerValue;
+    }
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return ((NSHTTPURLResponse *)response).statusCode;
+    }
+    return error ? 0 : 200; // Default to success if no HTTP response
+}
+
 @end
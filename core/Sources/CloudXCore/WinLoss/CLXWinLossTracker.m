@@ -14,8 +14,20 @@
 #import <CloudXCore/CLXSDKConfig.h>
 #import <CloudXCore/CLXBidResponse.h>
 #import <CloudXCore/CLXLogger.h>
-#import <CloudXCore/URLSession+CLX.h>
+#import <CloudXCore/CLXError.h>
+#import <CloudXCore/CLXURLSessionProvider.h>
 #import <CloudXCore/CLXSQLiteDatabase.h>
+#import <CloudXCore/CLXFlushScheduler.h>
+#import <CloudXCore/CLXTrackingFieldResolver.h>
+
+// Retry cadence for cached events, plus early-retry thresholds for failed sends piling up
+static const NSTimeInterval kCLXWinLossRetryIntervalSeconds = 60.0;
+static const NSUInteger kCLXWinLossPendingEventFlushThreshold = 20;
+static const NSUInteger kCLXWinLossPendingBytesFlushThreshold = 32 * 1024;
+
+// With a batch endpoint, events arriving within this window (an auction's win and losses) share one request
+static const NSTimeInterval kCLXWinLossBatchWindowSeconds = 0.5;
+static const NSUInteger kCLXWinLossMaxBatchSize = 50;
 
 /**
  * Simple model for cached win/loss events
@@ -39,15 +51,50 @@
 }
 @end
 
+/**
+ * Win/loss payloads persisted and retried together as one batch request
+ */
+@interface CLXCachedWinLossBatch : NSObject
+@property (nonatomic, copy) NSString *batchId;
+@property (nonatomic, copy) NSString *endpointUrl;
+@property (nonatomic, copy) NSArray<NSDictionary<NSString *, id> *> *payloads;
+- (instancetype)initWithBatchId:(NSString *)batchId endpointUrl:(NSString *)endpointUrl payloads:(NSArray<NSDictionary<NSString *, id> *> *)payloads;
+@end
+
+@implementation CLXCachedWinLossBatch
+- (instancetype)initWithBatchId:(NSString *)batchId endpointUrl:(NSString *)endpointUrl payloads:(NSArray<NSDictionary<NSString *, id> *> *)payloads {
+    self = [super init];
+    if (self) {
+        _batchId = [batchId copy];
+        _endpointUrl = [endpointUrl copy];
+        _payloads = [payloads copy];
+    }
+    return self;
+}
+@end
+
 @interface CLXWinLossTracker ()
 @property (nonatomic, strong) CLXAuctionBidManager *auctionBidManager;
 @property (nonatomic, strong) CLXWinLossFieldResolver *winLossFieldResolver;
 @property (nonatomic, strong) CLXWinLossNetworkService *networkService;
 @property (nonatomic, strong) CLXLogger *logger;
 @property (nonatomic, strong) CLXSQLiteDatabase *database;
+@property (nonatomic, strong) dispatch_queue_t flushQueue;
+@property (nonatomic, strong) CLXFlushScheduler *flushScheduler;
 
 @property (nonatomic, copy, nullable) NSString *appKey;
 @property (nonatomic, copy, nullable) NSString *endpointUrl;
+
+// Batched mode, used while the config names a batch endpoint that has not refused a batch
+@property (nonatomic, strong, nullable) CLXWinLossNetworkService *batchNetworkService;
+@property (atomic, copy, nullable) NSString *batchEndpointUrl;
+@property (atomic, assign) BOOL batchEndpointUnsupported;
+@property (nonatomic, strong) dispatch_queue_t batchQueue;
+@property (nonatomic, strong) NSMutableArray<NSDictionary<NSString *, id> *> *pendingBatchPayloads;
+@property (nonatomic, assign) BOOL batchFlushScheduled;
+
+// Ids of event and batch rows with a send in flight; the retry pass leaves them alone
+@property (nonatomic, strong) NSMutableSet<NSString *> *inFlightRowIds;
 @end
 
 @implementation CLXWinLossTracker
@@ -85,14 +132,37 @@ static id<CLXWinLossTracking> _testInstance = nil;
         _auctionBidManager = [[CLXAuctionBidManager alloc] init];
         _winLossFieldResolver = [[CLXWinLossFieldResolver alloc] init];
         _logger = [[CLXLogger alloc] initWithCategory:@"WinLossTracker"];
-        _database = [[CLXSQLiteDatabase alloc] initWithDatabaseName:@"cloudx_winloss"];
+        _database = [CLXSQLiteDatabase sharedDatabase];
         
         // Create table synchronously since we fixed the deadlock issues in CLXSQLiteDatabase
         [self createWinLossTableIfNeeded];
+        [self createWinLossBatchTableIfNeeded];
+        [_database importTable:@"cached_win_loss_events_table" fromLegacyDatabaseNamed:@"cloudx_winloss"];
+        
+        _batchQueue = dispatch_queue_create("com.cloudx.winloss.batch", DISPATCH_QUEUE_SERIAL);
+        _pendingBatchPayloads = [NSMutableArray array];
+        _inFlightRowIds = [NSMutableSet set];
         
         // Initialize network service with placeholder URL (will be updated when endpoint is set)
-        NSURLSession *urlSession = [NSURLSession cloudxSessionWithIdentifier:@"winloss"];
+        NSURLSession *urlSession = [[CLXURLSessionProvider shared] sessionForPurpose:CLXURLSessionPurposeTracking];
         _networkService = [[CLXWinLossNetworkService alloc] initWithBaseURL:@"" urlSession:urlSession];
+        
+        // Cached events are retried periodically and whenever failed sends pile up
+        _flushQueue = dispatch_queue_create("com.cloudx.winloss.flush", DISPATCH_QUEUE_SERIAL);
+        __weak typeof(self) weakSelf = self;
+        _flushScheduler = [[CLXFlushScheduler alloc] initWithName:@"winloss"
+                                                          interval:kCLXWinLossRetryIntervalSeconds
+                                                             queue:_flushQueue
+                                                        flushBlock:^(dispatch_block_t completion) {
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf) {
+                [strongSelf _sendPendingEventsWithCompletion:completion];
+            } else {
+                completion();
+            }
+        }];
+        _flushScheduler.pendingEventThreshold = kCLXWinLossPendingEventFlushThreshold;
+        _flushScheduler.pendingBytesThreshold = kCLXWinLossPendingBytesFlushThreshold;
     }
     return self;
 }
@@ -107,10 +177,13 @@ static id<CLXWinLossTracking> _testInstance = nil;
 - (void)setEndpoint:(nullable NSString *)endpointUrl {
     self.endpointUrl = [endpointUrl copy];
     
-    // Recreate network service with new endpoint
+    // Recreate network service with new endpoint; it keeps the shared session and its warm connections
     if (endpointUrl) {
-        NSURLSession *urlSession = [NSURLSession cloudxSessionWithIdentifier:@"winloss"];
+        NSURLSession *urlSession = [[CLXURLSessionProvider shared] sessionForPurpose:CLXURLSessionPurposeTracking];
         self.networkService = [[CLXWinLossNetworkService alloc] initWithBaseURL:endpointUrl urlSession:urlSession];
+        [self.flushScheduler start];
+    } else {
+        [self.flushScheduler stop];
     }
     
     [self.logger debug:[NSString stringWithFormat:@"🔧 [WinLossTracker] Endpoint set: %@", endpointUrl ?: @"(nil)"]];
@@ -118,18 +191,26 @@ static id<CLXWinLossTracking> _testInstance = nil;
 
 - (void)setConfig:(CLXSDKConfigResponse *)config {
     [self.winLossFieldResolver setConfig:config];
+    [self setBatchEndpoint:config.winLossNotificationBatchURL];
     [self.logger debug:@"🔧 [WinLossTracker] Config set for field resolver"];
 }
 
-- (void)trySendingPendingWinLossEvents {
-    NSArray<CLXCachedWinLossEvent *> *cachedEvents = [self getAllCachedEvents];
-    
-    if (cachedEvents.count == 0) {
-        return;
+- (void)setBatchEndpoint:(nullable NSString *)batchEndpointUrl {
+    if (batchEndpointUrl.length > 0) {
+        NSURLSession *urlSession = [[CLXURLSessionProvider shared] sessionForPurpose:CLXURLSessionPurposeTracking];
+        self.batchNetworkService = [[CLXWinLossNetworkService alloc] initWithBaseURL:batchEndpointUrl urlSession:urlSession];
+        self.batchEndpointUrl = batchEndpointUrl;
+    } else {
+        self.batchEndpointUrl = nil;
+        self.batchNetworkService = nil;
     }
+    self.batchEndpointUnsupported = NO;
     
-    [self.logger debug:[NSString stringWithFormat:@"🔄 [WinLossTracker] Retrying %lu cached events", (unsigned long)cachedEvents.count]];
-    [self sendCachedEvents:cachedEvents];
+    CLX_LOG_DEBUG(self.logger, @"🔧 [WinLossTracker] Batch endpoint set: %@", batchEndpointUrl ?: @"(nil)");
+}
+
+- (void)trySendingPendingWinLossEvents {
+    [self _sendPendingEventsWithCompletion:nil];
 }
 
 - (void)addBid:(NSString *)auctionId bid:(CLXBidResponseBid *)bid {
@@ -171,7 +252,8 @@ static id<CLXWinLossTracking> _testInstance = nil;
                                                                                                loadedBidPrice:loadedBidPrice];
         
         if (payload) {
-            NSString *reasonStr = (lossReason.integerValue == CLXLossReasonLostToHigherBid) ? @"HigherBid" : @"TechError";
+            NSString *reasonStr = (lossReason.integerValue == CLXLossReasonLostToHigherBid) ? @"HigherBid" :
+                                  (lossReason.integerValue == CLXLossReasonExpired) ? @"Expired" : @"TechError";
             [self.logger debug:[NSString stringWithFormat:@"📊 [WinLossTracker] LOSS: %@ (%@)", bidId, reasonStr]];
             [self trackWinLoss:payload];
         } else {
@@ -207,6 +289,7 @@ static id<CLXWinLossTracking> _testInstance = nil;
         
         // Clear auction data after successful win notification (matches Android)
         [self.auctionBidManager clearAuction:auctionId];
+        [[CLXTrackingFieldResolver shared] clearAuction:auctionId];
     });
 }
 
@@ -246,6 +329,7 @@ static id<CLXWinLossTracking> _testInstance = nil;
 
 - (void)clearAuction:(NSString *)auctionId {
     [self.auctionBidManager clearAuction:auctionId];
+    [[CLXTrackingFieldResolver shared] clearAuction:auctionId];
 }
 
 #pragma mark - Database Management
@@ -267,24 +351,51 @@ static id<CLXWinLossTracking> _testInstance = nil;
     }
 }
 
+- (void)createWinLossBatchTableIfNeeded {
+    if (![self.database tableExists:@"cached_win_loss_batches_table"]) {
+        NSString *createTableSQL = @"CREATE TABLE cached_win_loss_batches_table ("
+                                   @"id TEXT PRIMARY KEY,"
+                                   @"endpointUrl TEXT NOT NULL,"
+                                   @"payloads TEXT NOT NULL"
+                                   @");";
+        
+        if ([self.database executeSQL:createTableSQL]) {
+            [self.logger debug:@"Win/loss batches table created successfully"];
+        } else {
+            [self.logger error:@"Failed to create win/loss batches table"];
+        }
+    }
+}
+
 #pragma mark - Private Methods
 
 /**
  * Sends win/loss payload to server with database persistence for retry
  */
 - (void)trackWinLoss:(NSDictionary<NSString *, id> *)payload {
-    // Save to database first for retry capability
-    NSString *eventId = [self saveToDatabase:payload];
+    if ([self _isBatchingEnabled]) {
+        [self _enqueueBatchPayload:payload];
+        return;
+    }
+    
+    // Save to database first for retry capability. The row is claimed before it exists so the
+    // retry pass cannot send it again while this send is in flight.
+    NSUInteger payloadBytes = 0;
+    NSString *eventId = [[NSUUID UUID] UUIDString];
+    [self _claimRowId:eventId];
+    [self saveToDatabase:payload eventId:eventId payloadBytes:&payloadBytes];
     
     NSString *endpoint = self.endpointUrl;
     if (!endpoint || endpoint.length == 0) {
         [self.logger error:@"❌ [WinLossTracker] No endpoint configured for win/loss notification"];
+        [self _releaseRowId:eventId];
         return;
     }
     
     NSString *appKey = self.appKey;
     if (!appKey || appKey.length == 0) {
         [self.logger error:@"❌ [WinLossTracker] No app key configured for win/loss notification"];
+        [self _releaseRowId:eventId];
         return;
     }
     
@@ -297,73 +408,356 @@ static id<CLXWinLossTracking> _testInstance = nil;
         if (success) {
             // Remove from database cache on success
             [self deleteEventWithId:eventId];
+        } else if ([self _isPermanentFailure:error]) {
+            [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Send rejected, dropping event: %@", error.localizedDescription]];
+            [self deleteEventWithId:eventId];
         } else {
             [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Send failed: %@", 
                                error ? error.localizedDescription : @"Unknown error"]];
             // Keep in database for retry
+            [self.flushScheduler noteEnqueuedEvents:1 bytes:payloadBytes];
         }
+        [self _releaseRowId:eventId];
     }];
 }
 
+#pragma mark - In-Flight Rows
+
 /**
- * Saves payload to database and returns event ID for tracking
+ * Marks a row as being sent
+ * @return NO if a send for it is already in flight
  */
-- (NSString *)saveToDatabase:(NSDictionary<NSString *, id> *)payload {
-    NSString *eventId = [[NSUUID UUID] UUIDString];
+- (BOOL)_claimRowId:(NSString *)rowId {
+    @synchronized (self.inFlightRowIds) {
+        if ([self.inFlightRowIds containsObject:rowId]) {
+            return NO;
+        }
+        [self.inFlightRowIds addObject:rowId];
+        return YES;
+    }
+}
+
+- (void)_releaseRowId:(NSString *)rowId {
+    @synchronized (self.inFlightRowIds) {
+        [self.inFlightRowIds removeObject:rowId];
+    }
+}
+
+/**
+ * Whether a failed send would fail the same way on every retry: a 4xx other than 408 and 429,
+ * or a payload that cannot be encoded
+ */
+- (BOOL)_isPermanentFailure:(nullable NSError *)error {
+    NSNumber *statusCode = error.userInfo[CLXErrorHTTPStatusCodeKey];
+    if (statusCode) {
+        NSInteger code = statusCode.integerValue;
+        return code >= 400 && code < 500 && code != 408 && code != 429;
+    }
+    return [error.domain isEqualToString:@"CLXWinLossNetworkService"];
+}
+
+#pragma mark - Batching
+
+- (BOOL)_isBatchingEnabled {
+    return self.batchEndpointUrl.length > 0 && !self.batchEndpointUnsupported;
+}
+
+/**
+ * Holds a payload for the current batch window; the first payload opens the window
+ */
+- (void)_enqueueBatchPayload:(NSDictionary<NSString *, id> *)payload {
+    dispatch_async(self.batchQueue, ^{
+        [self.pendingBatchPayloads addObject:payload];
+        
+        if (self.pendingBatchPayloads.count >= kCLXWinLossMaxBatchSize) {
+            [self _flushPendingBatch];
+        } else if (!self.batchFlushScheduled) {
+            self.batchFlushScheduled = YES;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kCLXWinLossBatchWindowSeconds * NSEC_PER_SEC)), self.batchQueue, ^{
+                [self _flushPendingBatch];
+            });
+        }
+    });
+}
+
+/**
+ * Persists the payloads gathered in the window as one batch row and sends them. Runs on batchQueue.
+ */
+- (void)_flushPendingBatch {
+    self.batchFlushScheduled = NO;
+    if (self.pendingBatchPayloads.count == 0) {
+        return;
+    }
+    
+    NSArray<NSDictionary<NSString *, id> *> *payloads = [self.pendingBatchPayloads copy];
+    [self.pendingBatchPayloads removeAllObjects];
     
+    NSString *batchEndpoint = self.batchEndpointUrl;
+    if (batchEndpoint.length == 0 || self.batchEndpointUnsupported) {
+        // Batching was switched off while the window was open
+        for (NSDictionary<NSString *, id> *payload in payloads) {
+            [self trackWinLoss:payload];
+        }
+        return;
+    }
+    
+    CLXCachedWinLossBatch *batch = [[CLXCachedWinLossBatch alloc] initWithBatchId:[[NSUUID UUID] UUIDString]
+                                                                      endpointUrl:batchEndpoint
+                                                                         payloads:payloads];
+    [self _claimRowId:batch.batchId];
+    [self insertBatch:batch];
+    [self _sendBatch:batch completion:nil];
+}
+
+/**
+ * Sends a persisted batch the caller has claimed, and releases it once done. An answered batch
+ * leaves the store, including events the server rejected, and a server without batch support
+ * gets the events one by one.
+ */
+- (void)_sendBatch:(CLXCachedWinLossBatch *)batch completion:(nullable dispatch_block_t)completion {
+    NSString *appKey = self.appKey;
+    CLXWinLossNetworkService *batchService = self.batchNetworkService;
+    if (appKey.length == 0 || !batchService) {
+        [self.logger error:@"❌ [WinLossTracker] No app key or batch endpoint configured for win/loss batch"];
+        [self _releaseRowId:batch.batchId];
+        if (completion) {
+            completion();
+        }
+        return;
+    }
+    
+    [batchService sendBatchWithAppKey:appKey
+                          endpointUrl:batch.endpointUrl
+                             payloads:batch.payloads
+                           completion:^(CLXWinLossBatchResult result, NSIndexSet *acceptedIndexes, NSError * _Nullable error) {
+        switch (result) {
+            case CLXWinLossBatchResultSent: {
+                // An event the server lists as rejected was refused, like a 4xx for a single event
+                NSUInteger rejectedCount = batch.payloads.count - [acceptedIndexes countOfIndexesInRange:NSMakeRange(0, batch.payloads.count)];
+                if (rejectedCount > 0) {
+                    CLX_LOG_ERROR(self.logger, @"⚠️ [WinLossTracker] Batch %@: %lu of %lu events rejected, dropping them",
+                                  batch.batchId, (unsigned long)rejectedCount, (unsigned long)batch.payloads.count);
+                }
+                [self deleteBatchWithId:batch.batchId];
+                break;
+            }
+            case CLXWinLossBatchResultFailed:
+                if ([self _isPermanentFailure:error]) {
+                    CLX_LOG_ERROR(self.logger, @"❌ [WinLossTracker] Batch rejected, dropping %lu events: %@",
+                                  (unsigned long)batch.payloads.count, error.localizedDescription);
+                    [self deleteBatchWithId:batch.batchId];
+                    break;
+                }
+                CLX_LOG_ERROR(self.logger, @"❌ [WinLossTracker] Batch send failed: %@", error ? error.localizedDescription : @"Unknown error");
+                [self.flushScheduler noteEnqueuedEvents:batch.payloads.count bytes:0];
+                break;
+            case CLXWinLossBatchResultUnsupported:
+                // The per-event endpoint keeps working for servers without batch support
+                self.batchEndpointUnsupported = YES;
+                [self _convertBatchesToEvents:@[batch] send:YES];
+                break;
+        }
+        [self _releaseRowId:batch.batchId];
+        if (completion) {
+            completion();
+        }
+    }];
+}
+
+/**
+ * Replaces batch rows with one per-event row per payload in a single transaction
+ * @param send Also send the converted events right away
+ */
+- (void)_convertBatchesToEvents:(NSArray<CLXCachedWinLossBatch *> *)batches send:(BOOL)send {
+    NSString *endpoint = self.endpointUrl ?: @"";
+    NSMutableArray<CLXCachedWinLossEvent *> *events = [NSMutableArray array];
+    for (CLXCachedWinLossBatch *batch in batches) {
+        for (NSDictionary<NSString *, id> *payload in batch.payloads) {
+            NSData *jsonData = [NSJSONSerialization dataWithJSONObject:payload options:0 error:nil];
+            if (!jsonData) {
+                continue;
+            }
+            NSString *payloadJson = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+            [events addObject:[[CLXCachedWinLossEvent alloc] initWithEventId:[[NSUUID UUID] UUIDString]
+                                                                 endpointUrl:endpoint
+                                                                     payload:payloadJson]];
+        }
+    }
+    
+    [self.database executeInTransaction:^{
+        for (CLXCachedWinLossEvent *event in events) {
+            [self insertEventWithId:event.eventId endpointUrl:event.endpointUrl payload:event.payload];
+        }
+        for (CLXCachedWinLossBatch *batch in batches) {
+            [self deleteBatchWithId:batch.batchId];
+        }
+    }];
+    CLX_LOG_DEBUG(self.logger, @"🔄 [WinLossTracker] Converted %lu batches into %lu single events",
+                  (unsigned long)batches.count, (unsigned long)events.count);
+    
+    if (send && events.count > 0) {
+        [self sendCachedEvents:events completion:nil];
+    }
+}
+
+/**
+ * Saves payload to database under the given event ID for retry
+ */
+- (void)saveToDatabase:(NSDictionary<NSString *, id> *)payload eventId:(NSString *)eventId payloadBytes:(NSUInteger *)payloadBytes {
     // Convert payload to JSON string
     NSError *error = nil;
     NSData *jsonData = [NSJSONSerialization dataWithJSONObject:payload options:0 error:&error];
     if (error || !jsonData) {
         [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Failed to serialize payload: %@, payload: %@", error, payload]];
-        return eventId;
+        return;
     }
     
     NSString *payloadJson = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+    if (payloadBytes) {
+        *payloadBytes = jsonData.length;
+    }
     
     // Save to database
     [self insertEventWithId:eventId endpointUrl:self.endpointUrl ?: @"" payload:payloadJson];
     
     [self.logger debug:[NSString stringWithFormat:@"💾 [WinLossTracker] Saved event to database with ID: %@", eventId]];
-    return eventId;
 }
 
 /**
- * Sends cached events from database for retry processing
+ * Loads cached events and retries the ones without a send in flight; completion runs once every
+ * send has finished
  */
-- (void)sendCachedEvents:(NSArray<CLXCachedWinLossEvent *> *)cachedEvents {
+- (void)_sendPendingEventsWithCompletion:(nullable dispatch_block_t)completion {
+    // Batches being sent right now (a window just flushed, or the previous pass) are left to that send
+    NSMutableArray<CLXCachedWinLossBatch *> *cachedBatches = [NSMutableArray array];
+    for (CLXCachedWinLossBatch *batch in [self getAllCachedBatches]) {
+        if ([self _claimRowId:batch.batchId]) {
+            [cachedBatches addObject:batch];
+        }
+    }
+    if (cachedBatches.count > 0 && ![self _isBatchingEnabled]) {
+        // Batches stored while the server took them now go out one event at a time
+        [self _convertBatchesToEvents:cachedBatches send:NO];
+        for (CLXCachedWinLossBatch *batch in cachedBatches) {
+            [self _releaseRowId:batch.batchId];
+        }
+        [cachedBatches removeAllObjects];
+    }
+    NSArray<CLXCachedWinLossEvent *> *cachedEvents = [self getAllCachedEvents];
+    
+    if (cachedEvents.count == 0 && cachedBatches.count == 0) {
+        if (completion) {
+            completion();
+        }
+        return;
+    }
+    
+    [self.logger debug:[NSString stringWithFormat:@"🔄 [WinLossTracker] Retrying %lu cached events and %lu batches",
+                       (unsigned long)cachedEvents.count, (unsigned long)cachedBatches.count]];
+    
+    dispatch_group_t retryGroup = dispatch_group_create();
+    if (cachedEvents.count > 0) {
+        dispatch_group_enter(retryGroup);
+        [self sendCachedEvents:cachedEvents completion:^{
+            dispatch_group_leave(retryGroup);
+        }];
+    }
+    for (CLXCachedWinLossBatch *batch in cachedBatches) {
+        dispatch_group_enter(retryGroup);
+        [self _sendBatch:batch completion:^{
+            dispatch_group_leave(retryGroup);
+        }];
+    }
+    
+    dispatch_group_notify(retryGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (completion) {
+            completion();
+        }
+    });
+}
+
+/**
+ * Sends cached events from database for retry processing. Events with a send already in flight are
+ * skipped; events the server refuses for good are deleted along with the sent ones.
+ */
+- (void)sendCachedEvents:(NSArray<CLXCachedWinLossEvent *> *)cachedEvents completion:(nullable dispatch_block_t)completion {
     NSString *endpoint = self.endpointUrl;
     NSString *appKey = self.appKey;
     
     if (!endpoint || endpoint.length == 0) {
         [self.logger error:@"❌ [WinLossTracker] No endpoint configured for cached events"];
+        if (completion) {
+            completion();
+        }
         return;
     }
     
     if (!appKey || appKey.length == 0) {
         [self.logger error:@"❌ [WinLossTracker] No app key configured for cached events"];
+        if (completion) {
+            completion();
+        }
         return;
     }
     
+    // Sent and refused events are collected and removed with one batched delete once every send has completed
+    dispatch_group_t sendGroup = dispatch_group_create();
+    NSMutableArray<NSString *> *finishedEventIds = [NSMutableArray arrayWithCapacity:cachedEvents.count];
+    NSMutableArray<NSString *> *claimedEventIds = [NSMutableArray arrayWithCapacity:cachedEvents.count];
+    
     // Process each cached event
     for (CLXCachedWinLossEvent *cachedEvent in cachedEvents) {
+        if (![self _claimRowId:cachedEvent.eventId]) {
+            continue;
+        }
+        [claimedEventIds addObject:cachedEvent.eventId];
+        
         NSDictionary *payload = [self parsePayload:cachedEvent.payload];
-        if (payload) {
+        if (!payload) {
+            // Unreadable rows would fail the same way on every pass
+            @synchronized (finishedEventIds) {
+                [finishedEventIds addObject:cachedEvent.eventId];
+            }
+        } else {
             NSString *eventEndpoint = cachedEvent.endpointUrl.length > 0 ? cachedEvent.endpointUrl : endpoint;
             
+            dispatch_group_enter(sendGroup);
             [self.networkService sendWithAppKey:appKey
                                     endpointUrl:eventEndpoint
                                         payload:payload
                                      completion:^(BOOL success, NSError * _Nullable error) {
                 if (success) {
                     [self.logger debug:[NSString stringWithFormat:@"✅ [WinLossTracker] Cached event sent successfully: %@", cachedEvent.eventId]];
-                    [self deleteEventWithId:cachedEvent.eventId];
+                    @synchronized (finishedEventIds) {
+                        [finishedEventIds addObject:cachedEvent.eventId];
+                    }
+                } else if ([self _isPermanentFailure:error]) {
+                    [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Cached event rejected, dropping it: %@ (%@)",
+                                       cachedEvent.eventId, error.localizedDescription]];
+                    @synchronized (finishedEventIds) {
+                        [finishedEventIds addObject:cachedEvent.eventId];
+                    }
                 } else {
                     [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Cached event failed: %@", cachedEvent.eventId]];
                 }
+                dispatch_group_leave(sendGroup);
             }];
         }
     }
+    
+    dispatch_group_notify(sendGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSArray<NSString *> *idsToDelete;
+        @synchronized (finishedEventIds) {
+            idsToDelete = [finishedEventIds copy];
+        }
+        [self deleteEventsWithIds:idsToDelete];
+        for (NSString *eventId in claimedEventIds) {
+            [self _releaseRowId:eventId];
+        }
+        if (completion) {
+            completion();
+        }
+    });
 }
 
 /**
@@ -445,10 +839,67 @@ static id<CLXWinLossTracking> _testInstance = nil;
     }
 }
 
+- (void)deleteEventsWithIds:(NSArray<NSString *> *)eventIds {
+    if (eventIds.count == 0) {
+        return;
+    }
+    
+    if ([self.database deleteFromTable:@"cached_win_loss_events_table" whereColumn:@"id" inValues:eventIds]) {
+        [self.logger debug:[NSString stringWithFormat:@"Deleted %lu events in one transaction", (unsigned long)eventIds.count]];
+    } else {
+        [self.logger error:[NSString stringWithFormat:@"Failed to delete batch of %lu events", (unsigned long)eventIds.count]];
+    }
+}
+
+- (NSArray<CLXCachedWinLossBatch *> *)getAllCachedBatches {
+    NSArray<NSDictionary *> *rows = [self.database executeQuery:@"SELECT id, endpointUrl, payloads FROM cached_win_loss_batches_table;"];
+    
+    NSMutableArray<CLXCachedWinLossBatch *> *batches = [NSMutableArray arrayWithCapacity:rows.count];
+    for (NSDictionary *row in rows) {
+        NSData *jsonData = [row[@"payloads"] dataUsingEncoding:NSUTF8StringEncoding];
+        id payloads = jsonData ? [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:nil] : nil;
+        if (![payloads isKindOfClass:[NSArray class]]) {
+            [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Dropping unreadable batch: %@", row[@"id"]]];
+            [self deleteBatchWithId:row[@"id"] ?: @""];
+            continue;
+        }
+        [batches addObject:[[CLXCachedWinLossBatch alloc] initWithBatchId:row[@"id"] ?: @""
+                                                              endpointUrl:row[@"endpointUrl"] ?: @""
+                                                                 payloads:payloads]];
+    }
+    return [batches copy];
+}
+
+- (void)insertBatch:(CLXCachedWinLossBatch *)batch {
+    NSString *payloadsJson = [self _jsonStringForPayloads:batch.payloads];
+    if (!payloadsJson) {
+        [self.logger error:[NSString stringWithFormat:@"❌ [WinLossTracker] Failed to serialize batch: %@", batch.batchId]];
+        return;
+    }
+    
+    NSString *insertSQL = @"INSERT OR REPLACE INTO cached_win_loss_batches_table (id, endpointUrl, payloads) VALUES (?, ?, ?);";
+    if (![self.database executeSQL:insertSQL withParameters:@[batch.batchId, batch.endpointUrl ?: @"", payloadsJson]]) {
+        [self.logger error:[NSString stringWithFormat:@"Failed to insert batch with ID: %@", batch.batchId]];
+    }
+}
+
+- (void)deleteBatchWithId:(NSString *)batchId {
+    NSString *deleteSQL = @"DELETE FROM cached_win_loss_batches_table WHERE id = ?;";
+    if (![self.database executeSQL:deleteSQL withParameters:@[batchId]]) {
+        [self.logger error:[NSString stringWithFormat:@"Failed to delete batch with ID: %@", batchId]];
+    }
+}
+
+- (nullable NSString *)_jsonStringForPayloads:(NSArray<NSDictionary<NSString *, id> *> *)payloads {
+    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:payloads options:0 error:nil];
+    return jsonData ? [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding] : nil;
+}
+
 - (void)deleteAllEvents {
     NSString *deleteAllSQL = @"DELETE FROM cached_win_loss_events_table;";
     
     BOOL success = [self.database executeSQL:deleteAllSQL];
+    success = [self.database executeSQL:@"DELETE FROM cached_win_loss_batches_table;"] && success;
     if (success) {
         [self.logger debug:@"Deleted all cached events"];
     } else {